@@ -0,0 +1,76 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Shared helpers for the standalone benchmarks in bench/ (run with `make bench`)
+namespace Bench {
+
+// Wall-clock stopwatch in nanoseconds
+class Timer {
+public:
+    Timer() : start_(std::chrono::steady_clock::now()) {}
+
+    [[nodiscard]] double elapsedNs() const {
+        auto now = std::chrono::steady_clock::now();
+        return static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now - start_).count());
+    }
+
+    [[nodiscard]] double elapsedMs() const { return elapsedNs() / 1e6; }
+
+private:
+    std::chrono::steady_clock::time_point start_;
+};
+
+// Deterministic xorshift RNG so runs are comparable
+class Rng {
+public:
+    explicit Rng(uint64_t seed) : state_(seed ? seed : 0x9E3779B97F4A7C15ull) {}
+
+    [[nodiscard]] uint64_t next() {
+        state_ ^= state_ << 13;
+        state_ ^= state_ >> 7;
+        state_ ^= state_ << 17;
+        return state_;
+    }
+
+    // Uniform integer in [0, bound)
+    [[nodiscard]] int nextInt(int bound) {
+        return static_cast<int>(next() % static_cast<uint64_t>(bound));
+    }
+
+private:
+    uint64_t state_;
+};
+
+// Keeps the optimizer from discarding a computed value
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Integer command-line argument with default
+[[nodiscard]] inline int intArg(int argc, char* argv[], int index, int fallback) {
+    if (argc > index) {
+        int value = std::atoi(argv[index]);
+        if (value > 0) return value;
+    }
+    return fallback;
+}
+
+inline void printHeader(const std::string& title) {
+    std::printf("\n== %s ==\n", title.c_str());
+}
+
+inline void printRow(const std::string& label, double value, const char* unit) {
+    std::printf("  %-40s %14.2f %s\n", label.c_str(), value, unit);
+}
+
+}  // namespace Bench
+
+#endif // BENCH_UTIL_H
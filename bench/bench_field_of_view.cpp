@@ -0,0 +1,82 @@
+// Measures field-of-view updates while walking through a generated dungeon:
+// one-tile steps that reuse the cached opacity window against recasting from
+// a cold FieldOfView, and the cost of an update that changes nothing.
+//
+// Usage: bench_field_of_view [size] [steps]   (default 1024 x 1024, 100k steps)
+
+#include <vector>
+#include "BenchUtil.h"
+#include "field/FieldOfView.h"
+#include "field/Map.h"
+#include "field/MapGenerator.h"
+
+namespace {
+
+// Random walk over walkable tiles, one tile per step
+std::vector<Vec2> makeWalk(const Map& map, int steps) {
+    static const int DX[4] = {1, -1, 0, 0};
+    static const int DY[4] = {0, 0, 1, -1};
+    Bench::Rng rng(5);
+    std::vector<Vec2> walk;
+    walk.reserve(steps);
+    int x = map.getSpawnPosition().x;
+    int y = map.getSpawnPosition().y;
+    while (static_cast<int>(walk.size()) < steps) {
+        int dir = rng.nextInt(4);
+        if (map.getTile(x + DX[dir], y + DY[dir]).walkable) {
+            x += DX[dir];
+            y += DY[dir];
+            walk.push_back(Vec2{x, y});
+        }
+    }
+    return walk;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int size = Bench::intArg(argc, argv, 1, 1024);
+    int steps = Bench::intArg(argc, argv, 2, 100000);
+
+    MapGenerator::Config config;
+    config.style = MapGenerator::Style::Dungeon;
+    config.width = size;
+    config.height = size;
+    config.seed = 7;
+    Map map;
+    if (!MapGenerator::generate(config, map)) {
+        return 1;
+    }
+    std::vector<Vec2> walk = makeWalk(map, steps);
+
+    Bench::printHeader("Field of view " + std::to_string(size) + "x" + std::to_string(size));
+
+    for (int radius : {1, 4, 8}) {
+        std::string label = "radius " + std::to_string(radius);
+
+        FieldOfView cold;
+        Bench::Timer coldTimer;
+        for (const auto& pos : walk) {
+            cold.reset();
+            cold.update(map, pos, radius);
+        }
+        Bench::doNotOptimize(cold.getRevision());
+        Bench::printRow(label + ", recast from scratch", coldTimer.elapsedNs() / walk.size(), "ns/step");
+
+        FieldOfView fov;
+        Bench::Timer stepTimer;
+        for (const auto& pos : walk) {
+            fov.update(map, pos, radius);
+        }
+        Bench::doNotOptimize(fov.getRevision());
+        Bench::printRow(label + ", one-tile step", stepTimer.elapsedNs() / walk.size(), "ns/step");
+
+        Bench::Timer idleTimer;
+        for (int i = 0; i < steps; ++i) {
+            fov.update(map, walk.back(), radius);
+        }
+        Bench::doNotOptimize(fov.getRevision());
+        Bench::printRow(label + ", unchanged", idleTimer.elapsedNs() / steps, "ns/update");
+    }
+    return 0;
+}
@@ -0,0 +1,125 @@
+// Compares the compact 1-byte tile layer in Map against the previous
+// std::vector<Tile> layout (full Tile struct per cell).
+//
+// Usage: bench_map_storage [size] [probes]   (default 4096 x 4096, 20M probes)
+
+#include <vector>
+#include "BenchUtil.h"
+#include "field/Map.h"
+
+namespace {
+
+// Previous Map tile storage: one full Tile per cell
+class LegacyTileGrid {
+public:
+    LegacyTileGrid(int width, int height, const std::vector<TileType>& ids)
+        : width_(width), height_(height) {
+        tiles_.reserve(ids.size());
+        for (TileType id : ids) {
+            tiles_.push_back(Tile::fromId(static_cast<int>(id)));
+        }
+    }
+
+    [[nodiscard]] bool isInBounds(int x, int y) const {
+        return x >= 0 && x < width_ && y >= 0 && y < height_;
+    }
+
+    [[nodiscard]] const Tile& getTile(int x, int y) const {
+        if (!isInBounds(x, y)) return defaultTile_;
+        return tiles_[static_cast<size_t>(y) * width_ + x];
+    }
+
+    [[nodiscard]] bool isWalkable(int x, int y) const {
+        if (!isInBounds(x, y)) return false;
+        return getTile(x, y).isWalkable();
+    }
+
+    [[nodiscard]] size_t memoryBytes() const { return tiles_.size() * sizeof(Tile); }
+
+private:
+    std::vector<Tile> tiles_;
+    int width_;
+    int height_;
+    static constexpr Tile defaultTile_ = Tile::wall();
+};
+
+std::vector<TileType> makeTiles(int width, int height) {
+    Bench::Rng rng(42);
+    std::vector<TileType> ids(static_cast<size_t>(width) * height);
+    for (auto& id : ids) {
+        id = static_cast<TileType>(rng.nextInt(TILE_TYPE_COUNT));
+    }
+    return ids;
+}
+
+std::vector<int> makeProbes(int count, int width, int height) {
+    Bench::Rng rng(7);
+    std::vector<int> coords(static_cast<size_t>(count) * 2);
+    for (int i = 0; i < count; ++i) {
+        coords[i * 2] = rng.nextInt(width);
+        coords[i * 2 + 1] = rng.nextInt(height);
+    }
+    return coords;
+}
+
+template <typename Grid>
+double randomWalkable(const Grid& grid, const std::vector<int>& probes) {
+    Bench::Timer timer;
+    int walkable = 0;
+    for (size_t i = 0; i < probes.size(); i += 2) {
+        walkable += grid.isWalkable(probes[i], probes[i + 1]) ? 1 : 0;
+    }
+    Bench::doNotOptimize(walkable);
+    return timer.elapsedNs() / static_cast<double>(probes.size() / 2);
+}
+
+template <typename Grid>
+double randomGetTile(const Grid& grid, const std::vector<int>& probes) {
+    Bench::Timer timer;
+    int sum = 0;
+    for (size_t i = 0; i < probes.size(); i += 2) {
+        sum += grid.getTile(probes[i], probes[i + 1]).textureX;
+    }
+    Bench::doNotOptimize(sum);
+    return timer.elapsedNs() / static_cast<double>(probes.size() / 2);
+}
+
+template <typename Grid>
+double scanWalkable(const Grid& grid, int width, int height) {
+    Bench::Timer timer;
+    int walkable = 0;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            walkable += grid.isWalkable(x, y) ? 1 : 0;
+        }
+    }
+    Bench::doNotOptimize(walkable);
+    return timer.elapsedNs() / (static_cast<double>(width) * height);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int size = Bench::intArg(argc, argv, 1, 4096);
+    int probeCount = Bench::intArg(argc, argv, 2, 20000000);
+
+    std::vector<TileType> ids = makeTiles(size, size);
+    std::vector<int> probes = makeProbes(probeCount, size, size);
+
+    LegacyTileGrid legacy(size, size, ids);
+    Map map;
+    if (!map.loadFromTiles(size, size, ids)) {
+        return 1;
+    }
+
+    Bench::printHeader("Map tile storage " + std::to_string(size) + "x" + std::to_string(size));
+    Bench::printRow("legacy vector<Tile> memory", legacy.memoryBytes() / (1024.0 * 1024.0), "MiB");
+    Bench::printRow("compact TileType memory", map.getTileMemoryBytes() / (1024.0 * 1024.0), "MiB");
+    Bench::printRow("legacy getTile (random)", randomGetTile(legacy, probes), "ns/op");
+    Bench::printRow("compact getTile (random)", randomGetTile(map, probes), "ns/op");
+    Bench::printRow("legacy isWalkable (random)", randomWalkable(legacy, probes), "ns/op");
+    Bench::printRow("compact isWalkable (random)", randomWalkable(map, probes), "ns/op");
+    Bench::printRow("legacy isWalkable (row scan)", scanWalkable(legacy, size, size), "ns/op");
+    Bench::printRow("compact isWalkable (row scan)", scanWalkable(map, size, size), "ns/op");
+    return 0;
+}
@@ -0,0 +1,91 @@
+// Measures Map::isWalkable as the NPC count grows, against the previous
+// linear scan over all NPCs.
+//
+// Usage: bench_npc_occupancy [size] [probes]   (default 4096 x 4096, 10M probes)
+
+#include <string>
+#include <vector>
+#include "BenchUtil.h"
+#include "field/Map.h"
+
+namespace {
+
+// Previous NPC lookup: every query scans all NPCs
+bool linearHasNPCAt(const NPCSimulation& npcs, const Vec2& pos) {
+    for (size_t i = 0; i < npcs.size(); ++i) {
+        if (npcs.getX(i) == pos.x && npcs.getY(i) == pos.y) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<int> makeProbes(int count, int width, int height) {
+    Bench::Rng rng(7);
+    std::vector<int> coords(static_cast<size_t>(count) * 2);
+    for (int i = 0; i < count; ++i) {
+        coords[i * 2] = rng.nextInt(width);
+        coords[i * 2 + 1] = rng.nextInt(height);
+    }
+    return coords;
+}
+
+// Place NPCs on random free tiles
+void populate(Map& map, int count, int size) {
+    Bench::Rng rng(42);
+    while (static_cast<int>(map.getNPCs().size()) < count) {
+        Vec2 pos{rng.nextInt(size), rng.nextInt(size)};
+        if (!map.hasNPCAt(pos)) {
+            map.addNPC(pos, Direction::Down, "villager");
+        }
+    }
+}
+
+double indexedWalkable(const Map& map, const std::vector<int>& probes) {
+    Bench::Timer timer;
+    int walkable = 0;
+    for (size_t i = 0; i < probes.size(); i += 2) {
+        walkable += map.isWalkable(probes[i], probes[i + 1]) ? 1 : 0;
+    }
+    Bench::doNotOptimize(walkable);
+    return timer.elapsedNs() / static_cast<double>(probes.size() / 2);
+}
+
+double linearWalkable(const Map& map, const std::vector<int>& probes) {
+    Bench::Timer timer;
+    int walkable = 0;
+    for (size_t i = 0; i < probes.size(); i += 2) {
+        Vec2 pos{probes[i], probes[i + 1]};
+        bool free = map.getTile(pos.x, pos.y).walkable && !linearHasNPCAt(map.getNPCs(), pos);
+        walkable += free ? 1 : 0;
+    }
+    Bench::doNotOptimize(walkable);
+    return timer.elapsedNs() / static_cast<double>(probes.size() / 2);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int size = Bench::intArg(argc, argv, 1, 4096);
+    int probeCount = Bench::intArg(argc, argv, 2, 10000000);
+
+    Map map;
+    std::vector<TileType> tiles(static_cast<size_t>(size) * size, TileType::Grass);
+    if (!map.loadFromTiles(size, size, std::move(tiles))) {
+        return 1;
+    }
+    map.addNPCDefinition(NPCDefinition{"villager", 0, {"Hello!"}});
+
+    std::vector<int> probes = makeProbes(probeCount, size, size);
+    // The linear scan costs O(NPCs) per probe, so it gets a smaller sample
+    std::vector<int> linearProbes = makeProbes(probeCount / 1000, size, size);
+
+    Bench::printHeader("NPC occupancy " + std::to_string(size) + "x" + std::to_string(size));
+    for (int count : {0, 10, 100, 1000, 10000}) {
+        populate(map, count, size);
+        std::string label = std::to_string(count) + " NPCs";
+        Bench::printRow("indexed isWalkable, " + label, indexedWalkable(map, probes), "ns/op");
+        Bench::printRow("linear isWalkable, " + label, linearWalkable(map, linearProbes), "ns/op");
+    }
+    return 0;
+}
@@ -0,0 +1,66 @@
+// Measures the per-frame cost of simulating a crowded town: several hundred
+// wandering, patrolling and following NPCs updated on the per-frame think
+// budget against thinking every NPC each frame.
+//
+// Usage: bench_npc_simulation [npcs] [frames]   (default 500 NPCs, 10k frames)
+
+#include <string>
+#include <vector>
+#include "BenchUtil.h"
+#include "field/Map.h"
+#include "field/MapGenerator.h"
+
+namespace {
+
+// Generated overworld with NPCs on random walkable tiles
+bool makeTown(Map& map, int npcs) {
+    MapGenerator::Config config;
+    config.width = 128;
+    config.height = 128;
+    config.seed = 11;
+    if (!MapGenerator::generate(config, map)) {
+        return false;
+    }
+    map.addNPCDefinition(NPCDefinition{"villager", 0, {"Hello!"}, NPCBehavior::Wander});
+    map.addNPCDefinition(NPCDefinition{"guard", 1, {"Halt!"}, NPCBehavior::Patrol});
+    map.addNPCDefinition(NPCDefinition{"dog", 2, {"Woof!"}, NPCBehavior::Follow});
+
+    static const char* const IDS[3] = {"villager", "guard", "dog"};
+    Bench::Rng rng(3);
+    int placed = 0;
+    while (placed < npcs) {
+        Vec2 pos{rng.nextInt(map.getWidth()), rng.nextInt(map.getHeight())};
+        if (!map.isWalkable(pos.x, pos.y) || map.hasNPCAt(pos)) continue;
+        map.addNPC(pos, Direction::Down, IDS[placed % 3]);
+        if (placed % 3 == 1) {
+            Bench::doNotOptimize(map.setNPCPatrolRoute(pos, {Vec2{pos.x + 8, pos.y}, Vec2{pos.x + 8, pos.y + 8}, pos}));
+        }
+        ++placed;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int npcs = Bench::intArg(argc, argv, 1, 500);
+    int frames = Bench::intArg(argc, argv, 2, 10000);
+
+    Bench::printHeader("NPC simulation, " + std::to_string(npcs) + " NPCs");
+
+    for (int budget : {Constants::NPC_THINK_BUDGET, npcs}) {
+        Map map;
+        if (!makeTown(map, npcs)) {
+            return 1;
+        }
+        Vec2 player = map.getSpawnPosition();
+        Bench::Timer timer;
+        for (int i = 0; i < frames; ++i) {
+            map.updateNPCs(player, budget);
+        }
+        Bench::doNotOptimize(map.getNPCs().getX(0));
+        std::string label = budget == npcs ? "every NPC thinks" : "budget " + std::to_string(budget);
+        Bench::printRow(label, timer.elapsedNs() / frames, "ns/frame");
+    }
+    return 0;
+}
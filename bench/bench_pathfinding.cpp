@@ -0,0 +1,169 @@
+// Compares Pathfinder (jump-point A*, reusable arena, region labels) against
+// a textbook 4-connected A* that allocates its state per query.
+//
+// Usage: bench_pathfinding [size] [queries]   (default 1024 x 1024, 200 queries)
+
+#include <cstdlib>
+#include <queue>
+#include <string>
+#include <vector>
+#include "BenchUtil.h"
+#include "field/Map.h"
+#include "field/Pathfinder.h"
+
+namespace {
+
+// Open field with random wall segments, plus sealed rooms for unreachable goals
+std::vector<TileType> makeTiles(int size) {
+    Bench::Rng rng(42);
+    std::vector<TileType> tiles(static_cast<size_t>(size) * size, TileType::Grass);
+    auto wall = [&](int x, int y) {
+        if (x >= 0 && y >= 0 && x < size && y < size) tiles[static_cast<size_t>(y) * size + x] = TileType::Wall;
+    };
+
+    int segments = size * size / 64;
+    for (int i = 0; i < segments; ++i) {
+        int x = rng.nextInt(size);
+        int y = rng.nextInt(size);
+        int length = 4 + rng.nextInt(40);
+        bool horizontal = rng.nextInt(2) == 0;
+        for (int j = 0; j < length; ++j) {
+            horizontal ? wall(x + j, y) : wall(x, y + j);
+        }
+    }
+
+    for (int room = 0; room < 16; ++room) {
+        int x0 = rng.nextInt(size - 40);
+        int y0 = rng.nextInt(size - 40);
+        for (int j = 0; j < 32; ++j) {
+            wall(x0 + j, y0);
+            wall(x0 + j, y0 + 31);
+            wall(x0, y0 + j);
+            wall(x0 + 31, y0 + j);
+        }
+    }
+    return tiles;
+}
+
+// Textbook A*: binary heap, per-query g/parent arrays, no pruning
+int referenceAStar(const Map& map, const Vec2& start, const Vec2& goal) {
+    int width = map.getWidth();
+    size_t tiles = static_cast<size_t>(width) * map.getHeight();
+    std::vector<int> g(tiles, -1);
+    std::vector<int> parent(tiles, -1);
+    std::vector<bool> closed(tiles, false);
+    using Entry = std::pair<int, int>;  // (f, index)
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+
+    auto h = [&goal](int x, int y) { return std::abs(x - goal.x) + std::abs(y - goal.y); };
+    int startIndex = start.y * width + start.x;
+    g[startIndex] = 0;
+    open.push({h(start.x, start.y), startIndex});
+
+    while (!open.empty()) {
+        int index = open.top().second;
+        open.pop();
+        if (closed[index]) continue;
+        closed[index] = true;
+        int x = index % width;
+        int y = index / width;
+        if (x == goal.x && y == goal.y) return g[index];
+
+        const int offsets[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+        for (const auto& offset : offsets) {
+            int nx = x + offset[0];
+            int ny = y + offset[1];
+            if (!map.isWalkable(nx, ny)) continue;
+            int next = ny * width + nx;
+            if (g[next] < 0 || g[index] + 1 < g[next]) {
+                g[next] = g[index] + 1;
+                parent[next] = index;
+                open.push({g[next] + h(nx, ny), next});
+            }
+        }
+    }
+    return -1;
+}
+
+struct Query {
+    Vec2 start;
+    Vec2 goal;
+};
+
+std::vector<Query> makeQueries(Map& map, Pathfinder& pathfinder, int count, bool reachable) {
+    Bench::Rng rng(reachable ? 7 : 11);
+    std::vector<Query> queries;
+    int size = map.getWidth();
+    while (static_cast<int>(queries.size()) < count) {
+        Vec2 start{rng.nextInt(size), rng.nextInt(size)};
+        Vec2 goal{rng.nextInt(size), rng.nextInt(size)};
+        if (!map.isWalkable(start.x, start.y) || !map.isWalkable(goal.x, goal.y)) continue;
+        if (pathfinder.isReachable(map, start, goal) == reachable) {
+            queries.push_back(Query{start, goal});
+        }
+    }
+    return queries;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int size = Bench::intArg(argc, argv, 1, 1024);
+    int queryCount = Bench::intArg(argc, argv, 2, 200);
+
+    Map map;
+    if (!map.loadFromTiles(size, size, makeTiles(size))) {
+        return 1;
+    }
+
+    Pathfinder pathfinder;
+    Bench::Timer labelTimer;
+    Bench::doNotOptimize(pathfinder.getRegion(map, Vec2{0, 0}));
+    double labelMs = labelTimer.elapsedMs();
+
+    std::vector<Query> reachable = makeQueries(map, pathfinder, queryCount, true);
+    std::vector<Query> unreachable = makeQueries(map, pathfinder, queryCount / 10 + 1, false);
+
+    std::vector<Vec2> path;
+    long long expanded = 0;
+    long long steps = 0;
+    Bench::Timer jpsTimer;
+    for (const auto& query : reachable) {
+        if (pathfinder.findPath(map, query.start, query.goal, path)) {
+            steps += static_cast<long long>(path.size());
+        }
+        expanded += pathfinder.getExpandedNodes();
+    }
+    double jpsUs = jpsTimer.elapsedNs() / 1000.0 / reachable.size();
+
+    long long referenceSteps = 0;
+    Bench::Timer referenceTimer;
+    for (const auto& query : reachable) {
+        referenceSteps += referenceAStar(map, query.start, query.goal);
+    }
+    double referenceUs = referenceTimer.elapsedNs() / 1000.0 / reachable.size();
+
+    Bench::Timer rejectTimer;
+    int found = 0;
+    for (const auto& query : unreachable) {
+        found += pathfinder.findPath(map, query.start, query.goal, path) ? 1 : 0;
+    }
+    double rejectNs = rejectTimer.elapsedNs() / unreachable.size();
+
+    Bench::Timer referenceRejectTimer;
+    for (const auto& query : unreachable) {
+        found += referenceAStar(map, query.start, query.goal) >= 0 ? 1 : 0;
+    }
+    double referenceRejectUs = referenceRejectTimer.elapsedNs() / 1000.0 / unreachable.size();
+    Bench::doNotOptimize(found);
+
+    Bench::printHeader("Pathfinding " + std::to_string(size) + "x" + std::to_string(size));
+    Bench::printRow("region labelling", labelMs, "ms");
+    Bench::printRow("reference A* (reachable)", referenceUs, "us/query");
+    Bench::printRow("jump-point A* (reachable)", jpsUs, "us/query");
+    Bench::printRow("jump-point expanded nodes", static_cast<double>(expanded) / reachable.size(), "nodes/query");
+    Bench::printRow("path length mismatch", static_cast<double>(referenceSteps - steps), "steps");
+    Bench::printRow("reference A* (unreachable)", referenceRejectUs, "us/query");
+    Bench::printRow("region check (unreachable)", rejectNs, "ns/query");
+    return 0;
+}
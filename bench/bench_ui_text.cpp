@@ -0,0 +1,182 @@
+// Measures UI-heavy frames: the battle screen with status panel, menu, item
+// list, phrase book and dialogue box drawn on top, rendered headless. Compares text
+// drawn through the layout cache against laying every string out again, and
+// counts heap allocations per frame (operator new is replaced below).
+//
+// Usage: bench_ui_text [frames]   (default 2000 frames; run from the repo root)
+
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "BenchUtil.h"
+#include "battle/BattleState.h"
+#include "game/PlayerStats.h"
+#include "inventory/Inventory.h"
+#include "inventory/ItemDatabase.h"
+#include "system/Renderer.h"
+#include "system/ResourceManager.h"
+#include "ui/BattleBox.h"
+#include "ui/DialogueBox.h"
+#include "ui/DialogueState.h"
+#include "ui/ItemListBox.h"
+#include "ui/ItemListState.h"
+#include "ui/MenuBox.h"
+#include "ui/MenuState.h"
+#include "ui/PhraseBookBox.h"
+#include "ui/PhraseBookState.h"
+#include "ui/StatusPanel.h"
+#include "ui/TextRenderer.h"
+
+namespace {
+    uint64_t allocations = 0;
+}
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// Every phrase in the topic database, collected
+PhraseCollection collectAll() {
+    PhraseCollection collection = PhraseCollection::empty();
+    for (const PhraseEntry& phrase : collection.getAllPhrases()) {
+        collection = collection.collect(phrase.topicId);
+    }
+    return collection;
+}
+
+struct Screen {
+    PlayerStats stats = PlayerStats::create("Hero");
+    BattleState battle = BattleState::inactive().encounter(
+        EnemyDefinition::create("slime", "Slime", 12, 4, 2, 3, 5, 8, 0), stats);
+    MenuState menu = MenuState::open();
+    ItemListState items = ItemListState::open(Inventory::empty()
+        .addItem(ItemId::HERB, 12).addItem(ItemId::ANTIDOTE, 3).addItem(ItemId::TORCH, 1));
+    PhraseBookState phrases = PhraseBookState::open(collectAll());
+    DialogueState dialogue = DialogueState::create({DialoguePage("Saluton! Welcome to the\nvillage of Verda.")});
+
+    BattleBox battleBox;
+    StatusPanel statusPanel;
+    MenuBox menuBox;
+    ItemListBox itemListBox;
+    PhraseBookBox phraseBookBox;
+    DialogueBox dialogueBox;
+
+    void draw(Renderer& renderer, const TextRenderer& text) const {
+        battleBox.render(renderer, text, battle);
+        statusPanel.render(renderer, text, stats);
+        menuBox.render(renderer, text, menu);
+        itemListBox.render(renderer, text, items);
+        phraseBookBox.render(renderer, text, phrases);
+        dialogueBox.render(renderer, text, dialogue);
+    }
+};
+
+// The composed strings of one frame, built the way the boxes used to (for reference)
+size_t composeWithStreams(const PlayerStats& stats, const PhraseBookState& phrases) {
+    auto number = [](int value, int width) {
+        std::ostringstream oss;
+        oss << std::setw(width) << value;
+        return oss.str();
+    };
+    std::string hp = "HP " + number(stats.hp, 3) + "/" + number(stats.maxHp, 3);
+    std::string mp = "MP " + number(stats.mp, 3) + "/" + number(stats.maxMp, 3);
+    std::string exp = "EXP " + number(stats.exp, 6);
+    std::string gold = "Gold " + number(stats.gold, 6);
+    std::string battleHp = "HP: " + std::to_string(stats.hp) + "/" + std::to_string(stats.maxHp);
+    size_t total = hp.size() + mp.size() + exp.size() + gold.size() + battleHp.size();
+    for (int i = phrases.getVisibleStartIndex(); i < phrases.getVisibleEndIndex(); ++i) {
+        std::string translation = "(" + phrases.getPhrase(i)->japanese + ")";
+        total += translation.size();
+    }
+    return total;
+}
+
+// The same strings in stack buffers and a reused string, as the boxes do now
+size_t composeWithBuffers(const PlayerStats& stats, const PhraseBookState& phrases, std::string& scratch) {
+    char text[32];
+    size_t total = 0;
+    total += std::snprintf(text, sizeof(text), "HP %3d/%3d", stats.hp, stats.maxHp);
+    total += std::snprintf(text, sizeof(text), "MP %3d/%3d", stats.mp, stats.maxMp);
+    total += std::snprintf(text, sizeof(text), "EXP %6d", stats.exp);
+    total += std::snprintf(text, sizeof(text), "Gold %6d", stats.gold);
+    total += std::snprintf(text, sizeof(text), "HP: %d/%d", stats.hp, stats.maxHp);
+    for (int i = phrases.getVisibleStartIndex(); i < phrases.getVisibleEndIndex(); ++i) {
+        scratch.assign("(");
+        scratch.append(phrases.getPhrase(i)->japanese);
+        scratch.append(")");
+        total += scratch.size();
+    }
+    return total;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int frames = Bench::intArg(argc, argv, 1, 2000);
+
+    Renderer renderer;
+    if (!renderer.init("bench", Constants::WINDOW_WIDTH, Constants::WINDOW_HEIGHT, Renderer::Backend::Headless)) {
+        return 1;
+    }
+    ResourceManager resources(renderer.getSDLRenderer());
+    TextRenderer text;
+    if (!text.loadFont(resources, "assets/fonts/font.png")) {
+        return 1;
+    }
+    Screen screen;
+
+    Bench::printHeader("UI frame, " + std::to_string(frames) + " frames");
+    for (bool cached : {false, true}) {
+        text.setLayoutCacheEnabled(cached);
+        screen.draw(renderer, text);  // Warm up (and fill the cache)
+        renderer.present();
+
+        double drawNs = 0.0;
+        uint64_t before = allocations;
+        Bench::Timer total;
+        for (int i = 0; i < frames; ++i) {
+            renderer.clear();
+            Bench::Timer draw;
+            screen.draw(renderer, text);
+            drawNs += draw.elapsedNs();
+            renderer.present();
+        }
+        double totalNs = total.elapsedNs();
+        double perFrame = static_cast<double>(allocations - before) / frames;
+
+        std::string label = cached ? "layout cache" : "no layout cache";
+        Bench::printRow(label + ": draw", drawNs / frames, "ns/frame");
+        Bench::printRow(label + ": draw and present", totalNs / frames, "ns/frame");
+        Bench::printRow(label + ": allocations", perFrame, "per frame");
+    }
+
+    Bench::printHeader("Composing the strings of one frame");
+    std::string scratch;
+    for (bool streams : {true, false}) {
+        uint64_t before = allocations;
+        Bench::Timer timer;
+        for (int i = 0; i < frames; ++i) {
+            Bench::doNotOptimize(streams ? composeWithStreams(screen.stats, screen.phrases)
+                                         : composeWithBuffers(screen.stats, screen.phrases, scratch));
+        }
+        double ns = timer.elapsedNs() / frames;
+        double perFrame = static_cast<double>(allocations - before) / frames;
+        std::string label = streams ? "to_string / ostringstream" : "stack buffers";
+        Bench::printRow(label, ns, "ns/frame");
+        Bench::printRow(label + ": allocations", perFrame, "per frame");
+    }
+    return 0;
+}
@@ -0,0 +1,143 @@
+// Measures the bulk walkability queries (row spans, rectangles, lines)
+// answered from the packed masks against probing Map::isWalkable per tile,
+// on a generated overworld with NPCs. Times are per query (a whole span,
+// rectangle or line). The per-tile baseline reads the same masks one bit at
+// a time; it is not the byte-per-tile layout from before the masks.
+//
+// Usage: bench_walkability [size] [queries]   (default 2048 x 2048, 200k queries)
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include "BenchUtil.h"
+#include "field/Map.h"
+#include "field/MapGenerator.h"
+
+namespace {
+
+struct Query {
+    int x0;
+    int y0;
+    int x1;
+    int y1;
+};
+
+// Random query boxes up to maxSpan tiles on each side
+std::vector<Query> makeQueries(int count, int size, int maxSpan) {
+    Bench::Rng rng(11);
+    std::vector<Query> queries;
+    queries.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        int x0 = rng.nextInt(size);
+        int y0 = rng.nextInt(size);
+        int x1 = std::min(size - 1, std::max(0, x0 + rng.nextInt(2 * maxSpan + 1) - maxSpan));
+        int y1 = std::min(size - 1, std::max(0, y0 + rng.nextInt(2 * maxSpan + 1) - maxSpan));
+        queries.push_back(Query{x0, y0, x1, y1});
+    }
+    return queries;
+}
+
+bool spanByTile(const Map& map, int y, int x0, int x1) {
+    for (int x = std::min(x0, x1); x <= std::max(x0, x1); ++x) {
+        if (!map.isWalkable(x, y)) return false;
+    }
+    return true;
+}
+
+bool areaByTile(const Map& map, const Query& q) {
+    for (int y = std::min(q.y0, q.y1); y <= std::max(q.y0, q.y1); ++y) {
+        if (!spanByTile(map, y, q.x0, q.x1)) return false;
+    }
+    return true;
+}
+
+// Same tiles as Map::hasLineOfSight, one getTile per step
+bool lineByTile(const Map& map, const Query& q) {
+    long dx = std::abs(q.x1 - q.x0);
+    long dy = std::abs(q.y1 - q.y0);
+    long steps = std::max(1L, std::max(dx, dy));
+    for (long s = 0; s <= std::max(dx, dy); ++s) {
+        int x = q.x0 + (q.x1 >= q.x0 ? 1 : -1) * static_cast<int>((2 * s * dx + steps) / (2 * steps));
+        int y = q.y0 + (q.y1 >= q.y0 ? 1 : -1) * static_cast<int>((2 * s * dy + steps) / (2 * steps));
+        if (!map.getTile(x, y).walkable) return false;
+    }
+    return true;
+}
+
+// Time one query kind; returns ns per query and the number of true answers
+template <typename Fn>
+double timeQueries(const std::vector<Query>& queries, Fn fn, int& hits) {
+    Bench::Timer timer;
+    hits = 0;
+    for (const auto& query : queries) {
+        hits += fn(query) ? 1 : 0;
+    }
+    Bench::doNotOptimize(hits);
+    return timer.elapsedNs() / static_cast<double>(queries.size());
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int size = Bench::intArg(argc, argv, 1, 2048);
+    int count = Bench::intArg(argc, argv, 2, 200000);
+
+    MapGenerator::Config config;
+    config.width = size;
+    config.height = size;
+    config.seed = 3;
+    Map map;
+    if (!MapGenerator::generate(config, map)) {
+        return 1;
+    }
+    map.addNPCDefinition(NPCDefinition{"villager", 0, {"Hello!"}});
+    map.addNPCDefinition(NPCDefinition{"guard", 1, {"Halt!"}});
+    for (const auto& placement : map.getNPCPlacements()) {
+        map.addNPC(placement.pos, placement.facing, placement.definitionId);
+    }
+
+    Bench::printHeader("Walkability queries " + std::to_string(size) + "x" + std::to_string(size));
+
+    // Spans and areas on road-heavy samples: mostly walkable, so both sides scan fully
+    std::vector<Query> spans = makeQueries(count, size, 128);
+    std::vector<Query> areas = makeQueries(count, size, 8);
+    std::vector<Query> lines = makeQueries(count, size, 48);
+    int tileHits = 0;
+    int maskHits = 0;
+
+    double spanTile = timeQueries(spans, [&map](const Query& q) { return spanByTile(map, q.y0, q.x0, q.x1); }, tileHits);
+    double spanMask = timeQueries(spans, [&map](const Query& q) { return map.isSpanWalkable(q.y0, q.x0, q.x1); }, maskHits);
+    Bench::printRow("row span <= 257 tiles, per tile", spanTile, "ns/query");
+    Bench::printRow("row span <= 257 tiles, mask", spanMask, "ns/query");
+    Bench::printRow("row span answer mismatch", std::abs(tileHits - maskHits), "queries");
+
+    // Road rows: long fully walkable spans are the worst case for per-tile probing
+    std::vector<Query> roads;
+    for (const auto& q : spans) {
+        int road = (q.y0 / 32) * 32 + 16;
+        if (road < size) roads.push_back(Query{0, road, size - 1, road});
+        if (roads.size() >= 2000) break;
+    }
+    double roadTile = timeQueries(roads, [&map](const Query& q) { return spanByTile(map, q.y0, q.x0, q.x1); }, tileHits);
+    double roadMask = timeQueries(roads, [&map](const Query& q) { return map.isSpanWalkable(q.y0, q.x0, q.x1); }, maskHits);
+    Bench::printRow("full road row, per tile", roadTile, "ns/query");
+    Bench::printRow("full road row, mask", roadMask, "ns/query");
+
+    double areaTile = timeQueries(areas, [&map](const Query& q) { return areaByTile(map, q); }, tileHits);
+    double areaMask = timeQueries(areas, [&map](const Query& q) {
+        return map.isAreaWalkable(std::min(q.x0, q.x1), std::min(q.y0, q.y1),
+                                  std::abs(q.x1 - q.x0) + 1, std::abs(q.y1 - q.y0) + 1);
+    }, maskHits);
+    Bench::printRow("area <= 17x17, per tile", areaTile, "ns/query");
+    Bench::printRow("area <= 17x17, mask", areaMask, "ns/query");
+    Bench::printRow("area answer mismatch", std::abs(tileHits - maskHits), "queries");
+
+    double lineTile = timeQueries(lines, [&map](const Query& q) { return lineByTile(map, q); }, tileHits);
+    double lineMask = timeQueries(lines, [&map](const Query& q) {
+        return map.hasLineOfSight(Vec2{q.x0, q.y0}, Vec2{q.x1, q.y1});
+    }, maskHits);
+    Bench::printRow("line <= 48 tiles, per tile", lineTile, "ns/query");
+    Bench::printRow("line <= 48 tiles, mask", lineMask, "ns/query");
+    Bench::printRow("line answer mismatch", std::abs(tileHits - maskHits), "queries");
+    return 0;
+}
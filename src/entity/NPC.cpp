@@ -1,4 +1,6 @@
 #include "entity/NPC.h"
+#include "entity/NPCData.h"
+#include "entity/NPCSimulation.h"
 #include "system/ResourceManager.h"
 #include "system/Renderer.h"
 #include <cmath>
@@ -10,7 +12,16 @@ NPC::NPC(Vec2 pos, Direction facing, int definitionIndex, int spriteRow,
     , facing_(facing)
     , definitionIndex_(definitionIndex)
     , spriteRow_(spriteRow)
-    , dialogue_(std::move(dialogue)) {}
+    , dialogue_(std::make_shared<const std::vector<std::string>>(std::move(dialogue))) {}
+
+NPC::NPC(Vec2 pos, Direction facing, int definitionIndex, int spriteRow,
+         std::shared_ptr<const std::vector<std::string>> dialogue)
+    : posX_(pos.x)
+    , posY_(pos.y)
+    , facing_(facing)
+    , definitionIndex_(definitionIndex)
+    , spriteRow_(spriteRow)
+    , dialogue_(dialogue ? std::move(dialogue) : std::make_shared<const std::vector<std::string>>()) {}
 
 NPC NPC::faceToward(Vec2 targetPos) const {
     int dx = targetPos.x - posX_;
@@ -30,36 +41,59 @@ NPC NPC::faceToward(Vec2 targetPos) const {
 
 // NPCRenderer implementation
 NPCRenderer::NPCRenderer()
-    : texture_(nullptr)
+    : region_()
     , spriteWidth_(Constants::TILE_SIZE)
     , spriteHeight_(Constants::TILE_SIZE)
     , frameCounter_(0) {}
 
 bool NPCRenderer::loadSprites(ResourceManager& resourceManager, const std::string& path) {
-    texture_ = resourceManager.loadTexture(path);
-    return texture_ != nullptr;
+    region_ = resourceManager.loadRegion(path);
+    return region_.texture != nullptr;
 }
 
-void NPCRenderer::render(Renderer& renderer, const NPC& npc, int cameraX, int cameraY) {
-    if (!texture_) return;
-
-    Vec2 pixelPos = Vec2{
-        npc.getPosition().x * Constants::TILE_SIZE,
-        npc.getPosition().y * Constants::TILE_SIZE
-    };
-
-    int screenX = pixelPos.x - cameraX;
-    int screenY = pixelPos.y - cameraY;
-
-    // Update animation frame with safe wrap-around
+void NPCRenderer::advanceAnimation() {
+    // Safe wrap-around
     constexpr int MAX_FRAME_COUNT = 60000;  // Safe from overflow, ~16 min at 60fps
     frameCounter_ = (frameCounter_ + 1) % MAX_FRAME_COUNT;
-    int frame = (frameCounter_ / (Constants::ANIMATION_FRAME_DIVISOR * 4)) % 2;
+}
 
-    SDL_Rect src = getSourceRect(npc.getFacing(), npc.getSpriteRow(), frame);
-    SDL_Rect dst = {screenX, screenY, spriteWidth_, spriteHeight_};
+int NPCRenderer::getAnimationFrame() const {
+    return (frameCounter_ / (Constants::ANIMATION_FRAME_DIVISOR * 4)) % 2;
+}
 
-    renderer.drawTexture(texture_, &src, &dst);
+int NPCRenderer::interpolationPixels(double alpha) {
+    return static_cast<int>(std::lround((1.0 - alpha) * Constants::NPC_SPEED));
+}
+
+int NPCRenderer::drawnStepPixels(const NPCSimulation& npcs, size_t i, double alpha) {
+    int previous = npcs.getPreviousStepPixels(i);
+    int latest = npcs.getStepPixels(i);
+    return static_cast<int>(std::lround(previous + (latest - previous) * alpha));
+}
+
+void NPCRenderer::render(Renderer& renderer, const NPCSimulation& npcs,
+                         const std::vector<NPCDefinition>& definitions, int cameraX, int cameraY,
+                         double alpha) const {
+    if (!region_.texture) return;
+
+    int frame = getAnimationFrame();
+
+    for (size_t i = 0; i < npcs.size(); ++i) {
+        // Walking NPCs are drawn short of their tile, opposite to their facing
+        Vec2 back = directionToOffset(npcs.getFacing(i)).multiply(-drawnStepPixels(npcs, i, alpha));
+        int screenX = npcs.getX(i) * Constants::TILE_SIZE + back.x - cameraX;
+        int screenY = npcs.getY(i) * Constants::TILE_SIZE + back.y - cameraY;
+        if (screenX <= -spriteWidth_ || screenY <= -spriteHeight_ ||
+            screenX >= Constants::INTERNAL_WIDTH || screenY >= Constants::INTERNAL_HEIGHT) {
+            continue;
+        }
+
+        int definition = npcs.getDefinitionIndex(i);
+        int spriteRow = static_cast<size_t>(definition) < definitions.size() ? definitions[definition].spriteRow : 0;
+        SDL_Rect src = region_.toTexture(getSourceRect(npcs.getFacing(i), spriteRow, frame));
+        SDL_Rect dst = {screenX, screenY, spriteWidth_, spriteHeight_};
+        renderer.drawTexture(region_.texture, &src, &dst);
+    }
 }
 
 SDL_Rect NPCRenderer::getSourceRect(Direction dir, int spriteRow, int frame) const {
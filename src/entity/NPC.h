@@ -2,27 +2,34 @@
 #define NPC_H
 
 #include <SDL.h>
+#include <memory>
 #include <string>
 #include <vector>
+#include "system/TextureRegion.h"
 #include "util/Vec2.h"
 #include "util/Constants.h"
 
 class ResourceManager;
 class Renderer;
+class NPCSimulation;
 struct NPCDefinition;
 
-// Immutable NPC entity
+// Immutable NPC snapshot. Maps store spawned NPCs as arrays (NPCSimulation)
+// and hand out snapshots; dialogue is shared with the NPC's definition, so
+// copies are cheap.
 class NPC {
 public:
     // definitionIndex references into the Map's npcDefinitions_ vector (safer than pointer)
     NPC(Vec2 pos, Direction facing, int definitionIndex, int spriteRow,
         std::vector<std::string> dialogue);
+    NPC(Vec2 pos, Direction facing, int definitionIndex, int spriteRow,
+        std::shared_ptr<const std::vector<std::string>> dialogue);
 
     // Getters
     [[nodiscard]] Vec2 getPosition() const { return Vec2{posX_, posY_}; }
     [[nodiscard]] Direction getFacing() const { return facing_; }
     [[nodiscard]] int getSpriteRow() const { return spriteRow_; }
-    [[nodiscard]] const std::vector<std::string>& getDialogue() const { return dialogue_; }
+    [[nodiscard]] const std::vector<std::string>& getDialogue() const { return *dialogue_; }
     [[nodiscard]] int getDefinitionIndex() const { return definitionIndex_; }
 
     // Face toward a position (returns new NPC)
@@ -34,7 +41,7 @@ private:
     Direction facing_;
     int definitionIndex_;
     int spriteRow_;
-    std::vector<std::string> dialogue_;  // Copy of dialogue, no pointer needed
+    std::shared_ptr<const std::vector<std::string>> dialogue_;  // Never null
 };
 
 // Renders NPC sprites
@@ -45,18 +52,33 @@ public:
     // Load NPC sprite sheet
     [[nodiscard]] bool loadSprites(ResourceManager& resourceManager, const std::string& path);
 
-    // Render an NPC
-    void render(Renderer& renderer, const NPC& npc, int cameraX, int cameraY);
+    // Advance the idle animation by one frame (the clock only runs while called)
+    void advanceAnimation();
+
+    // Idle animation frame shown now (changes every ANIMATION_FRAME_DIVISOR * 4 frames)
+    [[nodiscard]] int getAnimationFrame() const;
+
+    // Render the NPCs in view (definitions supply sprite rows); walking NPCs
+    // are drawn alpha of the way from the previous simulation step to the latest
+    void render(Renderer& renderer, const NPCSimulation& npcs,
+                const std::vector<NPCDefinition>& definitions, int cameraX, int cameraY,
+                double alpha = 1.0) const;
+
+    // Pixels a walking NPC is drawn behind its latest step at alpha
+    [[nodiscard]] static int interpolationPixels(double alpha);
+
+    // Pixels NPC i is drawn short of its tile at alpha, between its offset
+    // on the previous simulation step and the latest (final step included)
+    [[nodiscard]] static int drawnStepPixels(const NPCSimulation& npcs, size_t i, double alpha);
 
     // Check if sprites are loaded
-    [[nodiscard]] bool isLoaded() const { return texture_ != nullptr; }
+    [[nodiscard]] bool isLoaded() const { return region_.texture != nullptr; }
 
 private:
     // Get source rect for NPC sprite
     [[nodiscard]] SDL_Rect getSourceRect(Direction dir, int spriteRow, int frame) const;
 
-    // Non-owning pointer - texture lifetime managed by ResourceManager
-    SDL_Texture* texture_;
+    TextureRegion region_;  // Sprite sheet
     int spriteWidth_;
     int spriteHeight_;
     int frameCounter_;
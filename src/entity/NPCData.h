@@ -1,19 +1,44 @@
 #ifndef NPC_DATA_H
 #define NPC_DATA_H
 
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 #include "util/Vec2.h"
 
+// How spawned NPCs move (see NPCSimulation)
+enum class NPCBehavior : uint8_t {
+    Stand,   // Stays on its tile
+    Wander,  // Random steps near where it spawned
+    Patrol,  // Walks a looping route of waypoints
+    Follow   // Walks after the player when near
+};
+
 // NPC definition (shared data for NPC type)
 struct NPCDefinition {
     std::string id;
     int spriteRow;  // Row in NPC sprite sheet
-    std::vector<std::string> dialogue;  // Dialogue pages
+    std::shared_ptr<const std::vector<std::string>> dialogue;  // Pages, shared by every NPC of this type
+    NPCBehavior behavior;
+
+    NPCDefinition()
+        : id(""), spriteRow(0), dialogue(std::make_shared<const std::vector<std::string>>())
+        , behavior(NPCBehavior::Stand) {}
+    NPCDefinition(std::string i, int row, std::vector<std::string> d, NPCBehavior b = NPCBehavior::Stand)
+        : id(std::move(i)), spriteRow(row)
+        , dialogue(std::make_shared<const std::vector<std::string>>(std::move(d)))
+        , behavior(b) {}
+};
+
+// NPC placement read from map data (definition is resolved when the NPC is spawned)
+struct NPCPlacement {
+    Vec2 pos;
+    Direction facing;
+    std::string definitionId;
 
-    NPCDefinition() : id(""), spriteRow(0), dialogue{} {}
-    NPCDefinition(std::string i, int row, std::vector<std::string> d)
-        : id(std::move(i)), spriteRow(row), dialogue(std::move(d)) {}
+    NPCPlacement(Vec2 p, Direction f, std::string id)
+        : pos(p), facing(f), definitionId(std::move(id)) {}
 };
 
 #endif // NPC_DATA_H
@@ -0,0 +1,235 @@
+#include "entity/NPCSimulation.h"
+#include <algorithm>
+#include <cstdlib>
+
+static_assert(Constants::NPC_STEP_FRAMES <= 255, "step counters are one byte");
+
+NPCSimulation::NPCSimulation() : cursor_(0), rng_(0x9E3779B9u), revision_(0) {}
+
+int NPCSimulation::add(const Vec2& pos, Direction facing, int definitionIndex, NPCBehavior behavior) {
+    x_.push_back(pos.x);
+    y_.push_back(pos.y);
+    facing_.push_back(facing);
+    definition_.push_back(definitionIndex);
+    behavior_.push_back(behavior);
+    homeX_.push_back(pos.x);
+    homeY_.push_back(pos.y);
+    stepFrames_.push_back(0);
+    arrived_.push_back(0);
+    restThinks_.push_back(0);
+    routeStart_.push_back(-1);
+    routeLength_.push_back(0);
+    routeNext_.push_back(0);
+    ++revision_;
+    return static_cast<int>(x_.size() - 1);
+}
+
+void NPCSimulation::remove(int index) {
+    size_t i = static_cast<size_t>(index);
+    size_t last = x_.size() - 1;
+    releaseRoute(i);
+    if (i != last) {
+        x_[i] = x_[last];
+        y_[i] = y_[last];
+        facing_[i] = facing_[last];
+        definition_[i] = definition_[last];
+        behavior_[i] = behavior_[last];
+        homeX_[i] = homeX_[last];
+        homeY_[i] = homeY_[last];
+        stepFrames_[i] = stepFrames_[last];
+        arrived_[i] = arrived_[last];
+        restThinks_[i] = restThinks_[last];
+        routeStart_[i] = routeStart_[last];
+        routeLength_[i] = routeLength_[last];
+        routeNext_[i] = routeNext_[last];
+    }
+    x_.pop_back();
+    y_.pop_back();
+    facing_.pop_back();
+    definition_.pop_back();
+    behavior_.pop_back();
+    homeX_.pop_back();
+    homeY_.pop_back();
+    stepFrames_.pop_back();
+    arrived_.pop_back();
+    restThinks_.pop_back();
+    routeStart_.pop_back();
+    routeLength_.pop_back();
+    routeNext_.pop_back();
+    ++revision_;
+}
+
+void NPCSimulation::clear() {
+    x_.clear();
+    y_.clear();
+    facing_.clear();
+    definition_.clear();
+    behavior_.clear();
+    homeX_.clear();
+    homeY_.clear();
+    stepFrames_.clear();
+    arrived_.clear();
+    restThinks_.clear();
+    routeStart_.clear();
+    routeLength_.clear();
+    routeNext_.clear();
+    routeX_.clear();
+    routeY_.clear();
+    cursor_ = 0;
+    ++revision_;
+}
+
+void NPCSimulation::moveTo(size_t i, const Vec2& pos) {
+    x_[i] = pos.x;
+    y_[i] = pos.y;
+    stepFrames_[i] = 0;
+    arrived_[i] = 0;
+    ++revision_;
+}
+
+void NPCSimulation::walk(size_t i, Direction dir) {
+    Vec2 offset = directionToOffset(dir);
+    x_[i] += offset.x;
+    y_[i] += offset.y;
+    facing_[i] = dir;
+    stepFrames_[i] = static_cast<uint8_t>(Constants::NPC_STEP_FRAMES);
+    ++revision_;
+}
+
+void NPCSimulation::setBehavior(size_t i, NPCBehavior behavior) {
+    behavior_[i] = behavior;
+    homeX_[i] = x_[i];
+    homeY_[i] = y_[i];
+}
+
+void NPCSimulation::setPatrolRoute(size_t i, const std::vector<Vec2>& waypoints) {
+    releaseRoute(i);
+    routeStart_[i] = waypoints.empty() ? -1 : static_cast<int>(routeX_.size());
+    routeLength_[i] = static_cast<int>(waypoints.size());
+    routeNext_[i] = 0;
+    for (const auto& point : waypoints) {
+        routeX_.push_back(point.x);
+        routeY_.push_back(point.y);
+    }
+}
+
+void NPCSimulation::releaseRoute(size_t i) {
+    if (routeStart_[i] < 0) return;
+
+    // Close the gap so the pool only holds live routes; routes change rarely
+    int start = routeStart_[i];
+    int length = routeLength_[i];
+    routeX_.erase(routeX_.begin() + start, routeX_.begin() + start + length);
+    routeY_.erase(routeY_.begin() + start, routeY_.begin() + start + length);
+    for (auto& other : routeStart_) {
+        if (other > start) {
+            other -= length;
+        }
+    }
+    routeStart_[i] = -1;
+    routeLength_[i] = 0;
+    routeNext_[i] = 0;
+}
+
+void NPCSimulation::advanceSteps() {
+    // Branch-free countdown over the byte arrays
+    uint8_t walking = 0;
+    for (size_t i = 0; i < stepFrames_.size(); ++i) {
+        uint8_t frames = stepFrames_[i];
+        walking |= frames;
+        arrived_[i] = static_cast<uint8_t>(frames == 1 ? 1 : 0);
+        stepFrames_[i] = static_cast<uint8_t>(frames - (frames > 0 ? 1 : 0));
+    }
+    revision_ += walking != 0 ? 1 : 0;
+}
+
+bool NPCSimulation::isAnyWalking() const {
+    return std::any_of(stepFrames_.begin(), stepFrames_.end(), [](uint8_t frames) { return frames > 0; });
+}
+
+bool NPCSimulation::isAnyMoving() const {
+    return isAnyWalking() || std::any_of(arrived_.begin(), arrived_.end(), [](uint8_t arrived) { return arrived != 0; });
+}
+
+void NPCSimulation::think(int budget, const Vec2& playerPos, std::vector<Step>& steps) {
+    size_t count = std::min(static_cast<size_t>(std::max(budget, 0)), size());
+    for (size_t n = 0; n < count; ++n) {
+        if (cursor_ >= size()) cursor_ = 0;
+        size_t i = cursor_++;
+
+        // Still walking into the last tile, or resting
+        if (stepFrames_[i] > 0) continue;
+        if (restThinks_[i] > 0) {
+            --restThinks_[i];
+            continue;
+        }
+
+        Direction dir = Direction::None;
+        switch (behavior_[i]) {
+            case NPCBehavior::Stand:
+                break;
+
+            case NPCBehavior::Wander: {
+                // Every other think on average takes a random step, then rests a while
+                uint32_t r = nextRandom();
+                restThinks_[i] = static_cast<uint8_t>((r >> 8) % (Constants::NPC_MAX_REST_THINKS + 1));
+                if (r & 1u) break;
+                dir = static_cast<Direction>(1 + (r >> 1) % 4);
+                Vec2 offset = directionToOffset(dir);
+                if (std::abs(x_[i] + offset.x - homeX_[i]) > Constants::NPC_WANDER_RADIUS ||
+                    std::abs(y_[i] + offset.y - homeY_[i]) > Constants::NPC_WANDER_RADIUS) {
+                    dir = stepToward(x_[i], y_[i], homeX_[i], homeY_[i]);
+                }
+                break;
+            }
+
+            case NPCBehavior::Patrol: {
+                if (routeStart_[i] < 0) break;
+                int point = routeStart_[i] + routeNext_[i];
+                if (x_[i] == routeX_[point] && y_[i] == routeY_[point]) {
+                    routeNext_[i] = (routeNext_[i] + 1) % routeLength_[i];
+                    point = routeStart_[i] + routeNext_[i];
+                }
+                dir = stepToward(x_[i], y_[i], routeX_[point], routeY_[point]);
+                break;
+            }
+
+            case NPCBehavior::Follow: {
+                int distance = std::abs(playerPos.x - x_[i]) + std::abs(playerPos.y - y_[i]);
+                if (distance == 1) {
+                    setFacing(i, stepToward(x_[i], y_[i], playerPos.x, playerPos.y));  // Beside: look at the player
+                } else if (distance > 1 && distance <= Constants::NPC_FOLLOW_RANGE) {
+                    dir = stepToward(x_[i], y_[i], playerPos.x, playerPos.y);
+                }
+                break;
+            }
+        }
+
+        if (dir != Direction::None) {
+            steps.push_back(Step{static_cast<int>(i), dir});
+        }
+    }
+}
+
+size_t NPCSimulation::getMemoryBytes() const {
+    size_t perNPC = sizeof(int) * 8 + sizeof(Direction) + sizeof(NPCBehavior) + sizeof(uint8_t) * 3;
+    return x_.capacity() * perNPC + (routeX_.capacity() + routeY_.capacity()) * sizeof(int);
+}
+
+Direction NPCSimulation::stepToward(int fromX, int fromY, int toX, int toY) {
+    int dx = toX - fromX;
+    int dy = toY - fromY;
+    if (dx == 0 && dy == 0) return Direction::None;
+    if (std::abs(dx) >= std::abs(dy)) {
+        return dx > 0 ? Direction::Right : Direction::Left;
+    }
+    return dy > 0 ? Direction::Down : Direction::Up;
+}
+
+uint32_t NPCSimulation::nextRandom() {
+    // xorshift32: deterministic per map, no shared engine state
+    rng_ ^= rng_ << 13;
+    rng_ ^= rng_ >> 17;
+    rng_ ^= rng_ << 5;
+    return rng_;
+}
@@ -0,0 +1,130 @@
+#ifndef NPC_SIMULATION_H
+#define NPC_SIMULATION_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "entity/NPCData.h"
+#include "util/Constants.h"
+#include "util/Vec2.h"
+
+// Spawned NPCs of a map as parallel arrays (structure of arrays): per-frame
+// passes over hundreds of NPCs touch only the fields they need.
+//
+// Behaviors run on a budget: think() visits at most `budget` NPCs, resuming
+// where the previous call stopped, and returns the steps they want to take;
+// the map applies them (walkability, occupancy). Walking between tiles is
+// animated for every NPC by advanceSteps(), one counter per NPC.
+class NPCSimulation {
+public:
+    // A step wanted by think(): to an adjacent tile, facing dir
+    struct Step {
+        int index;
+        Direction dir;
+    };
+
+    NPCSimulation();
+
+    // Index of the new NPC
+    int add(const Vec2& pos, Direction facing, int definitionIndex, NPCBehavior behavior);
+
+    // Remove in O(1): the last NPC takes over the index
+    void remove(int index);
+    void clear();
+
+    [[nodiscard]] size_t size() const { return x_.size(); }
+    [[nodiscard]] bool empty() const { return x_.empty(); }
+
+    [[nodiscard]] Vec2 getPosition(size_t i) const { return Vec2{x_[i], y_[i]}; }
+    [[nodiscard]] int getX(size_t i) const { return x_[i]; }
+    [[nodiscard]] int getY(size_t i) const { return y_[i]; }
+    [[nodiscard]] Direction getFacing(size_t i) const { return facing_[i]; }
+    [[nodiscard]] int getDefinitionIndex(size_t i) const { return definition_[i]; }
+    [[nodiscard]] NPCBehavior getBehavior(size_t i) const { return behavior_[i]; }
+
+    // Pixels left to walk into the current tile (0 when standing)
+    [[nodiscard]] int getStepPixels(size_t i) const {
+        return stepFrames_[i] * Constants::NPC_SPEED;
+    }
+
+    // Pixels left to walk as of the frame before (a step that just started
+    // was still a whole tile away; one that just ended was NPC_SPEED away)
+    [[nodiscard]] int getPreviousStepPixels(size_t i) const {
+        if (stepFrames_[i] > 0) {
+            return std::min((stepFrames_[i] + 1) * Constants::NPC_SPEED, Constants::TILE_SIZE);
+        }
+        return arrived_[i] * Constants::NPC_SPEED;
+    }
+
+    void setFacing(size_t i, Direction facing) {
+        revision_ += facing_[i] != facing ? 1 : 0;
+        facing_[i] = facing;
+    }
+
+    // Place on a tile at once, keeping facing
+    void moveTo(size_t i, const Vec2& pos);
+
+    // Walk to the adjacent tile in dir (animated over NPC_STEP_FRAMES)
+    void walk(size_t i, Direction dir);
+
+    // Behavior and its anchor: wandering stays near the current tile
+    void setBehavior(size_t i, NPCBehavior behavior);
+
+    // Waypoints a patrolling NPC walks in turn, looping (replaces any route)
+    void setPatrolRoute(size_t i, const std::vector<Vec2>& waypoints);
+
+    // Advance walking animations by one frame
+    void advanceSteps();
+
+    // True while any NPC is between tiles
+    [[nodiscard]] bool isAnyWalking() const;
+
+    // True while any NPC is drawn moving: walking, or arrived on the latest frame
+    [[nodiscard]] bool isAnyMoving() const;
+
+    // Let up to budget NPCs pick their next step (appended to steps)
+    void think(int budget, const Vec2& playerPos, std::vector<Step>& steps);
+
+    // Changes whenever an NPC is added, removed, moved, turned or walking
+    [[nodiscard]] uint64_t getRevision() const { return revision_; }
+
+    // Waypoints held by all patrol routes
+    [[nodiscard]] size_t getWaypointCount() const { return routeX_.size(); }
+
+    [[nodiscard]] size_t getMemoryBytes() const;
+
+private:
+    // Next step toward a tile along the longer axis (None when there)
+    [[nodiscard]] static Direction stepToward(int fromX, int fromY, int toX, int toY);
+
+    [[nodiscard]] uint32_t nextRandom();
+
+    // Drop NPC i's waypoints from the pool and leave it without a route
+    void releaseRoute(size_t i);
+
+    // One entry per NPC
+    std::vector<int> x_;
+    std::vector<int> y_;
+    std::vector<Direction> facing_;
+    std::vector<int> definition_;
+    std::vector<NPCBehavior> behavior_;
+    std::vector<int> homeX_;              // Wander anchor
+    std::vector<int> homeY_;
+    std::vector<uint8_t> stepFrames_;     // Walking frames left
+    std::vector<uint8_t> arrived_;        // 1 if the walk ended on the latest frame
+    std::vector<uint8_t> restThinks_;     // Thinks to skip before the next step
+    std::vector<int> routeStart_;         // First waypoint in route arrays (-1: none)
+    std::vector<int> routeLength_;
+    std::vector<int> routeNext_;          // Waypoint walked to, relative to routeStart_
+
+    // Waypoints of all patrol routes
+    std::vector<int> routeX_;
+    std::vector<int> routeY_;
+
+    size_t cursor_;  // Next NPC to think
+    uint32_t rng_;
+    uint64_t revision_;
+};
+
+#endif // NPC_SIMULATION_H
@@ -36,6 +36,12 @@ public:
     [[nodiscard]] int getX() const { return x_; }
     [[nodiscard]] int getY() const { return y_; }
 
+    // Tile at the center of the view
+    [[nodiscard]] Vec2 getCenterTile() const {
+        return Vec2{(x_ + Constants::INTERNAL_WIDTH / 2) / Constants::TILE_SIZE,
+                    (y_ + Constants::INTERNAL_HEIGHT / 2) / Constants::TILE_SIZE};
+    }
+
 private:
     const int x_;
     const int y_;
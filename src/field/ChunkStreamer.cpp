@@ -0,0 +1,240 @@
+#include "field/ChunkStreamer.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+    enum ChunkState : uint8_t {
+        Unloaded = 0,
+        Requested = 1,
+        Resident = 2,
+        Failed = 3  // Corrupt chunk; stays non-resident (not walkable) and is not retried
+    };
+}
+
+ChunkStreamer::ChunkStreamer()
+    : tileOffset_(0)
+    , width_(0)
+    , height_(0)
+    , chunksX_(0)
+    , chunksY_(0)
+    , budgetBytes_(0)
+    , frame_(0)
+    , inFlight_(0)
+    , stopping_(false) {}
+
+ChunkStreamer::~ChunkStreamer() {
+    stop();
+}
+
+bool ChunkStreamer::open(const std::string& path, const MapFormat::RMapHeader& header,
+                         size_t memoryBudgetBytes) {
+    stop();
+
+    // Open once here so a missing file fails fast instead of per chunk
+    std::ifstream probe(path, std::ios::binary);
+    if (!probe.is_open()) {
+        std::cerr << "Failed to open streamed map file" << std::endl;
+        slots_.clear();
+        return false;
+    }
+
+    path_ = path;
+    tileOffset_ = header.tileOffset;
+    width_ = static_cast<int>(header.width);
+    height_ = static_cast<int>(header.height);
+    chunksX_ = (width_ + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    chunksY_ = (height_ + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    budgetBytes_ = memoryBudgetBytes;
+
+    size_t chunkCount = static_cast<size_t>(chunksX_) * chunksY_;
+    slots_.clear();
+    slots_.resize(chunkCount);
+    state_.assign(chunkCount, Unloaded);
+    resident_.clear();
+    frame_ = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        requests_.clear();
+        loaded_.clear();
+        inFlight_ = 0;
+        stopping_ = false;
+    }
+
+    worker_ = std::thread(&ChunkStreamer::workerLoop, this);
+    return true;
+}
+
+void ChunkStreamer::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        requests_.clear();
+    }
+    wake_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void ChunkStreamer::update(int tileX, int tileY, int radiusChunks) {
+    if (slots_.empty()) return;
+    ++frame_;
+    integrateLoaded();
+    requestAround(tileX, tileY, radiusChunks);
+    evictOverBudget();
+}
+
+void ChunkStreamer::loadAround(int tileX, int tileY, int radiusChunks) {
+    if (slots_.empty()) return;
+    update(tileX, tileY, radiusChunks);
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return (requests_.empty() && inFlight_ == 0) || stopping_; });
+    }
+    // Second pass integrates the finished chunks and evicts over budget
+    update(tileX, tileY, radiusChunks);
+}
+
+void ChunkStreamer::integrateLoaded() {
+    std::vector<LoadedChunk> loaded;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        loaded.swap(loaded_);
+    }
+
+    for (auto& chunk : loaded) {
+        if (state_[chunk.index] != Requested) continue;  // Superseded request
+        if (chunk.tiles) {
+            slots_[chunk.index] = std::move(chunk.tiles);
+            state_[chunk.index] = Resident;
+            // Stamped by requestAround() only if still wanted, so stale loads can be evicted
+            resident_.push_back(ResidentChunk{chunk.index, 0});
+        } else {
+            state_[chunk.index] = Failed;
+        }
+    }
+}
+
+void ChunkStreamer::requestAround(int tileX, int tileY, int radiusChunks) {
+    int centerX = std::clamp(tileX / CHUNK_SIZE, 0, chunksX_ - 1);
+    int centerY = std::clamp(tileY / CHUNK_SIZE, 0, chunksY_ - 1);
+
+    // Refresh resident chunks that are still wanted
+    for (auto& chunk : resident_) {
+        int cx = chunk.index % chunksX_;
+        int cy = chunk.index / chunksX_;
+        if (std::abs(cx - centerX) <= radiusChunks && std::abs(cy - centerY) <= radiusChunks) {
+            chunk.lastWanted = frame_;
+        }
+    }
+
+    // Queue missing chunks nearest first (ring by ring around the center)
+    std::vector<int> wanted;
+    for (int ring = 0; ring <= radiusChunks; ++ring) {
+        for (int cy = centerY - ring; cy <= centerY + ring; ++cy) {
+            for (int cx = centerX - ring; cx <= centerX + ring; ++cx) {
+                bool onRing = std::abs(cx - centerX) == ring || std::abs(cy - centerY) == ring;
+                if (!onRing || cx < 0 || cy < 0 || cx >= chunksX_ || cy >= chunksY_) continue;
+                int index = cy * chunksX_ + cx;
+                if (state_[index] == Unloaded || state_[index] == Requested) {
+                    wanted.push_back(index);
+                }
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Requests not yet started are replaced, so a moving focus never builds a backlog
+        for (int index : requests_) {
+            if (state_[index] == Requested) state_[index] = Unloaded;
+        }
+        requests_.clear();
+        for (int index : wanted) {
+            if (state_[index] == Unloaded) {
+                requests_.push_back(index);
+                state_[index] = Requested;
+            }
+        }
+    }
+    if (!wanted.empty()) {
+        wake_.notify_one();
+    }
+}
+
+void ChunkStreamer::evictOverBudget() {
+    if (getResidentBytes() <= budgetBytes_) return;
+
+    // Oldest first; chunks wanted this frame are never evicted
+    std::sort(resident_.begin(), resident_.end(),
+              [](const ResidentChunk& a, const ResidentChunk& b) { return a.lastWanted < b.lastWanted; });
+
+    size_t evict = 0;
+    while (evict < resident_.size() &&
+           (resident_.size() - evict) * CHUNK_BYTES > budgetBytes_ &&
+           resident_[evict].lastWanted != frame_) {
+        int index = resident_[evict].index;
+        slots_[index].reset();
+        state_[index] = Unloaded;
+        ++evict;
+    }
+    resident_.erase(resident_.begin(), resident_.begin() + static_cast<std::ptrdiff_t>(evict));
+}
+
+void ChunkStreamer::workerLoop() {
+    std::ifstream file(path_, std::ios::binary);
+
+    while (true) {
+        int index = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stopping_ || !requests_.empty(); });
+            if (stopping_) {
+                inFlight_ = 0;
+                done_.notify_all();
+                return;
+            }
+            index = requests_.front();
+            requests_.pop_front();
+            ++inFlight_;
+        }
+
+        std::unique_ptr<TileType[]> tiles = readChunk(file, index);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            loaded_.push_back(LoadedChunk{index, std::move(tiles)});
+            --inFlight_;
+        }
+        done_.notify_all();
+    }
+}
+
+std::unique_ptr<TileType[]> ChunkStreamer::readChunk(std::ifstream& file, int index) const {
+    int cx = index % chunksX_;
+    int cy = index / chunksX_;
+    int originX = cx * CHUNK_SIZE;
+    int originY = cy * CHUNK_SIZE;
+    int columns = std::min(CHUNK_SIZE, width_ - originX);
+    int rows = std::min(CHUNK_SIZE, height_ - originY);
+
+    // Cells past the map edge read as wall, like out-of-bounds tiles
+    auto tiles = std::make_unique<TileType[]>(CHUNK_SIZE * CHUNK_SIZE);
+    std::fill(tiles.get(), tiles.get() + CHUNK_SIZE * CHUNK_SIZE, TileType::Wall);
+
+    for (int row = 0; row < rows; ++row) {
+        uint64_t offset = tileOffset_ + static_cast<uint64_t>(originY + row) * width_ + originX;
+        TileType* dst = tiles.get() + row * CHUNK_SIZE;
+        file.seekg(static_cast<std::streamoff>(offset));
+        file.read(reinterpret_cast<char*>(dst), columns);
+        if (!file.good() ||
+            !MapFormat::validateTiles(reinterpret_cast<const uint8_t*>(dst), static_cast<uint64_t>(columns))) {
+            file.clear();
+            std::cerr << "Failed to stream map chunk" << std::endl;
+            return nullptr;
+        }
+    }
+    return tiles;
+}
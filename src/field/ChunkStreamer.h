@@ -0,0 +1,103 @@
+#ifndef CHUNK_STREAMER_H
+#define CHUNK_STREAMER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "field/MapFormat.h"
+#include "field/Tile.h"
+
+// Streams fixed-size tile chunks of a large .rmap around a focus point.
+//
+// Chunk reads run on a background thread. All residency changes (integrating
+// finished chunks, eviction) happen on the owning thread in update(), so tile
+// lookups through chunkData() need no locking. Resident chunk memory is kept
+// under a byte budget by evicting the least recently wanted chunks; the chunk
+// slot table itself costs one pointer per chunk.
+class ChunkStreamer {
+public:
+    ChunkStreamer();
+    ~ChunkStreamer();
+
+    // Disable copy (owns a worker thread)
+    ChunkStreamer(const ChunkStreamer&) = delete;
+    ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+
+    // Start streaming tiles of a validated .rmap (header from MapFormat::readHeader)
+    [[nodiscard]] bool open(const std::string& path, const MapFormat::RMapHeader& header,
+                            size_t memoryBudgetBytes);
+
+    // Request chunks within radius of a tile, integrate finished loads and
+    // evict far chunks over budget. Call once per frame.
+    void update(int tileX, int tileY, int radiusChunks);
+
+    // Like update(), but blocks until every wanted chunk is resident
+    void loadAround(int tileX, int tileY, int radiusChunks);
+
+    // Tile data of a resident chunk (CHUNK_SIZE * CHUNK_SIZE, row-major) or nullptr
+    [[nodiscard]] const TileType* chunkData(int chunkX, int chunkY) const {
+        return slots_[static_cast<size_t>(chunkY) * chunksX_ + chunkX].get();
+    }
+
+    [[nodiscard]] int getResidentChunkCount() const { return static_cast<int>(resident_.size()); }
+    [[nodiscard]] size_t getResidentBytes() const { return resident_.size() * CHUNK_BYTES; }
+    [[nodiscard]] int getChunksX() const { return chunksX_; }
+    [[nodiscard]] int getChunksY() const { return chunksY_; }
+
+    static constexpr int CHUNK_SIZE = 32;
+    static constexpr size_t CHUNK_BYTES = CHUNK_SIZE * CHUNK_SIZE * sizeof(TileType);
+
+private:
+    struct LoadedChunk {
+        int index;
+        std::unique_ptr<TileType[]> tiles;  // nullptr if the read or validation failed
+    };
+
+    struct ResidentChunk {
+        int index;
+        uint32_t lastWanted;  // Frame stamp of the last update that wanted this chunk
+    };
+
+    // Worker thread: read requested chunks from the file
+    void workerLoop();
+    [[nodiscard]] std::unique_ptr<TileType[]> readChunk(std::ifstream& file, int index) const;
+
+    // Owner thread helpers
+    void integrateLoaded();
+    void requestAround(int tileX, int tileY, int radiusChunks);
+    void evictOverBudget();
+    void stop();
+
+    // File layout
+    std::string path_;
+    uint64_t tileOffset_;
+    int width_;
+    int height_;
+    int chunksX_;
+    int chunksY_;
+    size_t budgetBytes_;
+
+    // Owner thread state
+    std::vector<std::unique_ptr<TileType[]>> slots_;
+    std::vector<uint8_t> state_;            // ChunkState per chunk
+    std::vector<ResidentChunk> resident_;
+    uint32_t frame_;
+
+    // Shared with worker (guarded by mutex_)
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::deque<int> requests_;
+    std::vector<LoadedChunk> loaded_;
+    int inFlight_;
+    bool stopping_;
+    std::thread worker_;
+};
+
+#endif // CHUNK_STREAMER_H
@@ -0,0 +1,137 @@
+#include "field/FieldOfView.h"
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include "field/Map.h"
+
+namespace {
+    // The eight octants around the origin, each scanned as rows moving away from it
+    constexpr int OCTANT_COUNT = 8;
+    constexpr int OCTANTS[OCTANT_COUNT][4] = {
+        {1, 0, 0, 1}, {0, 1, 1, 0}, {0, -1, 1, 0}, {-1, 0, 0, 1},
+        {-1, 0, 0, -1}, {0, -1, -1, 0}, {0, 1, -1, 0}, {1, 0, 0, -1}
+    };
+}
+
+FieldOfView::FieldOfView()
+    : originX_(0), originY_(0), radius_(-1), tileRevision_(0), revision_(0), tilesRead_(0) {}
+
+bool FieldOfView::update(Map& map, const Vec2& origin, int radius) {
+    radius = std::max(radius, 0);
+    uint64_t tiles = map.getTileRevision();
+    if (radius == radius_ && origin.x == originX_ && origin.y == originY_ && tiles == tileRevision_) {
+        return false;
+    }
+
+    loadOpacity(map, origin.x, origin.y, radius);
+    originX_ = origin.x;
+    originY_ = origin.y;
+    radius_ = radius;
+    tileRevision_ = tiles;
+
+    // Loading a layout clears the memory; size it on the first look around
+    TileMask& explored = map.getExploredMask();
+    if (explored.getWidth() != map.getWidth() || explored.getHeight() != map.getHeight()) {
+        explored.reset(map.getWidth(), map.getHeight());
+    }
+
+    int size = 2 * radius + 1;
+    visible_.reset(size, size);
+    markVisible(explored, 0, 0);
+    for (const auto& m : OCTANTS) {
+        castLight(explored, 1, 1.0, 0.0, Octant{m[0], m[1], m[2], m[3]});
+    }
+    ++revision_;
+    return true;
+}
+
+void FieldOfView::reset() {
+    visible_.reset(0, 0);
+    opaque_.reset(0, 0);
+    scratch_.reset(0, 0);
+    radius_ = -1;
+    tileRevision_ = 0;
+    ++revision_;
+}
+
+void FieldOfView::loadOpacity(const Map& map, int originX, int originY, int radius) {
+    int size = 2 * radius + 1;
+    int shiftX = originX - originX_;
+    int shiftY = originY - originY_;
+    bool reuse = radius == radius_ && map.getTileRevision() == tileRevision_ &&
+                 std::abs(shiftX) < size && std::abs(shiftY) < size;
+
+    scratch_.reset(size, size);
+    tilesRead_ = 0;
+    int left = originX - radius;
+    int top = originY - radius;
+    for (int y = 0; y < size; ++y) {
+        // Window row y was row y + shiftY of the previous window; windows up to
+        // 64 tiles wide are one word per row, shifted whole
+        int from = 0;
+        int to = size - 1;
+        if (reuse && opaque_.isInBounds(0, y + shiftY) && size <= TileMask::WORD_BITS) {
+            uint64_t word = opaque_.getRow(y + shiftY)[0];
+            scratch_.setWord(y, 0, shiftX >= 0 ? (word >> shiftX) : (word << -shiftX));
+            from = shiftX >= 0 ? size - shiftX : 0;
+            to = shiftX >= 0 ? size - 1 : -shiftX - 1;
+        }
+        for (int x = from; x <= to; ++x) {
+            bool opaque;
+            if (reuse && opaque_.isInBounds(x + shiftX, y + shiftY)) {
+                opaque = opaque_.test(x + shiftX, y + shiftY);
+            } else {
+                opaque = map.getTile(left + x, top + y).opaque;
+                ++tilesRead_;
+            }
+            scratch_.set(x, y, opaque);
+        }
+    }
+    std::swap(opaque_, scratch_);
+}
+
+void FieldOfView::castLight(TileMask& explored, int row, double start, double end, const Octant& octant) {
+    if (start < end) return;
+
+    // r^2 + r rounds the edge of the lit area (radius 1 lights the full 3 x 3 block)
+    int reach = radius_ * radius_ + radius_;
+    double nextStart = start;
+    for (int depth = row; depth <= radius_; ++depth) {
+        bool blocked = false;
+        int dy = -depth;
+        for (int dx = -depth; dx <= 0; ++dx) {
+            // Slopes through the tile's outer corners
+            double leftSlope = (dx - 0.5) / (dy + 0.5);
+            double rightSlope = (dx + 0.5) / (dy - 0.5);
+            if (start < rightSlope) continue;
+            if (end > leftSlope) break;
+
+            int mapDx = dx * octant.xx + dy * octant.xy;
+            int mapDy = dx * octant.yx + dy * octant.yy;
+            if (dx * dx + dy * dy <= reach) {
+                markVisible(explored, mapDx, mapDy);
+            }
+
+            bool opaque = isOpaqueAt(mapDx, mapDy);
+            if (blocked) {
+                if (opaque) {
+                    nextStart = rightSlope;
+                    continue;
+                }
+                blocked = false;
+                start = nextStart;
+            } else if (opaque && depth < radius_) {
+                // Scan the lit part beyond this wall, then continue past it
+                blocked = true;
+                castLight(explored, depth + 1, start, leftSlope, octant);
+                nextStart = rightSlope;
+            }
+        }
+        if (blocked) break;
+    }
+}
+
+void FieldOfView::markVisible(TileMask& explored, int dx, int dy) {
+    visible_.set(dx + radius_, dy + radius_, true);
+    explored.set(originX_ + dx, originY_ + dy, true);
+}
@@ -0,0 +1,78 @@
+#ifndef FIELD_OF_VIEW_H
+#define FIELD_OF_VIEW_H
+
+#include <cstdint>
+#include "field/TileMask.h"
+#include "util/Vec2.h"
+
+class Map;
+
+// Tiles visible from the player, by recursive shadowcasting over Tile
+// opacity, plus the fog-of-war memory kept in the map's explored mask.
+//
+// All state lives in (2 * radius + 1)^2 windows centered on the origin, so an
+// update never touches anything map-sized. Opacity is cached in its window:
+// a one-tile step shifts the cache and reads only the newly exposed row or
+// column from the map. Updates with the same origin, radius and map tiles
+// are skipped entirely.
+class FieldOfView {
+public:
+    FieldOfView();
+
+    // Disable copy (holds per-radius windows); moving is fine
+    FieldOfView(const FieldOfView&) = delete;
+    FieldOfView& operator=(const FieldOfView&) = delete;
+    FieldOfView(FieldOfView&&) noexcept = default;
+    FieldOfView& operator=(FieldOfView&&) noexcept = default;
+
+    // Recompute visibility from origin and mark the visible tiles explored
+    // in the map. Returns false when nothing changed since the last update.
+    bool update(Map& map, const Vec2& origin, int radius);
+
+    // Forget the last update (e.g. after leaving the map); nothing is visible
+    void reset();
+
+    [[nodiscard]] bool isVisible(int x, int y) const {
+        return radius_ >= 0 && visible_.test(x - originX_ + radius_, y - originY_ + radius_);
+    }
+
+    // Changes whenever the visible set changes (for caches derived from it)
+    [[nodiscard]] uint64_t getRevision() const { return revision_; }
+    [[nodiscard]] int getRadius() const { return radius_; }
+
+    // Opacity window statistics of the last update (map tiles read)
+    [[nodiscard]] int getTilesRead() const { return tilesRead_; }
+
+private:
+    // Maps octant-local (column, row) offsets to map offsets
+    struct Octant {
+        int xx;
+        int xy;
+        int yx;
+        int yy;
+    };
+
+    // Refill the opacity window, reusing the previous one after a one-tile step
+    void loadOpacity(const Map& map, int originX, int originY, int radius);
+
+    // Light rows row..radius of one octant between two slopes
+    void castLight(TileMask& explored, int row, double start, double end, const Octant& octant);
+
+    void markVisible(TileMask& explored, int dx, int dy);
+
+    [[nodiscard]] bool isOpaqueAt(int dx, int dy) const {
+        return opaque_.test(dx + radius_, dy + radius_);
+    }
+
+    TileMask visible_;   // Window: tiles lit by the last update
+    TileMask opaque_;    // Window: tile opacity around the origin
+    TileMask scratch_;   // Window: next opacity while shifting
+    int originX_;
+    int originY_;
+    int radius_;         // -1 until the first update
+    uint64_t tileRevision_;
+    uint64_t revision_;
+    int tilesRead_;
+};
+
+#endif // FIELD_OF_VIEW_H
@@ -0,0 +1,95 @@
+#include "field/FogRenderer.h"
+#include <utility>
+#include "field/FieldOfView.h"
+#include "field/Map.h"
+#include "system/Renderer.h"
+#include "util/Constants.h"
+
+namespace {
+    // Tiles touched by the view, plus one for the partly scrolled edge
+    constexpr int FOG_COLUMNS = (Constants::INTERNAL_WIDTH + Constants::TILE_SIZE - 1) / Constants::TILE_SIZE + 1;
+    constexpr int FOG_ROWS = (Constants::INTERNAL_HEIGHT + Constants::TILE_SIZE - 1) / Constants::TILE_SIZE + 1;
+
+    constexpr uint32_t fogTexel(int alpha) {
+        return static_cast<uint32_t>(alpha) << 24;  // ARGB8888, black
+    }
+}
+
+FogRenderer::FogRenderer()
+    : texture_(nullptr), texels_(FOG_COLUMNS * FOG_ROWS, 0), lastTileX_(0), lastTileY_(0), lastRevision_(0) {}
+
+FogRenderer::~FogRenderer() {
+    release();
+}
+
+FogRenderer::FogRenderer(FogRenderer&& other) noexcept
+    : texture_(other.texture_)
+    , texels_(std::move(other.texels_))
+    , lastTileX_(other.lastTileX_)
+    , lastTileY_(other.lastTileY_)
+    , lastRevision_(other.lastRevision_) {
+    other.texture_ = nullptr;
+}
+
+FogRenderer& FogRenderer::operator=(FogRenderer&& other) noexcept {
+    if (this != &other) {
+        release();
+        texture_ = other.texture_;
+        texels_ = std::move(other.texels_);
+        lastTileX_ = other.lastTileX_;
+        lastTileY_ = other.lastTileY_;
+        lastRevision_ = other.lastRevision_;
+        other.texture_ = nullptr;
+    }
+    return *this;
+}
+
+void FogRenderer::render(Renderer& renderer, const Map& map, const FieldOfView& fov, int cameraX, int cameraY) {
+    int tileX = cameraX / Constants::TILE_SIZE;
+    int tileY = cameraY / Constants::TILE_SIZE;
+
+    bool stale = false;
+    if (!texture_) {
+        texture_ = renderer.createStreamingTexture(FOG_COLUMNS, FOG_ROWS);
+        if (!texture_) return;
+        stale = true;
+    }
+
+    if (stale || tileX != lastTileX_ || tileY != lastTileY_ || fov.getRevision() != lastRevision_) {
+        const TileMask& explored = map.getExploredMask();
+        for (int row = 0; row < FOG_ROWS; ++row) {
+            for (int col = 0; col < FOG_COLUMNS; ++col) {
+                int x = tileX + col;
+                int y = tileY + row;
+                int alpha = Constants::FOG_HIDDEN_ALPHA;
+                if (fov.isVisible(x, y)) {
+                    alpha = 0;
+                } else if (explored.test(x, y)) {
+                    alpha = Constants::FOG_EXPLORED_ALPHA;
+                }
+                texels_[row * FOG_COLUMNS + col] = fogTexel(alpha);
+            }
+        }
+        if (!renderer.updateTexture(texture_, texels_.data(), FOG_COLUMNS * static_cast<int>(sizeof(uint32_t)))) {
+            return;
+        }
+        lastTileX_ = tileX;
+        lastTileY_ = tileY;
+        lastRevision_ = fov.getRevision();
+    }
+
+    SDL_Rect dst = {
+        tileX * Constants::TILE_SIZE - cameraX,
+        tileY * Constants::TILE_SIZE - cameraY,
+        FOG_COLUMNS * Constants::TILE_SIZE,
+        FOG_ROWS * Constants::TILE_SIZE
+    };
+    renderer.drawTexture(texture_, nullptr, &dst);
+}
+
+void FogRenderer::release() {
+    if (texture_) {
+        SDL_DestroyTexture(texture_);
+        texture_ = nullptr;
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef FOG_RENDERER_H
+#define FOG_RENDERER_H
+
+#include <SDL.h>
+#include <cstdint>
+#include <vector>
+
+class Map;
+class FieldOfView;
+class Renderer;
+
+// Fog of war over the field: one texel per on-screen tile in a small
+// streaming texture (black, alpha by visibility), stretched over the view in
+// a single copy. Texels are rewritten only when the camera crosses a tile or
+// the field of view changes.
+class FogRenderer {
+public:
+    FogRenderer();
+    ~FogRenderer();
+
+    // Disable copy (owns a texture); moving is fine
+    FogRenderer(const FogRenderer&) = delete;
+    FogRenderer& operator=(const FogRenderer&) = delete;
+    FogRenderer(FogRenderer&& other) noexcept;
+    FogRenderer& operator=(FogRenderer&& other) noexcept;
+
+    // Camera position in pixels, as for Map::render
+    void render(Renderer& renderer, const Map& map, const FieldOfView& fov, int cameraX, int cameraY);
+
+    // Free the texture (before the renderer goes away; recreated on demand)
+    void release();
+
+private:
+    SDL_Texture* texture_;  // Owned
+    std::vector<uint32_t> texels_;
+    int lastTileX_;
+    int lastTileY_;
+    uint64_t lastRevision_;
+};
+
+#endif // FOG_RENDERER_H
@@ -1,19 +1,101 @@
 #include "field/Map.h"
+#include "field/ChunkStreamer.h"
+#include "field/MapFormat.h"
+#include "system/MappedFile.h"
 #include "system/Renderer.h"
 #include "system/ResourceManager.h"
+#include "util/PathUtil.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 
-const Tile Map::defaultTile_ = Tile::wall();
+namespace {
+    // Parse an integer field (leading/trailing whitespace allowed, like the tile cells)
+    bool parseInt(const std::string& text, int& out) {
+        try {
+            out = std::stoi(text);
+            return true;
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+
+    // Facing names used by #npc directives
+    bool parseFacing(const std::string& text, Direction& out) {
+        std::string name;
+        for (char c : text) {
+            if (c != ' ') name.push_back(c);
+        }
+        if (name == "up")    { out = Direction::Up;    return true; }
+        if (name == "down")  { out = Direction::Down;  return true; }
+        if (name == "left")  { out = Direction::Left;  return true; }
+        if (name == "right") { out = Direction::Right; return true; }
+        return false;
+    }
+
+    const char* facingName(Direction facing) {
+        switch (facing) {
+            case Direction::Up:    return "up";
+            case Direction::Left:  return "left";
+            case Direction::Right: return "right";
+            default:               return "down";
+        }
+    }
+
+    std::string trim(const std::string& text) {
+        size_t start = text.find_first_not_of(' ');
+        if (start == std::string::npos) return "";
+        size_t end = text.find_last_not_of(' ');
+        return text.substr(start, end - start + 1);
+    }
+
+    // Maps load on background threads too (MapCache), so revisions are atomic
+    uint64_t nextTileRevision() {
+        static std::atomic<uint64_t> counter{0};
+        return ++counter;
+    }
+}
 
-Map::Map() : width_(0), height_(0), spawnX_(1), spawnY_(1) {}
+Map::Map()
+    : tileData_(nullptr), width_(0), height_(0), spawnX_(1), spawnY_(1), dark_(false), tileRevision_(0) {}
+
+Map::~Map() = default;
+Map::Map(Map&&) noexcept = default;
+Map& Map::operator=(Map&&) noexcept = default;
+
+bool Map::load(const std::string& path) {
+    if (PathUtil::hasExtension(path, ".rmap")) {
+        return loadBinary(path);
+    }
+
+    std::string binaryPath = PathUtil::replaceExtension(path, ".rmap");
+    if (binaryPath != path && PathUtil::isSafeRelativePath(path) &&
+        PathUtil::isUpToDate(binaryPath, path) && loadBinary(binaryPath)) {
+        return true;
+    }
+    return loadFromCSV(path);
+}
+
+bool Map::loadBinary(const std::string& path) {
+    // Peek at the dimensions: large worlds stream by chunk, small maps are mapped whole
+    MapFormat::RMapHeader header{};
+    std::ifstream file(path, std::ios::binary);
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    uint64_t tileCount = static_cast<uint64_t>(header.width) * header.height;
+    if (file.good() && tileCount >= static_cast<uint64_t>(Constants::STREAMING_MIN_TILES)) {
+        return openStreaming(path);
+    }
+    return loadFromBinary(path);
+}
 
 bool Map::loadFromCSV(const std::string& path) {
     // Security: Validate path to prevent directory traversal attacks
-    if (path.find("..") != std::string::npos ||
-        path.find('/') == 0 ||
-        path.find('\\') != std::string::npos) {
+    if (!PathUtil::isSafeRelativePath(path)) {
         std::cerr << "Invalid map path: path traversal not allowed" << std::endl;
         return false;
     }
@@ -24,13 +106,53 @@ bool Map::loadFromCSV(const std::string& path) {
         return false;
     }
 
-    tiles_.clear();
     std::vector<std::vector<int>> tempData;
+    std::vector<MapTransition> transitions;
+    std::vector<NPCPlacement> placements;
+    int spawnX = 1;
+    int spawnY = 1;
+    bool hasSpawn = false;
+    bool dark = false;
     std::string line;
 
     while (std::getline(file, line)) {
         if (line.empty()) continue;
 
+        // Directive or comment line
+        if (line[0] == '#') {
+            std::vector<std::string> fields;
+            std::stringstream ss(line.substr(1));
+            std::string field;
+            while (std::getline(ss, field, ',')) {
+                fields.push_back(trim(field));
+            }
+            if (fields.empty()) continue;
+
+            int x = 0, y = 0, tx = 0, ty = 0;
+            Direction facing = Direction::Down;
+            if (fields[0] == "spawn" && fields.size() == 3 &&
+                parseInt(fields[1], x) && parseInt(fields[2], y)) {
+                spawnX = x;
+                spawnY = y;
+                hasSpawn = true;
+            } else if (fields[0] == "dark" && fields.size() == 1) {
+                dark = true;
+            } else if (fields[0] == "transition" && fields.size() == 6 &&
+                       parseInt(fields[1], x) && parseInt(fields[2], y) &&
+                       parseInt(fields[4], tx) && parseInt(fields[5], ty)) {
+                transitions.emplace_back(Vec2{x, y}, fields[3], Vec2{tx, ty});
+            } else if (fields[0] == "npc" && fields.size() == 5 &&
+                       parseInt(fields[1], x) && parseInt(fields[2], y) &&
+                       parseFacing(fields[3], facing) && !fields[4].empty()) {
+                placements.emplace_back(Vec2{x, y}, facing, fields[4]);
+            } else if (fields[0] == "spawn" || fields[0] == "dark" || fields[0] == "transition" ||
+                       fields[0] == "npc") {
+                std::cerr << "Invalid map directive ignored" << std::endl;
+            }
+            // Anything else is a comment
+            continue;
+        }
+
         std::vector<int> row;
         std::stringstream ss(line);
         std::string cell;
@@ -60,24 +182,313 @@ bool Map::loadFromCSV(const std::string& path) {
         return false;
     }
 
-    height_ = static_cast<int>(tempData.size());
-    width_ = static_cast<int>(tempData[0].size());
+    int height = static_cast<int>(tempData.size());
+    int width = static_cast<int>(tempData[0].size());
 
-    // Convert to Tile objects
-    tiles_.reserve(width_ * height_);
+    // Same checks as the binary loader, so csv2rmap output always loads
+    if (!MapFormat::isValidSpawn(width, height, spawnX, spawnY)) {
+        if (hasSpawn) {
+            std::cerr << "Map spawn point outside map" << std::endl;
+            return false;
+        }
+        spawnX = 0;  // The default (1, 1) does not fit a one-tile-wide map
+        spawnY = 0;
+    }
+
+    // Convert to tile IDs (IDs were range-checked above)
+    std::vector<TileType> tiles;
+    tiles.reserve(static_cast<size_t>(width) * height);
     for (const auto& row : tempData) {
-        for (int id : row) {
-            tiles_.push_back(Tile::fromId(id));
+        // Rows longer than the first row are truncated to keep the grid aligned
+        size_t count = std::min(row.size(), static_cast<size_t>(width));
+        for (size_t i = 0; i < count; ++i) {
+            tiles.push_back(static_cast<TileType>(row[i]));
         }
         // Pad rows if necessary
-        for (size_t i = row.size(); i < static_cast<size_t>(width_); ++i) {
-            tiles_.push_back(Tile::grass());
+        for (size_t i = count; i < static_cast<size_t>(width); ++i) {
+            tiles.push_back(TileType::Grass);
+        }
+    }
+
+    resetLayout();
+    tiles_ = std::move(tiles);
+    tileData_ = tiles_.data();
+    width_ = width;
+    height_ = height;
+    spawnX_ = spawnX;
+    spawnY_ = spawnY;
+    dark_ = dark;
+
+    // Map objects must lie on the map
+    for (const auto& transition : transitions) {
+        if (MapFormat::isValidTransition(width, height, transition)) {
+            transitions_.push_back(transition);
+        } else {
+            std::cerr << "Invalid transition ignored" << std::endl;
+        }
+    }
+    for (const auto& placement : placements) {
+        if (MapFormat::isValidPlacement(width, height, placement)) {
+            npcPlacements_.push_back(placement);
+        } else {
+            std::cerr << "NPC placement outside map ignored" << std::endl;
+        }
+    }
+
+    rebuildIndexes();
+    return true;
+}
+
+bool Map::loadFromBinary(const std::string& path) {
+    // Security: Validate path to prevent directory traversal attacks
+    if (!PathUtil::isSafeRelativePath(path)) {
+        std::cerr << "Invalid map path: path traversal not allowed" << std::endl;
+        return false;
+    }
+
+    auto file = std::make_unique<MappedFile>();
+    if (!file->open(path)) {
+        std::cerr << "Failed to open map file" << std::endl;
+        return false;
+    }
+
+    // Header, tile IDs and objects are all validated before the map is replaced
+    MapFormat::RMapHeader header;
+    if (!MapFormat::readHeader(file->data(), file->size(), header)) {
+        return false;
+    }
+
+    const uint8_t* tileBytes = file->data() + header.tileOffset;
+    if (!MapFormat::validateTiles(tileBytes, static_cast<uint64_t>(header.width) * header.height)) {
+        return false;
+    }
+
+    std::vector<MapTransition> transitions;
+    std::vector<NPCPlacement> placements;
+    if (!MapFormat::readObjects(header, file->data() + MapFormat::objectsBegin(header),
+                                transitions, placements)) {
+        return false;
+    }
+
+    resetLayout();
+    tileData_ = reinterpret_cast<const TileType*>(tileBytes);
+    mappedFile_ = std::move(file);
+    width_ = static_cast<int>(header.width);
+    height_ = static_cast<int>(header.height);
+    spawnX_ = header.spawnX;
+    spawnY_ = header.spawnY;
+    dark_ = (header.flags & MapFormat::FLAG_DARK) != 0;
+    transitions_ = std::move(transitions);
+    npcPlacements_ = std::move(placements);
+    rebuildIndexes();
+    return true;
+}
+
+bool Map::openStreaming(const std::string& path, size_t memoryBudgetBytes) {
+    // Security: Validate path to prevent directory traversal attacks
+    if (!PathUtil::isSafeRelativePath(path)) {
+        std::cerr << "Invalid map path: path traversal not allowed" << std::endl;
+        return false;
+    }
+
+    std::error_code ec;
+    uint64_t fileSize = std::filesystem::file_size(path, ec);
+    std::ifstream file(path, std::ios::binary);
+    if (ec || !file.is_open()) {
+        std::cerr << "Failed to open map file" << std::endl;
+        return false;
+    }
+
+    // Only the header and objects are read now; tiles stream in by chunk
+    uint8_t headerBytes[sizeof(MapFormat::RMapHeader)] = {};
+    file.read(reinterpret_cast<char*>(headerBytes), sizeof(headerBytes));
+    MapFormat::RMapHeader header;
+    if (!file.good() || !MapFormat::readHeader(headerBytes, fileSize, header)) {
+        return false;
+    }
+
+    uint64_t objectsBegin = MapFormat::objectsBegin(header);
+    uint64_t objectsSize = MapFormat::objectsEnd(header) - objectsBegin;
+    if (objectsSize > MAX_STREAMED_OBJECT_BYTES) {
+        std::cerr << "Binary map object data too large" << std::endl;
+        return false;
+    }
+    std::vector<uint8_t> objects(static_cast<size_t>(objectsSize));
+    file.seekg(static_cast<std::streamoff>(objectsBegin));
+    file.read(reinterpret_cast<char*>(objects.data()), static_cast<std::streamsize>(objectsSize));
+
+    std::vector<MapTransition> transitions;
+    std::vector<NPCPlacement> placements;
+    if (!file.good() || !MapFormat::readObjects(header, objects.data(), transitions, placements)) {
+        return false;
+    }
+
+    auto streamer = std::make_unique<ChunkStreamer>();
+    if (!streamer->open(path, header, memoryBudgetBytes)) {
+        return false;
+    }
+
+    resetLayout();
+    streamer_ = std::move(streamer);
+    width_ = static_cast<int>(header.width);
+    height_ = static_cast<int>(header.height);
+    spawnX_ = header.spawnX;
+    spawnY_ = header.spawnY;
+    dark_ = (header.flags & MapFormat::FLAG_DARK) != 0;
+    transitions_ = std::move(transitions);
+    npcPlacements_ = std::move(placements);
+    rebuildIndexes();
+
+    // Spawn area is loaded up front so the player can move on the first frame
+    loadAround(getSpawnPosition());
+    return true;
+}
+
+void Map::streamAround(const Vec2& tilePos) {
+    if (streamer_) {
+        streamer_->update(tilePos.x, tilePos.y, Constants::CHUNK_LOAD_RADIUS);
+    }
+}
+
+void Map::loadAround(const Vec2& tilePos) {
+    if (streamer_) {
+        streamer_->loadAround(tilePos.x, tilePos.y, Constants::CHUNK_LOAD_RADIUS);
+    }
+}
+
+size_t Map::getTileMemoryBytes() const {
+    if (streamer_) {
+        return streamer_->getResidentBytes();
+    }
+    return static_cast<size_t>(width_) * height_ * sizeof(TileType);
+}
+
+size_t Map::getMemoryBytes() const {
+    size_t bytes = sizeof(Map) + getTileMemoryBytes();
+    bytes += triggerIndex_.getMemoryBytes() + npcOccupancy_.getMemoryBytes();
+    bytes += walkableMask_.getMemoryBytes() + npcMask_.getMemoryBytes();
+    bytes += exploredMask_.getMemoryBytes();
+    for (const auto& transition : transitions_) {
+        bytes += sizeof(MapTransition) + transition.targetMap.capacity();
+    }
+    for (const auto& placement : npcPlacements_) {
+        bytes += sizeof(NPCPlacement) + placement.definitionId.capacity();
+    }
+    bytes += npcs_.getMemoryBytes() + npcSteps_.capacity() * sizeof(NPCSimulation::Step);
+    for (const auto& def : npcDefinitions_) {
+        bytes += sizeof(NPCDefinition) + def.id.capacity();
+        for (const auto& page : *def.dialogue) {
+            bytes += sizeof(std::string) + page.capacity();
+        }
+    }
+    return bytes;
+}
+
+const TileType* Map::findStreamedTile(int x, int y) const {
+    constexpr int size = ChunkStreamer::CHUNK_SIZE;
+    const TileType* chunk = streamer_->chunkData(x / size, y / size);
+    if (!chunk) return nullptr;
+    return chunk + (y % size) * size + (x % size);
+}
+
+TileType Map::getStreamedTileType(int x, int y) const {
+    const TileType* tile = findStreamedTile(x, y);
+    // Tiles in non-resident chunks are not walkable
+    return tile ? *tile : TileType::Wall;
+}
+
+bool Map::saveToBinary(const std::string& path) const {
+    // Streamed maps have no complete tile layer in memory
+    return MapFormat::write(path, width_, height_, spawnX_, spawnY_, tileData_,
+                            transitions_, npcPlacements_, dark_ ? MapFormat::FLAG_DARK : 0);
+}
+
+bool Map::saveToCSV(const std::string& path) const {
+    if (!tileData_) {
+        std::cerr << "Map has no complete tile layer to save" << std::endl;
+        return false;
+    }
+
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to create map file" << std::endl;
+        return false;
+    }
+
+    file << "#spawn," << spawnX_ << "," << spawnY_ << "\n";
+    if (dark_) {
+        file << "#dark\n";
+    }
+    for (const auto& transition : transitions_) {
+        file << "#transition," << transition.triggerPos.x << "," << transition.triggerPos.y << ","
+             << transition.targetMap << "," << transition.targetPos.x << ","
+             << transition.targetPos.y << "\n";
+    }
+    for (const auto& placement : npcPlacements_) {
+        file << "#npc," << placement.pos.x << "," << placement.pos.y << ","
+             << facingName(placement.facing) << "," << placement.definitionId << "\n";
+    }
+
+    // Tile IDs are single digits, so each row is built in one buffer
+    static_assert(Constants::MAX_TILE_ID < 10, "CSV rows are written one digit per tile");
+    std::string row;
+    row.reserve(static_cast<size_t>(width_) * 2);
+    for (int y = 0; y < height_; ++y) {
+        row.clear();
+        const TileType* tiles = tileData_ + static_cast<size_t>(y) * width_;
+        for (int x = 0; x < width_; ++x) {
+            if (x > 0) row.push_back(',');
+            row.push_back(static_cast<char>('0' + static_cast<int>(tiles[x])));
         }
+        row.push_back('\n');
+        file.write(row.data(), static_cast<std::streamsize>(row.size()));
     }
 
+    if (!file.good()) {
+        std::cerr << "Failed to write map file" << std::endl;
+        return false;
+    }
     return true;
 }
 
+bool Map::loadFromTiles(int width, int height, std::vector<TileType> tiles) {
+    if (width <= 0 || height <= 0 ||
+        tiles.size() != static_cast<size_t>(width) * static_cast<size_t>(height)) {
+        std::cerr << "Invalid tile layer dimensions" << std::endl;
+        return false;
+    }
+
+    for (TileType type : tiles) {
+        if (static_cast<int>(type) > Constants::MAX_TILE_ID) {
+            std::cerr << "Tile ID out of range in tile layer" << std::endl;
+            return false;
+        }
+    }
+
+    resetLayout();
+    tiles_ = std::move(tiles);
+    tileData_ = tiles_.data();
+    width_ = width;
+    height_ = height;
+    rebuildIndexes();
+    return true;
+}
+
+void Map::resetLayout() {
+    layerCache_.clear();
+    tiles_.clear();
+    mappedFile_.reset();
+    streamer_.reset();
+    tileData_ = nullptr;
+    width_ = 0;
+    height_ = 0;
+    spawnX_ = 1;
+    spawnY_ = 1;
+    dark_ = false;
+    transitions_.clear();
+    npcPlacements_.clear();
+}
+
 bool Map::loadTileSet(ResourceManager& resourceManager, const std::string& path) {
     return tileSet_.load(resourceManager, path);
 }
@@ -85,24 +496,95 @@ bool Map::loadTileSet(ResourceManager& resourceManager, const std::string& path)
 void Map::render(Renderer& renderer, int cameraX, int cameraY) const {
     if (!tileSet_.getTexture()) return;
 
+    // Visible pixel range, clamped to the map
+    int left = std::max(0, cameraX);
+    int top = std::max(0, cameraY);
+    int right = std::min(getPixelWidth(), cameraX + Constants::INTERNAL_WIDTH);
+    int bottom = std::min(getPixelHeight(), cameraY + Constants::INTERNAL_HEIGHT);
+    if (left >= right || top >= bottom) return;
+
+    int chunkPixels = Constants::TILE_CACHE_CHUNK_PIXELS;
+    int chunkTiles = Constants::TILE_CACHE_CHUNK_TILES;
+    bool useCache = renderer.supportsRenderTargets();
+    layerCache_.beginFrame();
+
+    for (int chunkY = top / chunkPixels; chunkY <= (bottom - 1) / chunkPixels; ++chunkY) {
+        for (int chunkX = left / chunkPixels; chunkX <= (right - 1) / chunkPixels; ++chunkX) {
+            int startX = chunkX * chunkTiles;
+            int startY = chunkY * chunkTiles;
+            int endX = std::min(width_, startX + chunkTiles);
+            int endY = std::min(height_, startY + chunkTiles);
+
+            SDL_Texture* texture = nullptr;
+            if (useCache) {
+                texture = layerCache_.find(chunkX, chunkY);
+                if (!texture) {
+                    texture = bakeChunk(renderer, chunkX, chunkY);
+                    layerCache_.insert(chunkX, chunkY, texture);
+                }
+            }
+
+            if (texture) {
+                int tileSize = Constants::TILE_SIZE;
+                SDL_Rect dst = {startX * tileSize - cameraX, startY * tileSize - cameraY,
+                                (endX - startX) * tileSize, (endY - startY) * tileSize};
+                renderer.drawTexture(texture, nullptr, &dst);
+            } else {
+                renderTiles(renderer, cameraX, cameraY, startX, startY, endX, endY);
+            }
+        }
+    }
+}
+
+SDL_Texture* Map::bakeChunk(Renderer& renderer, int chunkX, int chunkY) const {
+    int chunkTiles = Constants::TILE_CACHE_CHUNK_TILES;
+    int startX = chunkX * chunkTiles;
+    int startY = chunkY * chunkTiles;
+    int endX = std::min(width_, startX + chunkTiles);
+    int endY = std::min(height_, startY + chunkTiles);
+
+    // Streamed chunks are only baked once all their tiles are resident
+    if (!tileData_) {
+        for (int y = startY; y < endY; ++y) {
+            for (int x = startX; x < endX; ++x) {
+                if (!findStreamedTile(x, y)) return nullptr;
+            }
+        }
+    }
+
     int tileSize = Constants::TILE_SIZE;
+    SDL_Texture* texture = renderer.createRenderTarget((endX - startX) * tileSize,
+                                                       (endY - startY) * tileSize);
+    if (!texture) return nullptr;
+    if (!renderer.setRenderTarget(texture)) {
+        SDL_DestroyTexture(texture);
+        return nullptr;
+    }
 
-    // Calculate visible tile range
-    int startTileX = cameraX / tileSize;
-    int startTileY = cameraY / tileSize;
-    int endTileX = startTileX + Constants::TILES_PER_ROW + 1;
-    int endTileY = startTileY + Constants::TILES_PER_COL + 2;  // +2 for partial tile
+    SDL_Color drawColor = renderer.getDrawColor();
+    renderer.setDrawColor(0, 0, 0, 0);
+    renderer.clear();
+    renderTiles(renderer, startX * tileSize, startY * tileSize, startX, startY, endX, endY);
 
-    // Clamp to map bounds
-    startTileX = std::max(0, startTileX);
-    startTileY = std::max(0, startTileY);
-    endTileX = std::min(width_, endTileX);
-    endTileY = std::min(height_, endTileY);
+    if (!renderer.setRenderTarget(nullptr)) {
+        std::cerr << "Failed to restore render target" << std::endl;
+    }
+    renderer.setDrawColor(drawColor.r, drawColor.g, drawColor.b, drawColor.a);
+    return texture;
+}
 
-    // Render visible tiles
-    for (int y = startTileY; y < endTileY; ++y) {
-        for (int x = startTileX; x < endTileX; ++x) {
-            const Tile& tile = getTile(x, y);
+void Map::renderTiles(Renderer& renderer, int cameraX, int cameraY,
+                      int startX, int startY, int endX, int endY) const {
+    int tileSize = Constants::TILE_SIZE;
+
+    // Range is already clamped to the map, so index tile IDs directly
+    for (int y = startY; y < endY; ++y) {
+        const TileType* row = tileData_ ? tileData_ + static_cast<size_t>(y) * width_ : nullptr;
+        for (int x = startX; x < endX; ++x) {
+            // Streamed tiles in non-resident chunks are left undrawn
+            const TileType* type = row ? row + x : findStreamedTile(x, y);
+            if (!type) continue;
+            const Tile& tile = tileOf(*type);
 
             // Screen position (offset by camera)
             int screenX = x * tileSize - cameraX;
@@ -117,84 +599,223 @@ void Map::render(Renderer& renderer, int cameraX, int cameraY) const {
     }
 }
 
-const Tile& Map::getTile(int x, int y) const {
-    if (!isInBounds(x, y)) {
-        return defaultTile_;
+bool Map::setTile(int x, int y, TileType type) {
+    if (!isInBounds(x, y) || static_cast<int>(type) > Constants::MAX_TILE_ID) return false;
+    if (!tileData_) return false;  // Streamed chunks are read-only
+
+    // Mapped tile data is read-only: switch to an owned copy on the first edit
+    if (mappedFile_) {
+        tiles_.assign(tileData_, tileData_ + static_cast<size_t>(width_) * height_);
+        tileData_ = tiles_.data();
+        mappedFile_.reset();
     }
-    return tiles_[y * width_ + x];
+
+    tiles_[static_cast<size_t>(y) * width_ + x] = type;
+    walkableMask_.set(x, y, tileOf(type).walkable);
+    tileRevision_ = nextTileRevision();
+    layerCache_.invalidateTile(x, y);
+    return true;
 }
 
-bool Map::isWalkable(int x, int y) const {
-    if (!isInBounds(x, y)) return false;
-    if (!getTile(x, y).isWalkable()) return false;
-    if (hasNPCAt(Vec2{x, y})) return false;
+bool Map::isSpanWalkable(int y, int x0, int x1) const {
+    if (tileData_) return walkableMask_.allSetInRow(y, x0, x1, &npcMask_);
+    return isAreaWalkableByTile(std::min(x0, x1), y, std::abs(x1 - x0) + 1, 1);
+}
+
+bool Map::isAreaWalkable(int x, int y, int width, int height) const {
+    if (tileData_) return walkableMask_.allSetInRect(x, y, width, height, &npcMask_);
+    return isAreaWalkableByTile(x, y, width, height);
+}
+
+bool Map::isAreaWalkableByTile(int x, int y, int width, int height) const {
+    if (width <= 0 || height <= 0) return false;
+    for (int row = y; row < y + height; ++row) {
+        for (int col = x; col < x + width; ++col) {
+            if (!isWalkable(col, row)) return false;
+        }
+    }
     return true;
 }
 
-bool Map::isInBounds(int x, int y) const {
-    return x >= 0 && x < width_ && y >= 0 && y < height_;
+bool Map::hasLineOfSight(const Vec2& from, const Vec2& to) const {
+    if (tileData_) return walkableMask_.allSetOnLine(from.x, from.y, to.x, to.y);
+
+    // Streamed maps: tile by tile, offsets rounded like TileMask::allSetOnLine
+    if (!isInBounds(from.x, from.y) || !isInBounds(to.x, to.y)) return false;
+    int64_t dx = std::abs(to.x - from.x);
+    int64_t dy = std::abs(to.y - from.y);
+    int64_t steps = std::max<int64_t>(1, std::max(dx, dy));
+    int stepX = (to.x >= from.x) ? 1 : -1;
+    int stepY = (to.y >= from.y) ? 1 : -1;
+    for (int64_t s = 0; s <= std::max(dx, dy); ++s) {
+        int x = from.x + stepX * static_cast<int>((2 * s * dx + steps) / (2 * steps));
+        int y = from.y + stepY * static_cast<int>((2 * s * dy + steps) / (2 * steps));
+        if (!getTile(x, y).walkable) return false;
+    }
+    return true;
 }
 
 void Map::addTransition(const MapTransition& transition) {
+    const Vec2& pos = transition.triggerPos;
+    if (!triggerIndex_.isInBounds(pos.x, pos.y) ||
+        triggerIndex_.get(pos.x, pos.y) != OccupancyGrid::EMPTY) {
+        std::cerr << "Transition outside map or on a trigger tile ignored" << std::endl;
+        return;
+    }
+    triggerIndex_.set(pos.x, pos.y, static_cast<int32_t>(transitions_.size()));
     transitions_.push_back(transition);
 }
 
-std::optional<MapTransition> Map::getTransitionAt(const Vec2& pos) const {
-    for (const auto& transition : transitions_) {
-        if (transition.triggerPos == pos) {
-            return transition;
-        }
-    }
-    return std::nullopt;
+const MapTransition* Map::getTransitionAt(const Vec2& pos) const {
+    int32_t slot = triggerIndex_.get(pos.x, pos.y);
+    return slot == OccupancyGrid::EMPTY ? nullptr : &transitions_[slot];
 }
 
 // NPC management implementation
+void Map::addNPCPlacement(const NPCPlacement& placement) {
+    npcPlacements_.push_back(placement);
+}
+
 void Map::addNPCDefinition(const NPCDefinition& def) {
-    npcDefinitions_.push_back(def);
+    // Replace in place so indices held by spawned NPCs stay valid
+    int index = findDefinitionIndex(def.id);
+    if (index >= 0) {
+        npcDefinitions_[index] = def;
+    } else {
+        npcDefinitions_.push_back(def);
+    }
 }
 
 void Map::addNPC(const Vec2& pos, Direction facing, const std::string& definitionId) {
     int index = findDefinitionIndex(definitionId);
-    if (index >= 0) {
-        const NPCDefinition& def = npcDefinitions_[index];
-        npcs_.push_back(NPC{pos, facing, index, def.spriteRow, def.dialogue});
+    if (index < 0) return;
+
+    // Each NPC needs its own tile on the map to be indexed
+    if (!npcOccupancy_.isInBounds(pos.x, pos.y) || hasNPCAt(pos)) {
+        std::cerr << "NPC position outside map or occupied" << std::endl;
+        return;
     }
+
+    npcOccupancy_.set(pos.x, pos.y, static_cast<int32_t>(npcs_.size()));
+    npcMask_.set(pos.x, pos.y, true);
+    npcs_.add(pos, facing, index, npcDefinitions_[index].behavior);
 }
 
-bool Map::hasNPCAt(const Vec2& pos) const {
-    for (const auto& npc : npcs_) {
-        if (npc.getPosition() == pos) {
-            return true;
-        }
+bool Map::removeNPCAt(const Vec2& pos) {
+    int32_t slot = npcOccupancy_.get(pos.x, pos.y);
+    if (slot == OccupancyGrid::EMPTY) return false;
+    npcOccupancy_.clear(pos.x, pos.y);
+    npcMask_.set(pos.x, pos.y, false);
+
+    // The last NPC takes the freed slot so removal stays O(1); re-point its tile
+    npcs_.remove(slot);
+    if (static_cast<size_t>(slot) < npcs_.size()) {
+        npcOccupancy_.set(npcs_.getX(slot), npcs_.getY(slot), slot);
     }
-    return false;
+    return true;
 }
 
-const NPC* Map::getNPCAt(const Vec2& pos) const {
-    for (const auto& npc : npcs_) {
-        if (npc.getPosition() == pos) {
-            return &npc;
-        }
+bool Map::moveNPC(const Vec2& from, const Vec2& to) {
+    int32_t slot = npcOccupancy_.get(from.x, from.y);
+    if (slot == OccupancyGrid::EMPTY) return false;
+    if (!npcOccupancy_.isInBounds(to.x, to.y) || hasNPCAt(to)) return false;
+
+    relocateNPC(slot, from, to);
+    npcs_.moveTo(slot, to);
+    return true;
+}
+
+void Map::relocateNPC(int32_t slot, const Vec2& from, const Vec2& to) {
+    npcOccupancy_.clear(from.x, from.y);
+    npcOccupancy_.set(to.x, to.y, slot);
+    npcMask_.set(from.x, from.y, false);
+    npcMask_.set(to.x, to.y, true);
+}
+
+std::optional<NPC> Map::getNPCAt(const Vec2& pos) const {
+    int32_t slot = npcOccupancy_.get(pos.x, pos.y);
+    if (slot == OccupancyGrid::EMPTY) return std::nullopt;
+    int index = npcs_.getDefinitionIndex(slot);
+    const NPCDefinition& def = npcDefinitions_[index];
+    return NPC{npcs_.getPosition(slot), npcs_.getFacing(slot), index, def.spriteRow, def.dialogue};
+}
+
+void Map::updateNPCFacing(const Vec2& npcPos, const Vec2& playerPos) {
+    std::optional<NPC> npc = getNPCAt(npcPos);
+    if (npc) {
+        npcs_.setFacing(npcOccupancy_.get(npcPos.x, npcPos.y), npc->faceToward(playerPos).getFacing());
     }
-    return nullptr;
 }
 
-NPC* Map::getNPCAt(const Vec2& pos) {
-    for (auto& npc : npcs_) {
-        if (npc.getPosition() == pos) {
-            return &npc;
+bool Map::setNPCBehavior(const Vec2& pos, NPCBehavior behavior) {
+    int32_t slot = npcOccupancy_.get(pos.x, pos.y);
+    if (slot == OccupancyGrid::EMPTY) return false;
+    npcs_.setBehavior(slot, behavior);
+    return true;
+}
+
+bool Map::setNPCPatrolRoute(const Vec2& pos, const std::vector<Vec2>& waypoints) {
+    int32_t slot = npcOccupancy_.get(pos.x, pos.y);
+    if (slot == OccupancyGrid::EMPTY) return false;
+    npcs_.setBehavior(slot, NPCBehavior::Patrol);
+    npcs_.setPatrolRoute(slot, waypoints);
+    return true;
+}
+
+void Map::updateNPCs(const Vec2& playerPos, const Vec2& playerTarget, int budget) {
+    npcs_.advanceSteps();
+    npcSteps_.clear();
+    npcs_.think(budget, playerPos, npcSteps_);
+
+    for (const auto& step : npcSteps_) {
+        Vec2 from = npcs_.getPosition(step.index);
+        Vec2 to = from.add(directionToOffset(step.dir));
+        npcs_.setFacing(step.index, step.dir);
+        if (!isWalkable(to.x, to.y) || to.equals(playerPos) || to.equals(playerTarget) ||
+            getTransitionAt(to)) {
+            continue;
         }
+        relocateNPC(step.index, from, to);
+        npcs_.walk(step.index, step.dir);
     }
-    return nullptr;
 }
 
-void Map::updateNPCFacing(const Vec2& npcPos, const Vec2& playerPos) {
-    for (size_t i = 0; i < npcs_.size(); ++i) {
-        if (npcs_[i].getPosition() == npcPos) {
-            npcs_[i] = npcs_[i].faceToward(playerPos);
-            break;
+void Map::rebuildIndexes() {
+    tileRevision_ = nextTileRevision();
+
+    // Trigger layer: first transition on a tile wins
+    std::vector<MapTransition> transitions;
+    transitions.swap(transitions_);
+    triggerIndex_.reset(width_, height_);
+    for (const auto& transition : transitions) {
+        addTransition(transition);
+    }
+
+    // Walkability masks (streamed maps have no complete tile layer to pack)
+    walkableMask_.reset(0, 0);
+    npcMask_.reset(0, 0);
+    exploredMask_.reset(0, 0);
+    if (tileData_) {
+        walkableMask_.reset(width_, height_);
+        npcMask_.reset(width_, height_);
+        int words = walkableMask_.getWordsPerRow();
+        for (int y = 0; y < height_; ++y) {
+            const TileType* row = tileData_ + static_cast<size_t>(y) * width_;
+            for (int word = 0; word < words; ++word) {
+                int start = word * TileMask::WORD_BITS;
+                int count = std::min(TileMask::WORD_BITS, width_ - start);
+                uint64_t bits = 0;
+                for (int i = 0; i < count; ++i) {
+                    bits |= static_cast<uint64_t>(tileOf(row[start + i]).walkable) << i;
+                }
+                walkableMask_.setWord(y, word, bits);
+            }
         }
     }
+
+    // NPCs are spawned per layout (from its placements) after loading
+    npcs_.clear();
+    npcOccupancy_.reset(width_, height_);
 }
 
 int Map::findDefinitionIndex(const std::string& id) const {
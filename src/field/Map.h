@@ -1,17 +1,24 @@
 #ifndef MAP_H
 #define MAP_H
 
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
-#include <optional>
+#include "field/OccupancyGrid.h"
 #include "field/Tile.h"
+#include "field/TileLayerCache.h"
+#include "field/TileMask.h"
 #include "field/TileSet.h"
 #include "util/Vec2.h"
 #include "entity/NPC.h"
 #include "entity/NPCData.h"
+#include "entity/NPCSimulation.h"
 
 class Renderer;
 class ResourceManager;
+class MappedFile;
+class ChunkStreamer;
 
 // Map transition trigger
 struct MapTransition {
@@ -27,20 +34,109 @@ struct MapTransition {
 class Map {
 public:
     Map();
+    ~Map();
+
+    // Disable copy (tile data may point into a mapped file); moving is fine
+    Map(const Map&) = delete;
+    Map& operator=(const Map&) = delete;
+    Map(Map&&) noexcept;
+    Map& operator=(Map&&) noexcept;
+
+    // Load map by path: .rmap is loaded as binary; for .csv an up-to-date
+    // compiled .rmap next to it is preferred, otherwise the CSV is parsed
+    [[nodiscard]] bool load(const std::string& path);
 
     // Load map from CSV file
+    // Lines starting with '#' are directives or comments:
+    //   #spawn,x,y
+    //   #dark                  (see isDark)
+    //   #transition,x,y,targetMap,targetX,targetY
+    //   #npc,x,y,facing(up|down|left|right),definitionId
     [[nodiscard]] bool loadFromCSV(const std::string& path);
 
+    // Load map from binary .rmap file (memory-mapped, tile layer used in place)
+    [[nodiscard]] bool loadFromBinary(const std::string& path);
+
+    // Write map (tiles, spawn, transitions, NPC placements) as binary .rmap
+    // (not available for streamed maps)
+    [[nodiscard]] bool saveToBinary(const std::string& path) const;
+
+    // Write map in the CSV authoring format (directives first, then tile rows)
+    // (not available for streamed maps)
+    [[nodiscard]] bool saveToCSV(const std::string& path) const;
+
+    // Open a .rmap as a chunked streaming world: tiles are loaded in
+    // CHUNK_SIZE chunks around the focus on a background thread and far
+    // chunks are evicted under the memory budget. Map::load picks this mode
+    // for maps with at least STREAMING_MIN_TILES tiles.
+    [[nodiscard]] bool openStreaming(const std::string& path,
+                                     size_t memoryBudgetBytes = Constants::STREAMING_MEMORY_BUDGET);
+
+    // Streaming focus (no-ops for fully loaded maps)
+    void streamAround(const Vec2& tilePos);  // Request nearby chunks, evict far ones (per frame)
+    void loadAround(const Vec2& tilePos);    // Same, but blocks until nearby chunks are resident
+    [[nodiscard]] bool isStreaming() const { return streamer_ != nullptr; }
+
+    // Load map from an in-memory tile layer (row-major, width * height entries)
+    [[nodiscard]] bool loadFromTiles(int width, int height, std::vector<TileType> tiles);
+
     // Load tileset for rendering
     [[nodiscard]] bool loadTileSet(ResourceManager& resourceManager, const std::string& path);
 
-    // Render the map (visible portion based on camera)
+    // Render the map (visible portion based on camera). The tile layer is
+    // drawn from pre-rendered chunk textures when render targets are supported.
     void render(Renderer& renderer, int cameraX, int cameraY) const;
 
-    // Tile access
-    [[nodiscard]] const Tile& getTile(int x, int y) const;
-    [[nodiscard]] bool isWalkable(int x, int y) const;
-    [[nodiscard]] bool isInBounds(int x, int y) const;
+    // Drop pre-rendered chunks (e.g. after the renderer lost its render targets)
+    void invalidateRenderCache() { layerCache_.clear(); }
+
+    // Tile access (out-of-bounds and non-resident streamed tiles read as wall)
+    [[nodiscard]] const Tile& getTile(int x, int y) const { return tileOf(getTileType(x, y)); }
+    [[nodiscard]] TileType getTileType(int x, int y) const {
+        if (!isInBounds(x, y)) return TileType::Wall;
+        if (tileData_) return tileData_[static_cast<size_t>(y) * width_ + x];
+        return getStreamedTileType(x, y);
+    }
+    [[nodiscard]] bool isWalkable(int x, int y) const {
+        // Fully loaded maps: one bounds check, then a bit of each mask (same
+        // size), combined without a branch since terrain bits are unpredictable
+        if (tileData_) {
+            return walkableMask_.isInBounds(x, y) &&
+                   (walkableMask_.testInBounds(x, y) & !npcMask_.testInBounds(x, y));
+        }
+        return tileOf(getTileType(x, y)).walkable && npcOccupancy_.get(x, y) == OccupancyGrid::EMPTY;
+    }
+
+    // Bulk walkability (terrain and NPCs; out-of-bounds tiles are not walkable).
+    // Fully loaded maps answer from the walkability masks 64 tiles per word.
+    [[nodiscard]] bool isSpanWalkable(int y, int x0, int x1) const;             // Tiles x0..x1 of row y
+    [[nodiscard]] bool isAreaWalkable(int x, int y, int width, int height) const;
+
+    // Every tile on the straight line between two tiles (ends included) has
+    // walkable terrain; NPCs do not block the line
+    [[nodiscard]] bool hasLineOfSight(const Vec2& from, const Vec2& to) const;
+
+    // Packed walkability of the tile layer and of tiles holding an NPC, one
+    // bit per tile (empty for streamed maps)
+    [[nodiscard]] const TileMask& getWalkableMask() const { return walkableMask_; }
+    [[nodiscard]] const TileMask& getNPCMask() const { return npcMask_; }
+
+    // Tiles the player has seen (fog of war); empty until a field of view
+    // sizes it, cleared whenever a new layout is loaded
+    [[nodiscard]] const TileMask& getExploredMask() const { return exploredMask_; }
+    [[nodiscard]] TileMask& getExploredMask() { return exploredMask_; }
+    // Change a tile at runtime (fully loaded maps only; a mapped .rmap is copied first)
+    [[nodiscard]] bool setTile(int x, int y, TileType type);
+
+    // Changes whenever the tile layer changes (load or setTile); unique across
+    // maps, so derived data (e.g. pathfinding regions) can tell when to rebuild
+    [[nodiscard]] uint64_t getTileRevision() const { return tileRevision_; }
+
+    [[nodiscard]] bool isInBounds(int x, int y) const {
+        // Unsigned compare covers negative coordinates in one test
+        return static_cast<unsigned>(x) < static_cast<unsigned>(width_) &&
+               static_cast<unsigned>(y) < static_cast<unsigned>(height_);
+    }
 
     // Map dimensions
     [[nodiscard]] int getWidth() const { return width_; }
@@ -48,40 +144,124 @@ public:
     [[nodiscard]] int getPixelWidth() const { return width_ * Constants::TILE_SIZE; }
     [[nodiscard]] int getPixelHeight() const { return height_ * Constants::TILE_SIZE; }
 
-    // Transitions
+    // Transitions (trigger layer: tile -> transitions_ slot, O(1) lookup).
+    // At most one transition per tile; the returned pointer is valid until
+    // the next load, so copy what is needed before loading the target map.
     void addTransition(const MapTransition& transition);
-    [[nodiscard]] std::optional<MapTransition> getTransitionAt(const Vec2& pos) const;
+    [[nodiscard]] const std::vector<MapTransition>& getTransitions() const { return transitions_; }
+    [[nodiscard]] const MapTransition* getTransitionAt(const Vec2& pos) const;
 
     // Get spawn position
     [[nodiscard]] Vec2 getSpawnPosition() const { return Vec2{spawnX_, spawnY_}; }
     void setSpawnPosition(const Vec2& pos) { spawnX_ = pos.x; spawnY_ = pos.y; }
 
+    // Dark maps (dungeons) show only what the player can see
+    [[nodiscard]] bool isDark() const { return dark_; }
+    void setDark(bool dark) { dark_ = dark; }
+
     // NPC management
+    // NPC lookups by tile go through an occupancy grid, so they are O(1)
+    // regardless of NPC count. At most one NPC stands on a tile. Spawned NPCs
+    // belong to the loaded layout and are cleared by the next load; definitions
+    // are kept, and re-adding a definition ID replaces it (spawned NPCs share
+    // its dialogue).
     void addNPCDefinition(const NPCDefinition& def);
+    [[nodiscard]] const std::vector<NPCDefinition>& getNPCDefinitions() const { return npcDefinitions_; }
     void addNPC(const Vec2& pos, Direction facing, const std::string& definitionId);
-    [[nodiscard]] const std::vector<NPC>& getNPCs() const { return npcs_; }
-    [[nodiscard]] bool hasNPCAt(const Vec2& pos) const;
-    [[nodiscard]] const NPC* getNPCAt(const Vec2& pos) const;
-    [[nodiscard]] NPC* getNPCAt(const Vec2& pos);
+    [[nodiscard]] bool removeNPCAt(const Vec2& pos);
+    [[nodiscard]] bool moveNPC(const Vec2& from, const Vec2& to);  // Fails if target is occupied
+    [[nodiscard]] const NPCSimulation& getNPCs() const { return npcs_; }
+
+    // NPC placements from map data (spawn them with addNPC once definitions exist)
+    void addNPCPlacement(const NPCPlacement& placement);
+    [[nodiscard]] const std::vector<NPCPlacement>& getNPCPlacements() const { return npcPlacements_; }
+    [[nodiscard]] bool hasNPCAt(const Vec2& pos) const {
+        return npcOccupancy_.get(pos.x, pos.y) != OccupancyGrid::EMPTY;
+    }
+    [[nodiscard]] std::optional<NPC> getNPCAt(const Vec2& pos) const;
 
     // Update NPC to face toward player
     void updateNPCFacing(const Vec2& npcPos, const Vec2& playerPos);
 
+    // Override the behavior of one spawned NPC (its definition's by default)
+    [[nodiscard]] bool setNPCBehavior(const Vec2& pos, NPCBehavior behavior);
+    [[nodiscard]] bool setNPCPatrolRoute(const Vec2& pos, const std::vector<Vec2>& waypoints);
+
+    // One frame of NPC behavior: walking animations advance for everyone and
+    // up to budget NPCs choose a step. Steps onto blocked tiles, transition
+    // triggers or either tile of a walking player (the one being left and the
+    // one being entered) only turn the NPC.
+    void updateNPCs(const Vec2& playerPos, const Vec2& playerTarget, int budget = Constants::NPC_THINK_BUDGET);
+
+    // Same, for a player standing on playerPos
+    void updateNPCs(const Vec2& playerPos, int budget = Constants::NPC_THINK_BUDGET) {
+        updateNPCs(playerPos, playerPos, budget);
+    }
+
+    // Bytes used by the tile layer (resident chunks only when streaming)
+    [[nodiscard]] size_t getTileMemoryBytes() const;
+
+    // Approximate bytes held by the map: tiles, triggers, NPCs and placements
+    [[nodiscard]] size_t getMemoryBytes() const;
+
+    // Whether the tile layer is used in place from a memory-mapped .rmap
+    [[nodiscard]] bool isMemoryMapped() const { return mappedFile_ != nullptr; }
+
 private:
-    std::vector<Tile> tiles_;
+    // One byte per tile; properties come from TILE_TABLE.
+    // tileData_ points into tiles_ (CSV / in-memory) or into mappedFile_ (.rmap);
+    // it is null for streamed maps, whose tiles live in streamer_ chunks.
+    std::vector<TileType> tiles_;
+    std::unique_ptr<MappedFile> mappedFile_;
+    std::unique_ptr<ChunkStreamer> streamer_;
+    const TileType* tileData_;
     std::vector<MapTransition> transitions_;
+    OccupancyGrid triggerIndex_;  // Tile -> index into transitions_
+    TileMask walkableMask_;       // Terrain walkability, kept in sync with tileData_
+    std::vector<NPCPlacement> npcPlacements_;
     TileSet tileSet_;
+    mutable TileLayerCache layerCache_;  // Baked lazily while rendering
     int width_;
     int height_;
     int spawnX_;
     int spawnY_;
+    bool dark_;
+    uint64_t tileRevision_;
 
     // NPC data
     std::vector<NPCDefinition> npcDefinitions_;
-    std::vector<NPC> npcs_;
+    NPCSimulation npcs_;
+    std::vector<NPCSimulation::Step> npcSteps_;  // Scratch for updateNPCs
+    OccupancyGrid npcOccupancy_;  // Tile -> index into npcs_
+    TileMask npcMask_;            // Tiles holding an NPC (fully loaded maps only)
+    TileMask exploredMask_;       // Fog-of-war memory, sized on first use
+
+    // Clear tiles, transitions and placements before loading new map data
+    void resetLayout();
+
+    // Index triggers, build the walkability masks and clear NPCs (after a load)
+    void rebuildIndexes();
+
+    // Generic per-tile fallbacks for streamed maps (no masks)
+    [[nodiscard]] bool isAreaWalkableByTile(int x, int y, int width, int height) const;
+
+    // Load a .rmap whole or as a streaming world depending on its size
+    [[nodiscard]] bool loadBinary(const std::string& path);
+
+    // Streamed tile lookup (nullptr / wall when the chunk is not resident)
+    [[nodiscard]] const TileType* findStreamedTile(int x, int y) const;
+    [[nodiscard]] TileType getStreamedTileType(int x, int y) const;
+
+    // Tile layer drawing: one chunk texture, or tile by tile within a tile rect
+    [[nodiscard]] SDL_Texture* bakeChunk(Renderer& renderer, int chunkX, int chunkY) const;
+    void renderTiles(Renderer& renderer, int cameraX, int cameraY,
+                     int startX, int startY, int endX, int endY) const;
+
+    // Upper bound on transitions/NPC/string bytes read for a streamed map
+    static constexpr uint64_t MAX_STREAMED_OBJECT_BYTES = 16 * 1024 * 1024;
 
-    // Default tile for out-of-bounds
-    static const Tile defaultTile_;
+    // Move an NPC's occupancy from one tile to another (target checked by the caller)
+    void relocateNPC(int32_t slot, const Vec2& from, const Vec2& to);
 
     // Find NPC definition index by ID (-1 if not found)
     [[nodiscard]] int findDefinitionIndex(const std::string& id) const;
@@ -0,0 +1,174 @@
+#include "field/MapCache.h"
+#include <algorithm>
+#include <iostream>
+
+MapCache::MapCache(size_t budgetBytes, SetupHook setup)
+    : budgetBytes_(budgetBytes)
+    , useCounter_(0)
+    , setup_(std::move(setup))
+    , stopping_(false) {
+    worker_ = std::thread(&MapCache::workerLoop, this);
+}
+
+MapCache::~MapCache() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        requests_.clear();
+    }
+    wake_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+std::shared_ptr<Map> MapCache::acquire(const std::string& path) {
+    integrateLoaded();
+    if (Entry* entry = find(path)) {
+        entry->lastUsed = ++useCounter_;
+        return entry->map;
+    }
+
+    // Take the path off the prefetch queue, or wait if the worker is loading it
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        requests_.erase(std::remove(requests_.begin(), requests_.end(), path), requests_.end());
+        done_.wait(lock, [this, &path] { return loadingPath_ != path; });
+    }
+    integrateLoaded();
+    if (Entry* entry = find(path)) {
+        entry->lastUsed = ++useCounter_;
+        return entry->map;
+    }
+
+    auto map = std::make_unique<Map>();
+    if (!map->load(path)) {
+        return nullptr;
+    }
+    return insert(path, std::move(map));
+}
+
+void MapCache::prefetch(const std::vector<std::string>& paths) {
+    integrateLoaded();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        requests_.clear();
+        for (const auto& path : paths) {
+            bool queued = std::find(requests_.begin(), requests_.end(), path) != requests_.end();
+            if (!find(path) && path != loadingPath_ && !queued) {
+                requests_.push_back(path);
+            }
+        }
+    }
+    wake_.notify_one();
+}
+
+void MapCache::update() {
+    integrateLoaded();
+}
+
+void MapCache::waitForPrefetch() {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return requests_.empty() && loadingPath_.empty(); });
+    }
+    integrateLoaded();
+}
+
+void MapCache::forEachMap(const std::function<void(Map&)>& fn) {
+    for (auto& entry : entries_) {
+        fn(*entry.map);
+    }
+}
+
+bool MapCache::contains(const std::string& path) const {
+    return std::any_of(entries_.begin(), entries_.end(),
+                       [&path](const Entry& entry) { return entry.path == path; });
+}
+
+size_t MapCache::getCachedBytes() const {
+    size_t total = 0;
+    for (const auto& entry : entries_) {
+        total += entry.bytes;
+    }
+    return total;
+}
+
+void MapCache::workerLoop() {
+    while (true) {
+        std::string path;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stopping_ || !requests_.empty(); });
+            if (stopping_) return;
+            path = requests_.front();
+            requests_.pop_front();
+            loadingPath_ = path;
+        }
+
+        auto map = std::make_unique<Map>();
+        if (!map->load(path)) {
+            std::cerr << "Failed to prefetch map" << std::endl;
+            map.reset();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            loaded_.push_back(LoadedMap{path, std::move(map)});
+            loadingPath_.clear();
+        }
+        done_.notify_all();
+    }
+}
+
+void MapCache::integrateLoaded() {
+    std::vector<LoadedMap> loaded;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        loaded.swap(loaded_);
+    }
+
+    for (auto& result : loaded) {
+        if (result.map && !find(result.path)) {
+            insert(result.path, std::move(result.map));
+        }
+    }
+}
+
+std::shared_ptr<Map> MapCache::insert(const std::string& path, std::unique_ptr<Map> map) {
+    if (setup_) {
+        setup_(*map);
+    }
+    size_t bytes = map->getMemoryBytes();
+    std::shared_ptr<Map> shared(std::move(map));
+    entries_.push_back(Entry{path, shared, bytes, ++useCounter_});
+    evictOverBudget();
+    return shared;
+}
+
+void MapCache::evictOverBudget() {
+    size_t total = getCachedBytes();
+    while (total > budgetBytes_) {
+        // Least recently used map that nobody outside the cache still holds;
+        // the newest entry is kept so a single oversized map still loads
+        auto victim = entries_.end();
+        for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+            if (it->map.use_count() == 1 && it->lastUsed != useCounter_ &&
+                (victim == entries_.end() || it->lastUsed < victim->lastUsed)) {
+                victim = it;
+            }
+        }
+        if (victim == entries_.end()) return;
+        total -= victim->bytes;
+        entries_.erase(victim);
+    }
+}
+
+MapCache::Entry* MapCache::find(const std::string& path) {
+    for (auto& entry : entries_) {
+        if (entry.path == path) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
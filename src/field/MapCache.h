@@ -0,0 +1,91 @@
+#ifndef MAP_CACHE_H
+#define MAP_CACHE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "field/Map.h"
+#include "util/Constants.h"
+
+// Keeps recently used maps (tiles, triggers, spawned NPCs) in memory, so
+// walking back and forth through a door does not touch the disk again.
+//
+// Maps are kept in least-recently-used order under a byte budget; a map that
+// is still held outside the cache is never evicted. prefetch() loads maps on
+// a background thread; finished loads are adopted on the owning thread in
+// update() / acquire(), where the setup hook runs once per loaded map.
+class MapCache {
+public:
+    // Called once for every newly loaded map (e.g. to spawn NPCs)
+    using SetupHook = std::function<void(Map&)>;
+
+    explicit MapCache(size_t budgetBytes = Constants::MAP_CACHE_BUDGET, SetupHook setup = nullptr);
+    ~MapCache();
+
+    // Disable copy (owns a worker thread)
+    MapCache(const MapCache&) = delete;
+    MapCache& operator=(const MapCache&) = delete;
+
+    // Cached map for a path; loads it now if it is neither cached nor
+    // prefetched yet (waits for an in-flight prefetch). nullptr if loading fails.
+    [[nodiscard]] std::shared_ptr<Map> acquire(const std::string& path);
+
+    // Load maps that are not cached yet in the background (replaces queued requests)
+    void prefetch(const std::vector<std::string>& paths);
+
+    // Adopt finished prefetches. Call once per frame.
+    void update();
+
+    // Block until no prefetch is queued or running, then adopt the results
+    void waitForPrefetch();
+
+    // Apply to every cached map (e.g. invalidateRenderCache after a device reset)
+    void forEachMap(const std::function<void(Map&)>& fn);
+
+    [[nodiscard]] bool contains(const std::string& path) const;
+    [[nodiscard]] int getMapCount() const { return static_cast<int>(entries_.size()); }
+    [[nodiscard]] size_t getCachedBytes() const;
+
+private:
+    struct Entry {
+        std::string path;
+        std::shared_ptr<Map> map;
+        size_t bytes;
+        uint64_t lastUsed;
+    };
+
+    struct LoadedMap {
+        std::string path;
+        std::unique_ptr<Map> map;  // nullptr if loading failed
+    };
+
+    void workerLoop();
+    void integrateLoaded();
+    std::shared_ptr<Map> insert(const std::string& path, std::unique_ptr<Map> map);
+    void evictOverBudget();
+    [[nodiscard]] Entry* find(const std::string& path);
+
+    // Owner thread state
+    std::vector<Entry> entries_;
+    size_t budgetBytes_;
+    uint64_t useCounter_;
+    SetupHook setup_;
+
+    // Shared with worker (guarded by mutex_)
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::deque<std::string> requests_;
+    std::vector<LoadedMap> loaded_;
+    std::string loadingPath_;  // Empty when idle
+    bool stopping_;
+    std::thread worker_;
+};
+
+#endif // MAP_CACHE_H
@@ -0,0 +1,274 @@
+#include "field/MapFormat.h"
+#include "util/PathUtil.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace MapFormat {
+
+namespace {
+    // Check [offset, offset + length) lies inside a file of fileSize bytes
+    bool inRange(uint64_t offset, uint64_t length, uint64_t fileSize) {
+        return offset <= fileSize && length <= fileSize - offset;
+    }
+
+    bool inMap(int width, int height, int x, int y) {
+        return x >= 0 && x < width && y >= 0 && y < height;
+    }
+
+    // Check binary-provided facing value is a real direction
+    bool isValidFacing(uint32_t value) {
+        return value >= static_cast<uint32_t>(Direction::Up) &&
+               value <= static_cast<uint32_t>(Direction::Right);
+    }
+
+    uint64_t transitionBytes(const RMapHeader& header) {
+        return static_cast<uint64_t>(header.transitionCount) * sizeof(RMapTransition);
+    }
+
+    uint64_t npcBytes(const RMapHeader& header) {
+        return static_cast<uint64_t>(header.npcCount) * sizeof(RMapNPC);
+    }
+}
+
+bool isValidSpawn(int width, int height, int x, int y) {
+    return inMap(width, height, x, y);
+}
+
+bool isValidTransition(int width, int height, const MapTransition& transition) {
+    return inMap(width, height, transition.triggerPos.x, transition.triggerPos.y) &&
+           transition.targetPos.x >= 0 && transition.targetPos.y >= 0 &&
+           !transition.targetMap.empty() && transition.targetMap.size() <= MAX_STRING_LENGTH &&
+           PathUtil::isSafeRelativePath(transition.targetMap);
+}
+
+bool isValidPlacement(int width, int height, const NPCPlacement& placement) {
+    return inMap(width, height, placement.pos.x, placement.pos.y) &&
+           !placement.definitionId.empty() && placement.definitionId.size() <= MAX_STRING_LENGTH;
+}
+
+bool readHeader(const uint8_t* data, uint64_t fileSize, RMapHeader& out) {
+    RMapHeader header;
+    if (fileSize < sizeof(header)) {
+        std::cerr << "Binary map file is truncated" << std::endl;
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        header.version != VERSION || header.headerSize != sizeof(RMapHeader)) {
+        std::cerr << "Unsupported binary map format" << std::endl;
+        return false;
+    }
+    if (header.width == 0 || header.height == 0 ||
+        header.width > MAX_DIMENSION || header.height > MAX_DIMENSION) {
+        std::cerr << "Binary map dimensions out of range" << std::endl;
+        return false;
+    }
+
+    uint64_t tileCount = static_cast<uint64_t>(header.width) * header.height;
+    if (header.tileOffset < sizeof(RMapHeader) || !inRange(header.tileOffset, tileCount, fileSize)) {
+        std::cerr << "Binary map tile layer out of range" << std::endl;
+        return false;
+    }
+    // Dimensions are at most MAX_DIMENSION, so they fit in an int
+    if (!isValidSpawn(static_cast<int>(header.width), static_cast<int>(header.height),
+                      header.spawnX, header.spawnY)) {
+        std::cerr << "Binary map spawn point outside map" << std::endl;
+        return false;
+    }
+
+    // Object sections must follow the tile layer and lie inside the file
+    uint64_t tileEnd = header.tileOffset + tileCount;
+    if (header.transitionCount > MAX_TRANSITIONS || header.npcCount > MAX_NPCS ||
+        header.transitionOffset < tileEnd || header.npcOffset < tileEnd || header.stringOffset < tileEnd ||
+        !inRange(header.transitionOffset, transitionBytes(header), fileSize) ||
+        !inRange(header.npcOffset, npcBytes(header), fileSize) ||
+        !inRange(header.stringOffset, header.stringSize, fileSize)) {
+        std::cerr << "Binary map sections out of range" << std::endl;
+        return false;
+    }
+
+    out = header;
+    return true;
+}
+
+bool validateTiles(const uint8_t* tiles, uint64_t count) {
+    // Max reduction instead of an early-exit loop so the compiler can vectorize it
+    uint8_t maxId = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+        maxId = std::max(maxId, tiles[i]);
+    }
+    if (maxId > Constants::MAX_TILE_ID) {
+        std::cerr << "Tile ID out of range in binary map" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+uint64_t objectsBegin(const RMapHeader& header) {
+    return std::min({static_cast<uint64_t>(header.transitionOffset),
+                     static_cast<uint64_t>(header.npcOffset),
+                     static_cast<uint64_t>(header.stringOffset)});
+}
+
+uint64_t objectsEnd(const RMapHeader& header) {
+    return std::max({header.transitionOffset + transitionBytes(header),
+                     header.npcOffset + npcBytes(header),
+                     static_cast<uint64_t>(header.stringOffset) + header.stringSize});
+}
+
+bool readObjects(const RMapHeader& header, const uint8_t* region,
+                 std::vector<MapTransition>& transitions,
+                 std::vector<NPCPlacement>& placements) {
+    // Offsets are relative to the file; the region starts at objectsBegin
+    const uint64_t base = objectsBegin(header);
+    const int width = static_cast<int>(header.width);
+    const int height = static_cast<int>(header.height);
+    const uint8_t* strings = region + (header.stringOffset - base);
+
+    auto readString = [&header, strings](uint32_t offset, uint32_t length, std::string& out) {
+        if (length == 0 || length > MAX_STRING_LENGTH ||
+            offset > header.stringSize || length > header.stringSize - offset) {
+            return false;
+        }
+        out.assign(reinterpret_cast<const char*>(strings + offset), length);
+        return true;
+    };
+
+    transitions.clear();
+    transitions.reserve(header.transitionCount);
+    for (uint32_t i = 0; i < header.transitionCount; ++i) {
+        RMapTransition record;
+        std::memcpy(&record, region + (header.transitionOffset - base) + i * sizeof(record), sizeof(record));
+        std::string target;
+        if (!readString(record.targetMapOffset, record.targetMapLength, target)) {
+            std::cerr << "Invalid transition in binary map" << std::endl;
+            return false;
+        }
+        MapTransition transition(Vec2{record.triggerX, record.triggerY}, std::move(target),
+                                 Vec2{record.targetX, record.targetY});
+        if (!isValidTransition(width, height, transition)) {
+            std::cerr << "Invalid transition in binary map" << std::endl;
+            return false;
+        }
+        transitions.push_back(std::move(transition));
+    }
+
+    placements.clear();
+    placements.reserve(header.npcCount);
+    for (uint32_t i = 0; i < header.npcCount; ++i) {
+        RMapNPC record;
+        std::memcpy(&record, region + (header.npcOffset - base) + i * sizeof(record), sizeof(record));
+        std::string definitionId;
+        if (!isValidFacing(record.facing) ||
+            !readString(record.definitionIdOffset, record.definitionIdLength, definitionId)) {
+            std::cerr << "Invalid NPC placement in binary map" << std::endl;
+            return false;
+        }
+        NPCPlacement placement(Vec2{record.x, record.y}, static_cast<Direction>(record.facing),
+                               std::move(definitionId));
+        if (!isValidPlacement(width, height, placement)) {
+            std::cerr << "Invalid NPC placement in binary map" << std::endl;
+            return false;
+        }
+        placements.push_back(std::move(placement));
+    }
+
+    return true;
+}
+
+bool write(const std::string& path, int width, int height,
+           int spawnX, int spawnY, const TileType* tiles,
+           const std::vector<MapTransition>& transitions,
+           const std::vector<NPCPlacement>& placements, uint32_t flags) {
+    if (!tiles || width <= 0 || height <= 0) {
+        return false;
+    }
+
+    // Refuse to write a map the loader would reject
+    if (!isValidSpawn(width, height, spawnX, spawnY)) {
+        std::cerr << "Map spawn point outside map" << std::endl;
+        return false;
+    }
+    for (const auto& transition : transitions) {
+        if (!isValidTransition(width, height, transition)) {
+            std::cerr << "Invalid map transition" << std::endl;
+            return false;
+        }
+    }
+    for (const auto& placement : placements) {
+        if (!isValidPlacement(width, height, placement)) {
+            std::cerr << "Invalid NPC placement" << std::endl;
+            return false;
+        }
+    }
+
+    // String table (target maps and NPC definition IDs)
+    std::string strings;
+    auto addString = [&strings](const std::string& value, uint32_t& offset, uint32_t& length) {
+        offset = static_cast<uint32_t>(strings.size());
+        length = static_cast<uint32_t>(value.size());
+        strings += value;
+    };
+
+    std::vector<RMapTransition> transitionRecords;
+    for (const auto& transition : transitions) {
+        RMapTransition record{};
+        record.triggerX = transition.triggerPos.x;
+        record.triggerY = transition.triggerPos.y;
+        record.targetX = transition.targetPos.x;
+        record.targetY = transition.targetPos.y;
+        addString(transition.targetMap, record.targetMapOffset, record.targetMapLength);
+        transitionRecords.push_back(record);
+    }
+
+    std::vector<RMapNPC> npcRecords;
+    for (const auto& placement : placements) {
+        RMapNPC record{};
+        record.x = placement.pos.x;
+        record.y = placement.pos.y;
+        record.facing = static_cast<uint32_t>(placement.facing);
+        addString(placement.definitionId, record.definitionIdOffset, record.definitionIdLength);
+        npcRecords.push_back(record);
+    }
+
+    uint64_t tileCount = static_cast<uint64_t>(width) * height;
+
+    RMapHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.headerSize = sizeof(RMapHeader);
+    header.width = static_cast<uint32_t>(width);
+    header.height = static_cast<uint32_t>(height);
+    header.spawnX = spawnX;
+    header.spawnY = spawnY;
+    header.flags = flags;
+    header.tileOffset = sizeof(RMapHeader);
+    header.transitionOffset = static_cast<uint32_t>(header.tileOffset + tileCount);
+    header.transitionCount = static_cast<uint32_t>(transitionRecords.size());
+    header.npcOffset = header.transitionOffset +
+        header.transitionCount * static_cast<uint32_t>(sizeof(RMapTransition));
+    header.npcCount = static_cast<uint32_t>(npcRecords.size());
+    header.stringOffset = header.npcOffset + header.npcCount * static_cast<uint32_t>(sizeof(RMapNPC));
+    header.stringSize = static_cast<uint32_t>(strings.size());
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open binary map for writing" << std::endl;
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(tiles), static_cast<std::streamsize>(tileCount));
+    file.write(reinterpret_cast<const char*>(transitionRecords.data()),
+               static_cast<std::streamsize>(transitionRecords.size() * sizeof(RMapTransition)));
+    file.write(reinterpret_cast<const char*>(npcRecords.data()),
+               static_cast<std::streamsize>(npcRecords.size() * sizeof(RMapNPC)));
+    file.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+
+    return file.good();
+}
+
+}  // namespace MapFormat
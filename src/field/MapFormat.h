@@ -0,0 +1,102 @@
+#ifndef MAP_FORMAT_H
+#define MAP_FORMAT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "field/Map.h"
+
+// Binary map format (.rmap)
+//
+// Produced offline from CSV maps by the csv2rmap tool (`make maps`) and
+// memory-mapped by Map::loadFromBinary. The tile layer is used in place.
+//
+// Layout (host byte order, little-endian on all supported targets):
+//   RMapHeader
+//   tile layer     width * height bytes, one TileType per tile, row-major
+//   transitions    transitionCount * RMapTransition
+//   NPCs           npcCount * RMapNPC
+//   string table   UTF-8 bytes referenced by (offset, length) pairs
+namespace MapFormat {
+    constexpr char MAGIC[4] = {'R', 'M', 'A', 'P'};
+    constexpr uint16_t VERSION = 2;  // 2: header flags
+
+    // Limits enforced when loading (guards against corrupted files)
+    constexpr uint32_t MAX_DIMENSION = 16384;
+    constexpr uint32_t MAX_TRANSITIONS = 65536;
+    constexpr uint32_t MAX_NPCS = 65536;
+    constexpr uint32_t MAX_STRING_LENGTH = 256;
+
+    // RMapHeader::flags
+    constexpr uint32_t FLAG_DARK = 1u << 0;  // Shown through field of view only (see Map::isDark)
+
+    struct RMapHeader {
+        char magic[4];
+        uint16_t version;
+        uint16_t headerSize;        // sizeof(RMapHeader), for forward compatibility
+        uint32_t width;
+        uint32_t height;
+        int32_t spawnX;
+        int32_t spawnY;
+        uint32_t tileOffset;
+        uint32_t transitionOffset;
+        uint32_t transitionCount;
+        uint32_t npcOffset;
+        uint32_t npcCount;
+        uint32_t stringOffset;
+        uint32_t stringSize;
+        uint32_t flags;             // FLAG_* bits
+    };
+
+    struct RMapTransition {
+        int32_t triggerX;
+        int32_t triggerY;
+        int32_t targetX;
+        int32_t targetY;
+        uint32_t targetMapOffset;   // Into string table
+        uint32_t targetMapLength;
+    };
+
+    struct RMapNPC {
+        int32_t x;
+        int32_t y;
+        uint32_t facing;            // Direction value
+        uint32_t definitionIdOffset;  // Into string table
+        uint32_t definitionIdLength;
+    };
+
+    static_assert(sizeof(RMapHeader) == 56, "RMapHeader layout must not change within a version");
+    static_assert(sizeof(RMapTransition) == 24, "RMapTransition layout must not change within a version");
+    static_assert(sizeof(RMapNPC) == 20, "RMapNPC layout must not change within a version");
+
+    // Object checks shared by the CSV and binary loaders (and write), so a map
+    // one of them accepts is accepted by the other
+    [[nodiscard]] bool isValidSpawn(int width, int height, int x, int y);
+    [[nodiscard]] bool isValidTransition(int width, int height, const MapTransition& transition);
+    [[nodiscard]] bool isValidPlacement(int width, int height, const NPCPlacement& placement);
+
+    // Read and validate the header of a file of fileSize bytes
+    // (magic, version, dimensions, spawn point, and that every section lies inside the file)
+    [[nodiscard]] bool readHeader(const uint8_t* data, uint64_t fileSize, RMapHeader& out);
+
+    // Check a block of tile bytes holds only valid TileType IDs
+    [[nodiscard]] bool validateTiles(const uint8_t* tiles, uint64_t count);
+
+    // File range holding transitions, NPCs and strings (everything after the tile layer)
+    [[nodiscard]] uint64_t objectsBegin(const RMapHeader& header);
+    [[nodiscard]] uint64_t objectsEnd(const RMapHeader& header);
+
+    // Decode transitions and NPC placements. region holds the file bytes
+    // starting at objectsBegin(header) and ending at objectsEnd(header).
+    [[nodiscard]] bool readObjects(const RMapHeader& header, const uint8_t* region,
+                                   std::vector<MapTransition>& transitions,
+                                   std::vector<NPCPlacement>& placements);
+
+    // Write a complete .rmap file
+    [[nodiscard]] bool write(const std::string& path, int width, int height,
+                             int spawnX, int spawnY, const TileType* tiles,
+                             const std::vector<MapTransition>& transitions,
+                             const std::vector<NPCPlacement>& placements, uint32_t flags = 0);
+}
+
+#endif // MAP_FORMAT_H
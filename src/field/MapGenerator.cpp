@@ -0,0 +1,403 @@
+#include "field/MapGenerator.h"
+#include "field/Map.h"
+#include "field/MapFormat.h"
+#include "util/PathUtil.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+static_assert(MapGenerator::MAX_SIZE == static_cast<int>(MapFormat::MAX_DIMENSION),
+              "Generated maps must fit the .rmap format");
+
+namespace {
+    constexpr int BLOCK_SIZE = 32;  // Overworld block, one road crossing each
+    constexpr int CELL_SIZE = 16;   // Dungeon cell, one room each
+    constexpr int NOISE_CELL = 8;   // Value noise lattice spacing
+
+    // Salts so each decision draws independent values for the same coordinates
+    constexpr uint32_t SALT_TERRAIN = 0x1B873593u;
+    constexpr uint32_t SALT_BIOME = 0x68E31DA4u;
+    constexpr uint32_t SALT_FEATURE = 0xB5297A4Du;
+    constexpr uint32_t SALT_ROOM = 0x1B56C4E9u;
+
+    enum class Biome { Plains, Forest, Highlands, Lake };
+    enum class Theme { Hall, Cave, Garden, Flooded };
+    constexpr int KIND_COUNT = 4;  // Biomes and themes each
+
+    // Stateless coordinate hash (murmur-style finalizer)
+    uint32_t hash(uint32_t seed, int x, int y) {
+        uint32_t h = seed ^ (static_cast<uint32_t>(x) * 0x9E3779B1u)
+                          ^ (static_cast<uint32_t>(y) * 0x85EBCA77u);
+        h ^= h >> 16;
+        h *= 0x7FEB352Du;
+        h ^= h >> 15;
+        h *= 0x846CA68Bu;
+        h ^= h >> 16;
+        return h;
+    }
+
+    // Value noise in [0, 255]: hashed lattice values, bilinear in between
+    int valueNoise(uint32_t seed, int x, int y) {
+        int cx = x / NOISE_CELL;
+        int cy = y / NOISE_CELL;
+        int fx = x % NOISE_CELL;
+        int fy = y % NOISE_CELL;
+        int top = static_cast<int>(hash(seed, cx, cy) & 255) * (NOISE_CELL - fx) +
+                  static_cast<int>(hash(seed, cx + 1, cy) & 255) * fx;
+        int bottom = static_cast<int>(hash(seed, cx, cy + 1) & 255) * (NOISE_CELL - fx) +
+                     static_cast<int>(hash(seed, cx + 1, cy + 1) & 255) * fx;
+        return (top * (NOISE_CELL - fy) + bottom * fy) / (NOISE_CELL * NOISE_CELL);
+    }
+
+    // Pick one of KIND_COUNT kinds for a block or room. The first KIND_COUNT
+    // indices cycle through all kinds, so even the smallest map has each one.
+    int pickKind(uint32_t seed, uint32_t salt, int index, int x, int y) {
+        if (index < KIND_COUNT) {
+            return static_cast<int>((static_cast<uint32_t>(index) + seed) % KIND_COUNT);
+        }
+        return static_cast<int>(hash(seed ^ salt, x, y) % KIND_COUNT);
+    }
+
+    // Map under construction
+    struct Layout {
+        const MapGenerator::Config& config;
+        int width;
+        int height;
+        std::vector<TileType> tiles;
+        std::vector<MapTransition> transitions;
+        std::vector<NPCPlacement> placements;
+        int spawnX;
+        int spawnY;
+
+        explicit Layout(const MapGenerator::Config& c)
+            : config(c)
+            , width(c.width)
+            , height(c.height)
+            , tiles(static_cast<size_t>(c.width) * c.height, TileType::Grass)
+            , spawnX(0)
+            , spawnY(0) {}
+
+        TileType& at(int x, int y) { return tiles[static_cast<size_t>(y) * width + x]; }
+
+        // Stairs with a transition to the linked map (up to the format limit)
+        void addStairs(int x, int y) {
+            if (transitions.size() >= MapFormat::MAX_TRANSITIONS) return;
+            at(x, y) = TileType::Stairs;
+            transitions.emplace_back(Vec2{x, y}, config.linkMap, Vec2{config.linkX, config.linkY});
+        }
+
+        // NPC on a tile, which is made walkable (up to the format limit)
+        void addNPC(int x, int y, TileType ground, Direction facing, const char* definitionId) {
+            if (placements.size() >= MapFormat::MAX_NPCS) return;
+            at(x, y) = ground;
+            placements.emplace_back(Vec2{x, y}, facing, definitionId);
+        }
+    };
+
+    // --- Overworld ---
+
+    TileType terrainTile(Biome biome, int noise, int distance) {
+        switch (biome) {
+            case Biome::Forest:
+                return noise > 100 ? TileType::Tree : TileType::Grass;
+            case Biome::Highlands:
+                return noise > 120 ? TileType::Mountain : TileType::Grass;
+            case Biome::Lake: {
+                // Noisy diamond around the block center, always water in the middle
+                int height = noise / 2 + 255 - distance * 16;
+                if (height > 200) return TileType::Water;
+                if (height > 160) return TileType::Sand;
+                return noise > 215 ? TileType::Tree : TileType::Grass;
+            }
+            default:
+                return noise > 215 ? TileType::Tree : TileType::Grass;
+        }
+    }
+
+    // House south-east of a road crossing: door faces the road, villagers inside and out
+    void placeHouse(Layout& layout, int cx, int cy) {
+        const int left = cx + 3;
+        const int top = cy + 3;
+        const int width = 6;
+        const int height = 5;
+        for (int y = top; y < top + height; ++y) {
+            for (int x = left; x < left + width; ++x) {
+                bool edge = x == left || x == left + width - 1 || y == top || y == top + height - 1;
+                layout.at(x, y) = edge ? TileType::Wall : TileType::Floor;
+            }
+        }
+        layout.at(left + 2, top) = TileType::Door;
+        layout.at(left + 2, top - 1) = TileType::Grass;  // Step between road and door
+        layout.addNPC(left + 3, top + 2, TileType::Floor, Direction::Down, "villager");
+        layout.addNPC(cx + 2, cy + 2, TileType::Grass, Direction::Left, "villager");
+    }
+
+    // Stairs in a rock face north-west of a road crossing, with a guard beside the road
+    void placeEntrance(Layout& layout, int cx, int cy) {
+        layout.at(cx - 2, cy - 4) = TileType::Mountain;
+        layout.at(cx - 1, cy - 4) = TileType::Mountain;
+        layout.at(cx - 2, cy - 3) = TileType::Mountain;
+        layout.at(cx - 2, cy - 2) = TileType::Mountain;
+        layout.addStairs(cx - 1, cy - 3);
+        layout.addNPC(cx - 1, cy - 2, TileType::Grass, Direction::Right, "guard");
+    }
+
+    void buildOverworld(Layout& layout) {
+        const uint32_t seed = layout.config.seed;
+        const int blocksX = (layout.width + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        const int blocksY = (layout.height + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        const int fullX = layout.width / BLOCK_SIZE;  // Blocks with a complete road crossing
+        const int fullY = layout.height / BLOCK_SIZE;
+        const int half = BLOCK_SIZE / 2;
+
+        std::vector<Biome> biomes(static_cast<size_t>(blocksX) * blocksY);
+        for (int by = 0; by < blocksY; ++by) {
+            for (int bx = 0; bx < blocksX; ++bx) {
+                int index = (bx < fullX && by < fullY) ? by * fullX + bx : KIND_COUNT;
+                biomes[static_cast<size_t>(by) * blocksX + bx] =
+                    static_cast<Biome>(pickKind(seed, SALT_BIOME, index, bx, by));
+            }
+        }
+
+        // Terrain
+        for (int y = 0; y < layout.height; ++y) {
+            int by = y / BLOCK_SIZE;
+            int dy = std::abs(y % BLOCK_SIZE - half);
+            for (int x = 0; x < layout.width; ++x) {
+                int bx = x / BLOCK_SIZE;
+                int distance = std::abs(x % BLOCK_SIZE - half) + dy;
+                Biome biome = biomes[static_cast<size_t>(by) * blocksX + bx];
+                layout.at(x, y) = terrainTile(biome, valueNoise(seed ^ SALT_TERRAIN, x, y), distance);
+            }
+        }
+
+        // Two-tile roads through every block center that fits on the map
+        for (int road = half; road + 1 < layout.width; road += BLOCK_SIZE) {
+            for (int y = 0; y < layout.height; ++y) {
+                for (int x = road; x <= road + 1; ++x) {
+                    layout.at(x, y) = layout.at(x, y) == TileType::Water ? TileType::Bridge : TileType::Floor;
+                }
+            }
+        }
+        for (int road = half; road + 1 < layout.height; road += BLOCK_SIZE) {
+            for (int y = road; y <= road + 1; ++y) {
+                for (int x = 0; x < layout.width; ++x) {
+                    TileType& tile = layout.at(x, y);
+                    if (tile != TileType::Bridge) {
+                        tile = tile == TileType::Water ? TileType::Bridge : TileType::Floor;
+                    }
+                }
+            }
+        }
+
+        // Houses and dungeon entrances; the first two blocks always get one of each
+        for (int by = 0; by < fullY; ++by) {
+            for (int bx = 0; bx < fullX; ++bx) {
+                int index = by * fullX + bx;
+                uint32_t roll = hash(seed ^ SALT_FEATURE, bx, by) % 16;
+                int cx = bx * BLOCK_SIZE + half;
+                int cy = by * BLOCK_SIZE + half;
+                if (index == 0 || (index > 1 && roll == 0)) {
+                    placeHouse(layout, cx, cy);
+                } else if (index == 1 || roll == 1) {
+                    placeEntrance(layout, cx, cy);
+                }
+            }
+        }
+
+        layout.spawnX = half;
+        layout.spawnY = half;
+    }
+
+    // --- Dungeon ---
+
+    struct Room {
+        int left;
+        int top;
+        int width;
+        int height;
+
+        int centerX() const { return left + width / 2; }
+        int centerY() const { return top + height / 2; }
+        bool isEdge(int x, int y) const {
+            return x == left || y == top || x == left + width - 1 || y == top + height - 1;
+        }
+    };
+
+    // Room floor; obstacles only inside the outer ring, so the ring always connects
+    void fillRoom(Layout& layout, const Room& room, Theme theme) {
+        const uint32_t seed = layout.config.seed ^ SALT_TERRAIN;
+        for (int y = room.top; y < room.top + room.height; ++y) {
+            for (int x = room.left; x < room.left + room.width; ++x) {
+                bool inner = !room.isEdge(x, y);
+                int dx = x - room.left;
+                int dy = y - room.top;
+                TileType tile = TileType::Floor;
+                switch (theme) {
+                    case Theme::Cave:
+                        tile = (inner && dx % 2 == 0 && dy % 2 == 0) ? TileType::Mountain : TileType::Sand;
+                        break;
+                    case Theme::Garden:
+                        tile = (inner && ((dx == 2 && dy == 2) || hash(seed, x, y) % 3 == 0))
+                            ? TileType::Tree : TileType::Grass;
+                        break;
+                    case Theme::Flooded:
+                        tile = inner ? TileType::Water : TileType::Floor;
+                        break;
+                    default:
+                        break;
+                }
+                layout.at(x, y) = tile;
+            }
+        }
+    }
+
+    // Corridor step: bridges over water, dug through walls and obstacles
+    void carve(TileType& tile) {
+        if (tile == TileType::Water) {
+            tile = TileType::Bridge;
+        } else if (!tileOf(tile).walkable) {
+            tile = TileType::Floor;
+        }
+    }
+
+    // L-shaped corridor between room centers (horizontal first), with a door
+    // on the first wall tile it digs through
+    void carveCorridor(Layout& layout, const Room& from, const Room& to) {
+        int x = from.centerX();
+        int y = from.centerY();
+        bool doorPlaced = false;
+        auto step = [&layout, &doorPlaced](int tx, int ty) {
+            TileType& tile = layout.at(tx, ty);
+            if (!doorPlaced && tile == TileType::Wall) {
+                tile = TileType::Door;
+                doorPlaced = true;
+            } else {
+                carve(tile);
+            }
+        };
+
+        step(x, y);
+        while (x != to.centerX()) {
+            x += (to.centerX() > x) ? 1 : -1;
+            step(x, y);
+        }
+        while (y != to.centerY()) {
+            y += (to.centerY() > y) ? 1 : -1;
+            step(x, y);
+        }
+    }
+
+    // Ring corners that no corridor enters through, so an object placed there
+    // cannot block a passage (the rest of the ring goes around it)
+    int findQuietCorners(Layout& layout, const Room& room, int out[4][2]) {
+        const int right = room.left + room.width - 1;
+        const int bottom = room.top + room.height - 1;
+        const int corners[4][4] = {
+            {room.left, room.top, -1, -1},
+            {right, room.top, 1, -1},
+            {room.left, bottom, -1, 1},
+            {right, bottom, 1, 1}
+        };
+        int count = 0;
+        for (const auto& corner : corners) {
+            int x = corner[0];
+            int y = corner[1];
+            if (layout.at(x + corner[2], y) == TileType::Wall &&
+                layout.at(x, y + corner[3]) == TileType::Wall) {
+                out[count][0] = x;
+                out[count][1] = y;
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    void buildDungeon(Layout& layout) {
+        const uint32_t seed = layout.config.seed;
+        const int cellsX = layout.width / CELL_SIZE;
+        const int cellsY = layout.height / CELL_SIZE;
+        std::fill(layout.tiles.begin(), layout.tiles.end(), TileType::Wall);
+
+        // One room per cell with at least one wall tile to every cell border
+        std::vector<Room> rooms;
+        rooms.reserve(static_cast<size_t>(cellsX) * cellsY);
+        for (int cy = 0; cy < cellsY; ++cy) {
+            for (int cx = 0; cx < cellsX; ++cx) {
+                uint32_t roll = hash(seed ^ SALT_ROOM, cx, cy);
+                int width = 5 + static_cast<int>(roll & 7);
+                int height = 5 + static_cast<int>((roll >> 3) & 7);
+                int left = cx * CELL_SIZE + 1 + static_cast<int>((roll >> 6) % (CELL_SIZE - width - 1));
+                int top = cy * CELL_SIZE + 1 + static_cast<int>((roll >> 12) % (CELL_SIZE - height - 1));
+                rooms.push_back(Room{left, top, width, height});
+
+                int index = cy * cellsX + cx;
+                fillRoom(layout, rooms.back(), static_cast<Theme>(pickKind(seed, SALT_ROOM, index, cx, cy)));
+            }
+        }
+
+        for (int cy = 0; cy < cellsY; ++cy) {
+            for (int cx = 0; cx < cellsX; ++cx) {
+                const Room& room = rooms[static_cast<size_t>(cy) * cellsX + cx];
+                if (cx + 1 < cellsX) carveCorridor(layout, room, rooms[static_cast<size_t>(cy) * cellsX + cx + 1]);
+                if (cy + 1 < cellsY) carveCorridor(layout, room, rooms[static_cast<size_t>(cy + 1) * cellsX + cx]);
+            }
+        }
+
+        // Stairs and guards on quiet ring corners (the second room always has both)
+        for (size_t i = 0; i < rooms.size(); ++i) {
+            const Room& room = rooms[i];
+            uint32_t roll = hash(seed ^ SALT_FEATURE, room.left, room.top);
+            int corners[4][2];
+            int count = findQuietCorners(layout, room, corners);
+            int next = 0;
+            if (next < count && (i == 1 || roll % 32 == 0)) {
+                layout.addStairs(corners[next][0], corners[next][1]);
+                ++next;
+            }
+            if (next < count && (i == 1 || (roll >> 8) % 32 == 0)) {
+                TileType ground = layout.at(corners[next][0], corners[next][1]);
+                layout.addNPC(corners[next][0], corners[next][1], ground, Direction::Down, "guard");
+            }
+        }
+
+        // Corridors dig through the center of the first room
+        layout.spawnX = rooms[0].centerX();
+        layout.spawnY = rooms[0].centerY();
+    }
+}
+
+namespace MapGenerator {
+    bool generate(const Config& config, Map& out) {
+        if (config.width < MIN_SIZE || config.width > MAX_SIZE ||
+            config.height < MIN_SIZE || config.height > MAX_SIZE) {
+            std::cerr << "Generated map size out of range" << std::endl;
+            return false;
+        }
+        if (!PathUtil::isSafeRelativePath(config.linkMap)) {
+            std::cerr << "Invalid link map path for generated map" << std::endl;
+            return false;
+        }
+
+        Layout layout(config);
+        if (config.style == Style::Dungeon) {
+            buildDungeon(layout);
+        } else {
+            buildOverworld(layout);
+        }
+
+        if (!out.loadFromTiles(layout.width, layout.height, std::move(layout.tiles))) {
+            return false;
+        }
+        out.setSpawnPosition(Vec2{layout.spawnX, layout.spawnY});
+        out.setDark(config.style == Style::Dungeon);
+        for (const auto& transition : layout.transitions) {
+            out.addTransition(transition);
+        }
+        for (const auto& placement : layout.placements) {
+            out.addNPCPlacement(placement);
+        }
+        return true;
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef MAP_GENERATOR_H
+#define MAP_GENERATOR_H
+
+#include <cstdint>
+#include <string>
+
+class Map;
+
+// Seeded procedural maps for stress tests, benchmarks and large fixtures
+// (`mapgen` writes them as .csv or .rmap).
+//
+// The same config always produces the same map: the generator hashes tile
+// coordinates with its own integer hash instead of using <random>, so output
+// does not depend on the standard library. Every map contains all tile types,
+// NPC placements ("villager" / "guard" definitions) and transitions on Stairs
+// tiles, and the spawn point, NPC tiles and stairs are connected by walkable
+// tiles (NPCs stand beside roads and corridors, never on them).
+//
+// Overworld: blocks of 32x32 tiles, each with a biome (plains, forest,
+//   highlands, lake) and crossed by two-tile roads through its center;
+//   roads become bridges over water. Some blocks hold a house (walls,
+//   floor, door, villagers) or a dungeon entrance (stairs, guard).
+// Dungeon: one room per 16x16 cell on a wall background, joined to its
+//   right and lower neighbours by corridors with a door where they leave
+//   the room. Rooms are halls, sandy caves with rock pillars, overgrown
+//   gardens or flooded rooms crossed by bridges.
+namespace MapGenerator {
+    enum class Style {
+        Overworld,
+        Dungeon
+    };
+
+    // Side length limits (the upper one is MapFormat::MAX_DIMENSION)
+    constexpr int MIN_SIZE = 64;
+    constexpr int MAX_SIZE = 16384;
+
+    struct Config {
+        Style style = Style::Overworld;
+        int width = MIN_SIZE;
+        int height = MIN_SIZE;
+        uint32_t seed = 1;
+        std::string linkMap = "data/maps/world_01.csv";  // Target of every transition
+        int linkX = 9;                                    // Arrival tile in linkMap
+        int linkY = 10;
+    };
+
+    // Replace the map's layout with a generated one (definitions are kept).
+    // Fails for sizes outside [MIN_SIZE, MAX_SIZE] or an unsafe linkMap path.
+    [[nodiscard]] bool generate(const Config& config, Map& out);
+}
+
+#endif // MAP_GENERATOR_H
@@ -0,0 +1,39 @@
+#include "field/OccupancyGrid.h"
+#include <algorithm>
+
+OccupancyGrid::OccupancyGrid() : width_(0), height_(0), blocksX_(0) {}
+
+void OccupancyGrid::reset(int width, int height) {
+    width_ = std::max(0, width);
+    height_ = std::max(0, height);
+    blocksX_ = (width_ + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    int blocksY = (height_ + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    blocks_.clear();
+    blocks_.resize(static_cast<size_t>(blocksX_) * blocksY);
+}
+
+void OccupancyGrid::set(int x, int y, int32_t slot) {
+    if (!isInBounds(x, y)) return;
+    auto& block = blocks_[blockIndex(x, y)];
+    if (!block) {
+        block = std::make_unique<int32_t[]>(BLOCK_SIZE * BLOCK_SIZE);
+        std::fill(block.get(), block.get() + BLOCK_SIZE * BLOCK_SIZE, EMPTY);
+    }
+    block[cellIndex(x, y)] = slot;
+}
+
+void OccupancyGrid::clear(int x, int y) {
+    if (!isInBounds(x, y)) return;
+    auto& block = blocks_[blockIndex(x, y)];
+    if (block) {
+        block[cellIndex(x, y)] = EMPTY;
+    }
+}
+
+size_t OccupancyGrid::getMemoryBytes() const {
+    size_t bytes = blocks_.size() * sizeof(blocks_[0]);
+    for (const auto& block : blocks_) {
+        if (block) bytes += BLOCK_SIZE * BLOCK_SIZE * sizeof(int32_t);
+    }
+    return bytes;
+}
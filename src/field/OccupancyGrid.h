@@ -0,0 +1,63 @@
+#ifndef OCCUPANCY_GRID_H
+#define OCCUPANCY_GRID_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Maps tile positions to slots in a table (NPCs, triggers) for O(1)
+// "what is on this tile" queries.
+//
+// Cells are stored in BLOCK_SIZE x BLOCK_SIZE blocks that are allocated on
+// first use, so a huge streamed overworld with a few NPCs only pays for the
+// block table (one pointer per block) plus the blocks that hold entities.
+class OccupancyGrid {
+public:
+    static constexpr int32_t EMPTY = -1;
+    static constexpr int BLOCK_SIZE = 32;
+
+    OccupancyGrid();
+
+    // Disable copy (owns block storage); moving is fine
+    OccupancyGrid(const OccupancyGrid&) = delete;
+    OccupancyGrid& operator=(const OccupancyGrid&) = delete;
+    OccupancyGrid(OccupancyGrid&&) noexcept = default;
+    OccupancyGrid& operator=(OccupancyGrid&&) noexcept = default;
+
+    // Clear all cells and resize to a width x height tile area
+    void reset(int width, int height);
+
+    // Slot stored at a tile (EMPTY if none or out of bounds)
+    [[nodiscard]] int32_t get(int x, int y) const {
+        if (!isInBounds(x, y)) return EMPTY;
+        const int32_t* block = blocks_[blockIndex(x, y)].get();
+        return block ? block[cellIndex(x, y)] : EMPTY;
+    }
+
+    // Store / clear the slot at an in-bounds tile (out-of-bounds is ignored)
+    void set(int x, int y, int32_t slot);
+    void clear(int x, int y);
+
+    [[nodiscard]] bool isInBounds(int x, int y) const {
+        return static_cast<unsigned>(x) < static_cast<unsigned>(width_) &&
+               static_cast<unsigned>(y) < static_cast<unsigned>(height_);
+    }
+
+    // Bytes used by the block table and allocated blocks
+    [[nodiscard]] size_t getMemoryBytes() const;
+
+private:
+    [[nodiscard]] size_t blockIndex(int x, int y) const {
+        return static_cast<size_t>(y / BLOCK_SIZE) * blocksX_ + static_cast<size_t>(x / BLOCK_SIZE);
+    }
+    [[nodiscard]] static int cellIndex(int x, int y) {
+        return (y % BLOCK_SIZE) * BLOCK_SIZE + (x % BLOCK_SIZE);
+    }
+
+    std::vector<std::unique_ptr<int32_t[]>> blocks_;
+    int width_;
+    int height_;
+    int blocksX_;
+};
+
+#endif // OCCUPANCY_GRID_H
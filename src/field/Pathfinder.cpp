@@ -0,0 +1,294 @@
+#include "field/Pathfinder.h"
+#include "field/Map.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+    // Heap order: lowest f first; on ties prefer the deeper node (higher g)
+    struct OpenNodeOrder {
+        template <typename Node>
+        bool operator()(const Node& a, const Node& b) const {
+            return a.f > b.f || (a.f == b.f && a.g < b.g);
+        }
+    };
+
+    uint32_t manhattan(int ax, int ay, int bx, int by) {
+        return static_cast<uint32_t>(std::abs(ax - bx) + std::abs(ay - by));
+    }
+}
+
+Pathfinder::Pathfinder()
+    : map_(nullptr)
+    , walkable_(nullptr)
+    , npcs_(nullptr)
+    , revision_(0)
+    , width_(0)
+    , height_(0)
+    , wordsPerRow_(0)
+    , generation_(0)
+    , startIndex_(-1)
+    , goalIndex_(-1)
+    , startX_(-1)
+    , startY_(-1)
+    , goalX_(0)
+    , goalY_(0)
+    , expanded_(0) {}
+
+bool Pathfinder::findPath(const Map& map, const Vec2& start, const Vec2& goal,
+                          std::vector<Vec2>& path) {
+    path.clear();
+    expanded_ = 0;
+    if (!isReachable(map, start, goal)) return false;
+    if (start == goal) return true;
+    if (!map.isWalkable(goal.x, goal.y)) return false;  // Goal taken by an NPC
+
+    // New generation invalidates all per-tile state from earlier queries
+    if (++generation_ == 0) {
+        std::fill(openedGen_.begin(), openedGen_.end(), 0);
+        std::fill(closedGen_.begin(), closedGen_.end(), 0);
+        generation_ = 1;
+    }
+
+    startIndex_ = start.y * width_ + start.x;
+    startX_ = start.x;
+    startY_ = start.y;
+    goalIndex_ = goal.y * width_ + goal.x;
+    goalX_ = goal.x;
+    goalY_ = goal.y;
+
+    g_[startIndex_] = 0;
+    parent_[startIndex_] = -1;
+    openedGen_[startIndex_] = generation_;
+    open_.clear();
+    open_.push_back(OpenNode{manhattan(start.x, start.y, goal.x, goal.y), 0, startIndex_});
+
+    while (!open_.empty()) {
+        std::pop_heap(open_.begin(), open_.end(), OpenNodeOrder{});
+        OpenNode node = open_.back();
+        open_.pop_back();
+
+        // Skip stale heap entries (already expanded, or improved since pushed)
+        if (closedGen_[node.index] == generation_ || node.g != g_[node.index]) continue;
+        closedGen_[node.index] = generation_;
+        ++expanded_;
+
+        if (node.index == goalIndex_) {
+            buildPath(path);
+            return true;
+        }
+
+        int x = node.index % width_;
+        int y = node.index / width_;
+        int32_t parent = parent_[node.index];
+
+        if (parent < 0) {
+            // Start node: every direction is open
+            pushSuccessor(node.index, jumpHorizontal(x, y, 1), node.g);
+            pushSuccessor(node.index, jumpHorizontal(x, y, -1), node.g);
+            pushSuccessor(node.index, jumpVertical(x, y, 1), node.g);
+            pushSuccessor(node.index, jumpVertical(x, y, -1), node.g);
+        } else if (parent / width_ == y) {
+            // Horizontal: keep going, turn only around obstacle corners
+            int dx = (x > parent % width_) ? 1 : -1;
+            pushSuccessor(node.index, jumpHorizontal(x, y, dx), node.g);
+            if (isOpen(x, y - 1) && !isOpen(x - dx, y - 1)) {
+                pushSuccessor(node.index, jumpVertical(x, y, -1), node.g);
+            }
+            if (isOpen(x, y + 1) && !isOpen(x - dx, y + 1)) {
+                pushSuccessor(node.index, jumpVertical(x, y, 1), node.g);
+            }
+        } else {
+            // Vertical: keep going or branch sideways
+            int dy = (y > parent / width_) ? 1 : -1;
+            pushSuccessor(node.index, jumpVertical(x, y, dy), node.g);
+            pushSuccessor(node.index, jumpHorizontal(x, y, 1), node.g);
+            pushSuccessor(node.index, jumpHorizontal(x, y, -1), node.g);
+        }
+    }
+    return false;
+}
+
+bool Pathfinder::isReachable(const Map& map, const Vec2& start, const Vec2& goal) {
+    uint32_t startRegion = getRegion(map, start);
+    return startRegion != 0 && startRegion == getRegion(map, goal);
+}
+
+uint32_t Pathfinder::getRegion(const Map& map, const Vec2& pos) {
+    if (!prepare(map) || !map.isInBounds(pos.x, pos.y)) return 0;
+    return region_[static_cast<size_t>(pos.y) * width_ + pos.x];
+}
+
+bool Pathfinder::prepare(const Map& map) {
+    // Streamed worlds have no complete tile layer (or masks) to search
+    size_t tiles = static_cast<size_t>(map.getWidth()) * map.getHeight();
+    if (map.isStreaming() || tiles == 0 ||
+        tiles > static_cast<size_t>(Constants::PATHFINDING_MAX_TILES)) {
+        return false;
+    }
+    if (map_ == &map && revision_ == map.getTileRevision()) return true;
+
+    map_ = &map;
+    walkable_ = &map.getWalkableMask();
+    npcs_ = &map.getNPCMask();
+    revision_ = map.getTileRevision();
+    width_ = map.getWidth();
+    height_ = map.getHeight();
+    wordsPerRow_ = walkable_->getWordsPerRow();
+
+    // Stale generation stamps are harmless, so arenas only grow
+    if (openedGen_.size() < tiles) {
+        openedGen_.resize(tiles, 0);
+        closedGen_.resize(tiles, 0);
+        g_.resize(tiles, 0);
+        parent_.resize(tiles, -1);
+    }
+    labelRegions();
+    return true;
+}
+
+void Pathfinder::labelRegions() {
+    size_t tiles = static_cast<size_t>(width_) * height_;
+    region_.assign(tiles, 0);
+
+    // Flood fill over tile walkability only (NPCs move, tiles rarely change)
+    uint32_t label = 0;
+    for (size_t seed = 0; seed < tiles; ++seed) {
+        int seedX = static_cast<int>(seed % width_);
+        int seedY = static_cast<int>(seed / width_);
+        if (region_[seed] != 0 || !walkable_->test(seedX, seedY)) continue;
+
+        ++label;
+        region_[seed] = label;
+        scratch_.clear();
+        scratch_.push_back(static_cast<int32_t>(seed));
+        while (!scratch_.empty()) {
+            int32_t index = scratch_.back();
+            scratch_.pop_back();
+            int x = index % width_;
+            int y = index / width_;
+            const int offsets[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+            for (const auto& offset : offsets) {
+                int nx = x + offset[0];
+                int ny = y + offset[1];
+                if (!walkable_->test(nx, ny)) continue;
+                size_t next = static_cast<size_t>(ny) * width_ + nx;
+                if (region_[next] == 0) {
+                    region_[next] = label;
+                    scratch_.push_back(static_cast<int32_t>(next));
+                }
+            }
+        }
+    }
+}
+
+bool Pathfinder::isOpen(int x, int y) const {
+    // The start tile may hold the NPC that is planning the route
+    return map_->isWalkable(x, y) || (map_->isInBounds(x, y) && y * width_ + x == startIndex_);
+}
+
+uint64_t Pathfinder::openWord(int y, int word) const {
+    if (static_cast<unsigned>(y) >= static_cast<unsigned>(height_) ||
+        static_cast<unsigned>(word) >= static_cast<unsigned>(wordsPerRow_)) {
+        return 0;
+    }
+    uint64_t bits = walkable_->getRow(y)[word] & ~npcs_->getRow(y)[word];
+    if (y == startY_ && word == startX_ / TileMask::WORD_BITS) {
+        bits |= uint64_t{1} << (startX_ % TileMask::WORD_BITS);
+    }
+    return bits;
+}
+
+int32_t Pathfinder::jumpHorizontal(int x, int y, int dx) const {
+    // Word-parallel scan for the first stop: a blocked tile (-1), the goal, or
+    // a forced neighbour (open above/below where the tile one step back is not).
+    // Padding bits past the row end read as blocked.
+    const int bitsPerWord = TileMask::WORD_BITS;
+    int from = x + dx;
+    if (from < 0 || from >= width_) return -1;
+
+    for (int word = from / bitsPerWord; word >= 0 && word < wordsPerRow_; word += dx) {
+        uint64_t open = openWord(y, word);
+        uint64_t up = openWord(y - 1, word);
+        uint64_t down = openWord(y + 1, word);
+        uint64_t upBack;
+        uint64_t downBack;
+        if (dx > 0) {
+            upBack = (up << 1) | (openWord(y - 1, word - 1) >> (bitsPerWord - 1));
+            downBack = (down << 1) | (openWord(y + 1, word - 1) >> (bitsPerWord - 1));
+        } else {
+            upBack = (up >> 1) | (openWord(y - 1, word + 1) << (bitsPerWord - 1));
+            downBack = (down >> 1) | (openWord(y + 1, word + 1) << (bitsPerWord - 1));
+        }
+
+        uint64_t stops = ~open | (up & ~upBack) | (down & ~downBack);
+        if (y == goalY_ && word == goalX_ / bitsPerWord) {
+            stops |= uint64_t{1} << (goalX_ % bitsPerWord);
+        }
+        if (word == from / bitsPerWord) {
+            // Only tiles at or beyond the first step
+            int bit = from % bitsPerWord;
+            stops &= (dx > 0) ? (~uint64_t{0} << bit)
+                              : (~uint64_t{0} >> (bitsPerWord - 1 - bit));
+        }
+        if (stops == 0) continue;
+
+        int bit = (dx > 0) ? __builtin_ctzll(stops) : (bitsPerWord - 1 - __builtin_clzll(stops));
+        if (!((open >> bit) & 1u)) return -1;
+        return y * width_ + word * bitsPerWord + bit;
+    }
+    return -1;
+}
+
+int32_t Pathfinder::jumpVertical(int x, int y, int dy) const {
+    while (true) {
+        y += dy;
+        if (!isOpen(x, y)) return -1;
+        if (x == goalX_ && y == goalY_) return y * width_ + x;
+
+        // Stop where a sideways jump finds the goal or a corner
+        if (jumpHorizontal(x, y, 1) >= 0 || jumpHorizontal(x, y, -1) >= 0) {
+            return y * width_ + x;
+        }
+    }
+}
+
+void Pathfinder::pushSuccessor(int32_t from, int32_t to, uint32_t g) {
+    if (to < 0 || closedGen_[to] == generation_) return;
+
+    int fromX = from % width_;
+    int fromY = from / width_;
+    int toX = to % width_;
+    int toY = to / width_;
+    uint32_t newG = g + manhattan(fromX, fromY, toX, toY);
+    if (openedGen_[to] == generation_ && newG >= g_[to]) return;
+
+    openedGen_[to] = generation_;
+    g_[to] = newG;
+    parent_[to] = from;
+    open_.push_back(OpenNode{newG + manhattan(toX, toY, goalX_, goalY_), newG, to});
+    std::push_heap(open_.begin(), open_.end(), OpenNodeOrder{});
+}
+
+void Pathfinder::buildPath(std::vector<Vec2>& path) {
+    // Jump points from goal back to start
+    scratch_.clear();
+    for (int32_t index = goalIndex_; index >= 0; index = parent_[index]) {
+        scratch_.push_back(index);
+    }
+
+    // Expand the straight segments between jump points into single steps
+    path.reserve(g_[goalIndex_]);
+    for (size_t i = scratch_.size() - 1; i > 0; --i) {
+        int x = scratch_[i] % width_;
+        int y = scratch_[i] / width_;
+        int toX = scratch_[i - 1] % width_;
+        int toY = scratch_[i - 1] / width_;
+        int dx = (toX > x) - (toX < x);
+        int dy = (toY > y) - (toY < y);
+        while (x != toX || y != toY) {
+            x += dx;
+            y += dy;
+            path.push_back(Vec2{x, y});
+        }
+    }
+}
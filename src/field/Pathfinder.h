@@ -0,0 +1,100 @@
+#ifndef PATHFINDER_H
+#define PATHFINDER_H
+
+#include <cstdint>
+#include <vector>
+#include "util/Vec2.h"
+
+class Map;
+class TileMask;
+
+// 4-connected grid pathfinding over Map walkability.
+//
+// Searches use A* with jump-point pruning: horizontal moves run straight
+// until they hit a forced neighbour (an obstacle corner), vertical moves
+// stop where a horizontal jump would find something, so open areas cost a
+// handful of heap operations instead of one per tile. Horizontal jumps scan
+// the map's walkability masks 64 tiles per step.
+//
+// Per-tile search state lives in arrays sized to the map and tagged with a
+// query generation, so queries do not allocate or clear memory. Connected
+// regions of walkable tiles are labelled once per tile revision of the map;
+// goals in another region are rejected in O(1) without searching.
+//
+// NPCs count as obstacles during a search (except on the start tile, so an
+// NPC can plan its own route), but not for region labels: a goal in the same
+// region can still be cut off by NPCs.
+class Pathfinder {
+public:
+    Pathfinder();
+
+    // Disable copy (per-map search arenas can be large); moving is fine
+    Pathfinder(const Pathfinder&) = delete;
+    Pathfinder& operator=(const Pathfinder&) = delete;
+    Pathfinder(Pathfinder&&) noexcept = default;
+    Pathfinder& operator=(Pathfinder&&) noexcept = default;
+
+    // Shortest path from start to goal. On success path holds every step
+    // after start up to and including goal (empty when start == goal).
+    // Fails for unreachable goals and for streamed or oversized maps.
+    [[nodiscard]] bool findPath(const Map& map, const Vec2& start, const Vec2& goal,
+                                std::vector<Vec2>& path);
+
+    // O(1) check that both tiles lie in the same connected walkable region
+    [[nodiscard]] bool isReachable(const Map& map, const Vec2& start, const Vec2& goal);
+
+    // Region label of a tile (0 = not walkable or map unsupported)
+    [[nodiscard]] uint32_t getRegion(const Map& map, const Vec2& pos);
+
+    // Search statistics of the last findPath call
+    [[nodiscard]] int getExpandedNodes() const { return expanded_; }
+
+private:
+    struct OpenNode {
+        uint32_t f;
+        uint32_t g;
+        int32_t index;
+    };
+
+    // Bind to a map, rebuilding arenas and regions if its tiles changed
+    [[nodiscard]] bool prepare(const Map& map);
+    void labelRegions();
+
+    // Jump-point search helpers (indices are y * width + x, -1 = nothing found)
+    [[nodiscard]] bool isOpen(int x, int y) const;
+    [[nodiscard]] uint64_t openWord(int y, int word) const;  // isOpen for 64 tiles of a row
+    [[nodiscard]] int32_t jumpHorizontal(int x, int y, int dx) const;
+    [[nodiscard]] int32_t jumpVertical(int x, int y, int dy) const;
+    void pushSuccessor(int32_t from, int32_t to, uint32_t g);
+    void buildPath(std::vector<Vec2>& path);
+
+    // Bound map
+    const Map* map_;
+    const TileMask* walkable_;
+    const TileMask* npcs_;
+    uint64_t revision_;
+    int width_;
+    int height_;
+    int wordsPerRow_;
+    std::vector<uint32_t> region_;
+
+    // Search arena, reused across queries
+    std::vector<uint32_t> openedGen_;   // Generation in which a tile got a g value
+    std::vector<uint32_t> closedGen_;   // Generation in which a tile was expanded
+    std::vector<uint32_t> g_;
+    std::vector<int32_t> parent_;
+    std::vector<OpenNode> open_;
+    std::vector<int32_t> scratch_;      // Flood fill stack / jump points of a path
+    uint32_t generation_;
+
+    // Current query
+    int32_t startIndex_;
+    int32_t goalIndex_;
+    int startX_;
+    int startY_;
+    int goalX_;
+    int goalY_;
+    int expanded_;
+};
+
+#endif // PATHFINDER_H
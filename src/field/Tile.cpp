@@ -1,17 +1,14 @@
 #include "field/Tile.h"
 
+// TILE_TABLE must be ordered by TileType value
+static_assert(tileOf(TileType::Grass).type == TileType::Grass, "TILE_TABLE order");
+static_assert(tileOf(TileType::Wall).type == TileType::Wall, "TILE_TABLE order");
+static_assert(tileOf(TileType::Stairs).type == TileType::Stairs, "TILE_TABLE order");
+static_assert(sizeof(TileType) == 1, "Map stores one byte per tile");
+
 Tile Tile::fromId(int id) {
-    switch (static_cast<TileType>(id)) {
-        case TileType::Grass:    return grass();
-        case TileType::Water:    return water();
-        case TileType::Wall:     return wall();
-        case TileType::Floor:    return floor();
-        case TileType::Tree:     return tree();
-        case TileType::Mountain: return mountain();
-        case TileType::Sand:     return sand();
-        case TileType::Bridge:   return bridge();
-        case TileType::Door:     return door();
-        case TileType::Stairs:   return stairs();
-        default:                 return grass();  // Default to grass for unknown IDs
+    if (id < 0 || id >= TILE_TYPE_COUNT) {
+        return grass();  // Default to grass for unknown IDs
     }
+    return TILE_TABLE[id];
 }
@@ -1,8 +1,10 @@
 #ifndef TILE_H
 #define TILE_H
 
-// Tile types for the map
-enum class TileType : int {
+#include <cstdint>
+
+// Tile types for the map (1 byte so maps can store one TileType per cell)
+enum class TileType : uint8_t {
     Grass = 0,
     Water = 1,
     Wall = 2,
@@ -21,19 +23,21 @@ struct Tile {
     const bool walkable;
     const int textureX;  // X position in tileset (in tile units)
     const int textureY;  // Y position in tileset (in tile units)
+    const bool opaque;   // Blocks line of sight (field of view)
 
-    constexpr Tile(TileType t, bool w, int tx, int ty)
-        : type(t), walkable(w), textureX(tx), textureY(ty) {}
+    constexpr Tile(TileType t, bool w, int tx, int ty, bool o = false)
+        : type(t), walkable(w), textureX(tx), textureY(ty), opaque(o) {}
 
     [[nodiscard]] constexpr bool isWalkable() const { return walkable; }
+    [[nodiscard]] constexpr bool isOpaque() const { return opaque; }
 
     // Factory functions for common tiles
     [[nodiscard]] static constexpr Tile grass() { return Tile{TileType::Grass, true, 0, 0}; }
     [[nodiscard]] static constexpr Tile water() { return Tile{TileType::Water, false, 1, 0}; }
-    [[nodiscard]] static constexpr Tile wall() { return Tile{TileType::Wall, false, 2, 0}; }
+    [[nodiscard]] static constexpr Tile wall() { return Tile{TileType::Wall, false, 2, 0, true}; }
     [[nodiscard]] static constexpr Tile floor() { return Tile{TileType::Floor, true, 3, 0}; }
-    [[nodiscard]] static constexpr Tile tree() { return Tile{TileType::Tree, false, 0, 1}; }
-    [[nodiscard]] static constexpr Tile mountain() { return Tile{TileType::Mountain, false, 1, 1}; }
+    [[nodiscard]] static constexpr Tile tree() { return Tile{TileType::Tree, false, 0, 1, true}; }
+    [[nodiscard]] static constexpr Tile mountain() { return Tile{TileType::Mountain, false, 1, 1, true}; }
     [[nodiscard]] static constexpr Tile sand() { return Tile{TileType::Sand, true, 2, 1}; }
     [[nodiscard]] static constexpr Tile bridge() { return Tile{TileType::Bridge, true, 3, 1}; }
     [[nodiscard]] static constexpr Tile door() { return Tile{TileType::Door, true, 0, 2}; }
@@ -43,4 +47,27 @@ struct Tile {
     [[nodiscard]] static Tile fromId(int id);
 };
 
+// Number of tile types (TileType values are contiguous from 0)
+constexpr int TILE_TYPE_COUNT = 10;
+
+// Tile properties indexed by TileType. Maps store only the 1-byte TileType
+// per cell and resolve walkability / atlas coordinates through this table.
+inline constexpr Tile TILE_TABLE[TILE_TYPE_COUNT] = {
+    Tile::grass(),
+    Tile::water(),
+    Tile::wall(),
+    Tile::floor(),
+    Tile::tree(),
+    Tile::mountain(),
+    Tile::sand(),
+    Tile::bridge(),
+    Tile::door(),
+    Tile::stairs()
+};
+
+// Table lookup for a tile type (type must be a valid TileType)
+[[nodiscard]] inline constexpr const Tile& tileOf(TileType type) {
+    return TILE_TABLE[static_cast<int>(type)];
+}
+
 #endif // TILE_H
@@ -0,0 +1,74 @@
+#include "field/TileLayerCache.h"
+#include <utility>
+
+TileLayerCache::TileLayerCache() : frame_(0) {}
+
+TileLayerCache::~TileLayerCache() {
+    clear();
+}
+
+TileLayerCache::TileLayerCache(TileLayerCache&& other) noexcept
+    : entries_(std::move(other.entries_))
+    , frame_(other.frame_) {
+    other.entries_.clear();
+}
+
+TileLayerCache& TileLayerCache::operator=(TileLayerCache&& other) noexcept {
+    if (this != &other) {
+        clear();
+        entries_ = std::move(other.entries_);
+        frame_ = other.frame_;
+        other.entries_.clear();
+    }
+    return *this;
+}
+
+SDL_Texture* TileLayerCache::find(int chunkX, int chunkY) {
+    // Only a handful of chunks are cached, so a linear search is cheapest
+    for (auto& entry : entries_) {
+        if (entry.chunkX == chunkX && entry.chunkY == chunkY) {
+            entry.lastUsed = frame_;
+            return entry.texture;
+        }
+    }
+    return nullptr;
+}
+
+void TileLayerCache::insert(int chunkX, int chunkY, SDL_Texture* texture) {
+    if (!texture) return;
+
+    if (static_cast<int>(entries_.size()) >= Constants::TILE_CACHE_MAX_CHUNKS) {
+        size_t oldest = 0;
+        for (size_t i = 1; i < entries_.size(); ++i) {
+            if (entries_[i].lastUsed < entries_[oldest].lastUsed) {
+                oldest = i;
+            }
+        }
+        remove(oldest);
+    }
+    entries_.push_back(Entry{chunkX, chunkY, texture, frame_});
+}
+
+void TileLayerCache::invalidateTile(int tileX, int tileY) {
+    int chunkX = tileX / Constants::TILE_CACHE_CHUNK_TILES;
+    int chunkY = tileY / Constants::TILE_CACHE_CHUNK_TILES;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        if (entries_[i].chunkX == chunkX && entries_[i].chunkY == chunkY) {
+            remove(i);
+            return;
+        }
+    }
+}
+
+void TileLayerCache::clear() {
+    for (auto& entry : entries_) {
+        SDL_DestroyTexture(entry.texture);
+    }
+    entries_.clear();
+}
+
+void TileLayerCache::remove(size_t index) {
+    SDL_DestroyTexture(entries_[index].texture);
+    entries_[index] = entries_.back();
+    entries_.pop_back();
+}
@@ -0,0 +1,54 @@
+#ifndef TILE_LAYER_CACHE_H
+#define TILE_LAYER_CACHE_H
+
+#include <SDL.h>
+#include <cstdint>
+#include <vector>
+#include "util/Constants.h"
+
+// Pre-rendered map chunks: render-target textures of TILE_CACHE_CHUNK_PIXELS
+// squares, so the static tile layer costs one copy per visible chunk instead
+// of one per tile. At most TILE_CACHE_MAX_CHUNKS textures are kept; the least
+// recently drawn chunk is dropped first. Map bakes chunks on demand and
+// invalidates them when tiles change.
+class TileLayerCache {
+public:
+    TileLayerCache();
+    ~TileLayerCache();
+
+    // Disable copy (owns chunk textures); moving is fine
+    TileLayerCache(const TileLayerCache&) = delete;
+    TileLayerCache& operator=(const TileLayerCache&) = delete;
+    TileLayerCache(TileLayerCache&& other) noexcept;
+    TileLayerCache& operator=(TileLayerCache&& other) noexcept;
+
+    // Start a frame (chunks found or inserted after this count as recently used)
+    void beginFrame() { ++frame_; }
+
+    // Baked texture of a chunk (chunk coordinates in TILE_CACHE_CHUNK_TILES units) or nullptr
+    [[nodiscard]] SDL_Texture* find(int chunkX, int chunkY);
+
+    // Take ownership of a baked chunk texture, evicting the least recently used over capacity
+    void insert(int chunkX, int chunkY, SDL_Texture* texture);
+
+    // Drop the chunk containing a tile / all chunks
+    void invalidateTile(int tileX, int tileY);
+    void clear();
+
+    [[nodiscard]] int getChunkCount() const { return static_cast<int>(entries_.size()); }
+
+private:
+    struct Entry {
+        int chunkX;
+        int chunkY;
+        SDL_Texture* texture;  // Owned
+        uint32_t lastUsed;
+    };
+
+    void remove(size_t index);
+
+    std::vector<Entry> entries_;
+    uint32_t frame_;
+};
+
+#endif // TILE_LAYER_CACHE_H
@@ -0,0 +1,138 @@
+#include "field/TileMask.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+    // Integer division rounding toward +infinity (d > 0)
+    int64_t ceilDiv(int64_t n, int64_t d) {
+        return n >= 0 ? (n + d - 1) / d : n / d;  // Truncation is the ceiling for n < 0
+    }
+}
+
+TileMask::TileMask() : width_(0), height_(0), wordsPerRow_(0) {}
+
+void TileMask::reset(int width, int height) {
+    if (width <= 0 || height <= 0) {
+        words_.clear();
+        words_.shrink_to_fit();
+        width_ = 0;
+        height_ = 0;
+        wordsPerRow_ = 0;
+        return;
+    }
+    width_ = width;
+    height_ = height;
+    wordsPerRow_ = (width + WORD_BITS - 1) / WORD_BITS;
+    words_.assign(static_cast<size_t>(wordsPerRow_) * height, 0);
+}
+
+void TileMask::set(int x, int y, bool value) {
+    if (!isInBounds(x, y)) return;
+    uint64_t bit = uint64_t{1} << (x % WORD_BITS);
+    uint64_t& word = words_[wordIndex(x, y)];
+    word = value ? (word | bit) : (word & ~bit);
+}
+
+void TileMask::setWord(int y, int word, uint64_t bits) {
+    if (static_cast<unsigned>(y) >= static_cast<unsigned>(height_) ||
+        static_cast<unsigned>(word) >= static_cast<unsigned>(wordsPerRow_)) {
+        return;
+    }
+    int padding = wordsPerRow_ * WORD_BITS - width_;
+    if (word == wordsPerRow_ - 1 && padding > 0) {
+        bits &= bitRange(0, WORD_BITS - 1 - padding);
+    }
+    words_[static_cast<size_t>(y) * wordsPerRow_ + word] = bits;
+}
+
+bool TileMask::allSetInRow(int y, int x0, int x1, const TileMask* exclude) const {
+    if (x0 > x1) std::swap(x0, x1);
+    if (!isInBounds(x0, y) || !isInBounds(x1, y)) return false;
+    if (exclude && (exclude->width_ != width_ || exclude->height_ != height_)) return false;
+
+    const uint64_t* row = getRow(y);
+    const uint64_t* skip = exclude ? exclude->getRow(y) : nullptr;
+    auto wordAt = [row, skip](int i) { return skip ? (row[i] & ~skip[i]) : row[i]; };
+
+    int first = x0 / WORD_BITS;
+    int last = x1 / WORD_BITS;
+    if (first == last) {
+        uint64_t bits = bitRange(x0 % WORD_BITS, x1 % WORD_BITS);
+        return (wordAt(first) & bits) == bits;
+    }
+
+    uint64_t head = bitRange(x0 % WORD_BITS, WORD_BITS - 1);
+    uint64_t tail = bitRange(0, x1 % WORD_BITS);
+    if ((wordAt(first) & head) != head || (wordAt(last) & tail) != tail) return false;
+
+    // Whole words in between: branch-free AND reduction
+    uint64_t all = ~uint64_t{0};
+    if (skip) {
+        for (int i = first + 1; i < last; ++i) all &= row[i] & ~skip[i];
+    } else {
+        for (int i = first + 1; i < last; ++i) all &= row[i];
+    }
+    return all == ~uint64_t{0};
+}
+
+bool TileMask::allSetInRect(int x, int y, int width, int height, const TileMask* exclude) const {
+    if (width <= 0 || height <= 0) return false;
+    for (int row = y; row < y + height; ++row) {
+        if (!allSetInRow(row, x, x + width - 1, exclude)) return false;
+    }
+    return true;
+}
+
+int TileMask::countInRow(int y, int x0, int x1) const {
+    if (x0 > x1) std::swap(x0, x1);
+    x0 = std::max(x0, 0);
+    x1 = std::min(x1, width_ - 1);
+    if (static_cast<unsigned>(y) >= static_cast<unsigned>(height_) || x0 > x1) return 0;
+
+    const uint64_t* row = getRow(y);
+    int first = x0 / WORD_BITS;
+    int last = x1 / WORD_BITS;
+    if (first == last) {
+        return __builtin_popcountll(row[first] & bitRange(x0 % WORD_BITS, x1 % WORD_BITS));
+    }
+    int count = __builtin_popcountll(row[first] & bitRange(x0 % WORD_BITS, WORD_BITS - 1)) +
+                __builtin_popcountll(row[last] & bitRange(0, x1 % WORD_BITS));
+    for (int i = first + 1; i < last; ++i) {
+        count += __builtin_popcountll(row[i]);
+    }
+    return count;
+}
+
+bool TileMask::allSetOnLine(int x0, int y0, int x1, int y1) const {
+    // The mask is a rectangle, so in-bounds ends keep the whole line inside
+    if (!isInBounds(x0, y0) || !isInBounds(x1, y1)) return false;
+
+    int dx = std::abs(x1 - x0);
+    int dy = std::abs(y1 - y0);
+    int stepX = (x1 >= x0) ? 1 : -1;
+    int stepY = (y1 >= y0) ? 1 : -1;
+
+    if (dy == 0) {
+        return allSetInRow(y0, x0, x1);
+    }
+
+    if (dx >= dy) {
+        // Column t (0..dx) lies in row k = round(t * dy / dx), halves rounded up,
+        // so row k holds columns ceil((2k - 1) dx / 2dy) .. ceil((2k + 1) dx / 2dy) - 1
+        for (int k = 0; k <= dy; ++k) {
+            int64_t first = std::max<int64_t>(0, ceilDiv(int64_t{2 * k - 1} * dx, 2 * dy));
+            int64_t last = std::min<int64_t>(dx, ceilDiv(int64_t{2 * k + 1} * dx, 2 * dy) - 1);
+            int spanStart = x0 + stepX * static_cast<int>(first);
+            int spanEnd = x0 + stepX * static_cast<int>(last);
+            if (!allSetInRow(y0 + stepY * k, spanStart, spanEnd)) return false;
+        }
+        return true;
+    }
+
+    // Steep: one tile per row, column k * dx / dy rounded the same way
+    for (int k = 0; k <= dy; ++k) {
+        int t = static_cast<int>((int64_t{2} * k * dx + dy) / (int64_t{2} * dy));
+        if (!test(x0 + stepX * t, y0 + stepY * k)) return false;
+    }
+    return true;
+}
@@ -0,0 +1,94 @@
+#ifndef TILE_MASK_H
+#define TILE_MASK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// One bit per tile (e.g. walkable terrain, tiles holding an NPC).
+//
+// Rows are padded to whole 64-bit words and padding bits are always clear,
+// so span, rectangle and line queries test 64 tiles per word operation; the
+// inner word loops are plain AND reductions the compiler can vectorize.
+// Tiles outside the mask read as clear.
+class TileMask {
+public:
+    static constexpr int WORD_BITS = 64;
+
+    TileMask();
+
+    // Disable copy (a 16384 x 16384 mask is 32 MB); moving is fine
+    TileMask(const TileMask&) = delete;
+    TileMask& operator=(const TileMask&) = delete;
+    TileMask(TileMask&&) noexcept = default;
+    TileMask& operator=(TileMask&&) noexcept = default;
+
+    // Resize to width x height with every bit clear (0 x 0 releases memory)
+    void reset(int width, int height);
+
+    [[nodiscard]] bool test(int x, int y) const {
+        return isInBounds(x, y) && testInBounds(x, y);
+    }
+
+    // test() without the bounds check, for callers that checked already
+    [[nodiscard]] bool testInBounds(int x, int y) const {
+        return (words_[wordIndex(x, y)] >> (static_cast<unsigned>(x) % WORD_BITS)) & 1u;
+    }
+
+    // Set / clear one in-bounds tile (out-of-bounds is ignored)
+    void set(int x, int y, bool value);
+
+    // Overwrite one word of a row (bit i = tile word * 64 + i; padding is masked off)
+    void setWord(int y, int word, uint64_t bits);
+
+    // Every tile of the span [x0, x1] in row y is set, and not set in
+    // exclude (same dimensions) when given. False if the span leaves the mask.
+    [[nodiscard]] bool allSetInRow(int y, int x0, int x1, const TileMask* exclude = nullptr) const;
+
+    // Same for every row of a width x height rectangle
+    [[nodiscard]] bool allSetInRect(int x, int y, int width, int height,
+                                    const TileMask* exclude = nullptr) const;
+
+    // Number of set tiles in the span [x0, x1] of row y (clipped to the mask)
+    [[nodiscard]] int countInRow(int y, int x0, int x1) const;
+
+    // Every tile on the straight line from (x0, y0) to (x1, y1), both ends
+    // included, is set. The line takes the tile nearest to the exact line in
+    // each column (shallow lines) or row (steep lines), so the tiles of one
+    // row form a single span that is tested word by word.
+    [[nodiscard]] bool allSetOnLine(int x0, int y0, int x1, int y1) const;
+
+    // Raw row words for word-level consumers (y must be in bounds)
+    [[nodiscard]] const uint64_t* getRow(int y) const {
+        return words_.data() + static_cast<size_t>(y) * wordsPerRow_;
+    }
+    [[nodiscard]] int getWordsPerRow() const { return wordsPerRow_; }
+
+    [[nodiscard]] bool isInBounds(int x, int y) const {
+        // Unsigned compare covers negative coordinates in one test
+        return static_cast<unsigned>(x) < static_cast<unsigned>(width_) &&
+               static_cast<unsigned>(y) < static_cast<unsigned>(height_);
+    }
+    [[nodiscard]] int getWidth() const { return width_; }
+    [[nodiscard]] int getHeight() const { return height_; }
+    [[nodiscard]] size_t getMemoryBytes() const { return words_.capacity() * sizeof(uint64_t); }
+
+private:
+    [[nodiscard]] size_t wordIndex(int x, int y) const {
+        // Unsigned: x is in bounds, and a signed divide would need a sign fixup
+        return static_cast<size_t>(y) * static_cast<size_t>(wordsPerRow_) + static_cast<unsigned>(x) / WORD_BITS;
+    }
+
+    // Bits [from, to] of one word (0 <= from <= to < 64)
+    [[nodiscard]] static uint64_t bitRange(int from, int to) {
+        uint64_t upper = (to == WORD_BITS - 1) ? ~uint64_t{0} : ((uint64_t{1} << (to + 1)) - 1);
+        return upper & (~uint64_t{0} << from);
+    }
+
+    std::vector<uint64_t> words_;
+    int width_;
+    int height_;
+    int wordsPerRow_;
+};
+
+#endif // TILE_MASK_H
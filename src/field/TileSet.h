@@ -3,11 +3,12 @@
 
 #include <SDL.h>
 #include <string>
+#include "system/TextureRegion.h"
 #include "util/Constants.h"
 
 class ResourceManager;
 
-// Manages a tileset texture for rendering map tiles
+// Manages a tileset image (possibly packed in an atlas) for rendering map tiles
 class TileSet {
 public:
     explicit TileSet(int tileSize = Constants::TILE_SIZE);
@@ -16,14 +17,13 @@ public:
     [[nodiscard]] bool load(ResourceManager& resourceManager, const std::string& path);
 
     // Get the texture for rendering
-    [[nodiscard]] SDL_Texture* getTexture() const { return texture_; }
+    [[nodiscard]] SDL_Texture* getTexture() const { return region_.texture; }
 
-    // Get source rect for a tile at grid position
+    // Get source rect (in the texture) for a tile at grid position
     [[nodiscard]] SDL_Rect getSourceRect(int tileX, int tileY) const;
 
 private:
-    // Non-owning pointer - texture lifetime managed by ResourceManager
-    SDL_Texture* texture_;
+    TextureRegion region_;
     int tileSize_;
 };
 
@@ -3,6 +3,8 @@
 #include "dialogue/TopicDatabase.h"
 #include <SDL.h>
 #include <SDL_image.h>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <random>
 
@@ -10,11 +12,23 @@ Game::Game()
     : sdlInitialized_(false)
     , renderer_(nullptr)
     , resourceManager_(nullptr)
+    , mapCache_(Constants::MAP_CACHE_BUDGET, [this](Map& map) { setupNPCs(map); })
+    , torchLit_(false)
     , textRenderer_(nullptr)
     , saveManager_("saves")
-    , isRunning_(false) {}
+    , isRunning_(false)
+    , redrawNeeded_(true)
+    , previousMap_(nullptr)
+    , previousCameraX_(0)
+    , previousCameraY_(0)
+    , previousPlayerX_(0)
+    , previousPlayerY_(0) {}
 
 Game::~Game() {
+    // Cached maps own render-target textures; free them while the renderer exists
+    mapCache_.forEachMap([](Map& map) { map.invalidateRenderCache(); });
+    fogRenderer_.release();
+
     textRenderer_.reset();
     renderer_.reset();
     resourceManager_.reset();
@@ -25,9 +39,10 @@ Game::~Game() {
     }
 }
 
-bool Game::init() {
-    // Initialize SDL
-    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+bool Game::init(Renderer::Backend backend) {
+    // Initialize SDL (headless runs need no video device, only events for input)
+    bool headless = backend == Renderer::Backend::Headless;
+    if (SDL_Init(headless ? SDL_INIT_EVENTS : SDL_INIT_VIDEO) < 0) {
         std::cerr << "SDL initialization failed: " << SDL_GetError() << std::endl;
         return false;
     }
@@ -42,25 +57,39 @@ bool Game::init() {
 
     // Create renderer
     renderer_ = std::make_unique<Renderer>();
-    if (!renderer_->init(Constants::WINDOW_TITLE, Constants::WINDOW_WIDTH, Constants::WINDOW_HEIGHT)) {
+    if (!renderer_->init(Constants::WINDOW_TITLE, Constants::WINDOW_WIDTH, Constants::WINDOW_HEIGHT, backend)) {
         return false;
     }
 
     // Create resource manager
     resourceManager_ = std::make_unique<ResourceManager>(renderer_->getSDLRenderer());
 
+    // Pack every sprite sheet into shared atlas pages, so a field frame batches
+    // into few draw calls (sheets that fail here load on their own below).
+    // The sheets decode on worker threads while a loading bar is drawn.
+    for (const char* path : {"assets/tiles/tileset.png", "assets/characters/player.png",
+                             "assets/characters/npcs.png"}) {
+        resourceManager_->addToAtlas(path);
+    }
+    // The font goes in as the image loadFont will draw from (baked atlas or sheet)
+    resourceManager_->addToAtlas(TextRenderer::getFontImagePath("assets/fonts/font.png"));
+    if (!waitForAssets()) {
+        return true;  // Window closed while loading: run() returns at once
+    }
+    if (!resourceManager_->buildAtlas()) {
+        std::cerr << "Failed to build sprite atlas (non-fatal)" << std::endl;
+    }
+
     // Create text renderer
     textRenderer_ = std::make_unique<TextRenderer>();
     if (!textRenderer_->loadFont(*resourceManager_, "assets/fonts/font.png")) {
         std::cerr << "Failed to load font (non-fatal)" << std::endl;
         // Continue without font - dialogue will just not display text
     }
-
-    // Load tileset
-    if (!currentMap_.loadTileSet(*resourceManager_, "assets/tiles/tileset.png")) {
-        std::cerr << "Failed to load tileset" << std::endl;
-        return false;
+    if (!textRenderer_->loadGlyphs("assets/fonts/glyphs.hex")) {
+        std::cerr << "No glyph font at assets/fonts/glyphs.hex: non-ASCII text shows as boxes" << std::endl;
     }
+    loadNPCDefinitions();
 
     // Load player sprite
     if (!playerRenderer_.loadSprite(*resourceManager_, "assets/characters/player.png")) {
@@ -84,86 +113,289 @@ bool Game::init() {
     return true;
 }
 
+bool Game::waitForAssets() {
+    int total = resourceManager_->getLoadingCount();
+    while (resourceManager_->isLoading()) {
+        input_.update();
+        if (input_.isQuitRequested()) {
+            return false;
+        }
+        resourceManager_->update();
+
+        int done = total - resourceManager_->getLoadingCount();
+        int barWidth = Constants::INTERNAL_WIDTH / 2;
+        int barX = (Constants::INTERNAL_WIDTH - barWidth) / 2;
+        int barY = Constants::INTERNAL_HEIGHT / 2 - 4;
+        renderer_->setDrawColor(0, 0, 0, 255);
+        renderer_->clear();
+        renderer_->setDrawColor(255, 255, 255, 255);
+        renderer_->drawRect(barX, barY, barWidth, 8);
+        renderer_->fillRect(barX, barY, total > 0 ? barWidth * done / total : barWidth, 8);
+        renderer_->present();  // Waits for vsync with a window
+    }
+    return true;
+}
+
 bool Game::loadMap(const std::string& path) {
-    if (!currentMap_.loadFromCSV(path)) {
+    if (!enterMap(path)) {
         return false;
     }
 
-    // Configure map transitions based on map file
-    if (path == "data/maps/world_01.csv") {
-        // Stairs at (9, 10) lead to dungeon
-        currentMap_.addTransition(MapTransition{
-            Vec2{9, 10},
-            "data/maps/dungeon_01.csv",
-            Vec2{7, 7}
-        });
-    } else if (path == "data/maps/dungeon_01.csv") {
-        // Stairs at (7, 7) lead back to world
-        currentMap_.addTransition(MapTransition{
-            Vec2{7, 7},
-            "data/maps/world_01.csv",
-            Vec2{9, 10}
-        });
+    // Initialize game state with spawn position
+    Vec2 spawnPos = currentMap_->getSpawnPosition();
+    gameState_ = std::make_unique<GameState>(GameState::initial(*currentMap_, spawnPos));
+
+    return true;
+}
+
+bool Game::enterMap(const std::string& path) {
+    // Cached or prefetched maps are swapped in without disk I/O
+    std::shared_ptr<Map> map = mapCache_.acquire(path);
+    if (!map) {
+        return false;
     }
 
-    // Setup NPCs for this map
-    setupNPCs(path);
+    // Tileset textures are shared through the ResourceManager cache
+    if (!map->loadTileSet(*resourceManager_, "assets/tiles/tileset.png")) {
+        std::cerr << "Failed to load tileset" << std::endl;
+        return false;
+    }
+    currentMap_ = std::move(map);
 
-    // Initialize game state with spawn position
-    Vec2 spawnPos = currentMap_.getSpawnPosition();
-    gameState_ = std::make_unique<GameState>(GameState::initial(currentMap_, spawnPos));
+    // Light does not carry over between maps
+    fieldOfView_.reset();
+    torchLit_ = false;
 
+    // Load the maps reachable from here in the background
+    std::vector<std::string> targets;
+    for (const auto& transition : currentMap_->getTransitions()) {
+        targets.push_back(transition.targetMap);
+    }
+    mapCache_.prefetch(targets);
     return true;
 }
 
-void Game::setupNPCs(const std::string& mapPath) {
-    // Define NPC types
-    currentMap_.addNPCDefinition(NPCDefinition{
-        "villager",
-        0,  // spriteRow
-        {"Hello, traveler!", "Welcome to our village."}
-    });
-
-    currentMap_.addNPCDefinition(NPCDefinition{
-        "guard",
-        1,  // spriteRow
-        {"The king awaits\nin the castle."}
-    });
-
-    // Place NPCs based on map
-    if (mapPath == "data/maps/world_01.csv") {
-        currentMap_.addNPC(Vec2{5, 5}, Direction::Down, "villager");
-        currentMap_.addNPC(Vec2{8, 3}, Direction::Left, "guard");
+bool Game::isDarkMap() const {
+    return currentMap_ && currentMap_->isDark();
+}
+
+void Game::loadNPCDefinitions() {
+    npcDefinitions_ = {
+        NPCDefinition{
+            "villager",
+            0,  // spriteRow
+            {"Hello, traveler!", "Welcome to our village."},
+            NPCBehavior::Wander
+        },
+        NPCDefinition{
+            "guard",
+            1,  // spriteRow
+            {"The king awaits in the castle."}
+        }
+    };
+
+    // Wrap and paginate each script once; every NPC of a type shares the pages
+    for (auto& def : npcDefinitions_) {
+        def.dialogue = std::make_shared<const std::vector<std::string>>(
+            dialogueBox_.layoutPages(*textRenderer_, *def.dialogue));
     }
 }
 
-void Game::run() {
-    while (isRunning_) {
-        Uint32 frameStart = SDL_GetTicks();
+void Game::setupNPCs(Map& map) const {
+    for (const auto& def : npcDefinitions_) {
+        map.addNPCDefinition(def);
+    }
 
-        handleInput();
-        update();
-        render();
+    // Place NPCs from map data
+    for (const auto& placement : map.getNPCPlacements()) {
+        map.addNPC(placement.pos, placement.facing, placement.definitionId);
+    }
+}
 
-        // Frame rate limiting
-        Uint32 frameTime = SDL_GetTicks() - frameStart;
-        if (frameTime < Constants::FRAME_DELAY) {
-            SDL_Delay(Constants::FRAME_DELAY - frameTime);
+void Game::run(int maxFrames) {
+    bool headless = renderer_->getBackend() == Renderer::Backend::Headless;
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 step = frequency / Constants::TARGET_FPS;  // Counter ticks per simulation step
+    Uint64 runStart = SDL_GetPerformanceCounter();
+    Uint64 previous = runStart;
+    Uint64 accumulator = step;  // Simulate once before the first frame
+    int frames = 0;
+
+    while (isRunning_ && (maxFrames <= 0 || frames < maxFrames)) {
+#ifdef RPG_PROFILE
+        profiler_.beginFrame();
+        profiler_.collect();
+        redrawNeeded_ = redrawNeeded_ || profilerVisible_;  // Keep the statistics live
+#endif
+
+        // After a stall, drop the time that more than MAX_CATCH_UP_STEPS steps would need
+        Uint64 now = SDL_GetPerformanceCounter();
+        accumulator = headless ? step : std::min(accumulator + (now - previous), step * Constants::MAX_CATCH_UP_STEPS);
+        previous = now;
+
+        while (accumulator >= step && isRunning_) {
+            saveInterpolationStart();
+            handleInput();
+            update();
+            accumulator -= step;
         }
+        double alpha = headless ? 1.0 : static_cast<double>(accumulator) / static_cast<double>(step);
+        ++frames;
+
+        // Skip drawing and presenting a frame that would look like the last one,
+        // unless it is to be captured (the back buffer is gone after presenting)
+        bool captureDue = frameCapture_.beginFrame();
+        redrawNeeded_ = redrawNeeded_ || captureDue;
+        FrameKey key = makeFrameKey(alpha);
+        bool changed = headless || redrawNeeded_ || !(key == lastFrameKey_);
+        if (changed) {
+            render(alpha);
+            if (captureDue) {
+                frameCapture_.capture(*renderer_);
+            }
+            {
+                PROFILE_SCOPE(profiler_, ProfileSection::Present);
+                renderer_->present();  // Waits for vsync with a window
+            }
+            lastFrameKey_ = key;
+            redrawNeeded_ = false;
+        }
+        if (headless) continue;  // Measure the render path at full speed
+
+        if (!changed && isWorldPaused()) {
+            // Nothing moves behind an idle window: sleep until input arrives,
+            // then handle it at once without catching up on the idle time
+            SDL_WaitEventTimeout(nullptr, Constants::IDLE_WAIT_MAX_MS);
+            previous = SDL_GetPerformanceCounter();
+            accumulator = step;
+        } else if (!changed) {
+            // Nothing to draw: sleep until the next simulation step is due
+            SDL_Delay(static_cast<Uint32>((step - accumulator) * 1000 / frequency));
+        }
+    }
+
+    frameCapture_.waitUntilIdle();
+    if (frameCapture_.getSavedCount() > 0) {
+        std::cout << frameCapture_.getSavedCount() << " frames captured to " << frameCapture_.getDirectory() << "/"
+                  << std::endl;
+    }
+
+    if (headless && frames > 0) {
+        double seconds = static_cast<double>(SDL_GetPerformanceCounter() - runStart) /
+                         static_cast<double>(SDL_GetPerformanceFrequency());
+        const Renderer::FrameStats& stats = renderer_->getFrameStats();
+        std::cout << frames << " headless frames, " << seconds * 1000.0 / frames << " ms/frame, "
+                  << stats.drawCalls << " draw calls and " << stats.sprites << " sprites in the last frame"
+                  << std::endl;
     }
 }
 
 void Game::handleInput() {
+    PROFILE_SCOPE(profiler_, ProfileSection::Input);
     input_.update();
 
     if (input_.isQuitRequested()) {
         isRunning_ = false;
     }
+
+    // Pre-rendered map chunks are lost with the render targets; rebake them
+    if (input_.isRenderTargetsReset()) {
+        mapCache_.forEachMap([](Map& map) { map.invalidateRenderCache(); });
+    }
+
+    if (input_.isScreenshotPressed()) {
+        frameCapture_.requestScreenshot();
+    }
+    if (input_.isCaptureSequencePressed()) {
+        if (frameCapture_.isSequenceActive()) {
+            frameCapture_.stopSequence();
+        } else {
+            frameCapture_.startSequence(Constants::CAPTURE_SEQUENCE_INTERVAL, Constants::CAPTURE_SEQUENCE_FRAMES);
+        }
+    }
+
+#ifdef RPG_PROFILE
+    if (input_.isProfilerTogglePressed()) {
+        profilerVisible_ = !profilerVisible_;
+    }
+#endif
+
+    // Keys and window events may change anything on screen
+    redrawNeeded_ = redrawNeeded_ || input_.hasActivity();
+}
+
+Game::FrameKey Game::makeFrameKey(double alpha) const {
+    FrameKey key;
+    if (!gameState_) return key;
+    Pose pose = interpolate(alpha);
+    key.map = currentMap_.get();
+    key.cameraX = pose.cameraX;
+    key.cameraY = pose.cameraY;
+    key.playerX = pose.playerX;
+    key.playerY = pose.playerY;
+    key.facing = gameState_->player.getFacing();
+    key.playerMoving = gameState_->player.isMoving();
+    key.tileRevision = currentMap_->getTileRevision();
+    key.npcRevision = currentMap_->getNPCs().getRevision();
+    key.fovRevision = fieldOfView_.getRevision();
+    key.npcFrame = npcRenderer_.getAnimationFrame();
+    key.npcOffset = currentMap_->getNPCs().isAnyMoving() ? NPCRenderer::interpolationPixels(alpha) : 0;
+    return key;
+}
+
+Game::Pose Game::interpolate(double alpha) const {
+    Vec2 player = gameState_->player.getPixelPos();
+    Pose pose = {gameState_->camera.getX(), gameState_->camera.getY(), player.x, player.y};
+    if (previousMap_ != currentMap_.get()) {
+        return pose;  // Arrived on another map: nothing to move between
+    }
+
+    auto lerp = [alpha](int from, int to) {
+        return from + static_cast<int>(std::lround((to - from) * alpha));
+    };
+    return Pose{lerp(previousCameraX_, pose.cameraX), lerp(previousCameraY_, pose.cameraY),
+                lerp(previousPlayerX_, pose.playerX), lerp(previousPlayerY_, pose.playerY)};
+}
+
+void Game::saveInterpolationStart() {
+    if (!gameState_) return;
+    Vec2 player = gameState_->player.getPixelPos();
+    previousMap_ = currentMap_.get();
+    previousCameraX_ = gameState_->camera.getX();
+    previousCameraY_ = gameState_->camera.getY();
+    previousPlayerX_ = player.x;
+    previousPlayerY_ = player.y;
+}
+
+bool Game::isWorldPaused() const {
+    if (!gameState_) return false;
+    const GameState& state = *gameState_;
+    return state.dialogue.isActive() || state.menu.isActive() || state.itemList.isActive() ||
+           state.saveSlot.isActive() || state.phraseBookView.isActive() || state.battle.isActive();
 }
 
 void Game::update() {
+    PROFILE_SCOPE(profiler_, ProfileSection::Update);
     if (!gameState_) return;
 
+    // Keep world chunks around the camera resident (no-op unless the map streams)
+    currentMap_->streamAround(gameState_->camera.getCenterTile());
+    mapCache_.update();
+    resourceManager_->update();
+
+    // Recast only when the player reached another tile or the tiles changed
+    if (isDarkMap()) {
+        int radius = torchLit_ ? Constants::FOV_TORCH_RADIUS : Constants::FOV_DARK_RADIUS;
+        fieldOfView_.update(*currentMap_, gameState_->player.getTilePos(), radius);
+    }
+
+    // NPCs hold still while a window is open or a battle runs
+    if (!isWorldPaused()) {
+        currentMap_->updateNPCs(gameState_->player.getTilePos(), gameState_->player.getTargetPos());
+        npcRenderer_.advanceAnimation();
+    }
+    playerRenderer_.advanceAnimation();
+
     // Handle battle input (highest priority when active)
     if (gameState_->battle.isActive()) {
         BattlePhase phase = gameState_->battle.getPhase();
@@ -257,7 +489,12 @@ void Game::update() {
         } else if (input_.isMenuDownPressed()) {
             gameState_ = std::make_unique<GameState>(gameState_->itemListMoveDown());
         } else if (input_.isConfirmPressed()) {
-            gameState_ = std::make_unique<GameState>(gameState_->useSelectedItem());
+            // A torch only burns (and is used up) where it is dark
+            bool torch = gameState_->itemList.getSelectedItemId() == ItemId::TORCH;
+            if (!torch || isDarkMap()) {
+                gameState_ = std::make_unique<GameState>(gameState_->useSelectedItem());
+                torchLit_ = torchLit_ || torch;
+            }
         } else if (input_.isCancelPressed()) {
             gameState_ = std::make_unique<GameState>(gameState_->closeItemList());
         }
@@ -294,7 +531,7 @@ void Game::update() {
 
     // Handle interaction (confirm key)
     if (input_.isConfirmPressed()) {
-        gameState_ = std::make_unique<GameState>(gameState_->tryInteract(currentMap_));
+        gameState_ = std::make_unique<GameState>(gameState_->tryInteract(*currentMap_));
         if (gameState_->dialogue.isActive()) {
             return;  // Interaction started dialogue
         }
@@ -303,7 +540,7 @@ void Game::update() {
     // Normal movement
     Direction dir = input_.getMovementDirection();
     GameState oldState = *gameState_;
-    gameState_ = std::make_unique<GameState>(gameState_->update(dir, currentMap_));
+    gameState_ = std::make_unique<GameState>(gameState_->update(dir, *currentMap_));
 
     // Check for map transitions when player stops moving
     if (!gameState_->player.isMoving()) {
@@ -345,42 +582,65 @@ Personality Game::getEncounterPersonality(const std::string& enemyId) {
 }
 
 void Game::checkMapTransition() {
-    auto transition = currentMap_.getTransitionAt(gameState_->player.getTilePos());
+    const MapTransition* transition = currentMap_->getTransitionAt(gameState_->player.getTilePos());
     if (transition) {
-        // Load new map
-        if (currentMap_.loadFromCSV(transition->targetMap)) {
-            // Setup NPCs for new map
-            setupNPCs(transition->targetMap);
+        // Copy the target first: entering the new map releases this one
+        std::string targetMap = transition->targetMap;
+        Vec2 targetPos = transition->targetPos;
+
+        if (enterMap(targetMap)) {
+            // Streamed worlds: make sure the arrival area is resident
+            currentMap_->loadAround(targetPos);
 
             // Update game state for new map
             gameState_ = std::make_unique<GameState>(gameState_->withMap(
-                transition->targetMap,
-                currentMap_,
-                transition->targetPos
+                targetMap,
+                *currentMap_,
+                targetPos
             ));
         }
     }
 }
 
-void Game::render() {
+void Game::render(double alpha) {
+    PROFILE_SCOPE(profiler_, ProfileSection::Render);
+
     // Clear with dark blue (like old RPG skies)
     renderer_->setDrawColor(16, 16, 64);
     renderer_->clear();
 
     if (gameState_) {
-        int camX = gameState_->camera.getX();
-        int camY = gameState_->camera.getY();
+        Pose pose = interpolate(alpha);
+        int camX = pose.cameraX;
+        int camY = pose.cameraY;
 
         // Render map
-        currentMap_.render(*renderer_, camX, camY);
+        renderer_->setLayer(RenderLayer::Ground);
+        {
+            PROFILE_SCOPE(profiler_, ProfileSection::RenderMap);
+            currentMap_->render(*renderer_, camX, camY);
+        }
 
-        // Render NPCs
-        for (const auto& npc : currentMap_.getNPCs()) {
-            npcRenderer_.render(*renderer_, npc, camX, camY);
+        // Render NPCs (those in view) and the player, y-sorted together
+        renderer_->setLayer(RenderLayer::Objects);
+        {
+            PROFILE_SCOPE(profiler_, ProfileSection::RenderNPCs);
+            npcRenderer_.render(*renderer_, currentMap_->getNPCs(), currentMap_->getNPCDefinitions(), camX, camY, alpha);
+        }
+        {
+            PROFILE_SCOPE(profiler_, ProfileSection::RenderPlayer);
+            playerRenderer_.render(*renderer_, gameState_->player, Vec2{pose.playerX, pose.playerY}, camX, camY);
+        }
+
+        // Fog of war over the field, under the UI
+        renderer_->setLayer(RenderLayer::Overlay);
+        if (isDarkMap()) {
+            fogRenderer_.render(*renderer_, *currentMap_, fieldOfView_, camX, camY);
         }
 
-        // Render player
-        playerRenderer_.render(*renderer_, gameState_->player, camX, camY);
+        // Windows keep their drawing order
+        renderer_->setLayer(RenderLayer::UI);
+        PROFILE_SCOPE(profiler_, ProfileSection::RenderUI);
 
         // Render dialogue box (if active)
         if (gameState_->dialogue.isActive() && textRenderer_) {
@@ -413,5 +673,10 @@ void Game::render() {
         }
     }
 
-    renderer_->present();
+#ifdef RPG_PROFILE
+    if (profilerVisible_ && textRenderer_) {
+        renderer_->setLayer(RenderLayer::UI);
+        profilerOverlay_.render(*renderer_, *textRenderer_, profiler_);
+    }
+#endif
 }
@@ -3,12 +3,18 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 #include "game/GameState.h"
 #include "game/Player.h"
 #include "field/Map.h"
+#include "field/MapCache.h"
+#include "field/FieldOfView.h"
+#include "field/FogRenderer.h"
 #include "system/Renderer.h"
 #include "system/Input.h"
 #include "system/ResourceManager.h"
+#include "system/Profiler.h"
+#include "system/FrameCapture.h"
 #include "entity/NPC.h"
 #include "ui/TextRenderer.h"
 #include "ui/DialogueBox.h"
@@ -17,6 +23,7 @@
 #include "ui/ItemListBox.h"
 #include "ui/SaveSlotBox.h"
 #include "ui/BattleBox.h"
+#include "ui/ProfilerOverlay.h"
 #include "save/SaveManager.h"
 #include "battle/EncounterManager.h"
 
@@ -29,20 +36,59 @@ public:
     Game(const Game&) = delete;
     Game& operator=(const Game&) = delete;
 
-    // Initialize game systems
-    [[nodiscard]] bool init();
+    // Initialize game systems (headless: no window, frames drawn offscreen)
+    [[nodiscard]] bool init(Renderer::Backend backend = Renderer::Backend::Window);
 
-    // Main game loop
-    void run();
+    // Main game loop; stops after maxFrames when positive. The simulation runs
+    // in fixed TARGET_FPS steps from an accumulator of elapsed time, and frames
+    // are drawn at display rate (vsync) with positions interpolated between
+    // the last two steps. Frames that would look like the last one are not
+    // drawn, and while a window holds the world still the loop sleeps until
+    // input arrives. Headless runs take one step per frame as fast as they can
+    // (faster than real time), draw every frame and report their average
+    // frame time when done.
+    void run(int maxFrames = 0);
+
+    // Save every interval-th frame to Constants::CAPTURE_DIRECTORY while running
+    // (F12 saves one screenshot, F11 starts or stops a short sequence)
+    void startCaptureSequence(int interval) { frameCapture_.startSequence(interval); }
 
 private:
+    // Everything a drawn frame depends on besides input-driven UI state
+    struct FrameKey {
+        const Map* map = nullptr;
+        int cameraX = 0;
+        int cameraY = 0;
+        int playerX = 0;  // Pixels, interpolated
+        int playerY = 0;
+        Direction facing = Direction::None;
+        bool playerMoving = false;
+        uint64_t tileRevision = 0;
+        uint64_t npcRevision = 0;
+        uint64_t fovRevision = 0;
+        int npcFrame = 0;
+        int npcOffset = 0;  // Interpolated walking pixels
+
+        [[nodiscard]] bool operator==(const FrameKey& other) const {
+            return map == other.map && cameraX == other.cameraX && cameraY == other.cameraY &&
+                   playerX == other.playerX && playerY == other.playerY && facing == other.facing &&
+                   playerMoving == other.playerMoving && tileRevision == other.tileRevision &&
+                   npcRevision == other.npcRevision && fovRevision == other.fovRevision &&
+                   npcFrame == other.npcFrame && npcOffset == other.npcOffset;
+        }
+    };
+
     // Game loop steps
     void handleInput();
     void update();
-    void render();
+    void render(double alpha);  // Draw only (run() presents); alpha: progress from the previous step to the latest
+
+    // Draw a loading bar until queued assets are decoded (false if the window was closed)
+    [[nodiscard]] bool waitForAssets();
 
     // Map management
     [[nodiscard]] bool loadMap(const std::string& path);
+    [[nodiscard]] bool enterMap(const std::string& path);  // Make a cached map current
     void checkMapTransition();
 
     // SDL subsystem management
@@ -54,9 +100,16 @@ private:
     Input input_;
 
     // Game objects
-    Map currentMap_;
+    MapCache mapCache_;
+    std::shared_ptr<Map> currentMap_;  // Shared with mapCache_
     PlayerRenderer playerRenderer_;
     NPCRenderer npcRenderer_;
+    std::vector<NPCDefinition> npcDefinitions_;  // Dialogue already wrapped and paginated
+
+    // Field of view in dark maps; a torch widens it until the player leaves the map
+    FieldOfView fieldOfView_;
+    FogRenderer fogRenderer_;
+    bool torchLit_;
 
     // UI components
     std::unique_ptr<TextRenderer> textRenderer_;
@@ -73,14 +126,56 @@ private:
     // Battle system
     EncounterManager encounterManager_;
 
+    // Screenshots and frame sequences, written on a worker thread
+    FrameCapture frameCapture_;
+
+#ifdef RPG_PROFILE
+    // Frame-time profiler and its overlay (toggled with F3)
+    Profiler profiler_;
+    ProfilerOverlay profilerOverlay_;
+    bool profilerVisible_ = false;
+#endif
+
     // Game state (mutable, but updated immutably)
     std::unique_ptr<GameState> gameState_;
 
     // Running flag
     bool isRunning_;
 
-    // Setup NPCs for the current map
-    void setupNPCs(const std::string& mapPath);
+    // Damage tracking: what the last drawn frame showed, and whether input
+    // (which may change any window) asks for a redraw regardless
+    FrameKey lastFrameKey_;
+    bool redrawNeeded_;
+    [[nodiscard]] FrameKey makeFrameKey(double alpha) const;
+
+    // Camera and player as drawn, between the last two simulation steps
+    struct Pose {
+        int cameraX;
+        int cameraY;
+        int playerX;
+        int playerY;
+    };
+    [[nodiscard]] Pose interpolate(double alpha) const;
+    void saveInterpolationStart();  // Call before each simulation step
+
+    // Pose before the latest simulation step (not interpolated across maps)
+    const Map* previousMap_;
+    int previousCameraX_;
+    int previousCameraY_;
+    int previousPlayerX_;
+    int previousPlayerY_;
+
+    // A window or battle is open: NPCs and their animation hold still
+    [[nodiscard]] bool isWorldPaused() const;
+
+    // The current map shows only what the player can see (a flag in its map data)
+    [[nodiscard]] bool isDarkMap() const;
+
+    // Define NPC types, their scripts paged for the dialogue box (needs the font)
+    void loadNPCDefinitions();
+
+    // Add the NPC types to a newly loaded map and spawn its NPCs
+    void setupNPCs(Map& map) const;
 
     // Get personality for an encounter based on enemy type
     Personality getEncounterPersonality(const std::string& enemyId);
@@ -67,7 +67,7 @@ struct GameState {
             saveSlot.isActive() || phraseBookView.isActive() || battle.isActive()) return *this;
 
         Vec2 facingTile = player.getTilePos().add(directionToOffset(player.getFacing()));
-        const NPC* npc = map.getNPCAt(facingTile);
+        std::optional<NPC> npc = map.getNPCAt(facingTile);
 
         if (npc) {
             // Make NPC face toward player
@@ -317,7 +317,8 @@ struct GameState {
         // Start with some items for testing
         Inventory startInv = Inventory::empty()
             .addItem(ItemId::HERB, 3)
-            .addItem(ItemId::ANTIDOTE, 2);
+            .addItem(ItemId::ANTIDOTE, 2)
+            .addItem(ItemId::TORCH, 1);
         return GameState{p, c, "",
                         DialogueState::inactive(), MenuState::inactive(),
                         PlayerStats::create(playerName),
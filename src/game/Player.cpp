@@ -54,34 +54,37 @@ Vec2 Player::getPixelPos() const {
 
 // PlayerRenderer implementation
 PlayerRenderer::PlayerRenderer()
-    : texture_(nullptr)
+    : region_()
     , spriteWidth_(Constants::TILE_SIZE)
     , spriteHeight_(Constants::TILE_SIZE)
     , frameCounter_(0) {}
 
 bool PlayerRenderer::loadSprite(ResourceManager& resourceManager, const std::string& path) {
-    texture_ = resourceManager.loadTexture(path);
-    return texture_ != nullptr;
+    region_ = resourceManager.loadRegion(path);
+    return region_.texture != nullptr;
 }
 
-void PlayerRenderer::render(Renderer& renderer, const Player& player, int cameraX, int cameraY) {
-    if (!texture_) return;
+void PlayerRenderer::advanceAnimation() {
+    // Wrap around to prevent overflow
+    frameCounter_ = (frameCounter_ + 1) % (Constants::ANIMATION_FRAME_DIVISOR * Constants::WALK_ANIMATION_FRAMES * 1000);
+}
+
+void PlayerRenderer::render(Renderer& renderer, const Player& player, const Vec2& pixelPos,
+                            int cameraX, int cameraY) const {
+    if (!region_.texture) return;
 
-    Vec2 pixelPos = player.getPixelPos();
     int screenX = pixelPos.x - cameraX;
     int screenY = pixelPos.y - cameraY;
 
-    // Update animation frame with wrap-around to prevent overflow
-    frameCounter_ = (frameCounter_ + 1) % (Constants::ANIMATION_FRAME_DIVISOR * Constants::WALK_ANIMATION_FRAMES * 1000);
     int frame = 0;
     if (player.isMoving()) {
         frame = (frameCounter_ / Constants::ANIMATION_FRAME_DIVISOR) % Constants::WALK_ANIMATION_FRAMES;
     }
 
-    SDL_Rect src = getSourceRect(player.getFacing(), frame);
+    SDL_Rect src = region_.toTexture(getSourceRect(player.getFacing(), frame));
     SDL_Rect dst = {screenX, screenY, spriteWidth_, spriteHeight_};
 
-    renderer.drawTexture(texture_, &src, &dst);
+    renderer.drawTexture(region_.texture, &src, &dst);
 }
 
 SDL_Rect PlayerRenderer::getSourceRect(Direction dir, int frame) const {
@@ -3,6 +3,7 @@
 
 #include <SDL.h>
 #include <string>
+#include "system/TextureRegion.h"
 #include "util/Vec2.h"
 #include "util/Constants.h"
 
@@ -32,6 +33,9 @@ public:
     // Get current tile position
     [[nodiscard]] constexpr Vec2 getTilePos() const { return tilePos_; }
 
+    // Get the tile being walked to (the current tile when standing)
+    [[nodiscard]] constexpr Vec2 getTargetPos() const { return targetPos_; }
+
     // Get pixel position (for rendering)
     [[nodiscard]] Vec2 getPixelPos() const;
 
@@ -60,20 +64,24 @@ private:
 };
 
 // Player sprite renderer (separate from state)
-// Note: This class has internal animation state, so render() is not const
+// Note: This class has internal animation state, advanced once per simulation step
 class PlayerRenderer {
 public:
     PlayerRenderer();
 
     [[nodiscard]] bool loadSprite(ResourceManager& resourceManager, const std::string& path);
-    void render(Renderer& renderer, const Player& player, int cameraX, int cameraY);
+
+    // Advance the walking animation by one simulation step
+    void advanceAnimation();
+
+    // Draw the player at pixelPos (interpolated by the caller)
+    void render(Renderer& renderer, const Player& player, const Vec2& pixelPos, int cameraX, int cameraY) const;
 
 private:
-    // Non-owning pointer - texture lifetime managed by ResourceManager
-    SDL_Texture* texture_;
+    TextureRegion region_;  // Sprite sheet
     int spriteWidth_;
     int spriteHeight_;
-    int frameCounter_;  // Animation state, updated each render
+    int frameCounter_;  // Animation state, updated each simulation step
 
     // Get source rect based on direction and animation frame
     [[nodiscard]] SDL_Rect getSourceRect(Direction dir, int frame) const;
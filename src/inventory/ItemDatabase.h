@@ -44,6 +44,12 @@ public:
         return std::nullopt;
     }
 
+    // Find item by ID without copying it (nullptr if not found), for lookups every frame
+    [[nodiscard]] const Item* find(int id) const {
+        auto it = items_.find(id);
+        return it != items_.end() ? &it->second : nullptr;
+    }
+
     // Deleted copy/move constructors and assignment operators
     ItemDatabase(const ItemDatabase&) = delete;
     ItemDatabase& operator=(const ItemDatabase&) = delete;
@@ -1,18 +1,43 @@
 #include "game/Game.h"
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 int main(int argc, char* argv[]) {
-    (void)argc;
-    (void)argv;
+    // --headless renders offscreen without a window; --frames N stops after N frames;
+    // --capture N saves every Nth frame as PNG
+    Renderer::Backend backend = Renderer::Backend::Window;
+    int maxFrames = 0;
+    int captureInterval = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            backend = Renderer::Backend::Headless;
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            maxFrames = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--capture") == 0 && i + 1 < argc && std::atoi(argv[i + 1]) > 0) {
+            captureInterval = std::atoi(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--headless] [--frames N] [--capture N]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Without input, a headless run would never end
+    if (backend == Renderer::Backend::Headless && maxFrames <= 0) {
+        maxFrames = Constants::HEADLESS_DEFAULT_FRAMES;
+    }
 
     Game game;
 
-    if (!game.init()) {
+    if (!game.init(backend)) {
         std::cerr << "Failed to initialize game" << std::endl;
         return 1;
     }
 
-    game.run();
+    if (captureInterval > 0) {
+        game.startCaptureSequence(captureInterval);
+    }
+    game.run(maxFrames);
 
     return 0;
 }
@@ -0,0 +1,99 @@
+#include "system/AssetLoader.h"
+#include <SDL_image.h>
+#include <algorithm>
+#include <iostream>
+
+AssetLoader::AssetLoader(int threadCount)
+    : threadCount_(std::max(1, threadCount))
+    , requested_(0)
+    , decoding_(0)
+    , stopping_(false) {}
+
+AssetLoader::~AssetLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        requests_.clear();
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void AssetLoader::request(const std::string& path) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        requests_.push_back(path);
+    }
+    ++requested_;
+    if (workers_.empty()) {
+        // SDL_image loads codecs on first use, which is not thread-safe:
+        // load PNG support before workers can decode in parallel
+        if ((IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG) == 0) {
+            std::cerr << "Failed to initialize PNG loading - " << IMG_GetError() << std::endl;
+        }
+        for (int i = 0; i < threadCount_; ++i) {
+            workers_.emplace_back(&AssetLoader::workerLoop, this);
+        }
+    }
+    wake_.notify_one();
+}
+
+void AssetLoader::takeFinished(std::vector<Decoded>& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& decoded : finished_) {
+        out.push_back(std::move(decoded));
+    }
+    finished_.clear();
+}
+
+void AssetLoader::waitForFinished() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return !finished_.empty() || (requests_.empty() && decoding_ == 0); });
+}
+
+int AssetLoader::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(requests_.size() + finished_.size()) + decoding_;
+}
+
+AssetLoader::SurfacePtr AssetLoader::decode(const std::string& path) {
+    SurfacePtr loaded(IMG_Load(path.c_str()));
+    if (!loaded) {
+        std::cerr << "Failed to load image - " << IMG_GetError() << std::endl;
+        return nullptr;
+    }
+
+    // Paletted and alpha-less images become ARGB (color keys turn into alpha)
+    SurfacePtr image(SDL_ConvertSurfaceFormat(loaded.get(), SDL_PIXELFORMAT_ARGB8888, 0));
+    if (!image) {
+        std::cerr << "Failed to convert image - " << SDL_GetError() << std::endl;
+        return nullptr;
+    }
+    SDL_SetSurfaceBlendMode(image.get(), SDL_BLENDMODE_NONE);
+    return image;
+}
+
+void AssetLoader::workerLoop() {
+    while (true) {
+        std::string path;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stopping_ || !requests_.empty(); });
+            if (stopping_) return;
+            path = std::move(requests_.front());
+            requests_.pop_front();
+            ++decoding_;
+        }
+
+        SurfacePtr surface = decode(path);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            finished_.push_back(Decoded{std::move(path), std::move(surface)});
+            --decoding_;
+        }
+        done_.notify_all();
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include <SDL.h>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "util/Constants.h"
+
+// Decodes image files into surfaces on background threads. Decoding (file
+// reads, PNG inflate, conversion to ARGB8888) is the slow part of loading a
+// texture and needs no renderer; only the upload does, so ResourceManager
+// takes the finished surfaces on the render thread and uploads them there.
+//
+// Worker threads start with the first request, after SDL_image's PNG support
+// is loaded. Results are handed out in the order they finish, not the order
+// they were requested.
+class AssetLoader {
+public:
+    struct SurfaceDeleter {
+        void operator()(SDL_Surface* surface) const { SDL_FreeSurface(surface); }
+    };
+    using SurfacePtr = std::unique_ptr<SDL_Surface, SurfaceDeleter>;
+
+    struct Decoded {
+        std::string path;
+        SurfacePtr surface;  // nullptr if the file could not be decoded
+    };
+
+    explicit AssetLoader(int threadCount = Constants::ASSET_DECODE_THREADS);
+    ~AssetLoader();  // Drops queued requests and waits for running decodes
+
+    // Disable copy (owns worker threads)
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // Queue an image for decoding (the path must already be validated)
+    void request(const std::string& path);
+
+    // Move finished decodes into out
+    void takeFinished(std::vector<Decoded>& out);
+
+    // Block until a decode is finished and not taken yet, or none is pending
+    void waitForFinished();
+
+    // Requests queued, decoding, or finished but not taken
+    [[nodiscard]] int getPendingCount() const;
+
+    // Requests made so far
+    [[nodiscard]] int getRequestCount() const { return requested_; }
+
+    // Load an image as an ARGB8888 surface with blending off, so it copies
+    // as is (safe on any thread; nullptr and a message on failure)
+    [[nodiscard]] static SurfacePtr decode(const std::string& path);
+
+private:
+    void workerLoop();
+
+    int threadCount_;
+    int requested_;
+
+    // Shared with workers (guarded by mutex_)
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::deque<std::string> requests_;
+    std::vector<Decoded> finished_;
+    int decoding_;
+    bool stopping_;
+    std::vector<std::thread> workers_;
+};
+
+#endif // ASSET_LOADER_H
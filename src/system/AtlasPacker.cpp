@@ -0,0 +1,105 @@
+#include "system/AtlasPacker.h"
+#include <algorithm>
+#include <numeric>
+
+AtlasPacker::AtlasPacker(int pageWidth, int pageHeight, int padding)
+    : pageWidth_(pageWidth), pageHeight_(pageHeight), padding_(padding) {}
+
+std::vector<AtlasPacker::Placement> AtlasPacker::pack(const std::vector<Vec2>& sizes) {
+    std::vector<Placement> placements(sizes.size(), Placement{-1, 0, 0});
+
+    // Tallest first (then widest) leaves the flattest skyline
+    std::vector<size_t> order(sizes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&sizes](size_t a, size_t b) {
+        if (sizes[a].y != sizes[b].y) return sizes[a].y > sizes[b].y;
+        return sizes[a].x > sizes[b].x;
+    });
+
+    for (size_t index : order) {
+        int w = sizes[index].x + padding_;
+        int h = sizes[index].y + padding_;
+        if (sizes[index].x > pageWidth_ || sizes[index].y > pageHeight_) continue;
+
+        // Padding may run off the page edge
+        w = std::min(w, pageWidth_);
+        h = std::min(h, pageHeight_);
+
+        int x = 0;
+        int y = 0;
+        size_t page = 0;
+        while (page < pages_.size() && !place(pages_[page], w, h, x, y)) {
+            ++page;
+        }
+        if (page == pages_.size()) {
+            pages_.push_back(Page{{Segment{0, 0, pageWidth_}}, 0, 0});
+            if (!place(pages_.back(), w, h, x, y)) continue;
+        }
+        placements[index] = Placement{static_cast<int>(page), x, y};
+    }
+    return placements;
+}
+
+Vec2 AtlasPacker::getUsedSize(int page) const {
+    const Page& p = pages_[static_cast<size_t>(page)];
+    return Vec2{p.usedWidth, p.usedHeight};
+}
+
+int AtlasPacker::fitAt(const Page& page, size_t i, int w, int h) const {
+    int x = page.skyline[i].x;
+    if (x + w > pageWidth_) return -1;
+
+    // Rest on the highest segment under the rectangle
+    int y = 0;
+    int remaining = w;
+    for (size_t j = i; remaining > 0; ++j) {
+        y = std::max(y, page.skyline[j].y);
+        remaining -= page.skyline[j].width;
+    }
+    return y + h <= pageHeight_ ? y : -1;
+}
+
+bool AtlasPacker::place(Page& page, int w, int h, int& x, int& y) const {
+    size_t best = page.skyline.size();
+    int bestY = 0;
+    for (size_t i = 0; i < page.skyline.size(); ++i) {
+        int top = fitAt(page, i, w, h);
+        if (top >= 0 && (best == page.skyline.size() || top < bestY)) {
+            best = i;
+            bestY = top;
+        }
+    }
+    if (best == page.skyline.size()) return false;
+
+    x = page.skyline[best].x;
+    y = bestY;
+
+    // The rectangle's bottom edge replaces the segments it covers
+    std::vector<Segment>& skyline = page.skyline;
+    skyline.insert(skyline.begin() + static_cast<long>(best), Segment{x, y + h, w});
+    size_t next = best + 1;
+    while (next < skyline.size() && skyline[next].x < x + w) {
+        int overlap = x + w - skyline[next].x;
+        if (overlap >= skyline[next].width) {
+            skyline.erase(skyline.begin() + static_cast<long>(next));
+        } else {
+            skyline[next].x += overlap;
+            skyline[next].width -= overlap;
+            break;
+        }
+    }
+
+    // Merge neighbors of equal height
+    for (size_t i = 0; i + 1 < skyline.size();) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + static_cast<long>(i) + 1);
+        } else {
+            ++i;
+        }
+    }
+
+    page.usedWidth = std::max(page.usedWidth, x + w);
+    page.usedHeight = std::max(page.usedHeight, y + h);
+    return true;
+}
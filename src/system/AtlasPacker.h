@@ -0,0 +1,58 @@
+#ifndef ATLAS_PACKER_H
+#define ATLAS_PACKER_H
+
+#include <cstddef>
+#include <vector>
+#include "util/Vec2.h"
+
+// Packs rectangles into fixed-size atlas pages with a skyline (bottom-left)
+// heuristic: each page keeps the top edge of its placed rectangles as a list
+// of horizontal segments, and a rectangle goes where its bottom edge ends up
+// lowest. Tallest rectangles are placed first; a new page is opened when no
+// page has room. Pure layout, no SDL: ResourceManager copies the pixels.
+class AtlasPacker {
+public:
+    // Where a rectangle went (page -1: larger than a page)
+    struct Placement {
+        int page;
+        int x;
+        int y;
+    };
+
+    // Padding is left empty right of and below each rectangle
+    AtlasPacker(int pageWidth, int pageHeight, int padding);
+
+    // Place rectangles of the given sizes; placements are in input order
+    [[nodiscard]] std::vector<Placement> pack(const std::vector<Vec2>& sizes);
+
+    [[nodiscard]] int getPageCount() const { return static_cast<int>(pages_.size()); }
+
+    // Extent used on a page (pixels right of / below it are empty)
+    [[nodiscard]] Vec2 getUsedSize(int page) const;
+
+private:
+    struct Segment {
+        int x;
+        int y;      // Lowest free row above this segment
+        int width;
+    };
+
+    struct Page {
+        std::vector<Segment> skyline;
+        int usedWidth;
+        int usedHeight;
+    };
+
+    // Top of a w-wide rectangle resting on the skyline from segment i (-1: does not fit)
+    [[nodiscard]] int fitAt(const Page& page, size_t i, int w, int h) const;
+
+    // Place on a page if there is room
+    [[nodiscard]] bool place(Page& page, int w, int h, int& x, int& y) const;
+
+    int pageWidth_;
+    int pageHeight_;
+    int padding_;
+    std::vector<Page> pages_;
+};
+
+#endif // ATLAS_PACKER_H
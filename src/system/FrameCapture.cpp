@@ -0,0 +1,213 @@
+#include "system/FrameCapture.h"
+#include "system/Renderer.h"
+#include <SDL.h>
+#include <SDL_image.h>
+#include <algorithm>
+#include <ctime>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    std::string makeStamp() {
+        std::time_t now = std::time(nullptr);
+        std::tm local{};
+#ifdef _WIN32
+        localtime_s(&local, &now);
+#else
+        localtime_r(&now, &local);
+#endif
+        std::ostringstream oss;
+        oss << std::put_time(&local, "%Y%m%d-%H%M%S");
+        return oss.str();
+    }
+}
+
+FrameCapture::FrameCapture(std::string directory, Encoder encoder)
+    : directory_(std::move(directory))
+    , encoder_(encoder ? std::move(encoder) : Encoder(&FrameCapture::writePNG))
+    , stamp_(makeStamp())
+    , screenshotRequested_(false)
+    , screenshotDue_(false)
+    , sequenceDue_(false)
+    , screenshotNumber_(0)
+    , sequenceNumber_(0)
+    , sequenceInterval_(0)
+    , sequenceRemaining_(0)
+    , sequenceFrame_(0)
+    , sequenceCaptured_(0)
+    , droppedCount_(0)
+    , bufferCount_(0)
+    , writing_(false)
+    , savedCount_(0)
+    , failedCount_(0)
+    , stopping_(false) {
+    worker_ = std::thread(&FrameCapture::workerLoop, this);
+}
+
+FrameCapture::~FrameCapture() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void FrameCapture::requestScreenshot() {
+    screenshotRequested_ = true;
+}
+
+void FrameCapture::startSequence(int interval, int count) {
+    sequenceInterval_ = std::max(interval, 1);
+    sequenceRemaining_ = std::max(count, 0);
+    sequenceFrame_ = 0;
+    sequenceCaptured_ = 0;
+    ++sequenceNumber_;
+}
+
+void FrameCapture::stopSequence() {
+    sequenceInterval_ = 0;
+}
+
+bool FrameCapture::beginFrame() {
+    screenshotDue_ = screenshotRequested_;
+    sequenceDue_ = false;
+    if (sequenceInterval_ > 0) {
+        sequenceDue_ = sequenceFrame_ % sequenceInterval_ == 0;
+        ++sequenceFrame_;
+    }
+    return screenshotDue_ || sequenceDue_;
+}
+
+void FrameCapture::capture(Renderer& renderer) {
+    if (!screenshotDue_ && !sequenceDue_) return;
+
+    // One read back serves a sequence frame and a screenshot due together; a
+    // screenshot without a buffer waits for the next frame, a sequence frame cannot
+    Job job;
+    if (!acquireBuffer(job.pixels)) {
+        droppedCount_ += sequenceDue_ ? 1 : 0;
+    } else if (renderer.readPixels(job.pixels, job.width, job.height)) {
+        if (sequenceDue_) {
+            std::ostringstream name;
+            name << directory_ << "/sequence-" << stamp_ << "-" << sequenceNumber_ << "-"
+                 << std::setw(5) << std::setfill('0') << sequenceCaptured_ << ".png";
+            Job copy;
+            bool both = screenshotDue_ && acquireBuffer(copy.pixels);
+            if (both) {
+                copy.pixels.assign(job.pixels.begin(), job.pixels.end());
+                copy.width = job.width;
+                copy.height = job.height;
+            }
+            job.path = name.str();
+            queue(std::move(job));
+            job = std::move(copy);
+            screenshotDue_ = both;
+
+            ++sequenceCaptured_;
+            if (sequenceRemaining_ > 0 && --sequenceRemaining_ == 0) {
+                stopSequence();
+            }
+        }
+        if (screenshotDue_) {
+            job.path = directory_ + "/screenshot-" + stamp_ + "-" + std::to_string(++screenshotNumber_) + ".png";
+            queue(std::move(job));
+            screenshotRequested_ = false;
+        }
+    } else {
+        // Reading back failed: give the buffer back and do not retry every frame
+        std::lock_guard<std::mutex> lock(mutex_);
+        freeBuffers_.push_back(std::move(job.pixels));
+        screenshotRequested_ = false;
+        droppedCount_ += sequenceDue_ ? 1 : 0;
+    }
+    screenshotDue_ = false;
+    sequenceDue_ = false;
+}
+
+void FrameCapture::waitUntilIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return jobs_.empty() && !writing_; });
+}
+
+int FrameCapture::getSavedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return savedCount_;
+}
+
+int FrameCapture::getFailedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failedCount_;
+}
+
+bool FrameCapture::acquireBuffer(std::vector<uint8_t>& buffer) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!freeBuffers_.empty()) {
+            buffer = std::move(freeBuffers_.back());
+            freeBuffers_.pop_back();
+            return true;
+        }
+    }
+    if (bufferCount_ >= Constants::CAPTURE_BUFFER_POOL) {
+        return false;
+    }
+    ++bufferCount_;  // Sized by the first read back
+    buffer.clear();
+    return true;
+}
+
+void FrameCapture::queue(Job job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back(std::move(job));
+    }
+    wake_.notify_one();
+}
+
+void FrameCapture::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+        if (jobs_.empty()) {
+            return;  // Stopping, and every frame is written
+        }
+        Job job = std::move(jobs_.front());
+        jobs_.pop_front();
+        writing_ = true;
+
+        // Encode without the lock, so the owner can queue more frames meanwhile
+        lock.unlock();
+        bool saved = encoder_(Image{job.pixels.data(), job.width, job.height}, job.path);
+        lock.lock();
+
+        savedCount_ += saved ? 1 : 0;
+        failedCount_ += saved ? 0 : 1;
+        freeBuffers_.push_back(std::move(job.pixels));
+        writing_ = false;
+        done_.notify_all();
+    }
+}
+
+bool FrameCapture::writePNG(const Image& image, const std::string& path) {
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormatFrom(const_cast<uint8_t*>(image.pixels), image.width,
+                                                              image.height, 32, image.width * 4,
+                                                              SDL_PIXELFORMAT_RGBA32);
+    if (!surface) {
+        std::cerr << "Failed to wrap captured frame: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    bool saved = IMG_SavePNG(surface, path.c_str()) == 0;
+    if (!saved) {
+        std::cerr << "Failed to save " << path << ": " << IMG_GetError() << std::endl;
+    }
+    SDL_FreeSurface(surface);
+    return saved;
+}
@@ -0,0 +1,114 @@
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "util/Constants.h"
+
+class Renderer;
+
+// Saves rendered frames as PNG files without stalling the game loop: a frame
+// is read back into a pooled pixel buffer on the owning (render) thread, and
+// a background thread encodes and writes it, then returns the buffer.
+//
+// Requests are a single screenshot or a sequence keeping every Nth frame. If
+// the worker falls behind and all CAPTURE_BUFFER_POOL buffers are in use, a
+// sequence frame is dropped (and counted) and a screenshot waits for the next
+// frame, so capturing never blocks drawing. Works with either Renderer backend.
+class FrameCapture {
+public:
+    // A captured frame: RGBA32 rows, width * 4 bytes each
+    struct Image {
+        const uint8_t* pixels;
+        int width;
+        int height;
+    };
+
+    // Writes an image to a path, true on success. Runs on the worker thread;
+    // the default encodes PNG with SDL_image.
+    using Encoder = std::function<bool(const Image&, const std::string&)>;
+
+    explicit FrameCapture(std::string directory = Constants::CAPTURE_DIRECTORY, Encoder encoder = nullptr);
+    ~FrameCapture();  // Writes the frames still queued
+
+    // Disable copy (owns a worker thread)
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    // Capture the next drawn frame
+    void requestScreenshot();
+
+    // Capture every interval-th frame from the next one on, count times
+    // (0: until stopped). Replaces a running sequence.
+    void startSequence(int interval, int count = 0);
+    void stopSequence();
+    [[nodiscard]] bool isSequenceActive() const { return sequenceInterval_ > 0; }
+
+    // Call once per game loop frame: true if this frame is to be captured
+    // (it must then be drawn and passed to capture() before presenting)
+    [[nodiscard]] bool beginFrame();
+
+    // Read back the frame drawn so far and queue it for writing
+    void capture(Renderer& renderer);
+
+    // Block until every queued frame is written
+    void waitUntilIdle();
+
+    [[nodiscard]] int getSavedCount() const;
+    [[nodiscard]] int getFailedCount() const;
+    [[nodiscard]] int getDroppedCount() const { return droppedCount_; }
+    [[nodiscard]] int getBufferCount() const { return bufferCount_; }  // Allocated by the pool
+    [[nodiscard]] const std::string& getDirectory() const { return directory_; }
+
+private:
+    struct Job {
+        std::vector<uint8_t> pixels;
+        int width;
+        int height;
+        std::string path;
+    };
+
+    void workerLoop();
+
+    // A free pixel buffer, or false when all pooled buffers are in use
+    [[nodiscard]] bool acquireBuffer(std::vector<uint8_t>& buffer);
+    void queue(Job job);
+
+    [[nodiscard]] static bool writePNG(const Image& image, const std::string& path);
+
+    // Owner thread state
+    std::string directory_;
+    Encoder encoder_;
+    std::string stamp_;        // Start time in file names, so runs do not overwrite each other
+    bool screenshotRequested_;
+    bool screenshotDue_;       // This frame
+    bool sequenceDue_;
+    int screenshotNumber_;
+    int sequenceNumber_;
+    int sequenceInterval_;     // 0: no sequence running
+    int sequenceRemaining_;    // Frames left to capture (0: until stopped)
+    int sequenceFrame_;        // Frames since the sequence started
+    int sequenceCaptured_;
+    int droppedCount_;
+    int bufferCount_;
+
+    // Shared with worker (guarded by mutex_)
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::deque<Job> jobs_;
+    std::vector<std::vector<uint8_t>> freeBuffers_;
+    bool writing_;
+    int savedCount_;
+    int failedCount_;
+    bool stopping_;
+    std::thread worker_;
+};
+
+#endif // FRAME_CAPTURE_H
@@ -1,7 +1,8 @@
 #include "system/Input.h"
 #include <cstring>
 
-Input::Input() : currentKeyState_(nullptr), quitRequested_(false) {
+Input::Input()
+    : currentKeyState_(nullptr), quitRequested_(false), renderTargetsReset_(false), activity_(false) {
     std::memset(previousKeyState_, 0, sizeof(previousKeyState_));
     currentKeyState_ = SDL_GetKeyboardState(nullptr);
 }
@@ -11,14 +12,25 @@ void Input::update() {
     std::memcpy(previousKeyState_, currentKeyState_, SDL_NUM_SCANCODES);
 
     // Process SDL events
+    renderTargetsReset_ = false;
+    activity_ = false;
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
+        // Mouse motion and the like show nothing: they must not force a redraw
         switch (event.type) {
             case SDL_QUIT:
                 quitRequested_ = true;
                 break;
+            case SDL_RENDER_TARGETS_RESET:
+            case SDL_RENDER_DEVICE_RESET:
+                renderTargetsReset_ = true;
+                activity_ = true;
+                break;
             case SDL_KEYDOWN:
                 // ESC no longer quits - handled by game for menu
+            case SDL_KEYUP:
+            case SDL_WINDOWEVENT:
+                activity_ = true;
                 break;
         }
     }
@@ -66,6 +78,18 @@ bool Input::isMenuPressed() const {
            isKeyJustPressed(SDL_SCANCODE_M);
 }
 
+bool Input::isProfilerTogglePressed() const {
+    return isKeyJustPressed(SDL_SCANCODE_F3);
+}
+
+bool Input::isCaptureSequencePressed() const {
+    return isKeyJustPressed(SDL_SCANCODE_F11);
+}
+
+bool Input::isScreenshotPressed() const {
+    return isKeyJustPressed(SDL_SCANCODE_F12);
+}
+
 bool Input::isMenuUpPressed() const {
     return isKeyJustPressed(SDL_SCANCODE_UP) || isKeyJustPressed(SDL_SCANCODE_W);
 }
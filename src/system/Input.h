@@ -14,6 +14,13 @@ public:
     // Check if quit was requested
     [[nodiscard]] bool isQuitRequested() const { return quitRequested_; }
 
+    // Check if render target contents were lost this frame (device reset)
+    [[nodiscard]] bool isRenderTargetsReset() const { return renderTargetsReset_; }
+
+    // Check if a key, window or render-reset event arrived this frame (the
+    // screen may need redrawing; other events are left to the frame key)
+    [[nodiscard]] bool hasActivity() const { return activity_; }
+
     // Get movement direction based on current key state
     [[nodiscard]] Direction getMovementDirection() const;
 
@@ -25,6 +32,9 @@ public:
     [[nodiscard]] bool isConfirmPressed() const;
     [[nodiscard]] bool isCancelPressed() const;
     [[nodiscard]] bool isMenuPressed() const;
+    [[nodiscard]] bool isProfilerTogglePressed() const;  // F3 (profiling builds only)
+    [[nodiscard]] bool isCaptureSequencePressed() const;  // F11
+    [[nodiscard]] bool isScreenshotPressed() const;       // F12
 
     // Menu navigation (just-pressed for single-step navigation)
     [[nodiscard]] bool isMenuUpPressed() const;
@@ -34,6 +44,8 @@ private:
     const Uint8* currentKeyState_;
     Uint8 previousKeyState_[SDL_NUM_SCANCODES];
     bool quitRequested_;
+    bool renderTargetsReset_;
+    bool activity_;
 };
 
 #endif // INPUT_H
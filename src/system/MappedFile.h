@@ -0,0 +1,35 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read-only memory mapping of a whole file (POSIX mmap)
+// Pages are loaded lazily by the OS, so data can be used in place without parsing.
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    // Disable copy (owns the mapping)
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // Map file into memory (closes any previous mapping)
+    [[nodiscard]] bool open(const std::string& path);
+    void close();
+
+    [[nodiscard]] bool isOpen() const { return data_ != nullptr; }
+    [[nodiscard]] const uint8_t* data() const { return data_; }
+    [[nodiscard]] size_t size() const { return size_; }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+};
+
+#endif // MAPPED_FILE_H
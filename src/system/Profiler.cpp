@@ -0,0 +1,99 @@
+#include "system/Profiler.h"
+#include <algorithm>
+
+const char* getProfileSectionName(ProfileSection section) {
+    switch (section) {
+        case ProfileSection::Input:        return "input";
+        case ProfileSection::Update:       return "update";
+        case ProfileSection::Render:       return "render";
+        case ProfileSection::RenderMap:    return " map";
+        case ProfileSection::RenderNPCs:   return " npcs";
+        case ProfileSection::RenderPlayer: return " player";
+        case ProfileSection::RenderUI:     return " ui";
+        case ProfileSection::Present:      return "present";
+        default:                           return "frame";
+    }
+}
+
+Profiler::Profiler()
+    : ring_()
+    , current_()
+    , frameStart_()
+    , timing_(false)
+    , history_(Constants::PROFILER_HISTORY_FRAMES)
+    , historyNext_(0)
+    , historySize_(0)
+    , droppedFrames_(0) {}
+
+void Profiler::beginFrame() {
+    Clock::time_point now = Clock::now();
+    if (timing_) {
+        current_.frame = static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(now - frameStart_).count());
+        pushSample(current_);
+    }
+    current_ = ProfileSample{};
+    frameStart_ = now;
+    timing_ = true;
+}
+
+void Profiler::add(ProfileSection section, uint32_t micros) {
+    current_.sections[static_cast<size_t>(section)] += micros;
+}
+
+void Profiler::pushSample(const ProfileSample& sample) {
+    if (!ring_.push(sample)) {
+        ++droppedFrames_;
+    }
+}
+
+void Profiler::collect() {
+    ProfileSample sample;
+    while (ring_.pop(sample)) {
+        history_[historyNext_] = sample;
+        historyNext_ = (historyNext_ + 1) % history_.size();
+        historySize_ = std::min(historySize_ + 1, history_.size());
+    }
+}
+
+Profiler::Stats Profiler::getStats(ProfileSection section) const {
+    return computeStats(getHistory(section));
+}
+
+Profiler::Stats Profiler::getFrameStats() const {
+    return computeStats(getHistory(ProfileSection::Count));
+}
+
+std::vector<uint32_t> Profiler::getFrameHistory() const {
+    return getHistory(ProfileSection::Count);
+}
+
+std::vector<uint32_t> Profiler::getHistory(ProfileSection section) const {
+    std::vector<uint32_t> values;
+    values.reserve(historySize_);
+    size_t first = (historyNext_ + history_.size() - historySize_) % history_.size();
+    for (size_t n = 0; n < historySize_; ++n) {
+        const ProfileSample& sample = history_[(first + n) % history_.size()];
+        values.push_back(section == ProfileSection::Count ? sample.frame
+                                                          : sample.sections[static_cast<size_t>(section)]);
+    }
+    return values;
+}
+
+Profiler::Stats Profiler::computeStats(std::vector<uint32_t> values) const {
+    Stats stats;
+    if (values.empty()) return stats;
+
+    uint64_t total = 0;
+    for (uint32_t value : values) {
+        total += value;
+    }
+    stats.min = *std::min_element(values.begin(), values.end());
+    stats.average = static_cast<uint32_t>(total / values.size());
+
+    // Nearest rank: the smallest value at least 99% of the frames do not exceed
+    size_t rank = (values.size() * 99 + 99) / 100 - 1;
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(rank), values.end());
+    stats.p99 = values[rank];
+    return stats;
+}
@@ -0,0 +1,129 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "system/SampleRing.h"
+#include "util/Constants.h"
+
+// Timed parts of a frame; the Render* stages are parts of Render
+enum class ProfileSection {
+    Input,
+    Update,
+    Render,
+    RenderMap,
+    RenderNPCs,
+    RenderPlayer,
+    RenderUI,
+    Present,
+    Count
+};
+
+constexpr size_t PROFILE_SECTION_COUNT = static_cast<size_t>(ProfileSection::Count);
+
+// Short name for the overlay ("map", "present", ...)
+[[nodiscard]] const char* getProfileSectionName(ProfileSection section);
+
+// Microseconds spent in each section during one frame
+struct ProfileSample {
+    std::array<uint32_t, PROFILE_SECTION_COUNT> sections{};
+    uint32_t frame = 0;  // Whole frame, waiting for vsync and sleeping included
+};
+
+// Frame-time profiler. Scoped timers (PROFILE_SCOPE) add to the sample of the
+// current frame; beginFrame() pushes it into a lock-free ring and collect()
+// drains the ring into a history of the last PROFILER_HISTORY_FRAMES frames,
+// which the statistics are computed over. The game pushes and collects on its
+// own thread; the ring would let a reader on another thread collect instead.
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Microseconds over the history
+    struct Stats {
+        uint32_t min = 0;
+        uint32_t average = 0;
+        uint32_t p99 = 0;
+    };
+
+    Profiler();
+
+    // Disable copy
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    // Finish the frame being timed (if any) and start the next one. Frames
+    // finding the ring full are dropped and counted.
+    void beginFrame();
+
+    // Add time to a section of the current frame (sections may run several times)
+    void add(ProfileSection section, uint32_t micros);
+
+    // Move finished frames from the ring into the history
+    void collect();
+
+    [[nodiscard]] Stats getStats(ProfileSection section) const;
+    [[nodiscard]] Stats getFrameStats() const;
+
+    // Whole-frame times in the history, oldest first
+    [[nodiscard]] std::vector<uint32_t> getFrameHistory() const;
+
+    [[nodiscard]] size_t getHistorySize() const { return historySize_; }
+    [[nodiscard]] uint64_t getDroppedFrames() const { return droppedFrames_; }
+
+    // Push a finished sample as beginFrame() does (for tests and replays)
+    void pushSample(const ProfileSample& sample);
+
+private:
+    // Statistics of one value per history frame
+    [[nodiscard]] Stats computeStats(std::vector<uint32_t> values) const;
+
+    // Value of a section (or the whole frame for Count) in each history frame
+    [[nodiscard]] std::vector<uint32_t> getHistory(ProfileSection section) const;
+
+    SampleRing<ProfileSample, Constants::PROFILER_RING_CAPACITY> ring_;
+    ProfileSample current_;
+    Clock::time_point frameStart_;
+    bool timing_;                          // A frame has begun
+
+    std::vector<ProfileSample> history_;  // Circular, PROFILER_HISTORY_FRAMES long
+    size_t historyNext_;                   // Slot the next collected frame goes to
+    size_t historySize_;
+    uint64_t droppedFrames_;
+};
+
+// Adds the time until the end of its scope to a profiler section
+class ProfileScope {
+public:
+    ProfileScope(Profiler& profiler, ProfileSection section)
+        : profiler_(profiler), section_(section), start_(Profiler::Clock::now()) {}
+
+    ~ProfileScope() {
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Profiler::Clock::now() - start_);
+        profiler_.add(section_, static_cast<uint32_t>(elapsed.count()));
+    }
+
+    // Disable copy
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    Profiler& profiler_;
+    ProfileSection section_;
+    Profiler::Clock::time_point start_;
+};
+
+// Time the rest of the enclosing scope. Without -DRPG_PROFILE this expands to
+// nothing and its arguments are not evaluated (the profiler need not exist).
+#ifdef RPG_PROFILE
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(profiler, section) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)((profiler), (section))
+#else
+#define PROFILE_SCOPE(profiler, section) ((void)0)
+#endif
+
+#endif // PROFILER_H
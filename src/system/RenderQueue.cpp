@@ -0,0 +1,64 @@
+#include "system/RenderQueue.h"
+#include <algorithm>
+
+namespace {
+    constexpr int LAYER_SHIFT = 56;
+    constexpr int DEPTH_SHIFT = 40;
+    constexpr int TEXTURE_SHIFT = 32;
+    constexpr uint64_t MAX_TEXTURE_INDEX = 254;
+    constexpr int DEPTH_BIAS = 32768;  // Depth is stored unsigned in 16 bits
+}
+
+RenderQueue::RenderQueue() : layer_(RenderLayer::Ground) {}
+
+void RenderQueue::addSprite(SDL_Texture* texture, const SDL_Rect& src, const SDL_Rect& dst, SDL_Color color) {
+    uint64_t depth = 0;
+    uint64_t index = 0;
+    if (layer_ == RenderLayer::Objects) {
+        // Lower on screen is nearer: draw by bottom edge
+        int bottom = std::clamp(dst.y + dst.h + DEPTH_BIAS, 0, 0xFFFF);
+        depth = static_cast<uint64_t>(bottom);
+    }
+    if (layer_ == RenderLayer::Ground || layer_ == RenderLayer::Objects) {
+        index = textureIndex(texture) + 1;  // 0: rectangles
+    }
+    add(Command{Command::Type::Sprite, color, texture, src, dst}, depth, index);
+}
+
+void RenderQueue::addRect(Command::Type type, const SDL_Rect& rect, SDL_Color color) {
+    add(Command{type, color, nullptr, SDL_Rect{0, 0, 0, 0}, rect}, 0, 0);
+}
+
+const std::vector<uint32_t>& RenderQueue::sort() {
+    std::sort(keys_.begin(), keys_.end());
+    order_.clear();
+    for (uint64_t key : keys_) {
+        order_.push_back(static_cast<uint32_t>(key));
+    }
+    return order_;
+}
+
+void RenderQueue::clear() {
+    commands_.clear();
+    keys_.clear();
+    order_.clear();
+    textures_.clear();
+    layer_ = RenderLayer::Ground;
+}
+
+uint64_t RenderQueue::textureIndex(SDL_Texture* texture) {
+    // A frame draws from a handful of textures; a linear scan beats hashing
+    auto it = std::find(textures_.begin(), textures_.end(), texture);
+    if (it != textures_.end()) {
+        return std::min(static_cast<uint64_t>(it - textures_.begin()), MAX_TEXTURE_INDEX);
+    }
+    textures_.push_back(texture);
+    return std::min(static_cast<uint64_t>(textures_.size() - 1), MAX_TEXTURE_INDEX);
+}
+
+void RenderQueue::add(const Command& command, uint64_t depth, uint64_t texture) {
+    uint64_t sequence = commands_.size();
+    keys_.push_back((static_cast<uint64_t>(layer_) << LAYER_SHIFT) | (depth << DEPTH_SHIFT) |
+                    (texture << TEXTURE_SHIFT) | sequence);
+    commands_.push_back(command);
+}
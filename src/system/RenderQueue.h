@@ -0,0 +1,74 @@
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include <SDL.h>
+#include <cstdint>
+#include <vector>
+
+// Draw layers, drawn bottom to top
+enum class RenderLayer : uint8_t {
+    Ground,   // Map tiles: no overlap, grouped by texture
+    Objects,  // Characters: sorted by their bottom edge (y-sort), then texture
+    Overlay,  // Fog and effects over the field, in recorded order
+    UI        // Windows and text, in recorded order
+};
+
+// One frame of recorded draw commands. Each command gets a 64-bit sort key:
+//
+//   layer (8) | depth (16, Objects only) | texture (8, Ground/Objects) | sequence (32)
+//
+// (rectangles sort before textures within Ground and Objects)
+// so sorting the keys yields the draw order: layers bottom to top, y-sorted
+// characters, as few texture switches as the layer allows, and recording
+// order where nothing else decides. Commands live in a per-frame arena that
+// keeps its capacity across frames; recording touches no SDL state, so a
+// queue can be filled away from the thread that submits it.
+class RenderQueue {
+public:
+    struct Command {
+        enum class Type : uint8_t {
+            Sprite,
+            FillRect,
+            DrawRect
+        };
+
+        Type type;
+        SDL_Color color;       // Sprite: color and alpha mod; rectangles: draw color
+        SDL_Texture* texture;  // Sprite only
+        SDL_Rect src;          // Sprite only
+        SDL_Rect dst;
+    };
+
+    RenderQueue();
+
+    // Layer for the commands recorded next
+    void setLayer(RenderLayer layer) { layer_ = layer; }
+    [[nodiscard]] RenderLayer getLayer() const { return layer_; }
+
+    void addSprite(SDL_Texture* texture, const SDL_Rect& src, const SDL_Rect& dst, SDL_Color color);
+    void addRect(Command::Type type, const SDL_Rect& rect, SDL_Color color);
+
+    // Command indices in draw order
+    [[nodiscard]] const std::vector<uint32_t>& sort();
+
+    [[nodiscard]] const Command& getCommand(uint32_t index) const { return commands_[index]; }
+    [[nodiscard]] int size() const { return static_cast<int>(commands_.size()); }
+    [[nodiscard]] bool empty() const { return commands_.empty(); }
+
+    // Start the next frame (keeps the arena's capacity; the layer returns to Ground)
+    void clear();
+
+private:
+    // Small per-frame number for a texture (the first 254 textures get their own)
+    [[nodiscard]] uint64_t textureIndex(SDL_Texture* texture);
+
+    void add(const Command& command, uint64_t depth, uint64_t texture);
+
+    RenderLayer layer_;
+    std::vector<Command> commands_;
+    std::vector<uint64_t> keys_;          // One per command; the sequence is the command index
+    std::vector<uint32_t> order_;
+    std::vector<SDL_Texture*> textures_;  // Index of each texture seen this frame
+};
+
+#endif // RENDER_QUEUE_H
@@ -1,20 +1,31 @@
 #include "system/Renderer.h"
 #include <iostream>
 
-Renderer::Renderer() : window_(nullptr), renderer_(nullptr) {}
+Renderer::Renderer()
+    : backend_(Backend::Window), window_(nullptr), surface_(nullptr), renderer_(nullptr), target_(nullptr)
+    , drawColor_{0, 0, 0, 255}, frameNumber_(0) {}
 
 Renderer::~Renderer() {
     if (renderer_) {
         SDL_DestroyRenderer(renderer_);
         renderer_ = nullptr;
     }
+    if (surface_) {
+        SDL_FreeSurface(surface_);
+        surface_ = nullptr;
+    }
     if (window_) {
         SDL_DestroyWindow(window_);
         window_ = nullptr;
     }
 }
 
-bool Renderer::init(const std::string& title, int width, int height) {
+bool Renderer::init(const std::string& title, int width, int height, Backend backend) {
+    backend_ = backend;
+    if (backend == Backend::Headless) {
+        return initHeadless(width, height);
+    }
+
     window_ = SDL_CreateWindow(
         title.c_str(),
         SDL_WINDOWPOS_CENTERED,
@@ -46,28 +57,202 @@ bool Renderer::init(const std::string& title, int width, int height) {
     return true;
 }
 
+bool Renderer::initHeadless(int width, int height) {
+    surface_ = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!surface_) {
+        std::cerr << "Failed to create headless surface: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    renderer_ = SDL_CreateSoftwareRenderer(surface_);
+    if (!renderer_) {
+        std::cerr << "Failed to create software renderer: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    // Same scaling as the window, so frames match what a window would show
+    SDL_RenderSetLogicalSize(renderer_, Constants::INTERNAL_WIDTH, Constants::INTERNAL_HEIGHT);
+
+    return true;
+}
+
 void Renderer::clear() {
+    // Clearing the screen starts a frame: anything recorded before it is covered
+    if (!target_) {
+        queue_.clear();
+    }
+    flush();
     SDL_RenderClear(renderer_);
 }
 
 void Renderer::present() {
+    submitQueue();
+    flush();
     SDL_RenderPresent(renderer_);
+    lastFrameStats_ = frameStats_;
+    frameStats_ = FrameStats{};
+    ++frameNumber_;
+}
+
+bool Renderer::readPixels(std::vector<uint8_t>& pixels, int& width, int& height) {
+    if (target_) {
+        std::cerr << "Cannot read back the screen while a render target is set" << std::endl;
+        return false;
+    }
+    submitQueue();
+    flush();
+
+    // The logical size fills the whole output (no letterbox), so the viewport is the output
+    if (SDL_GetRendererOutputSize(renderer_, &width, &height) != 0) {
+        std::cerr << "Failed to get renderer output size: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    pixels.resize(static_cast<size_t>(width) * height * 4);
+    if (SDL_RenderReadPixels(renderer_, nullptr, SDL_PIXELFORMAT_RGBA32, pixels.data(), width * 4) != 0) {
+        std::cerr << "Failed to read back the screen: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    return true;
 }
 
 void Renderer::setDrawColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    drawColor_ = SDL_Color{r, g, b, a};
     SDL_SetRenderDrawColor(renderer_, r, g, b, a);
 }
 
+SDL_Color Renderer::getDrawColor() const {
+    return drawColor_;
+}
+
 void Renderer::fillRect(int x, int y, int w, int h) {
     SDL_Rect rect = {x, y, w, h};
-    SDL_RenderFillRect(renderer_, &rect);
+    if (!target_) {
+        queue_.addRect(RenderQueue::Command::Type::FillRect, rect, drawColor_);
+        return;
+    }
+    drawRectNow(RenderQueue::Command::Type::FillRect, rect, drawColor_);
 }
 
 void Renderer::drawRect(int x, int y, int w, int h) {
     SDL_Rect rect = {x, y, w, h};
-    SDL_RenderDrawRect(renderer_, &rect);
+    if (!target_) {
+        queue_.addRect(RenderQueue::Command::Type::DrawRect, rect, drawColor_);
+        return;
+    }
+    drawRectNow(RenderQueue::Command::Type::DrawRect, rect, drawColor_);
 }
 
 void Renderer::drawTexture(SDL_Texture* texture, const SDL_Rect* src, const SDL_Rect* dst) {
-    SDL_RenderCopy(renderer_, texture, src, dst);
+    int textureWidth = 0;
+    int textureHeight = 0;
+    if (!texture || !dst || SDL_QueryTexture(texture, nullptr, nullptr, &textureWidth, &textureHeight) != 0) {
+        return;
+    }
+
+    // The color and alpha mod may change before the frame is submitted: take them now
+    SDL_Color color = {255, 255, 255, 255};
+    SDL_GetTextureColorMod(texture, &color.r, &color.g, &color.b);
+    SDL_GetTextureAlphaMod(texture, &color.a);
+
+    SDL_Rect source = src ? *src : SDL_Rect{0, 0, textureWidth, textureHeight};
+    if (!target_) {
+        queue_.addSprite(texture, source, *dst, color);
+        return;
+    }
+    drawSprite(texture, source, *dst, color);
+}
+
+void Renderer::drawSprite(SDL_Texture* texture, const SDL_Rect& src, const SDL_Rect& dst, SDL_Color color) {
+    int textureWidth = 0;
+    int textureHeight = 0;
+    SDL_QueryTexture(texture, nullptr, nullptr, &textureWidth, &textureHeight);
+    SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+    SDL_GetTextureBlendMode(texture, &blendMode);
+    if (!batch_.accepts(texture, blendMode)) {
+        flush();
+    }
+
+    // Geometry ignores the texture's color and alpha mod, so they are baked into the vertices
+    batch_.add(texture, blendMode, textureWidth, textureHeight, src, dst, color);
+    ++frameStats_.sprites;
+}
+
+void Renderer::drawRectNow(RenderQueue::Command::Type type, const SDL_Rect& rect, SDL_Color color) {
+    flush();
+    SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, color.a);
+    if (type == RenderQueue::Command::Type::FillRect) {
+        SDL_RenderFillRect(renderer_, &rect);
+    } else {
+        SDL_RenderDrawRect(renderer_, &rect);
+    }
+    SDL_SetRenderDrawColor(renderer_, drawColor_.r, drawColor_.g, drawColor_.b, drawColor_.a);
+    ++frameStats_.drawCalls;
+}
+
+void Renderer::submitQueue() {
+    frameStats_.commands += queue_.size();
+    for (uint32_t index : queue_.sort()) {
+        const RenderQueue::Command& command = queue_.getCommand(index);
+        if (command.type == RenderQueue::Command::Type::Sprite) {
+            drawSprite(command.texture, command.src, command.dst, command.color);
+        } else {
+            drawRectNow(command.type, command.dst, command.color);
+        }
+    }
+    queue_.clear();
+}
+
+void Renderer::flush() {
+    if (batch_.empty()) return;
+    if (SDL_RenderGeometry(renderer_, batch_.getTexture(), batch_.getVertices(), batch_.getVertexCount(),
+                           batch_.getIndices(), batch_.getIndexCount()) != 0) {
+        std::cerr << "Failed to draw sprite batch: " << SDL_GetError() << std::endl;
+    }
+    ++frameStats_.drawCalls;
+    frameStats_.vertices += batch_.getVertexCount();
+    batch_.clear();
+}
+
+bool Renderer::supportsRenderTargets() const {
+    return renderer_ && SDL_RenderTargetSupported(renderer_);
+}
+
+SDL_Texture* Renderer::createRenderTarget(int width, int height) {
+    SDL_Texture* texture = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_ARGB8888,
+                                             SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!texture) {
+        std::cerr << "Failed to create render target: " << SDL_GetError() << std::endl;
+        return nullptr;
+    }
+    // Keep transparent tile pixels see-through when the target is drawn
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    return texture;
+}
+
+bool Renderer::setRenderTarget(SDL_Texture* target) {
+    flush();
+    if (SDL_SetRenderTarget(renderer_, target) != 0) return false;
+    target_ = target;
+    return true;
+}
+
+SDL_Texture* Renderer::createStreamingTexture(int width, int height) {
+    SDL_Texture* texture = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_ARGB8888,
+                                             SDL_TEXTUREACCESS_STREAMING, width, height);
+    if (!texture) {
+        std::cerr << "Failed to create streaming texture: " << SDL_GetError() << std::endl;
+        return nullptr;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    return texture;
+}
+
+bool Renderer::updateTexture(SDL_Texture* texture, const void* pixels, int pitch) {
+    flush();  // Batched quads may still sample the old pixels
+    return SDL_UpdateTexture(texture, nullptr, pixels, pitch) == 0;
+}
+
+bool Renderer::updateTexture(SDL_Texture* texture, const SDL_Rect& rect, const void* pixels, int pitch) {
+    flush();
+    return SDL_UpdateTexture(texture, &rect, pixels, pitch) == 0;
 }
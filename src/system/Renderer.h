@@ -2,11 +2,41 @@
 #define RENDERER_H
 
 #include <SDL.h>
+#include <cstdint>
 #include <string>
+#include <vector>
+#include "system/RenderQueue.h"
+#include "system/SpriteBatch.h"
 #include "util/Constants.h"
 
+// Draws to a window (accelerated, vsynced) or, headless, to an offscreen
+// SDL_Surface through SDL's software renderer: no window, display or vsync
+// needed, so the render path runs in tests, benchmarks and on servers.
+//
+// Drawing to the screen only records commands into a RenderQueue, under the
+// current layer (see RenderLayer); present() sorts and submits them. Drawing
+// to a render target is immediate. Textures are read when the frame is
+// submitted, so a texture updated mid-frame shows its new pixels.
+//
+// Submitted textures are batched: consecutive quads sharing a texture and
+// blend mode go to the driver as one SDL_RenderGeometry call. Everything else
+// (rectangles, clears, target switches, texture updates) submits the pending
+// batch first, so output matches unbatched drawing.
 class Renderer {
 public:
+    enum class Backend {
+        Window,
+        Headless
+    };
+
+    // Driver work of one frame, for profiling
+    struct FrameStats {
+        int commands = 0;   // Commands recorded for the screen
+        int drawCalls = 0;  // Geometry submissions and rectangles
+        int vertices = 0;   // Vertices submitted by geometry calls
+        int sprites = 0;    // Quads drawn through the batch
+    };
+
     Renderer();
     ~Renderer();
 
@@ -14,21 +44,73 @@ public:
     Renderer(const Renderer&) = delete;
     Renderer& operator=(const Renderer&) = delete;
 
-    [[nodiscard]] bool init(const std::string& title, int width, int height);
+    // Width and height are the window (or headless surface) size in pixels
+    [[nodiscard]] bool init(const std::string& title, int width, int height,
+                            Backend backend = Backend::Window);
     void clear();
     void present();
 
     // Drawing functions
     void setDrawColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255);
+    [[nodiscard]] SDL_Color getDrawColor() const;
     void fillRect(int x, int y, int w, int h);
     void drawRect(int x, int y, int w, int h);  // Outline only
-    void drawTexture(SDL_Texture* texture, const SDL_Rect* src, const SDL_Rect* dst);
+    void drawTexture(SDL_Texture* texture, const SDL_Rect* src, const SDL_Rect* dst);  // src nullptr: whole texture
+
+    // Layer for screen drawing until the next present() (which returns to Ground)
+    void setLayer(RenderLayer layer) { queue_.setLayer(layer); }
+
+    // Submit batched quads now (drawing does this when needed)
+    void flush();
+
+    // Counters of the last presented frame
+    [[nodiscard]] const FrameStats& getFrameStats() const { return lastFrameStats_; }
+
+    // Frames presented so far (the frame being drawn has this number)
+    [[nodiscard]] uint64_t getFrameNumber() const { return frameNumber_; }
+
+    // Offscreen render targets (the caller owns created textures)
+    [[nodiscard]] bool supportsRenderTargets() const;
+    [[nodiscard]] SDL_Texture* createRenderTarget(int width, int height);
+    [[nodiscard]] bool setRenderTarget(SDL_Texture* target);  // nullptr renders to the screen
+
+    // CPU-written ARGB8888 textures, blended when drawn (the caller owns created textures)
+    [[nodiscard]] SDL_Texture* createStreamingTexture(int width, int height);
+    [[nodiscard]] bool updateTexture(SDL_Texture* texture, const void* pixels, int pitch);
+    [[nodiscard]] bool updateTexture(SDL_Texture* texture, const SDL_Rect& rect, const void* pixels, int pitch);
 
     [[nodiscard]] SDL_Renderer* getSDLRenderer() const { return renderer_; }
+    [[nodiscard]] Backend getBackend() const { return backend_; }
+
+    // Read the screen back as RGBA32 rows (width * 4 bytes each) at output
+    // resolution. Call after drawing and before present(): the recorded
+    // commands are submitted first. Reuses the capacity of pixels.
+    [[nodiscard]] bool readPixels(std::vector<uint8_t>& pixels, int& width, int& height);
+
+    // Headless frame pixels (ARGB8888, complete after present()); nullptr with a window
+    [[nodiscard]] const SDL_Surface* getSurface() const { return surface_; }
 
 private:
+    [[nodiscard]] bool initHeadless(int width, int height);
+
+    // Draw at once (render targets and queue submission)
+    void drawSprite(SDL_Texture* texture, const SDL_Rect& src, const SDL_Rect& dst, SDL_Color color);
+    void drawRectNow(RenderQueue::Command::Type type, const SDL_Rect& rect, SDL_Color color);
+
+    // Sort and draw the commands recorded for the screen
+    void submitQueue();
+
+    Backend backend_;
     SDL_Window* window_;
+    SDL_Surface* surface_;  // Headless target
     SDL_Renderer* renderer_;
+    SDL_Texture* target_;  // nullptr: the screen (drawing is recorded)
+    SDL_Color drawColor_;
+    RenderQueue queue_;
+    SpriteBatch batch_;
+    FrameStats frameStats_;      // Frame being drawn
+    FrameStats lastFrameStats_;  // Last presented frame
+    uint64_t frameNumber_;
 };
 
 #endif // RENDERER_H
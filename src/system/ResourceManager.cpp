@@ -1,7 +1,15 @@
 #include "system/ResourceManager.h"
+#include "system/AtlasPacker.h"
+#include "util/Constants.h"
+#include "util/PathUtil.h"
 #include <SDL_image.h>
+#include <algorithm>
 #include <iostream>
 
+namespace {
+    using SurfacePtr = AssetLoader::SurfacePtr;
+}
+
 ResourceManager::ResourceManager(SDL_Renderer* renderer) : renderer_(renderer) {}
 
 ResourceManager::~ResourceManager() {
@@ -10,9 +18,7 @@ ResourceManager::~ResourceManager() {
 
 SDL_Texture* ResourceManager::loadTexture(const std::string& path) {
     // Security: Validate path to prevent directory traversal attacks
-    if (path.find("..") != std::string::npos ||
-        path.find('/') == 0 ||
-        path.find('\\') != std::string::npos) {
+    if (!PathUtil::isSafeRelativePath(path)) {
         std::cerr << "Invalid texture path: path traversal not allowed" << std::endl;
         return nullptr;
     }
@@ -51,5 +57,245 @@ SDL_Texture* ResourceManager::getTexture(const std::string& path) const {
 }
 
 void ResourceManager::unloadAllTextures() {
+    atlasRegions_.clear();
+    atlasPages_.clear();
     textures_.clear();
+
+    // Decodes still running are dropped when they finish
+    for (auto& pending : pendingTextures_) {
+        pending.second->failed = true;
+    }
+    pendingTextures_.clear();
+    uploads_.clear();
+}
+
+TextureHandle ResourceManager::requestTexture(const std::string& path) {
+    auto state = std::make_shared<TextureHandle::State>();
+
+    // Security: Validate path to prevent directory traversal attacks
+    if (!PathUtil::isSafeRelativePath(path)) {
+        std::cerr << "Invalid texture path: path traversal not allowed" << std::endl;
+        state->failed = true;
+        return TextureHandle(state);
+    }
+
+    auto region = atlasRegions_.find(path);
+    if (region != atlasRegions_.end()) {
+        state->region = region->second;
+        return TextureHandle(state);
+    }
+    auto texture = textures_.find(path);
+    if (texture != textures_.end()) {
+        state->region.texture = texture->second.get();
+        SDL_QueryTexture(state->region.texture, nullptr, nullptr, &state->region.rect.w, &state->region.rect.h);
+        return TextureHandle(state);
+    }
+    auto pending = pendingTextures_.find(path);
+    if (pending != pendingTextures_.end()) {
+        return TextureHandle(pending->second);
+    }
+
+    pendingTextures_[path] = state;
+    if (!isQueuedForAtlas(path)) {
+        loader_.request(path);
+    }
+    return TextureHandle(state);
+}
+
+void ResourceManager::update(int maxUploads) {
+    collectDecoded();
+
+    for (int uploaded = 0; uploaded < maxUploads && !uploads_.empty(); ++uploaded) {
+        AssetLoader::Decoded decoded = std::move(uploads_.front());
+        uploads_.pop_front();
+        auto pending = pendingTextures_.find(decoded.path);
+        if (pending == pendingTextures_.end()) continue;
+        std::shared_ptr<TextureHandle::State> state = std::move(pending->second);
+        pendingTextures_.erase(pending);
+
+        // loadTexture() may have loaded it meanwhile; keep that texture
+        SDL_Texture* texture = getTexture(decoded.path);
+        if (!texture) {
+            texture = SDL_CreateTextureFromSurface(renderer_, decoded.surface.get());
+            if (!texture) {
+                std::cerr << "Failed to create texture - " << SDL_GetError() << std::endl;
+                state->failed = true;
+                continue;
+            }
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+            textures_[decoded.path] = std::unique_ptr<SDL_Texture, TextureDeleter>(texture);
+        }
+        state->region.texture = texture;
+        SDL_QueryTexture(texture, nullptr, nullptr, &state->region.rect.w, &state->region.rect.h);
+    }
+}
+
+int ResourceManager::getLoadingCount() const {
+    int count = 0;
+    for (const auto& pending : pendingTextures_) {
+        if (!isQueuedForAtlas(pending.first)) ++count;
+    }
+    for (const auto& path : atlasQueue_) {
+        if (PathUtil::isSafeRelativePath(path) && atlasImages_.count(path) == 0) ++count;
+    }
+    return count;
+}
+
+void ResourceManager::collectDecoded() {
+    std::vector<AssetLoader::Decoded> finished;
+    loader_.takeFinished(finished);
+    for (auto& decoded : finished) {
+        if (isQueuedForAtlas(decoded.path) && atlasImages_.count(decoded.path) == 0) {
+            atlasImages_[decoded.path] = std::move(decoded.surface);
+            continue;
+        }
+        auto pending = pendingTextures_.find(decoded.path);
+        if (pending == pendingTextures_.end()) continue;  // Unloaded meanwhile
+        if (!decoded.surface) {
+            failPending(decoded.path);
+            continue;
+        }
+        uploads_.push_back(std::move(decoded));
+    }
+}
+
+void ResourceManager::failPending(const std::string& path) {
+    auto pending = pendingTextures_.find(path);
+    if (pending != pendingTextures_.end()) {
+        pending->second->failed = true;
+        pendingTextures_.erase(pending);
+    }
+}
+
+bool ResourceManager::isQueuedForAtlas(const std::string& path) const {
+    return std::find(atlasQueue_.begin(), atlasQueue_.end(), path) != atlasQueue_.end();
+}
+
+void ResourceManager::addToAtlas(const std::string& path) {
+    if (atlasRegions_.count(path) > 0) return;
+    if (isQueuedForAtlas(path)) return;
+    atlasQueue_.push_back(path);
+    if (!PathUtil::isSafeRelativePath(path)) return;
+
+    // A requested texture's decode goes to the atlas instead: taken from the
+    // upload queue if finished, else routed there by collectDecoded()
+    auto decoded = std::find_if(uploads_.begin(), uploads_.end(),
+                                [&path](const AssetLoader::Decoded& upload) { return upload.path == path; });
+    if (decoded != uploads_.end()) {
+        atlasImages_[path] = std::move(decoded->surface);
+        uploads_.erase(decoded);
+        return;
+    }
+    if (pendingTextures_.count(path) == 0) {
+        loader_.request(path);
+    }
+}
+
+bool ResourceManager::buildAtlas() {
+    // Wait for the queued images still decoding
+    auto decoding = [this] {
+        return std::any_of(atlasQueue_.begin(), atlasQueue_.end(), [this](const std::string& path) {
+            return PathUtil::isSafeRelativePath(path) && atlasImages_.count(path) == 0;
+        });
+    };
+    collectDecoded();
+    while (decoding() && loader_.getPendingCount() > 0) {
+        loader_.waitForFinished();
+        collectDecoded();
+    }
+
+    bool ok = true;
+    std::vector<std::string> paths;
+    std::vector<SurfacePtr> images;
+    std::vector<Vec2> sizes;
+    for (const auto& path : atlasQueue_) {
+        if (!PathUtil::isSafeRelativePath(path)) {
+            std::cerr << "Invalid texture path: path traversal not allowed" << std::endl;
+            ok = false;
+            continue;
+        }
+        auto decoded = atlasImages_.find(path);
+        if (decoded == atlasImages_.end() || !decoded->second) {
+            ok = false;  // The decoder reported why
+            failPending(path);
+            continue;
+        }
+        sizes.push_back(Vec2{decoded->second->w, decoded->second->h});
+        paths.push_back(path);
+        images.push_back(std::move(decoded->second));
+    }
+    atlasQueue_.clear();
+    atlasImages_.clear();
+    if (images.empty()) return ok;
+
+    AtlasPacker packer(Constants::ATLAS_PAGE_SIZE, Constants::ATLAS_PAGE_SIZE, Constants::ATLAS_PADDING);
+    std::vector<AtlasPacker::Placement> placements = packer.pack(sizes);
+
+    // Pages are only as large as their contents; unused pixels stay transparent
+    std::vector<SurfacePtr> pages;
+    for (int page = 0; page < packer.getPageCount(); ++page) {
+        Vec2 used = packer.getUsedSize(page);
+        pages.emplace_back(SDL_CreateRGBSurfaceWithFormat(0, used.x, used.y, 32, SDL_PIXELFORMAT_ARGB8888));
+        if (!pages.back()) {
+            std::cerr << "Failed to create atlas page - " << SDL_GetError() << std::endl;
+            for (const auto& path : paths) {
+                failPending(path);
+            }
+            return false;
+        }
+    }
+    for (size_t i = 0; i < images.size(); ++i) {
+        const AtlasPacker::Placement& placement = placements[i];
+        if (placement.page < 0) continue;
+        SDL_Rect dst = {placement.x, placement.y, images[i]->w, images[i]->h};
+        SDL_BlitSurface(images[i].get(), nullptr, pages[static_cast<size_t>(placement.page)].get(), &dst);
+    }
+
+    size_t firstPage = atlasPages_.size();
+    for (const auto& page : pages) {
+        SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer_, page.get());
+        if (!texture) {
+            std::cerr << "Failed to create atlas texture - " << SDL_GetError() << std::endl;
+            for (const auto& path : paths) {
+                failPending(path);
+            }
+            return false;
+        }
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        atlasPages_.emplace_back(texture);
+    }
+    for (size_t i = 0; i < images.size(); ++i) {
+        const AtlasPacker::Placement& placement = placements[i];
+        if (placement.page < 0) {
+            std::cerr << "Image too large for the atlas, kept separate: " << paths[i] << std::endl;
+            if (pendingTextures_.count(paths[i]) > 0) {
+                loader_.request(paths[i]);  // Requested as a texture: load it as one
+            }
+            continue;
+        }
+        SDL_Texture* page = atlasPages_[firstPage + static_cast<size_t>(placement.page)].get();
+        TextureRegion region{page, SDL_Rect{placement.x, placement.y, images[i]->w, images[i]->h}};
+        atlasRegions_[paths[i]] = region;
+
+        auto pending = pendingTextures_.find(paths[i]);
+        if (pending != pendingTextures_.end()) {
+            pending->second->region = region;
+            pendingTextures_.erase(pending);
+        }
+    }
+    return ok;
+}
+
+TextureRegion ResourceManager::loadRegion(const std::string& path) {
+    auto it = atlasRegions_.find(path);
+    if (it != atlasRegions_.end()) {
+        return it->second;
+    }
+
+    TextureRegion region;
+    region.texture = loadTexture(path);
+    if (region.texture) {
+        SDL_QueryTexture(region.texture, nullptr, nullptr, &region.rect.w, &region.rect.h);
+    }
+    return region;
 }
@@ -2,10 +2,52 @@
 #define RESOURCE_MANAGER_H
 
 #include <SDL.h>
+#include <deque>
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <vector>
+#include "system/AssetLoader.h"
+#include "system/TextureRegion.h"
+#include "util/Constants.h"
 
+// A texture requested with ResourceManager::requestTexture. Pending until the
+// image is decoded in the background and uploaded by ResourceManager::update();
+// copies share the result.
+class TextureHandle {
+public:
+    TextureHandle() = default;
+
+    [[nodiscard]] bool isReady() const { return state_ && state_->region.texture != nullptr; }
+    [[nodiscard]] bool isFailed() const { return state_ && state_->failed; }
+    [[nodiscard]] bool isPending() const { return state_ && !isReady() && !state_->failed; }
+
+    // The image once ready (an empty region before); owned by the ResourceManager
+    [[nodiscard]] const TextureRegion& getRegion() const {
+        static const TextureRegion empty;
+        return state_ ? state_->region : empty;
+    }
+
+private:
+    friend class ResourceManager;
+
+    struct State {
+        TextureRegion region;
+        bool failed = false;
+    };
+
+    explicit TextureHandle(std::shared_ptr<State> state) : state_(std::move(state)) {}
+
+    std::shared_ptr<State> state_;
+};
+
+// Loads and owns textures. Images added to the atlas are packed into shared
+// ATLAS_PAGE_SIZE pages by buildAtlas(), so sprites from different sheets
+// batch into one draw call; loadRegion() finds an image wherever it lives.
+//
+// loadTexture() loads on the spot. requestTexture() and addToAtlas() decode
+// on AssetLoader threads instead, and update() uploads a bounded number of
+// decoded images per frame, so the window keeps drawing while assets load.
 class ResourceManager {
 public:
     explicit ResourceManager(SDL_Renderer* renderer);
@@ -18,9 +60,47 @@ public:
     // Texture management
     [[nodiscard]] SDL_Texture* loadTexture(const std::string& path);
     [[nodiscard]] SDL_Texture* getTexture(const std::string& path) const;
-    void unloadAllTextures();
+    void unloadAllTextures();  // Pending handles fail
+
+    // Start loading a texture in the background. Images already loaded or
+    // packed give a ready handle; images queued for the atlas become ready
+    // with buildAtlas().
+    [[nodiscard]] TextureHandle requestTexture(const std::string& path);
+
+    // Take decoded images and upload at most maxUploads of them (call once per frame)
+    void update(int maxUploads = Constants::ASSET_UPLOADS_PER_FRAME);
+
+    // Requested textures not ready yet plus atlas images still decoding
+    [[nodiscard]] int getLoadingCount() const;
+    [[nodiscard]] bool isLoading() const { return getLoadingCount() > 0; }
+
+    // Queue an image for the next buildAtlas() and start decoding it (call at
+    // load time, before loadRegion). A decode already started by
+    // requestTexture() is reused.
+    void addToAtlas(const std::string& path);
+
+    // Pack queued images into new atlas pages (waits for images still
+    // decoding); images that cannot be packed stay separate textures. False
+    // if an image failed to load.
+    [[nodiscard]] bool buildAtlas();
+
+    // Image as packed in the atlas, or a whole texture of its own
+    [[nodiscard]] TextureRegion loadRegion(const std::string& path);
+
+    [[nodiscard]] int getAtlasPageCount() const { return static_cast<int>(atlasPages_.size()); }
+
+    // Images sent to the decoder so far
+    [[nodiscard]] int getDecodeCount() const { return loader_.getRequestCount(); }
 
 private:
+    // Move finished decodes to the atlas images or the upload queue
+    void collectDecoded();
+
+    // Give up on a requested texture (its handle reports failure)
+    void failPending(const std::string& path);
+
+    [[nodiscard]] bool isQueuedForAtlas(const std::string& path) const;
+
     // Non-owning pointer - renderer must outlive this ResourceManager
     SDL_Renderer* renderer_;
 
@@ -34,6 +114,15 @@ private:
     };
 
     std::unordered_map<std::string, std::unique_ptr<SDL_Texture, TextureDeleter>> textures_;
+
+    std::vector<std::string> atlasQueue_;
+    std::vector<std::unique_ptr<SDL_Texture, TextureDeleter>> atlasPages_;
+    std::unordered_map<std::string, TextureRegion> atlasRegions_;
+
+    AssetLoader loader_;
+    std::unordered_map<std::string, std::shared_ptr<TextureHandle::State>> pendingTextures_;
+    std::deque<AssetLoader::Decoded> uploads_;                               // Decoded, not uploaded yet
+    std::unordered_map<std::string, AssetLoader::SurfacePtr> atlasImages_;  // Decoded for the next buildAtlas()
 };
 
 #endif // RESOURCE_MANAGER_H
@@ -0,0 +1,54 @@
+#ifndef SAMPLE_RING_H
+#define SAMPLE_RING_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Fixed-capacity queue for one producer and one consumer thread, without
+// locks: each index is written by one side only. Capacity is a power of two
+// so indices wrap with a mask; pushing into a full ring fails instead of
+// waiting, so the producer never stalls on a slow consumer.
+template <typename T, size_t Capacity>
+class SampleRing {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+    SampleRing() : slots_(), head_(0), tail_(0) {}
+
+    // Disable copy
+    SampleRing(const SampleRing&) = delete;
+    SampleRing& operator=(const SampleRing&) = delete;
+
+    // Producer side: false if the ring is full (value dropped)
+    [[nodiscard]] bool push(const T& value) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == Capacity) return false;
+        slots_[head & (Capacity - 1)] = value;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: false if the ring is empty
+    [[nodiscard]] bool pop(T& value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire)) return false;
+        value = slots_[tail & (Capacity - 1)];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Values waiting (exact only when neither side is busy)
+    [[nodiscard]] size_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] static constexpr size_t capacity() { return Capacity; }
+
+private:
+    std::array<T, Capacity> slots_;
+    alignas(64) std::atomic<size_t> head_;  // Next slot to write; own cache line per side
+    alignas(64) std::atomic<size_t> tail_;  // Next slot to read
+};
+
+#endif // SAMPLE_RING_H
@@ -0,0 +1,33 @@
+#include "system/SpriteBatch.h"
+
+void SpriteBatch::add(SDL_Texture* texture, SDL_BlendMode blendMode, int textureWidth, int textureHeight,
+                      const SDL_Rect& src, const SDL_Rect& dst, SDL_Color color) {
+    texture_ = texture;
+    blendMode_ = blendMode;
+
+    float left = static_cast<float>(dst.x);
+    float top = static_cast<float>(dst.y);
+    float right = static_cast<float>(dst.x + dst.w);
+    float bottom = static_cast<float>(dst.y + dst.h);
+    float u0 = static_cast<float>(src.x) / textureWidth;
+    float v0 = static_cast<float>(src.y) / textureHeight;
+    float u1 = static_cast<float>(src.x + src.w) / textureWidth;
+    float v1 = static_cast<float>(src.y + src.h) / textureHeight;
+
+    int first = static_cast<int>(vertices_.size());
+    vertices_.push_back(SDL_Vertex{SDL_FPoint{left, top}, color, SDL_FPoint{u0, v0}});
+    vertices_.push_back(SDL_Vertex{SDL_FPoint{right, top}, color, SDL_FPoint{u1, v0}});
+    vertices_.push_back(SDL_Vertex{SDL_FPoint{right, bottom}, color, SDL_FPoint{u1, v1}});
+    vertices_.push_back(SDL_Vertex{SDL_FPoint{left, bottom}, color, SDL_FPoint{u0, v1}});
+
+    const int corners[6] = {0, 1, 2, 0, 2, 3};
+    for (int corner : corners) {
+        indices_.push_back(first + corner);
+    }
+}
+
+void SpriteBatch::clear() {
+    vertices_.clear();
+    indices_.clear();
+    texture_ = nullptr;
+}
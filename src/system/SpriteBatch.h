@@ -0,0 +1,44 @@
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include <SDL.h>
+#include <vector>
+
+// Textured quads waiting to be drawn with one SDL_RenderGeometry call: two
+// triangles per quad, texture coordinates normalized to the texture size and
+// the texture's color mod baked into the vertex colors. All quads in a batch
+// share one texture and blend mode; Renderer submits the batch when either
+// changes (so draw order is kept) and before anything it does not batch.
+class SpriteBatch {
+public:
+    SpriteBatch() : texture_(nullptr), blendMode_(SDL_BLENDMODE_NONE) {}
+
+    // True if a quad with this texture and blend mode can join the batch
+    [[nodiscard]] bool accepts(SDL_Texture* texture, SDL_BlendMode blendMode) const {
+        return vertices_.empty() || (texture == texture_ && blendMode == blendMode_);
+    }
+
+    // Add a quad copying src (pixels of a textureWidth x textureHeight texture) to dst
+    void add(SDL_Texture* texture, SDL_BlendMode blendMode, int textureWidth, int textureHeight,
+             const SDL_Rect& src, const SDL_Rect& dst, SDL_Color color);
+
+    // Drop all quads, keeping the allocated arrays
+    void clear();
+
+    [[nodiscard]] bool empty() const { return vertices_.empty(); }
+    [[nodiscard]] SDL_Texture* getTexture() const { return texture_; }
+    [[nodiscard]] SDL_BlendMode getBlendMode() const { return blendMode_; }
+    [[nodiscard]] int getQuadCount() const { return static_cast<int>(vertices_.size() / 4); }
+    [[nodiscard]] int getVertexCount() const { return static_cast<int>(vertices_.size()); }
+    [[nodiscard]] int getIndexCount() const { return static_cast<int>(indices_.size()); }
+    [[nodiscard]] const SDL_Vertex* getVertices() const { return vertices_.data(); }
+    [[nodiscard]] const int* getIndices() const { return indices_.data(); }
+
+private:
+    SDL_Texture* texture_;
+    SDL_BlendMode blendMode_;
+    std::vector<SDL_Vertex> vertices_;  // Four per quad: top left, top right, bottom right, bottom left
+    std::vector<int> indices_;          // Six per quad
+};
+
+#endif // SPRITE_BATCH_H
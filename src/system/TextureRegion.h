@@ -0,0 +1,17 @@
+#ifndef TEXTURE_REGION_H
+#define TEXTURE_REGION_H
+
+#include <SDL.h>
+
+// An image as drawn: a whole texture, or the rectangle an atlas packed it into.
+// Source rects in image pixels become texture rects with toTexture().
+struct TextureRegion {
+    SDL_Texture* texture = nullptr;  // Non-owning - lifetime managed by ResourceManager
+    SDL_Rect rect = {0, 0, 0, 0};
+
+    [[nodiscard]] SDL_Rect toTexture(const SDL_Rect& imageRect) const {
+        return SDL_Rect{rect.x + imageRect.x, rect.y + imageRect.y, imageRect.w, imageRect.h};
+    }
+};
+
+#endif // TEXTURE_REGION_H
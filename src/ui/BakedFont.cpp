@@ -0,0 +1,86 @@
+#include "ui/BakedFont.h"
+#include "util/PathUtil.h"
+#include <cstring>
+#include <iostream>
+
+BakedFont::BakedFont() : file_(), header_(), atlasPath_() {}
+
+bool BakedFont::open(const std::string& path) {
+    // Security: Validate path to prevent directory traversal attacks
+    if (!PathUtil::isSafeRelativePath(path)) {
+        std::cerr << "Invalid font path: path traversal not allowed" << std::endl;
+        return false;
+    }
+
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "Failed to open baked font " << path << std::endl;
+        return false;
+    }
+    FontFormat::RFntHeader header;
+    if (!FontFormat::readHeader(file.data(), file.size(), header) ||
+        !FontFormat::validateTables(file.data(), header)) {
+        return false;
+    }
+
+    // The atlas must sit in the same directory
+    std::string name(reinterpret_cast<const char*>(file.data() + header.nameOffset), header.nameLength);
+    if (!PathUtil::isSafeRelativePath(name) || name.find('/') != std::string::npos) {
+        std::cerr << "Invalid atlas name in baked font" << std::endl;
+        return false;
+    }
+    size_t slash = path.find_last_of('/');
+    atlasPath_ = slash == std::string::npos ? name : path.substr(0, slash + 1) + name;
+
+    file_ = std::move(file);
+    header_ = header;
+    return true;
+}
+
+bool BakedFont::find(char32_t codePoint, Glyph& out) const {
+    if (!file_.isOpen()) return false;
+    const uint8_t* table = file_.data() + header_.glyphOffset;
+
+    uint32_t low = 0;
+    uint32_t high = header_.glyphCount;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        FontFormat::RFntGlyph glyph;
+        std::memcpy(&glyph, table + mid * sizeof(glyph), sizeof(glyph));
+        if (glyph.codePoint == codePoint) {
+            out.src = SDL_Rect{glyph.x, glyph.y, glyph.width, glyph.height};
+            out.bearingX = glyph.bearingX;
+            out.bearingY = glyph.bearingY;
+            out.advance = glyph.advance;
+            return true;
+        }
+        if (glyph.codePoint < codePoint) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return false;
+}
+
+int BakedFont::getKerning(char32_t left, char32_t right) const {
+    if (!file_.isOpen() || header_.kerningCount == 0) return 0;
+    const uint8_t* table = file_.data() + header_.kerningOffset;
+
+    uint32_t low = 0;
+    uint32_t high = header_.kerningCount;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        FontFormat::RFntKerning pair;
+        std::memcpy(&pair, table + mid * sizeof(pair), sizeof(pair));
+        if (pair.left == left && pair.right == right) {
+            return pair.adjust;
+        }
+        if (pair.left < left || (pair.left == left && pair.right < right)) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,48 @@
+#ifndef BAKED_FONT_H
+#define BAKED_FONT_H
+
+#include <SDL.h>
+#include <string>
+#include "system/MappedFile.h"
+#include "ui/FontFormat.h"
+
+// Glyph metrics of a baked font (.rfnt, see FontFormat). The file is
+// memory-mapped and validated once; glyphs and kerning pairs are found by
+// binary search in place. The atlas image is loaded by the caller.
+class BakedFont {
+public:
+    // Where a glyph is drawn from and how it moves the pen
+    struct Glyph {
+        SDL_Rect src;   // In the atlas image (empty for blank glyphs)
+        int bearingX;   // Offset of src from the pen position at the line top
+        int bearingY;
+        int advance;
+    };
+
+    BakedFont();
+
+    [[nodiscard]] bool open(const std::string& path);
+    [[nodiscard]] bool isOpen() const { return file_.isOpen(); }
+
+    // Glyph of a code point, false if the font lacks it
+    [[nodiscard]] bool find(char32_t codePoint, Glyph& out) const;
+
+    // Advance adjustment between two code points (0 if the pair is not kerned)
+    [[nodiscard]] int getKerning(char32_t left, char32_t right) const;
+
+    [[nodiscard]] int getLineHeight() const { return header_.lineHeight; }
+    [[nodiscard]] int getGlyphCount() const { return static_cast<int>(header_.glyphCount); }
+    [[nodiscard]] int getKerningCount() const { return static_cast<int>(header_.kerningCount); }
+
+    // Atlas image path (next to the .rfnt) and the size glyph rects lie within
+    [[nodiscard]] const std::string& getAtlasPath() const { return atlasPath_; }
+    [[nodiscard]] int getAtlasWidth() const { return header_.atlasWidth; }
+    [[nodiscard]] int getAtlasHeight() const { return header_.atlasHeight; }
+
+private:
+    MappedFile file_;
+    FontFormat::RFntHeader header_;
+    std::string atlasPath_;
+};
+
+#endif // BAKED_FONT_H
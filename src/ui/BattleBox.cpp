@@ -1,7 +1,17 @@
 #include "ui/BattleBox.h"
+#include "ui/TextLayout.h"
 #include "ui/TextRenderer.h"
 #include "system/Renderer.h"
 #include "battle/BattleState.h"
+#include <cstdio>
+#include <string_view>
+
+namespace {
+    // Shared by the format helpers and the per-frame drawing, which formats
+    // into stack buffers instead of allocating strings
+    constexpr const char* HP_FORMAT = "HP: %d/%d";
+    constexpr const char* AFFINITY_FORMAT = "Affinity: %d/%d";
+}
 
 BattleBox::BattleBox() {}
 
@@ -151,11 +161,15 @@ bool BattleBox::isConversationBoxVisible(const BattleState& state) const {
 }
 
 std::string BattleBox::formatHPText(int currentHP, int maxHP) {
-    return "HP: " + std::to_string(currentHP) + "/" + std::to_string(maxHP);
+    char text[32];
+    std::snprintf(text, sizeof(text), HP_FORMAT, currentHP, maxHP);
+    return text;
 }
 
 std::string BattleBox::formatAffinityText(int affinity, int threshold) {
-    return "Affinity: " + std::to_string(affinity) + "/" + std::to_string(threshold);
+    char text[40];
+    std::snprintf(text, sizeof(text), AFFINITY_FORMAT, affinity, threshold);
+    return text;
 }
 
 SDL_Color BattleBox::getBackgroundColor() {
@@ -220,25 +234,21 @@ void BattleBox::drawMessageBox(Renderer& renderer, const TextRenderer& textRende
     SDL_Rect rect = getMessageBoxRect();
     drawBox(renderer, rect);
 
-    // Draw message text (handle multi-line)
-    const std::string& msg = state.getMessage();
+    // Messages change only between phases: wrap each one once and draw its lines
+    std::string_view msg = state.getMessage();
+    if (msg != wrappedMessage_) {
+        wrappedMessage_.assign(msg.data(), msg.size());
+        int width = Constants::BATTLE_MESSAGE_BOX_WIDTH - Constants::DIALOGUE_PADDING * 2;
+        messageLines_ = TextLayout::wrap(msg, width, [&textRenderer](char32_t previous, char32_t c) {
+            return textRenderer.getAdvance(previous, c);
+        });
+    }
+
     int x = Constants::BATTLE_MESSAGE_BOX_X + Constants::DIALOGUE_PADDING;
     int y = Constants::BATTLE_MESSAGE_BOX_Y + Constants::DIALOGUE_PADDING;
-
-    // Simple line splitting on '\n'
-    size_t start = 0;
-    size_t end;
-    int lineNum = 0;
-    while ((end = msg.find('\n', start)) != std::string::npos) {
-        std::string line = msg.substr(start, end - start);
-        textRenderer.renderText(renderer, line, x, y + lineNum * Constants::DIALOGUE_LINE_HEIGHT);
-        start = end + 1;
-        lineNum++;
-    }
-    // Last line (or only line)
-    if (start < msg.size()) {
-        std::string line = msg.substr(start);
-        textRenderer.renderText(renderer, line, x, y + lineNum * Constants::DIALOGUE_LINE_HEIGHT);
+    for (size_t i = 0; i < messageLines_.size(); ++i) {
+        int lineY = y + static_cast<int>(i) * Constants::DIALOGUE_LINE_HEIGHT;
+        textRenderer.renderText(renderer, messageLines_[i], x, lineY);
     }
 }
 
@@ -248,7 +258,8 @@ void BattleBox::drawStatusBox(Renderer& renderer, const TextRenderer& textRender
     drawBox(renderer, rect);
 
     // Draw HP display
-    std::string hpText = formatHPText(state.getPlayerHP(), state.getPlayerMaxHP());
+    char hpText[32];
+    std::snprintf(hpText, sizeof(hpText), HP_FORMAT, state.getPlayerHP(), state.getPlayerMaxHP());
     Vec2 textPos = getHPDisplayPosition();
     textRenderer.renderText(renderer, hpText, textPos.x, textPos.y);
 }
@@ -296,9 +307,9 @@ void BattleBox::drawAffinityBar(Renderer& renderer, const TextRenderer& textRend
 
     // Draw heart symbols based on affinity level
     int hearts = (affinity * 5) / (threshold > 0 ? threshold : 100);
-    std::string heartStr;
+    char heartStr[6] = {};
     for (int i = 0; i < 5; ++i) {
-        heartStr += (i < hearts) ? "*" : ".";
+        heartStr[i] = (i < hearts) ? '*' : '.';
     }
     int textX = rect.x + 4;
     int textY = rect.y + 4;
@@ -320,8 +331,10 @@ void BattleBox::drawConversationBox(Renderer& renderer, const TextRenderer& text
 
     // Draw Japanese translation below
     int transY = promptY + Constants::DIALOGUE_LINE_HEIGHT;
-    std::string translation = "(" + topic->promptJapanese + ")";
-    textRenderer.renderText(renderer, translation, promptX, transY);
+    scratch_.assign("(");
+    scratch_.append(topic->promptJapanese);
+    scratch_.append(")");
+    textRenderer.renderText(renderer, scratch_, promptX, transY);
 
     // Draw choices
     size_t choiceCount = topic->getChoiceCount();
@@ -332,9 +345,11 @@ void BattleBox::drawConversationBox(Renderer& renderer, const TextRenderer& text
         Vec2 textPos = getChoiceTextPosition(static_cast<int>(i));
 
         // Format: "Esperanto (Japanese)"
-        std::string choiceText = choice->esperanto;
+        std::string_view choiceText = choice->esperanto;
         if (choiceText.length() > 20) {
-            choiceText = choiceText.substr(0, 17) + "...";
+            scratch_.assign(choiceText.substr(0, 17));
+            scratch_.append("...");
+            choiceText = scratch_;
         }
         textRenderer.renderText(renderer, choiceText, textPos.x, textPos.y);
     }
@@ -3,6 +3,7 @@
 
 #include <SDL.h>
 #include <string>
+#include <vector>
 #include "util/Constants.h"
 #include "util/Vec2.h"
 
@@ -71,6 +72,10 @@ private:
 
     // Draw box with border
     void drawBox(Renderer& renderer, const SDL_Rect& rect) const;
+
+    mutable std::string scratch_;  // Reused for composed text, so drawing does not allocate
+    mutable std::string wrappedMessage_;             // Message messageLines_ was wrapped from
+    mutable std::vector<std::string> messageLines_;
 };
 
 #endif // BATTLE_BOX_H
@@ -1,7 +1,9 @@
 #include "ui/DialogueBox.h"
 #include "ui/DialogueState.h"
+#include "ui/TextLayout.h"
 #include "ui/TextRenderer.h"
 #include "system/Renderer.h"
+#include <algorithm>
 
 DialogueBox::DialogueBox()
     : x_(Constants::DIALOGUE_BOX_X)
@@ -28,6 +30,32 @@ void DialogueBox::render(Renderer& renderer, const TextRenderer& textRenderer,
     }
 }
 
+std::vector<std::string> DialogueBox::layoutPages(const TextRenderer& textRenderer,
+                                                  const std::vector<std::string>& script) const {
+    TextLayout::Advance advance = [&textRenderer](char32_t previous, char32_t c) {
+        return textRenderer.getAdvance(previous, c);
+    };
+    int lines = getLinesPerPage(textRenderer);
+
+    std::vector<std::string> pages;
+    for (const auto& text : script) {
+        for (auto& page : TextLayout::paginate(text, getTextWidth(), lines, advance)) {
+            pages.push_back(std::move(page));
+        }
+    }
+    return pages;
+}
+
+int DialogueBox::getTextWidth() const {
+    return width_ - padding_ * 2 - Constants::FONT_CHAR_WIDTH;
+}
+
+int DialogueBox::getLinesPerPage(const TextRenderer& textRenderer) const {
+    // The last line needs no gap below it
+    int gap = Constants::DIALOGUE_LINE_HEIGHT - Constants::FONT_CHAR_HEIGHT;
+    return std::max(1, (height_ - padding_ * 2 + gap) / textRenderer.getLineAdvance());
+}
+
 void DialogueBox::drawBox(Renderer& renderer) const {
     // Draw dark background
     renderer.setDrawColor(0, 0, 64, 230);
@@ -1,6 +1,8 @@
 #ifndef DIALOGUE_BOX_H
 #define DIALOGUE_BOX_H
 
+#include <string>
+#include <vector>
 #include "util/Constants.h"
 
 class Renderer;
@@ -16,6 +18,16 @@ public:
     void render(Renderer& renderer, const TextRenderer& textRenderer,
                 const DialogueState& state) const;
 
+    // Break script pages into pages that fit the box, wrapped with the
+    // renderer's font. Run once when the script is loaded; render() draws
+    // the pages as they are.
+    [[nodiscard]] std::vector<std::string> layoutPages(const TextRenderer& textRenderer,
+                                                       const std::vector<std::string>& script) const;
+
+    // Text area (the right column is left to the continue indicator)
+    [[nodiscard]] int getTextWidth() const;
+    [[nodiscard]] int getLinesPerPage(const TextRenderer& textRenderer) const;
+
 private:
     // Draw box background and border
     void drawBox(Renderer& renderer) const;
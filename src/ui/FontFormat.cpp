@@ -0,0 +1,126 @@
+#include "ui/FontFormat.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace FontFormat {
+
+namespace {
+    // Check [offset, offset + length) lies inside a file of fileSize bytes
+    bool inRange(uint64_t offset, uint64_t length, uint64_t fileSize) {
+        return offset <= fileSize && length <= fileSize - offset;
+    }
+
+    bool glyphLess(const RFntGlyph& a, const RFntGlyph& b) {
+        return a.codePoint < b.codePoint;
+    }
+
+    bool kerningLess(const RFntKerning& a, const RFntKerning& b) {
+        return a.left != b.left ? a.left < b.left : a.right < b.right;
+    }
+}
+
+bool readHeader(const uint8_t* data, uint64_t fileSize, RFntHeader& out) {
+    RFntHeader header;
+    if (fileSize < sizeof(header)) {
+        std::cerr << "Baked font file is truncated" << std::endl;
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        header.version != VERSION || header.headerSize != sizeof(RFntHeader)) {
+        std::cerr << "Unsupported baked font format" << std::endl;
+        return false;
+    }
+    if (header.lineHeight == 0 || header.atlasWidth == 0 || header.atlasHeight == 0 ||
+        header.atlasWidth > MAX_ATLAS_SIZE || header.atlasHeight > MAX_ATLAS_SIZE) {
+        std::cerr << "Baked font sizes out of range" << std::endl;
+        return false;
+    }
+    if (header.glyphCount == 0 || header.glyphCount > MAX_GLYPHS || header.kerningCount > MAX_KERNING ||
+        header.nameLength == 0 || header.nameLength > MAX_NAME_LENGTH ||
+        header.glyphOffset < sizeof(RFntHeader) || header.kerningOffset < sizeof(RFntHeader) ||
+        header.nameOffset < sizeof(RFntHeader) ||
+        !inRange(header.glyphOffset, static_cast<uint64_t>(header.glyphCount) * sizeof(RFntGlyph), fileSize) ||
+        !inRange(header.kerningOffset, static_cast<uint64_t>(header.kerningCount) * sizeof(RFntKerning), fileSize) ||
+        !inRange(header.nameOffset, header.nameLength, fileSize)) {
+        std::cerr << "Baked font sections out of range" << std::endl;
+        return false;
+    }
+
+    out = header;
+    return true;
+}
+
+bool validateTables(const uint8_t* data, const RFntHeader& header) {
+    RFntGlyph previous{};
+    for (uint32_t i = 0; i < header.glyphCount; ++i) {
+        RFntGlyph glyph;
+        std::memcpy(&glyph, data + header.glyphOffset + i * sizeof(glyph), sizeof(glyph));
+        if (glyph.codePoint > 0x10FFFF || (i > 0 && !glyphLess(previous, glyph)) ||
+            glyph.x + glyph.width > header.atlasWidth || glyph.y + glyph.height > header.atlasHeight) {
+            std::cerr << "Invalid glyph in baked font" << std::endl;
+            return false;
+        }
+        previous = glyph;
+    }
+
+    RFntKerning previousPair{};
+    for (uint32_t i = 0; i < header.kerningCount; ++i) {
+        RFntKerning pair;
+        std::memcpy(&pair, data + header.kerningOffset + i * sizeof(pair), sizeof(pair));
+        if ((i > 0 && !kerningLess(previousPair, pair)) ||
+            pair.adjust < -MAX_KERNING_ADJUST || pair.adjust > MAX_KERNING_ADJUST) {
+            std::cerr << "Invalid kerning pair in baked font" << std::endl;
+            return false;
+        }
+        previousPair = pair;
+    }
+    return true;
+}
+
+bool write(const std::string& path, int lineHeight, int atlasWidth, int atlasHeight,
+           std::vector<RFntGlyph> glyphs, std::vector<RFntKerning> kerning,
+           const std::string& atlasName) {
+    if (lineHeight <= 0 || atlasWidth <= 0 || atlasHeight <= 0 ||
+        atlasWidth > static_cast<int>(MAX_ATLAS_SIZE) || atlasHeight > static_cast<int>(MAX_ATLAS_SIZE) ||
+        glyphs.empty() || glyphs.size() > MAX_GLYPHS || kerning.size() > MAX_KERNING ||
+        atlasName.empty() || atlasName.size() > MAX_NAME_LENGTH) {
+        return false;
+    }
+    std::sort(glyphs.begin(), glyphs.end(), glyphLess);
+    std::sort(kerning.begin(), kerning.end(), kerningLess);
+
+    RFntHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.headerSize = sizeof(RFntHeader);
+    header.lineHeight = static_cast<uint16_t>(lineHeight);
+    header.atlasWidth = static_cast<uint16_t>(atlasWidth);
+    header.atlasHeight = static_cast<uint16_t>(atlasHeight);
+    header.glyphOffset = sizeof(RFntHeader);
+    header.glyphCount = static_cast<uint32_t>(glyphs.size());
+    header.kerningOffset = header.glyphOffset + header.glyphCount * static_cast<uint32_t>(sizeof(RFntGlyph));
+    header.kerningCount = static_cast<uint32_t>(kerning.size());
+    header.nameOffset = header.kerningOffset + header.kerningCount * static_cast<uint32_t>(sizeof(RFntKerning));
+    header.nameLength = static_cast<uint32_t>(atlasName.size());
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open baked font for writing" << std::endl;
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(glyphs.data()),
+               static_cast<std::streamsize>(glyphs.size() * sizeof(RFntGlyph)));
+    file.write(reinterpret_cast<const char*>(kerning.data()),
+               static_cast<std::streamsize>(kerning.size() * sizeof(RFntKerning)));
+    file.write(atlasName.data(), static_cast<std::streamsize>(atlasName.size()));
+
+    return file.good();
+}
+
+}  // namespace FontFormat
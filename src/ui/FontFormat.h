@@ -0,0 +1,83 @@
+#ifndef FONT_FORMAT_H
+#define FONT_FORMAT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Baked font format (.rfnt)
+//
+// Produced offline from bitmap font sources by the fontbake tool
+// (`make fonts`) and memory-mapped by BakedFont. Glyph rects point into one
+// atlas image stored next to the file, so loading needs no rasterizing or
+// measuring.
+//
+// Layout (host byte order, little-endian on all supported targets):
+//   RFntHeader
+//   glyphs         glyphCount * RFntGlyph, sorted by code point
+//   kerning        kerningCount * RFntKerning, sorted by (left, right)
+//   atlas name     file name of the atlas image, in the .rfnt's directory
+namespace FontFormat {
+    constexpr char MAGIC[4] = {'R', 'F', 'N', 'T'};
+    constexpr uint16_t VERSION = 1;
+
+    // Limits enforced when loading (guards against corrupted files)
+    constexpr uint32_t MAX_GLYPHS = 65536;
+    constexpr uint32_t MAX_KERNING = 65536;
+    constexpr uint32_t MAX_ATLAS_SIZE = 4096;
+    constexpr uint32_t MAX_NAME_LENGTH = 256;
+    constexpr int32_t MAX_KERNING_ADJUST = 64;
+
+    struct RFntHeader {
+        char magic[4];
+        uint16_t version;
+        uint16_t headerSize;        // sizeof(RFntHeader), for forward compatibility
+        uint16_t lineHeight;        // Pixels from one line's top to the next
+        uint16_t atlasWidth;
+        uint16_t atlasHeight;
+        uint16_t reserved;
+        uint32_t glyphOffset;
+        uint32_t glyphCount;
+        uint32_t kerningOffset;
+        uint32_t kerningCount;
+        uint32_t nameOffset;
+        uint32_t nameLength;
+    };
+
+    struct RFntGlyph {
+        uint32_t codePoint;
+        uint16_t x;                 // Rect in the atlas (0x0 for blank glyphs like space)
+        uint16_t y;
+        uint16_t width;
+        uint16_t height;
+        int16_t bearingX;           // Rect offset from the pen position at the line top
+        int16_t bearingY;
+        int16_t advance;            // Pen movement after the glyph
+        uint16_t reserved;
+    };
+
+    struct RFntKerning {
+        uint32_t left;              // Code points of the pair
+        uint32_t right;
+        int32_t adjust;             // Added to the left glyph's advance
+    };
+
+    static_assert(sizeof(RFntHeader) == 40, "RFntHeader layout must not change within a version");
+    static_assert(sizeof(RFntGlyph) == 20, "RFntGlyph layout must not change within a version");
+    static_assert(sizeof(RFntKerning) == 12, "RFntKerning layout must not change within a version");
+
+    // Read and validate the header of a file of fileSize bytes
+    // (magic, version, sizes, and that every section lies inside the file)
+    [[nodiscard]] bool readHeader(const uint8_t* data, uint64_t fileSize, RFntHeader& out);
+
+    // Check the glyph and kerning tables: sorted without duplicates, rects
+    // inside the atlas, valid code points
+    [[nodiscard]] bool validateTables(const uint8_t* data, const RFntHeader& header);
+
+    // Write a complete .rfnt file (tables are sorted here)
+    [[nodiscard]] bool write(const std::string& path, int lineHeight, int atlasWidth, int atlasHeight,
+                             std::vector<RFntGlyph> glyphs, std::vector<RFntKerning> kerning,
+                             const std::string& atlasName);
+}
+
+#endif // FONT_FORMAT_H
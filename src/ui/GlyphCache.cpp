@@ -0,0 +1,159 @@
+#include "ui/GlyphCache.h"
+#include "system/Renderer.h"
+#include "util/Utf8.h"
+#include <algorithm>
+
+namespace {
+    constexpr int CELLS_PER_ROW = Constants::GLYPH_PAGE_SIZE / Constants::GLYPH_CELL_SIZE;
+    constexpr int CELLS_PER_PAGE = CELLS_PER_ROW * CELLS_PER_ROW;
+}
+
+GlyphCache::GlyphCache(Rasterizer rasterizer, int maxPages)
+    : rasterizer_(std::move(rasterizer))
+    , maxPages_(std::max(maxPages, 1))
+    , usedCells_(0)
+    , colorMod_{255, 255, 255, 255}
+    , hits_(0)
+    , misses_(0)
+    , evictions_(0) {
+    // Returned glyph pointers stay valid while pages are added
+    cells_.reserve(static_cast<size_t>(maxPages_) * CELLS_PER_PAGE);
+}
+
+GlyphCache::~GlyphCache() {
+    for (SDL_Texture* page : pages_) {
+        SDL_DestroyTexture(page);
+    }
+}
+
+const GlyphCache::Glyph* GlyphCache::get(Renderer& renderer, char32_t codePoint) {
+    uint64_t frame = renderer.getFrameNumber();
+    auto it = index_.find(codePoint);
+    if (it != index_.end()) {
+        ++hits_;
+        Cell& cell = cells_[it->second];
+        cell.lastUsed = frame;
+        return &cell.glyph;
+    }
+
+    // Code points the font lacks share the replacement glyph
+    if (missing_.count(codePoint) != 0) {
+        return get(renderer, Utf8::REPLACEMENT);
+    }
+    bool found = rasterizer_ && rasterizer_(codePoint, bitmap_);
+    if (!found && codePoint != Utf8::REPLACEMENT) {
+        missing_.insert(codePoint);
+        return get(renderer, Utf8::REPLACEMENT);
+    }
+    if (!found) {
+        makeBox(bitmap_);
+    }
+    ++misses_;
+
+    int index = allocateCell(renderer);
+    if (index < 0) {
+        return nullptr;  // Every cell holds a glyph drawn this frame
+    }
+    Cell& cell = cells_[index];
+    if (cell.occupied) {
+        index_.erase(cell.codePoint);
+        ++evictions_;
+    }
+
+    // White with coverage as alpha, so color mods tint it
+    int width = std::min(bitmap_.width, Constants::GLYPH_CELL_SIZE);
+    int height = std::min(bitmap_.height, Constants::GLYPH_CELL_SIZE);
+    cell.glyph.src.w = width;
+    cell.glyph.src.h = height;
+    if (width > 0 && height > 0) {
+        upload_.resize(static_cast<size_t>(width) * height);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                uint32_t alpha = bitmap_.coverage[static_cast<size_t>(y) * bitmap_.width + x];
+                upload_[static_cast<size_t>(y) * width + x] = (alpha << 24) | 0x00FFFFFFu;
+            }
+        }
+        if (!renderer.updateTexture(cell.glyph.texture, cell.glyph.src, upload_.data(), width * 4)) {
+            cell.glyph.src.w = 0;  // Draws nothing rather than stale pixels
+        }
+    }
+    cell.codePoint = codePoint;
+    cell.lastUsed = frame;
+    cell.occupied = true;
+    index_[codePoint] = index;
+    advances_[codePoint] = bitmap_.width;
+    return &cell.glyph;
+}
+
+int GlyphCache::getAdvance(char32_t codePoint) {
+    auto it = advances_.find(codePoint);
+    if (it != advances_.end()) {
+        return it->second;
+    }
+    if (missing_.count(codePoint) != 0) {
+        return getAdvance(Utf8::REPLACEMENT);
+    }
+    bool found = rasterizer_ && rasterizer_(codePoint, bitmap_);
+    if (!found && codePoint != Utf8::REPLACEMENT) {
+        missing_.insert(codePoint);
+        return getAdvance(Utf8::REPLACEMENT);
+    }
+    if (!found) {
+        makeBox(bitmap_);
+    }
+    advances_[codePoint] = bitmap_.width;
+    return bitmap_.width;
+}
+
+void GlyphCache::setColorMod(uint8_t r, uint8_t g, uint8_t b) {
+    colorMod_ = SDL_Color{r, g, b, 255};
+    for (SDL_Texture* page : pages_) {
+        SDL_SetTextureColorMod(page, r, g, b);
+    }
+}
+
+void GlyphCache::makeBox(Bitmap& bitmap) {
+    // Outline one pixel short of the font cell, like a missing-glyph box
+    bitmap.width = Constants::FONT_CHAR_WIDTH;
+    bitmap.height = Constants::FONT_CHAR_HEIGHT;
+    bitmap.coverage.assign(static_cast<size_t>(bitmap.width) * bitmap.height, 0);
+    int right = bitmap.width - 2;
+    int bottom = bitmap.height - 2;
+    for (int y = 0; y <= bottom; ++y) {
+        for (int x = 0; x <= right; ++x) {
+            if (x == 0 || y == 0 || x == right || y == bottom) {
+                bitmap.coverage[static_cast<size_t>(y) * bitmap.width + x] = 255;
+            }
+        }
+    }
+}
+
+int GlyphCache::allocateCell(Renderer& renderer) {
+    if (usedCells_ < static_cast<int>(cells_.size())) {
+        return usedCells_++;
+    }
+
+    if (static_cast<int>(pages_.size()) < maxPages_) {
+        SDL_Texture* page = renderer.createStreamingTexture(Constants::GLYPH_PAGE_SIZE, Constants::GLYPH_PAGE_SIZE);
+        if (page) {
+            SDL_SetTextureColorMod(page, colorMod_.r, colorMod_.g, colorMod_.b);
+            pages_.push_back(page);
+            for (int i = 0; i < CELLS_PER_PAGE; ++i) {
+                SDL_Rect rect = {(i % CELLS_PER_ROW) * Constants::GLYPH_CELL_SIZE,
+                                 (i / CELLS_PER_ROW) * Constants::GLYPH_CELL_SIZE, 0, 0};
+                cells_.push_back(Cell{0, 0, false, Glyph{page, rect}});
+            }
+            return usedCells_++;
+        }
+    }
+
+    // Least recently drawn glyph, unless it is drawn in this frame
+    uint64_t frame = renderer.getFrameNumber();
+    int oldest = -1;
+    for (int i = 0; i < usedCells_; ++i) {
+        if (cells_[i].lastUsed < frame && (oldest < 0 || cells_[i].lastUsed < cells_[oldest].lastUsed)) {
+            oldest = i;
+        }
+    }
+    return oldest;
+}
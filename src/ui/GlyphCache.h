@@ -0,0 +1,94 @@
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <SDL.h>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "util/Constants.h"
+
+class Renderer;
+
+// Glyphs beyond the bitmap font (kana, kanji, ...), rasterized on first use
+// into fixed-size cells of streaming-texture pages. Pages are created as
+// they fill, up to a limit; after that the least recently drawn glyph gives
+// up its cell. A glyph drawn in the current frame is never evicted, since
+// recorded draws read their texture when the frame is submitted.
+class GlyphCache {
+public:
+    // Coverage of one glyph: width x height bytes, rows packed, 0 = empty
+    struct Bitmap {
+        int width = 0;
+        int height = 0;
+        std::vector<uint8_t> coverage;
+    };
+
+    // Rasterize a code point into bitmap, false if the font has no glyph for it
+    using Rasterizer = std::function<bool(char32_t, Bitmap&)>;
+
+    // Where a cached glyph is drawn from
+    struct Glyph {
+        SDL_Texture* texture;
+        SDL_Rect src;  // Glyph size, at most GLYPH_CELL_SIZE square
+    };
+
+    explicit GlyphCache(Rasterizer rasterizer, int maxPages = Constants::GLYPH_CACHE_PAGES);
+    ~GlyphCache();
+
+    // Disable copy (owns textures)
+    GlyphCache(const GlyphCache&) = delete;
+    GlyphCache& operator=(const GlyphCache&) = delete;
+
+    // Glyph for a code point, uploaded on first use. Code points the font
+    // lacks get a box. nullptr only if every cell is in use this frame.
+    [[nodiscard]] const Glyph* get(Renderer& renderer, char32_t codePoint);
+
+    // Horizontal advance in pixels (rasterizes to measure, without uploading)
+    [[nodiscard]] int getAdvance(char32_t codePoint);
+
+    // Color mod for all pages (as SDL_SetTextureColorMod)
+    void setColorMod(uint8_t r, uint8_t g, uint8_t b);
+
+    [[nodiscard]] int getPageCount() const { return static_cast<int>(pages_.size()); }
+    [[nodiscard]] int getGlyphCount() const { return static_cast<int>(index_.size()); }
+    [[nodiscard]] uint64_t getHitCount() const { return hits_; }
+    [[nodiscard]] uint64_t getMissCount() const { return misses_; }
+    [[nodiscard]] uint64_t getEvictionCount() const { return evictions_; }
+
+    // Changes whenever a glyph gives up its cell, so anything holding glyph
+    // rects (e.g. cached text layouts) knows to look them up again
+    [[nodiscard]] uint64_t getGeneration() const { return evictions_; }
+
+private:
+    struct Cell {
+        char32_t codePoint;
+        uint64_t lastUsed;  // Frame number
+        bool occupied;
+        Glyph glyph;
+    };
+
+    // Missing-glyph box, drawn for U+FFFD when the font has none
+    static void makeBox(Bitmap& bitmap);
+
+    // A cell to reuse: a free one, a new page, or the least recently used (-1: none)
+    [[nodiscard]] int allocateCell(Renderer& renderer);
+
+    Rasterizer rasterizer_;
+    int maxPages_;
+    std::vector<SDL_Texture*> pages_;
+    std::vector<Cell> cells_;                   // CELLS_PER_PAGE per page, in page order
+    int usedCells_;                             // Cells ever filled (the rest are free)
+    std::unordered_map<char32_t, int> index_;   // Code point -> cell
+    std::unordered_map<char32_t, int> advances_;
+    std::unordered_set<char32_t> missing_;      // Not in the font: drawn as U+FFFD
+    Bitmap bitmap_;                             // Scratch
+    std::vector<uint32_t> upload_;              // Scratch ARGB pixels of one cell
+    SDL_Color colorMod_;                        // Applied to pages created later too
+    uint64_t hits_;
+    uint64_t misses_;
+    uint64_t evictions_;
+};
+
+#endif // GLYPH_CACHE_H
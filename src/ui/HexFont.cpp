@@ -0,0 +1,88 @@
+#include "ui/HexFont.h"
+
+namespace {
+    int hexValue(uint8_t c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        return -1;
+    }
+}
+
+HexFont::HexFont() : file_(), glyphHeight_(0) {}
+
+bool HexFont::open(const std::string& path, int glyphHeight) {
+    glyphHeight_ = glyphHeight;
+    return glyphHeight > 0 && file_.open(path);
+}
+
+long HexFont::parseCodePoint(size_t offset, size_t& digits) const {
+    const uint8_t* data = file_.data();
+    size_t size = file_.size();
+    long codePoint = 0;
+    size_t i = offset;
+    while (i < size && data[i] != ':') {
+        int value = hexValue(data[i]);
+        if (value < 0 || i - offset >= 6) return -1;
+        codePoint = codePoint * 16 + value;
+        ++i;
+    }
+    if (i == offset || i >= size) return -1;
+    digits = i + 1;  // Glyph rows start after the colon
+    return codePoint;
+}
+
+bool HexFont::rasterize(char32_t codePoint, GlyphCache::Bitmap& bitmap) const {
+    if (!file_.isOpen()) return false;
+    const uint8_t* data = file_.data();
+    size_t size = file_.size();
+
+    // Binary search over byte offsets, snapping each probe to a line start
+    size_t low = 0;
+    size_t high = size;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        size_t line = mid;
+        while (line > low && data[line - 1] != '\n') {
+            --line;
+        }
+        size_t digits = 0;
+        long found = parseCodePoint(line, digits);
+        size_t next = line;
+        while (next < size && data[next] != '\n') {
+            ++next;
+        }
+        if (found < 0) {
+            return false;  // Malformed file
+        }
+
+        if (static_cast<char32_t>(found) == codePoint) {
+            size_t count = next - digits;
+            if (count > 0 && data[next - 1] == '\r') --count;  // CRLF line ends
+            size_t rowDigits = count / static_cast<size_t>(glyphHeight_);
+            if (rowDigits == 0 || rowDigits % 2 != 0 || rowDigits * glyphHeight_ != count) {
+                return false;
+            }
+            bitmap.width = static_cast<int>(rowDigits * 4);
+            bitmap.height = glyphHeight_;
+            bitmap.coverage.assign(static_cast<size_t>(bitmap.width) * bitmap.height, 0);
+            for (size_t d = 0; d < count; ++d) {
+                int value = hexValue(data[digits + d]);
+                if (value < 0) return false;
+                size_t pixel = d * 4;  // Rows are packed, so digit d covers pixels 4d..4d+3
+                for (int bit = 0; bit < 4; ++bit) {
+                    if (value & (8 >> bit)) {
+                        bitmap.coverage[pixel + bit] = 255;
+                    }
+                }
+            }
+            return true;
+        }
+        if (static_cast<char32_t>(found) < codePoint) {
+            low = next + 1;
+        } else {
+            high = line;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,33 @@
+#ifndef HEX_FONT_H
+#define HEX_FONT_H
+
+#include <string>
+#include "system/MappedFile.h"
+#include "ui/GlyphCache.h"
+
+// Bitmap glyphs in the .hex text format of GNU Unifont: one line per code
+// point, "XXXX:" followed by the rows as hex digits, sorted by code point.
+// The file is memory-mapped and glyphs are found by binary search on demand,
+// so opening costs nothing however many thousand glyphs the file holds.
+//
+// Every glyph has the height given to open(); its width follows from the
+// number of digits (e.g. height 16: 32 digits = 8 wide, 64 = 16 wide).
+class HexFont {
+public:
+    HexFont();
+
+    [[nodiscard]] bool open(const std::string& path, int glyphHeight);
+    [[nodiscard]] bool isOpen() const { return file_.isOpen(); }
+
+    // Rasterize a code point (coverage 0 or 255), false if the font lacks it
+    [[nodiscard]] bool rasterize(char32_t codePoint, GlyphCache::Bitmap& bitmap) const;
+
+private:
+    // Code point of the line starting at offset (-1 if malformed)
+    [[nodiscard]] long parseCodePoint(size_t offset, size_t& digits) const;
+
+    MappedFile file_;
+    int glyphHeight_;
+};
+
+#endif // HEX_FONT_H
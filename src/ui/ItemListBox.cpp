@@ -3,7 +3,7 @@
 #include "ui/TextRenderer.h"
 #include "system/Renderer.h"
 #include "inventory/ItemDatabase.h"
-#include <sstream>
+#include <cstdio>
 
 ItemListBox::ItemListBox()
     : x_(Constants::ITEM_LIST_BOX_X)
@@ -30,21 +30,20 @@ void ItemListBox::render(Renderer& renderer, const TextRenderer& textRenderer,
         if (!slot.has_value()) continue;
 
         // Get item name from database
-        auto item = ItemDatabase::instance().findById(slot->itemId);
-        if (item.has_value()) {
+        const Item* item = ItemDatabase::instance().find(slot->itemId);
+        char text[32];  // Stack buffer: drawn every frame, so no string allocations
+        if (item) {
             // Draw item name
             textRenderer.renderText(renderer, item->name, textX, textY);
 
             // Draw quantity (right-aligned)
-            std::ostringstream quantityStr;
-            quantityStr << "x" << slot->quantity;
+            std::snprintf(text, sizeof(text), "x%d", slot->quantity);
             int quantityX = x_ + Constants::ITEM_LIST_QUANTITY_X_OFFSET;
-            textRenderer.renderText(renderer, quantityStr.str(), quantityX, textY);
+            textRenderer.renderText(renderer, text, quantityX, textY);
         } else {
             // Fallback: show item ID if not in database
-            std::ostringstream idStr;
-            idStr << "Item " << slot->itemId;
-            textRenderer.renderText(renderer, idStr.str(), textX, textY);
+            std::snprintf(text, sizeof(text), "Item %d", slot->itemId);
+            textRenderer.renderText(renderer, text, textX, textY);
         }
 
         textY += Constants::ITEM_LIST_ITEM_HEIGHT;
@@ -2,13 +2,14 @@
 #include "ui/PhraseBookState.h"
 #include "ui/TextRenderer.h"
 #include "system/Renderer.h"
-#include <sstream>
+#include <cstdio>
 
 PhraseBookBox::PhraseBookBox()
     : x_(Constants::PHRASE_BOOK_BOX_X)
     , y_(Constants::PHRASE_BOOK_BOX_Y)
     , width_(Constants::PHRASE_BOOK_BOX_WIDTH)
-    , height_(Constants::PHRASE_BOOK_BOX_HEIGHT) {}
+    , height_(Constants::PHRASE_BOOK_BOX_HEIGHT)
+    , scratch_() {}
 
 void PhraseBookBox::render(Renderer& renderer, const TextRenderer& textRenderer,
                             const PhraseBookState& state) const {
@@ -35,8 +36,10 @@ void PhraseBookBox::render(Renderer& renderer, const TextRenderer& textRenderer,
             // Show collected phrase
             textRenderer.renderText(renderer, phrase->esperanto, textX, textY);
             // Show Japanese translation on second line (dimmed)
-            std::string translation = "(" + phrase->japanese + ")";
-            textRenderer.renderTextColored(renderer, translation, textX, textY + 10, 180, 180, 180);
+            scratch_.assign("(");
+            scratch_.append(phrase->japanese);
+            scratch_.append(")");
+            textRenderer.renderTextColored(renderer, scratch_, textX, textY + 10, 180, 180, 180);
         } else {
             // Show uncollected placeholder
             textRenderer.renderTextColored(renderer, "...........", textX, textY, 128, 128, 128);
@@ -84,11 +87,11 @@ void PhraseBookBox::drawTitle(Renderer& renderer, const TextRenderer& textRender
     renderer.fillRect(x_ + 4, y_ + 4, width_ - 8, Constants::PHRASE_BOOK_TITLE_HEIGHT - 4);
 
     // Draw title text
-    std::ostringstream titleStr;
-    titleStr << "Phrase Book [" << collectedCount << "/" << totalCount << "]";
+    char title[48];
+    std::snprintf(title, sizeof(title), "Phrase Book [%d/%d]", collectedCount, totalCount);
     int titleX = x_ + Constants::DIALOGUE_PADDING;
     int titleY = y_ + 6;
-    textRenderer.renderText(renderer, titleStr.str(), titleX, titleY);
+    textRenderer.renderText(renderer, title, titleX, titleY);
 }
 
 void PhraseBookBox::drawCursor(Renderer& renderer, int relativeIndex) const {
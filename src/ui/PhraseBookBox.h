@@ -1,6 +1,7 @@
 #ifndef PHRASE_BOOK_BOX_H
 #define PHRASE_BOOK_BOX_H
 
+#include <string>
 #include "util/Constants.h"
 
 class Renderer;
@@ -34,6 +35,7 @@ private:
     int y_;
     int width_;
     int height_;
+    mutable std::string scratch_;  // Reused for composed text, so drawing does not allocate
 };
 
 #endif // PHRASE_BOOK_BOX_H
@@ -0,0 +1,76 @@
+#include "ui/ProfilerOverlay.h"
+#include "ui/TextRenderer.h"
+#include "system/Profiler.h"
+#include "system/Renderer.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+namespace {
+    // Table: a header, one row per section and one for the whole frame
+    constexpr int TABLE_ROWS = static_cast<int>(PROFILE_SECTION_COUNT) + 2;
+    constexpr int PADDING = 4;
+    constexpr uint32_t FRAME_BUDGET_MICROS = 1000000 / Constants::TARGET_FPS;
+}
+
+ProfilerOverlay::ProfilerOverlay()
+    : x_(4)
+    , y_(4)
+    , width_(26 * Constants::FONT_CHAR_WIDTH + 2 * PADDING)
+    , height_(TABLE_ROWS * Constants::PROFILER_LINE_HEIGHT + Constants::PROFILER_GRAPH_HEIGHT + 3 * PADDING) {}
+
+void ProfilerOverlay::render(Renderer& renderer, const TextRenderer& textRenderer, const Profiler& profiler) const {
+    renderer.setDrawColor(0, 0, 0, 200);
+    renderer.fillRect(x_, y_, width_, height_);
+
+    int textX = x_ + PADDING;
+    int textY = y_ + PADDING;
+    textRenderer.renderTextColored(renderer, "us         min   avg   p99", textX, textY, 255, 255, 0);
+    textY += Constants::PROFILER_LINE_HEIGHT;
+
+    for (size_t i = 0; i < PROFILE_SECTION_COUNT; ++i) {
+        ProfileSection section = static_cast<ProfileSection>(i);
+        Profiler::Stats stats = profiler.getStats(section);
+        textRenderer.renderText(renderer, formatRow(getProfileSectionName(section), stats.min, stats.average, stats.p99),
+                                textX, textY);
+        textY += Constants::PROFILER_LINE_HEIGHT;
+    }
+
+    Profiler::Stats frame = profiler.getFrameStats();
+    textRenderer.renderTextColored(renderer, formatRow("frame", frame.min, frame.average, frame.p99),
+                                   textX, textY, 255, 255, 0);
+    textY += Constants::PROFILER_LINE_HEIGHT;
+
+    drawGraph(renderer, profiler, textX, textY + PADDING);
+}
+
+void ProfilerOverlay::drawGraph(Renderer& renderer, const Profiler& profiler, int x, int y) const {
+    constexpr int HEIGHT = Constants::PROFILER_GRAPH_HEIGHT;
+    int bottom = y + HEIGHT;
+
+    // Budget line halfway up: bars reaching the top took two frames or more
+    renderer.setDrawColor(255, 255, 0, 255);
+    renderer.fillRect(x, bottom - HEIGHT / 2, Constants::PROFILER_HISTORY_FRAMES, 1);
+
+    std::vector<uint32_t> frames = profiler.getFrameHistory();
+    for (size_t i = 0; i < frames.size(); ++i) {
+        uint32_t micros = frames[i];
+        int barHeight = static_cast<int>(std::min<uint64_t>(
+            HEIGHT, (static_cast<uint64_t>(micros) * HEIGHT / 2 + FRAME_BUDGET_MICROS - 1) / FRAME_BUDGET_MICROS));
+        if (barHeight == 0) continue;
+        if (micros > FRAME_BUDGET_MICROS) {
+            renderer.setDrawColor(255, 64, 64, 255);
+        } else {
+            renderer.setDrawColor(64, 255, 64, 255);
+        }
+        renderer.fillRect(x + static_cast<int>(i), bottom - barHeight, 1, barHeight);
+    }
+}
+
+std::string ProfilerOverlay::formatRow(const char* name, uint32_t min, uint32_t average, uint32_t p99) {
+    std::ostringstream oss;
+    oss << std::left << std::setw(8) << name << std::right
+        << std::setw(6) << min << std::setw(6) << average << std::setw(6) << p99;
+    return oss.str();
+}
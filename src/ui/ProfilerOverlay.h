@@ -0,0 +1,32 @@
+#ifndef PROFILER_OVERLAY_H
+#define PROFILER_OVERLAY_H
+
+#include <cstdint>
+#include <string>
+
+class Renderer;
+class TextRenderer;
+class Profiler;
+
+// Renders frame-time statistics (min, average and p99 per section, in
+// microseconds) and a graph of recent frame times in the top-left corner
+class ProfilerOverlay {
+public:
+    ProfilerOverlay();
+
+    void render(Renderer& renderer, const TextRenderer& textRenderer, const Profiler& profiler) const;
+
+private:
+    // Frame times as bars, green within the frame budget and red beyond
+    void drawGraph(Renderer& renderer, const Profiler& profiler, int x, int y) const;
+
+    // One table row: name padded to a column, then three right-aligned numbers
+    static std::string formatRow(const char* name, uint32_t min, uint32_t average, uint32_t p99);
+
+    int x_;
+    int y_;
+    int width_;
+    int height_;
+};
+
+#endif // PROFILER_OVERLAY_H
@@ -2,10 +2,13 @@
 #include "ui/SaveSlotState.h"
 #include "ui/TextRenderer.h"
 #include "system/Renderer.h"
-#include <sstream>
-#include <iomanip>
+#include <cstdio>
 #include <cstring>
 
+namespace {
+    constexpr const char* PLAY_TIME_FORMAT = "%02u:%02u";  // HH:MM
+}
+
 SaveSlotBox::SaveSlotBox()
     : x_(Constants::SAVE_SLOT_BOX_X)
     , y_(Constants::SAVE_SLOT_BOX_Y)
@@ -67,24 +70,28 @@ void SaveSlotBox::drawSlot(Renderer& renderer, const TextRenderer& textRenderer,
                 slotIndex * Constants::SAVE_SLOT_HEIGHT;
     int textX = x_ + Constants::DIALOGUE_PADDING + Constants::FONT_CHAR_WIDTH;
 
+    // Formatted into a stack buffer: drawn every frame, so no string allocations
+    char text[32];
     if (info.isEmpty) {
         // Draw "- Empty -" for empty slots
-        std::string emptyText = "Slot " + std::to_string(slotIndex + 1) + ": - Empty -";
-        textRenderer.renderText(renderer, emptyText.c_str(), textX, slotY + 4);
+        std::snprintf(text, sizeof(text), "Slot %d: - Empty -", slotIndex + 1);
+        textRenderer.renderText(renderer, text, textX, slotY + 4);
     } else {
-        // Draw slot info: "Slot N: Name"
-        std::string slotText = "Slot " + std::to_string(slotIndex + 1) + ": " + info.playerName;
-        textRenderer.renderText(renderer, slotText.c_str(), textX, slotY + 4);
+        // Draw slot info: "Slot N: Name" (the name is drawn after the label)
+        std::snprintf(text, sizeof(text), "Slot %d: ", slotIndex + 1);
+        textRenderer.renderText(renderer, text, textX, slotY + 4);
+        int nameX = textX + static_cast<int>(std::strlen(text)) * Constants::FONT_CHAR_WIDTH;
+        textRenderer.renderText(renderer, info.playerName, nameX, slotY + 4);
 
         // Draw level
-        std::string levelText = "Lv." + std::to_string(info.level);
-        textRenderer.renderText(renderer, levelText.c_str(), textX, slotY + 16);
+        std::snprintf(text, sizeof(text), "Lv.%d", info.level);
+        textRenderer.renderText(renderer, text, textX, slotY + 16);
 
         // Draw play time
-        std::string timeText = formatPlayTime(info.playTimeSeconds);
-        int timeX = x_ + width_ - Constants::DIALOGUE_PADDING -
-                    static_cast<int>(timeText.length()) * Constants::FONT_CHAR_WIDTH;
-        textRenderer.renderText(renderer, timeText.c_str(), timeX, slotY + 16);
+        uint32_t seconds = info.playTimeSeconds;
+        int length = std::snprintf(text, sizeof(text), PLAY_TIME_FORMAT, seconds / 3600, (seconds % 3600) / 60);
+        int timeX = x_ + width_ - Constants::DIALOGUE_PADDING - length * Constants::FONT_CHAR_WIDTH;
+        textRenderer.renderText(renderer, text, timeX, slotY + 16);
     }
 
     // Draw separator line after each slot (except last)
@@ -112,8 +119,7 @@ std::string SaveSlotBox::formatPlayTime(uint32_t seconds) {
     uint32_t hours = seconds / 3600;
     uint32_t minutes = (seconds % 3600) / 60;
 
-    std::ostringstream oss;
-    oss << std::setfill('0') << std::setw(2) << hours << ":"
-        << std::setfill('0') << std::setw(2) << minutes;
-    return oss.str();
+    char text[16];
+    std::snprintf(text, sizeof(text), PLAY_TIME_FORMAT, hours, minutes);
+    return text;
 }
@@ -2,9 +2,8 @@
 #include "ui/TextRenderer.h"
 #include "game/PlayerStats.h"
 #include "system/Renderer.h"
-#include <sstream>
-#include <iomanip>
 #include <algorithm>
+#include <cstdio>
 
 StatusPanel::StatusPanel()
     : x_(Constants::STATUS_PANEL_X)
@@ -20,29 +19,35 @@ void StatusPanel::render(Renderer& renderer, const TextRenderer& textRenderer,
     int textX = x_ + Constants::DIALOGUE_PADDING;
     int textY = y_ + Constants::DIALOGUE_PADDING;
 
+    // Formatted into a stack buffer: drawn every frame, so no string allocations
+    char text[32];
+
     // Name and Level
     textRenderer.renderText(renderer, stats.name, textX, textY);
-    textRenderer.renderText(renderer, "Lv" + formatNumber(stats.level, 2), textX + 100, textY);
+    std::snprintf(text, sizeof(text), "Lv%2d", stats.level);
+    textRenderer.renderText(renderer, text, textX + 100, textY);
     textY += Constants::STATUS_LINE_HEIGHT;
 
     // HP
-    std::string hpText = "HP " + formatNumber(stats.hp, 3) + "/" + formatNumber(stats.maxHp, 3);
-    textRenderer.renderText(renderer, hpText, textX, textY);
+    std::snprintf(text, sizeof(text), "HP %3d/%3d", stats.hp, stats.maxHp);
+    textRenderer.renderText(renderer, text, textX, textY);
     drawBar(renderer, textX + 120, textY + 2, 80, stats.hp, stats.maxHp, 0, 255, 0);
     textY += Constants::STATUS_LINE_HEIGHT;
 
     // MP
-    std::string mpText = "MP " + formatNumber(stats.mp, 3) + "/" + formatNumber(stats.maxMp, 3);
-    textRenderer.renderText(renderer, mpText, textX, textY);
+    std::snprintf(text, sizeof(text), "MP %3d/%3d", stats.mp, stats.maxMp);
+    textRenderer.renderText(renderer, text, textX, textY);
     drawBar(renderer, textX + 120, textY + 2, 80, stats.mp, stats.maxMp, 0, 128, 255);
     textY += Constants::STATUS_LINE_HEIGHT;
 
     // EXP
-    textRenderer.renderText(renderer, "EXP " + formatNumber(stats.exp, 6), textX, textY);
+    std::snprintf(text, sizeof(text), "EXP %6d", stats.exp);
+    textRenderer.renderText(renderer, text, textX, textY);
     textY += Constants::STATUS_LINE_HEIGHT;
 
     // Gold
-    textRenderer.renderText(renderer, "Gold " + formatNumber(stats.gold, 6), textX, textY);
+    std::snprintf(text, sizeof(text), "Gold %6d", stats.gold);
+    textRenderer.renderText(renderer, text, textX, textY);
 }
 
 void StatusPanel::drawBox(Renderer& renderer) const {
@@ -73,9 +78,3 @@ void StatusPanel::drawBar(Renderer& renderer, int x, int y, int width, int curre
     renderer.setDrawColor(255, 255, 255, 255);
     renderer.drawRect(x, y, width, 6);
 }
-
-std::string StatusPanel::formatNumber(int value, int width) {
-    std::ostringstream oss;
-    oss << std::setw(width) << value;
-    return oss.str();
-}
@@ -25,9 +25,6 @@ private:
     void drawBar(Renderer& renderer, int x, int y, int width, int current, int max,
                  uint8_t r, uint8_t g, uint8_t b) const;
 
-    // Format number to string with padding
-    static std::string formatNumber(int value, int width);
-
     int x_;
     int y_;
     int width_;
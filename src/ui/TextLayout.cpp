@@ -0,0 +1,129 @@
+#include "ui/TextLayout.h"
+#include "util/Utf8.h"
+
+namespace TextLayout {
+
+namespace {
+
+// Full-width characters (CJK, kana, fullwidth forms): no spaces between words,
+// so a line may break on either side of them
+bool isWide(char32_t c) {
+    return (c >= 0x2E80 && c <= 0x9FFF) || (c >= 0xF900 && c <= 0xFAFF) || (c >= 0xFF00 && c <= 0xFF60);
+}
+
+// Punctuation a line must not start with
+bool isClosing(char32_t c) {
+    switch (c) {
+        case ',': case '.': case '!': case '?': case ':': case ';': case ')':
+        case 0x3001: case 0x3002: case 0x3009: case 0x300D: case 0x300F: case 0x30FC:
+        case 0xFF01: case 0xFF09: case 0xFF0C: case 0xFF0E: case 0xFF1F:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Punctuation a line must not end with
+bool isOpening(char32_t c) {
+    return c == '(' || c == 0x3008 || c == 0x300C || c == 0x300E || c == 0xFF08;
+}
+
+// Width of text[begin, end) from the start of a line; previous gets its last code point
+int measure(std::string_view text, size_t begin, size_t end, const Advance& advance,
+            char32_t& previous) {
+    int width = 0;
+    previous = 0;
+    size_t pos = begin;
+    while (pos < end) {
+        char32_t c = Utf8::next(text, pos);
+        width += advance(previous, c);
+        previous = c;
+    }
+    return width;
+}
+
+// Greedy fill of one paragraph (text without '\n')
+void wrapParagraph(std::string_view text, int maxWidth, const Advance& advance,
+                   std::vector<std::string>& lines) {
+    size_t lineStart = 0;
+    size_t breakEnd = std::string_view::npos;  // Where the line may end (last break opportunity)
+    size_t breakResume = 0;                     // Where the next line starts if it does
+    int width = 0;
+    char32_t previous = 0;
+
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t charStart = pos;
+        char32_t c = Utf8::next(text, pos);
+
+        // Spaces may hang past the edge; a run of them is dropped at a break
+        if (c == ' ') {
+            if (previous != ' ') {
+                breakEnd = charStart;
+            }
+            breakResume = pos;
+            width += advance(previous, c);
+            previous = c;
+            continue;
+        }
+        if (charStart > lineStart && previous != ' ' && !isClosing(c) && !isOpening(previous) &&
+            (isWide(c) || isWide(previous) || previous == '-')) {
+            breakEnd = charStart;
+            breakResume = charStart;
+        }
+
+        int charWidth = advance(previous, c);
+        while (maxWidth > 0 && width + charWidth > maxWidth && charStart > lineStart) {
+            if (breakEnd != std::string_view::npos && breakEnd > lineStart) {
+                lines.emplace_back(text.substr(lineStart, breakEnd - lineStart));
+                lineStart = breakResume;
+                width = measure(text, lineStart, charStart, advance, previous);
+            } else {
+                // No break opportunity: split the word where it overflows
+                lines.emplace_back(text.substr(lineStart, charStart - lineStart));
+                lineStart = charStart;
+                width = 0;
+                previous = 0;
+            }
+            breakEnd = std::string_view::npos;
+            charWidth = advance(previous, c);
+        }
+        width += charWidth;
+        previous = c;
+    }
+    lines.emplace_back(text.substr(lineStart));
+}
+
+}  // namespace
+
+std::vector<std::string> wrap(std::string_view text, int maxWidth, const Advance& advance) {
+    std::vector<std::string> lines;
+    size_t start = 0;
+    size_t end;
+    while ((end = text.find('\n', start)) != std::string_view::npos) {
+        wrapParagraph(text.substr(start, end - start), maxWidth, advance, lines);
+        start = end + 1;
+    }
+    wrapParagraph(text.substr(start), maxWidth, advance, lines);
+    return lines;
+}
+
+std::vector<std::string> paginate(std::string_view text, int maxWidth, int maxLines, const Advance& advance) {
+    std::vector<std::string> lines = wrap(text, maxWidth, advance);
+    size_t perPage = maxLines > 0 ? static_cast<size_t>(maxLines) : lines.size();
+
+    std::vector<std::string> pages;
+    for (size_t first = 0; first < lines.size(); first += perPage) {
+        std::string page;
+        for (size_t i = first; i < lines.size() && i < first + perPage; ++i) {
+            if (i > first) {
+                page.push_back('\n');
+            }
+            page += lines[i];
+        }
+        pages.push_back(std::move(page));
+    }
+    return pages;
+}
+
+}  // namespace TextLayout
@@ -0,0 +1,31 @@
+#ifndef TEXT_LAYOUT_H
+#define TEXT_LAYOUT_H
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Word wrapping and pagination of UTF-8 text against a box width, measured
+// with the font's own advances (see TextRenderer::getAdvance). Static text
+// such as NPC scripts is laid out once when it is loaded and drawn from the
+// pre-broken pages afterwards, so nothing is wrapped while drawing.
+//
+// Lines break at spaces (which are dropped at the break), after hyphens, and
+// on either side of CJK characters, except before closing punctuation such
+// as "。" or ")". A word wider than the box is split where it overflows.
+// '\n' always starts a new line.
+namespace TextLayout {
+    // Pen movement for c drawn after previous (0 at the start of a line)
+    using Advance = std::function<int(char32_t previous, char32_t c)>;
+
+    // Break text into lines of at most maxWidth pixels (no limit if maxWidth <= 0)
+    [[nodiscard]] std::vector<std::string> wrap(std::string_view text, int maxWidth, const Advance& advance);
+
+    // Wrap text and group the lines into pages of at most maxLines lines
+    // (joined by '\n'); always returns at least one page
+    [[nodiscard]] std::vector<std::string> paginate(std::string_view text, int maxWidth, int maxLines,
+                                                    const Advance& advance);
+}
+
+#endif // TEXT_LAYOUT_H
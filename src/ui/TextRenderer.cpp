@@ -1,65 +1,257 @@
 #include "ui/TextRenderer.h"
+#include "ui/BakedFont.h"
+#include "ui/GlyphCache.h"
+#include "ui/HexFont.h"
 #include "system/ResourceManager.h"
 #include "system/Renderer.h"
+#include "util/PathUtil.h"
+#include "util/Utf8.h"
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <vector>
 
-TextRenderer::TextRenderer() : texture_(nullptr) {}
+TextRenderer::TextRenderer()
+    : region_()
+    , baked_()
+    , hexFont_()
+    , glyphs_(std::make_unique<GlyphCache>(nullptr))
+    , layoutCacheEnabled_(true)
+    , layouts_()
+    , scratch_()
+    , layoutHits_(0)
+    , layoutMisses_(0) {}
+
+TextRenderer::~TextRenderer() = default;
 
 bool TextRenderer::loadFont(ResourceManager& resourceManager, const std::string& path) {
-    texture_ = resourceManager.loadTexture(path);
-    return texture_ != nullptr;
+    if (PathUtil::hasExtension(path, ".rfnt")) {
+        return loadBakedFont(resourceManager, path);
+    }
+
+    std::string bakedPath = findBakedFont(path);
+    if (!bakedPath.empty() && loadBakedFont(resourceManager, bakedPath)) {
+        return true;
+    }
+
+    region_ = resourceManager.loadRegion(path);
+    baked_.reset();
+    layouts_.clear();
+    return region_.texture != nullptr;
 }
 
-void TextRenderer::renderText(Renderer& renderer, const std::string& text, int x, int y) const {
-    if (!texture_) return;
+std::string TextRenderer::getFontImagePath(const std::string& path) {
+    std::string bakedPath = PathUtil::hasExtension(path, ".rfnt") ? path : findBakedFont(path);
+    BakedFont font;
+    if (!bakedPath.empty() && font.open(bakedPath)) {
+        return font.getAtlasPath();
+    }
+    return path;
+}
 
-    int cursorX = x;
-    int cursorY = y;
+std::string TextRenderer::findBakedFont(const std::string& sheetPath) {
+    std::string bakedPath = PathUtil::replaceExtension(sheetPath, ".rfnt");
+    if (bakedPath != sheetPath && PathUtil::isSafeRelativePath(sheetPath) &&
+        PathUtil::isUpToDate(bakedPath, sheetPath)) {
+        return bakedPath;
+    }
+    return "";
+}
 
-    for (char c : text) {
-        if (c == '\n') {
-            cursorX = x;
-            cursorY += Constants::DIALOGUE_LINE_HEIGHT;
-            continue;
-        }
+bool TextRenderer::loadBakedFont(ResourceManager& resourceManager, const std::string& path) {
+    auto font = std::make_unique<BakedFont>();
+    if (!font->open(path)) {
+        return false;
+    }
+    TextureRegion atlas = resourceManager.loadRegion(font->getAtlasPath());
+    if (!atlas.texture || atlas.rect.w < font->getAtlasWidth() || atlas.rect.h < font->getAtlasHeight()) {
+        std::cerr << "Baked font atlas missing or smaller than its glyphs: " << font->getAtlasPath() << std::endl;
+        return false;
+    }
+
+    region_ = atlas;
+    baked_ = std::move(font);
+    layouts_.clear();
+    return true;
+}
+
+bool TextRenderer::loadGlyphs(const std::string& path, int glyphHeight) {
+    auto font = std::make_unique<HexFont>();
+    if (!font->open(path, glyphHeight)) {
+        return false;
+    }
+    hexFont_ = std::move(font);
+    const HexFont* hexFont = hexFont_.get();
+    glyphs_ = std::make_unique<GlyphCache>([hexFont](char32_t codePoint, GlyphCache::Bitmap& bitmap) {
+        return hexFont->rasterize(codePoint, bitmap);
+    });
+    layouts_.clear();  // Quads point into the old cache's pages
+    return true;
+}
+
+void TextRenderer::setLayoutCacheEnabled(bool enabled) {
+    layoutCacheEnabled_ = enabled;
+    layouts_.clear();
+}
 
-        SDL_Rect src = getCharRect(c);
-        SDL_Rect dst = {cursorX, cursorY, Constants::FONT_CHAR_WIDTH, Constants::FONT_CHAR_HEIGHT};
-        renderer.drawTexture(texture_, &src, &dst);
+void TextRenderer::renderText(Renderer& renderer, std::string_view text, int x, int y) const {
+    if (!region_.texture) return;
 
-        cursorX += Constants::FONT_CHAR_WIDTH;
+    const Layout& layout = findLayout(renderer, text, x, y);
+    for (const Quad& quad : layout.quads) {
+        renderer.drawTexture(quad.texture, &quad.src, &quad.dst);
     }
 }
 
-void TextRenderer::renderTextColored(Renderer& renderer, const std::string& text,
+void TextRenderer::renderTextColored(Renderer& renderer, std::string_view text,
                                       int x, int y, uint8_t r, uint8_t g, uint8_t b) const {
-    if (!texture_) return;
+    if (!region_.texture) return;
 
-    // Set color mod
-    SDL_SetTextureColorMod(texture_, r, g, b);
+    // Set color mod (the atlas page is shared; drawing bakes the color into each quad)
+    SDL_SetTextureColorMod(region_.texture, r, g, b);
+    glyphs_->setColorMod(r, g, b);
 
     renderText(renderer, text, x, y);
 
     // Reset color mod
-    SDL_SetTextureColorMod(texture_, 255, 255, 255);
+    SDL_SetTextureColorMod(region_.texture, 255, 255, 255);
+    glyphs_->setColorMod(255, 255, 255);
 }
 
-Vec2 TextRenderer::measureText(const std::string& text) const {
+Vec2 TextRenderer::measureText(std::string_view text) const {
     int maxWidth = 0;
     int currentWidth = 0;
     int lines = 1;
 
-    for (char c : text) {
+    char32_t previous = 0;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        char32_t c = Utf8::next(text, pos);
         if (c == '\n') {
             maxWidth = std::max(maxWidth, currentWidth);
             currentWidth = 0;
             lines++;
+            previous = 0;
         } else {
-            currentWidth += Constants::FONT_CHAR_WIDTH;
+            currentWidth += getAdvance(previous, c);
+            previous = c;
         }
     }
     maxWidth = std::max(maxWidth, currentWidth);
 
-    return Vec2{maxWidth, lines * Constants::DIALOGUE_LINE_HEIGHT};
+    return Vec2{maxWidth, lines * getLineAdvance()};
+}
+
+void TextRenderer::buildLayout(Renderer& renderer, std::string_view text, int x, int y, Layout& layout) const {
+    layout.text.assign(text.data(), text.size());
+    layout.x = x;
+    layout.y = y;
+    layout.complete = true;
+    layout.quads.clear();
+    layout.cachedGlyphs.clear();
+
+    // Glyphs from the cache sit on the font's bottom row
+    int cellHeight = baked_ ? baked_->getLineHeight() : Constants::FONT_CHAR_HEIGHT;
+
+    int cursorX = x;
+    int cursorY = y;
+    char32_t previous = 0;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        char32_t c = Utf8::next(text, pos);
+        if (c == '\n') {
+            cursorX = x;
+            cursorY += getLineAdvance();
+            previous = 0;
+            continue;
+        }
+
+        BakedFont::Glyph baked;
+        if (baked_ && baked_->find(c, baked)) {
+            cursorX += baked_->getKerning(previous, c);
+            if (baked.src.w > 0 && baked.src.h > 0) {
+                SDL_Rect dst = {cursorX + baked.bearingX, cursorY + baked.bearingY, baked.src.w, baked.src.h};
+                layout.quads.push_back(Quad{region_.texture, region_.toTexture(baked.src), dst});
+            }
+            cursorX += baked.advance;
+        } else if (!baked_ && c < 0x80) {
+            SDL_Rect src = getCharRect(static_cast<char>(c));
+            SDL_Rect dst = {cursorX, cursorY, Constants::FONT_CHAR_WIDTH, Constants::FONT_CHAR_HEIGHT};
+            layout.quads.push_back(Quad{region_.texture, src, dst});
+            cursorX += Constants::FONT_CHAR_WIDTH;
+        } else {
+            const GlyphCache::Glyph* glyph = glyphs_->get(renderer, c);
+            if (!glyph) {
+                layout.complete = false;
+            } else if (glyph->src.w > 0) {
+                SDL_Rect dst = {cursorX, cursorY + cellHeight - glyph->src.h, glyph->src.w, glyph->src.h};
+                layout.quads.push_back(Quad{glyph->texture, glyph->src, dst});
+            }
+            layout.cachedGlyphs.push_back(c);
+            cursorX += glyphs_->getAdvance(c);
+        }
+        previous = c;
+    }
+
+    // Glyphs do not overlap, so putting the font's first and grouping the rest
+    // by page keeps the output and makes one batch per texture. Font-only
+    // text is skipped: stable_sort allocates a buffer.
+    if (!layout.cachedGlyphs.empty()) {
+        SDL_Texture* font = region_.texture;
+        std::stable_sort(layout.quads.begin(), layout.quads.end(), [font](const Quad& a, const Quad& b) {
+            SDL_Texture* pageA = a.texture == font ? nullptr : a.texture;
+            SDL_Texture* pageB = b.texture == font ? nullptr : b.texture;
+            return std::less<SDL_Texture*>()(pageA, pageB);
+        });
+    }
+
+    // Read last: uploads above may have evicted glyphs of other layouts
+    layout.glyphGeneration = glyphs_->getGeneration();
+}
+
+const TextRenderer::Layout& TextRenderer::findLayout(Renderer& renderer, std::string_view text, int x, int y) const {
+    if (!layoutCacheEnabled_) {
+        buildLayout(renderer, text, x, y, scratch_);
+        return scratch_;
+    }
+
+    uint64_t frame = renderer.getFrameNumber();
+    uint64_t position = (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+    uint64_t key = std::hash<std::string_view>()(text) ^ (position * 0x9E3779B97F4A7C15ull);
+
+    auto it = layouts_.find(key);
+    if (it == layouts_.end()) {
+        if (static_cast<int>(layouts_.size()) >= Constants::TEXT_LAYOUT_CACHE_ENTRIES) {
+            sweepLayouts(frame);
+        }
+        it = layouts_.emplace(key, Layout()).first;
+    }
+
+    Layout& layout = it->second;
+    bool valid = layout.complete && layout.x == x && layout.y == y && layout.text == text &&
+                 (layout.cachedGlyphs.empty() || layout.glyphGeneration == glyphs_->getGeneration());
+    if (valid) {
+        ++layoutHits_;
+        // Marks the glyphs as drawn this frame (all hits: nothing was evicted)
+        for (char32_t c : layout.cachedGlyphs) {
+            (void)glyphs_->get(renderer, c);
+        }
+    } else {
+        ++layoutMisses_;
+        buildLayout(renderer, text, x, y, layout);
+    }
+    layout.lastUsed = frame;
+    return layout;
+}
+
+void TextRenderer::sweepLayouts(uint64_t frame) const {
+    for (auto it = layouts_.begin(); it != layouts_.end();) {
+        if (it->second.lastUsed + 1 < frame) {
+            it = layouts_.erase(it);
+        } else {
+            ++it;
+        }
+    }
 }
 
 SDL_Rect TextRenderer::getCharRect(char c) const {
@@ -72,10 +264,29 @@ SDL_Rect TextRenderer::getCharRect(char c) const {
     int col = charIndex % Constants::FONT_CHARS_PER_ROW;
     int row = charIndex / Constants::FONT_CHARS_PER_ROW;
 
-    return SDL_Rect{
+    return region_.toTexture(SDL_Rect{
         col * Constants::FONT_CHAR_WIDTH,
         row * Constants::FONT_CHAR_HEIGHT,
         Constants::FONT_CHAR_WIDTH,
         Constants::FONT_CHAR_HEIGHT
-    };
+    });
+}
+
+int TextRenderer::getAdvance(char32_t previous, char32_t c) const {
+    BakedFont::Glyph glyph;
+    if (baked_ && baked_->find(c, glyph)) {
+        return baked_->getKerning(previous, c) + glyph.advance;
+    }
+    if (!baked_ && c < 0x80) {
+        return Constants::FONT_CHAR_WIDTH;
+    }
+    return glyphs_->getAdvance(c);
+}
+
+int TextRenderer::getLineAdvance() const {
+    // The sheet's 8px rows get DIALOGUE_LINE_HEIGHT; a baked font keeps the same gap
+    if (baked_) {
+        return baked_->getLineHeight() + Constants::DIALOGUE_LINE_HEIGHT - Constants::FONT_CHAR_HEIGHT;
+    }
+    return Constants::DIALOGUE_LINE_HEIGHT;
 }
@@ -2,40 +2,125 @@
 #define TEXT_RENDERER_H
 
 #include <SDL.h>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "system/TextureRegion.h"
 #include "util/Constants.h"
 #include "util/Vec2.h"
 
 class ResourceManager;
 class Renderer;
+class BakedFont;
+class GlyphCache;
+class HexFont;
 
-// Renders bitmap font text
+// Renders UTF-8 text from a baked font (atlas plus metrics, see BakedFont)
+// or, without one, from the fixed 8x8 cells of the ASCII font sheet.
+// Characters the font lacks (kana, kanji, ...) come from a glyph cache filled
+// on demand from a .hex font. Cached glyphs of a string are drawn after the
+// font's, grouped by page, so each string is one batch per texture.
+//
+// UI boxes draw the same strings at the same place frame after frame, so the
+// quads of each (text, position) are kept in a layout cache and replayed
+// until the string changes, instead of decoding and looking up every glyph
+// again.
 class TextRenderer {
 public:
     TextRenderer();
+    ~TextRenderer();
 
-    // Load font sprite sheet
+    // Load a baked font (.rfnt), or a font sheet of 8x8 cells from ASCII 32.
+    // For a sheet, an up-to-date baked font next to it (same name, .rfnt)
+    // is used instead.
     [[nodiscard]] bool loadFont(ResourceManager& resourceManager, const std::string& path);
 
+    // Image loadFont(path) will draw from: the baked font's atlas when the
+    // baked font is used, else the sheet (to register it in a sprite atlas)
+    [[nodiscard]] static std::string getFontImagePath(const std::string& path);
+
+    // Use a .hex font (see HexFont) for non-ASCII text; without one, such
+    // characters show as boxes
+    [[nodiscard]] bool loadGlyphs(const std::string& path, int glyphHeight = Constants::GLYPH_HEX_HEIGHT);
+
     // Render text at position
-    void renderText(Renderer& renderer, const std::string& text, int x, int y) const;
+    void renderText(Renderer& renderer, std::string_view text, int x, int y) const;
 
     // Render text with custom color (using SDL color mod)
-    void renderTextColored(Renderer& renderer, const std::string& text,
+    void renderTextColored(Renderer& renderer, std::string_view text,
                           int x, int y, uint8_t r, uint8_t g, uint8_t b) const;
 
     // Measure text dimensions
-    [[nodiscard]] Vec2 measureText(const std::string& text) const;
+    [[nodiscard]] Vec2 measureText(std::string_view text) const;
+
+    // Pen movement for c drawn after previous (0: none), kerning included;
+    // what TextLayout wraps against
+    [[nodiscard]] int getAdvance(char32_t previous, char32_t c) const;
+
+    // Distance between the tops of two lines
+    [[nodiscard]] int getLineAdvance() const;
 
     // Check if font is loaded
-    [[nodiscard]] bool isLoaded() const { return texture_ != nullptr; }
+    [[nodiscard]] bool isLoaded() const { return region_.texture != nullptr; }
+    [[nodiscard]] bool isBaked() const { return baked_ != nullptr; }
+
+    // Layout cache (on by default; off lays text out on every draw)
+    void setLayoutCacheEnabled(bool enabled);
+    [[nodiscard]] int getLayoutCount() const { return static_cast<int>(layouts_.size()); }
+    [[nodiscard]] uint64_t getLayoutHitCount() const { return layoutHits_; }
+    [[nodiscard]] uint64_t getLayoutMissCount() const { return layoutMisses_; }
 
 private:
-    // Get source rect for a character
+    struct Quad {
+        SDL_Texture* texture;
+        SDL_Rect src;
+        SDL_Rect dst;
+    };
+
+    // Quads of one string at one position
+    struct Layout {
+        std::string text;                   // Compared on lookup, so hash collisions only cost a rebuild
+        int x = 0;
+        int y = 0;
+        uint64_t glyphGeneration = 0;       // GlyphCache generation the quads were built in
+        bool complete = false;              // False if a glyph could not be cached (rebuilt next draw)
+        uint64_t lastUsed = 0;              // Frame number
+        std::vector<Quad> quads;            // Font glyphs first, then cached glyphs by page
+        std::vector<char32_t> cachedGlyphs; // Looked up on each draw, so they stay cached
+    };
+
+    // Up-to-date baked font to use for a sheet (empty if none)
+    [[nodiscard]] static std::string findBakedFont(const std::string& sheetPath);
+
+    // Load a .rfnt and its atlas (keeps the current font on failure)
+    [[nodiscard]] bool loadBakedFont(ResourceManager& resourceManager, const std::string& path);
+
+    // Get source rect (in the texture) for a character of the font sheet
     [[nodiscard]] SDL_Rect getCharRect(char c) const;
 
-    // Non-owning pointer - texture lifetime managed by ResourceManager
-    SDL_Texture* texture_;
+    // Lay out text at (x, y) into layout's quads (the glyph cache may upload)
+    void buildLayout(Renderer& renderer, std::string_view text, int x, int y, Layout& layout) const;
+
+    // Cached layout for text at (x, y), built if missing or stale
+    [[nodiscard]] const Layout& findLayout(Renderer& renderer, std::string_view text, int x, int y) const;
+
+    // Drop layouts not drawn in this or the previous frame
+    void sweepLayouts(uint64_t frame) const;
+
+    TextureRegion region_;  // Font sheet or baked atlas
+    std::unique_ptr<BakedFont> baked_;  // nullptr: region_ is a sheet of 8x8 cells
+    std::unique_ptr<HexFont> hexFont_;
+    std::unique_ptr<GlyphCache> glyphs_;  // Never null
+
+    // Drawing is const for callers; the cache is an implementation detail
+    bool layoutCacheEnabled_;
+    mutable std::unordered_map<uint64_t, Layout> layouts_;  // Keyed by hash of text and position
+    mutable Layout scratch_;                                // Reused when the cache is off
+    mutable uint64_t layoutHits_;
+    mutable uint64_t layoutMisses_;
 };
 
 #endif // TEXT_RENDERER_H
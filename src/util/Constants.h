@@ -15,8 +15,10 @@ namespace Constants {
     constexpr int TILES_PER_COL = INTERNAL_HEIGHT / TILE_SIZE;   // 7 (with partial)
 
     // Game settings
-    constexpr int TARGET_FPS = 60;
-    constexpr int FRAME_DELAY = 1000 / TARGET_FPS;
+    constexpr int TARGET_FPS = 60;          // Simulation steps per second (drawing follows the display)
+    constexpr int MAX_CATCH_UP_STEPS = 5;   // Steps run at most per frame after a stall
+    constexpr int HEADLESS_DEFAULT_FRAMES = TARGET_FPS * 10;  // Headless runs without --frames
+    constexpr int IDLE_WAIT_MAX_MS = 250;  // Longest sleep behind an idle window (background loads show up)
 
     // Movement speed (pixels per frame at 60fps)
     constexpr int PLAYER_SPEED = 2;
@@ -26,6 +28,56 @@ namespace Constants {
     constexpr int ANIMATION_FRAME_DIVISOR = 8;   // Frames to hold each animation frame
     constexpr int WALK_ANIMATION_FRAMES = 4;     // Number of walk animation frames
 
+    // World streaming (chunked maps, see Map::openStreaming)
+    constexpr int CHUNK_LOAD_RADIUS = 2;                    // Chunks kept loaded around the camera
+    constexpr int STREAMING_MEMORY_BUDGET = 1024 * 1024;    // Resident chunk bytes (1024 chunks)
+    constexpr int STREAMING_MIN_TILES = 1024 * 1024;        // Maps this large stream by chunk
+
+    // Pre-rendered tile layer (see TileLayerCache)
+    constexpr int TILE_CACHE_CHUNK_PIXELS = 256;                                // Chunk texture size
+    constexpr int TILE_CACHE_CHUNK_TILES = TILE_CACHE_CHUNK_PIXELS / TILE_SIZE; // 8
+    constexpr int TILE_CACHE_MAX_CHUNKS = 16;                                   // Textures kept (4MB)
+
+    // Sprite atlas (see ResourceManager::buildAtlas)
+    constexpr int ATLAS_PAGE_SIZE = 1024;  // Page edge in pixels (at most 4MB per page)
+    constexpr int ATLAS_PADDING = 1;       // Empty pixels between packed images
+
+    // Background image decoding (see AssetLoader, ResourceManager::requestTexture)
+    constexpr int ASSET_DECODE_THREADS = 2;     // Worker threads decoding image files
+    constexpr int ASSET_UPLOADS_PER_FRAME = 2;  // Decoded images turned into textures per frame
+
+    // Parsed map cache (see MapCache)
+    constexpr int MAP_CACHE_BUDGET = 8 * 1024 * 1024;       // Bytes of maps kept in memory
+
+    // Pathfinding (see Pathfinder)
+    constexpr int PATHFINDING_MAX_TILES = 2048 * 2048;      // Larger maps are not searched (20 bytes/tile)
+
+    // NPC simulation (see NPCSimulation)
+    constexpr int NPC_SPEED = PLAYER_SPEED;                 // Pixels per frame while walking
+    constexpr int NPC_STEP_FRAMES = TILE_SIZE / NPC_SPEED;  // 16 frames per tile
+    constexpr int NPC_THINK_BUDGET = 64;                    // NPC behaviors run per frame
+    constexpr int NPC_MAX_REST_THINKS = 3;                  // Wanderers pause 0..3 thinks between steps
+    constexpr int NPC_WANDER_RADIUS = 3;                    // Tiles from the wander anchor
+    constexpr int NPC_FOLLOW_RANGE = 6;                     // Followers give up beyond this (Manhattan)
+
+    // Field of view in dark maps (see FieldOfView, FogRenderer)
+    constexpr int FOV_DARK_RADIUS = 1;       // Tiles seen without light
+    constexpr int FOV_TORCH_RADIUS = 4;      // Tiles seen while a torch burns
+    constexpr int FOG_EXPLORED_ALPHA = 176;  // Remembered but not visible tiles
+    constexpr int FOG_HIDDEN_ALPHA = 255;    // Never seen tiles
+
+    // Frame profiler, built with -DRPG_PROFILE (see Profiler, ProfilerOverlay)
+    constexpr int PROFILER_RING_CAPACITY = 256;     // Frames waiting for collect() (power of two)
+    constexpr int PROFILER_HISTORY_FRAMES = 120;    // Frames the statistics and graph cover
+    constexpr int PROFILER_LINE_HEIGHT = 10;
+    constexpr int PROFILER_GRAPH_HEIGHT = 32;       // Two frame budgets tall
+
+    // Frame capture (see FrameCapture)
+    constexpr const char* CAPTURE_DIRECTORY = "captures";
+    constexpr int CAPTURE_BUFFER_POOL = 4;         // Frames read back but not written yet
+    constexpr int CAPTURE_SEQUENCE_INTERVAL = 6;   // F11 sequences keep every 6th frame...
+    constexpr int CAPTURE_SEQUENCE_FRAMES = 100;   // ...100 times (10 seconds at 60fps)
+
     // Tile type range for validation
     constexpr int MIN_TILE_ID = 0;
     constexpr int MAX_TILE_ID = 9;
@@ -36,6 +88,15 @@ namespace Constants {
     constexpr int FONT_CHARS_PER_ROW = 16;
     constexpr int FONT_FIRST_CHAR = 32;  // ASCII space
 
+    // Glyphs beyond ASCII, cached on demand (see GlyphCache, HexFont)
+    constexpr int GLYPH_CELL_SIZE = 16;     // Largest glyph in pixels (cells are square)
+    constexpr int GLYPH_PAGE_SIZE = 256;    // Page edge: 256 cells per page
+    constexpr int GLYPH_CACHE_PAGES = 2;    // Pages at most (512 glyphs, 256KB per page)
+    constexpr int GLYPH_HEX_HEIGHT = 8;     // Glyph rows in assets/fonts/glyphs.hex
+
+    // Text layouts kept for reuse (see TextRenderer)
+    constexpr int TEXT_LAYOUT_CACHE_ENTRIES = 256;  // Above this, layouts not drawn recently are dropped
+
     // Dialogue box settings
     constexpr int DIALOGUE_BOX_X = 8;
     constexpr int DIALOGUE_BOX_Y = INTERNAL_HEIGHT - 64;
@@ -0,0 +1,45 @@
+#ifndef PATH_UTIL_H
+#define PATH_UTIL_H
+
+#include <filesystem>
+#include <string>
+
+namespace PathUtil {
+    // Security: reject paths that could escape the game directory
+    // (parent references, absolute paths, backslash separators)
+    [[nodiscard]] inline bool isSafeRelativePath(const std::string& path) {
+        return !path.empty() &&
+               path.find("..") == std::string::npos &&
+               path.find('/') != 0 &&
+               path.find('\\') == std::string::npos;
+    }
+
+    // Check whether path ends with the given extension (including the dot)
+    [[nodiscard]] inline bool hasExtension(const std::string& path, const std::string& ext) {
+        return path.size() >= ext.size() &&
+               path.compare(path.size() - ext.size(), ext.size(), ext) == 0;
+    }
+
+    // Replace the extension of path (path is returned unchanged if it has none)
+    [[nodiscard]] inline std::string replaceExtension(const std::string& path, const std::string& ext) {
+        size_t dot = path.find_last_of('.');
+        size_t slash = path.find_last_of('/');
+        if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+            return path;
+        }
+        return path.substr(0, dot) + ext;
+    }
+
+    // Check a file built from sourcePath (e.g. a compiled map) exists and is
+    // not older than its source; a missing source leaves it as the only copy
+    [[nodiscard]] inline bool isUpToDate(const std::string& builtPath, const std::string& sourcePath) {
+        std::error_code ec;
+        if (!std::filesystem::exists(builtPath, ec)) return false;
+        auto builtTime = std::filesystem::last_write_time(builtPath, ec);
+        if (ec) return false;
+        auto sourceTime = std::filesystem::last_write_time(sourcePath, ec);
+        return ec || builtTime >= sourceTime;
+    }
+}
+
+#endif // PATH_UTIL_H
@@ -0,0 +1,62 @@
+#ifndef UTF8_H
+#define UTF8_H
+
+#include <cstddef>
+#include <string_view>
+
+namespace Utf8 {
+    constexpr char32_t REPLACEMENT = 0xFFFD;  // Shown for malformed input
+
+    // Decode the code point starting at pos and advance pos past it. Malformed
+    // or truncated sequences, overlong forms and surrogates decode to
+    // REPLACEMENT and advance one byte, so decoding always makes progress.
+    [[nodiscard]] inline char32_t next(std::string_view text, size_t& pos) {
+        auto byte = [&text](size_t i) { return static_cast<unsigned char>(text[i]); };
+        unsigned char lead = byte(pos);
+        if (lead < 0x80) {
+            ++pos;
+            return lead;
+        }
+
+        int length = 0;
+        char32_t codePoint = 0;
+        char32_t minimum = 0;
+        if ((lead & 0xE0) == 0xC0) {
+            length = 2;
+            codePoint = lead & 0x1F;
+            minimum = 0x80;
+        } else if ((lead & 0xF0) == 0xE0) {
+            length = 3;
+            codePoint = lead & 0x0F;
+            minimum = 0x800;
+        } else if ((lead & 0xF8) == 0xF0) {
+            length = 4;
+            codePoint = lead & 0x07;
+            minimum = 0x10000;
+        } else {
+            ++pos;
+            return REPLACEMENT;
+        }
+
+        if (pos + length > text.size()) {
+            ++pos;
+            return REPLACEMENT;
+        }
+        for (int i = 1; i < length; ++i) {
+            unsigned char continuation = byte(pos + i);
+            if ((continuation & 0xC0) != 0x80) {
+                ++pos;
+                return REPLACEMENT;
+            }
+            codePoint = (codePoint << 6) | (continuation & 0x3F);
+        }
+        if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+            ++pos;
+            return REPLACEMENT;
+        }
+        pos += length;
+        return codePoint;
+    }
+}
+
+#endif // UTF8_H
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "system/AssetLoader.h"
+#include "system/Renderer.h"
+#include "system/ResourceManager.h"
+
+namespace {
+
+const std::vector<std::string> SHEETS = {"assets/fonts/font.png", "assets/tiles/tileset.png",
+                                         "assets/characters/player.png"};
+
+}  // namespace
+
+TEST(AssetLoaderTest, DecodesEveryRequest) {
+    AssetLoader loader(2);
+    for (const auto& path : SHEETS) {
+        loader.request(path);
+    }
+
+    std::vector<AssetLoader::Decoded> decoded;
+    while (loader.getPendingCount() > 0) {
+        loader.waitForFinished();
+        loader.takeFinished(decoded);
+    }
+
+    ASSERT_EQ(decoded.size(), SHEETS.size());
+    for (const auto& result : decoded) {
+        ASSERT_NE(result.surface, nullptr) << result.path;
+        EXPECT_GT(result.surface->w, 0);
+    }
+}
+
+class ResourceManagerAsyncTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(renderer_.init("test", Constants::WINDOW_WIDTH, Constants::WINDOW_HEIGHT,
+                                   Renderer::Backend::Headless));
+        resources_ = std::make_unique<ResourceManager>(renderer_.getSDLRenderer());
+    }
+
+    // Call update(maxUploads) until nothing is loading; false on timeout
+    bool updateUntilLoaded(int maxUploads, const std::vector<TextureHandle>& handles, int& maxReadyPerUpdate) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        maxReadyPerUpdate = 0;
+        int ready = 0;
+        while (resources_->isLoading()) {
+            if (std::chrono::steady_clock::now() > deadline) return false;
+            resources_->update(maxUploads);
+            int nowReady = 0;
+            for (const auto& handle : handles) {
+                nowReady += handle.isReady() ? 1 : 0;
+            }
+            maxReadyPerUpdate = std::max(maxReadyPerUpdate, nowReady - ready);
+            ready = nowReady;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    Renderer renderer_;
+    std::unique_ptr<ResourceManager> resources_;
+};
+
+TEST_F(ResourceManagerAsyncTest, HandlesBecomeReadyAfterBoundedUploads) {
+    std::vector<TextureHandle> handles;
+    for (const auto& path : SHEETS) {
+        handles.push_back(resources_->requestTexture(path));
+        EXPECT_TRUE(handles.back().isPending());
+    }
+    EXPECT_EQ(resources_->getLoadingCount(), 3);
+
+    int maxReadyPerUpdate = 0;
+    ASSERT_TRUE(updateUntilLoaded(1, handles, maxReadyPerUpdate));
+    EXPECT_EQ(maxReadyPerUpdate, 1);
+    for (const auto& handle : handles) {
+        ASSERT_TRUE(handle.isReady());
+        EXPECT_GT(handle.getRegion().rect.w, 0);
+    }
+
+    // Uploaded textures are cached like loadTexture()'s
+    EXPECT_EQ(resources_->loadTexture(SHEETS[0]), handles[0].getRegion().texture);
+    EXPECT_TRUE(resources_->requestTexture(SHEETS[0]).isReady());
+}
+
+TEST_F(ResourceManagerAsyncTest, RepeatedRequestsShareOneLoad) {
+    TextureHandle first = resources_->requestTexture(SHEETS[0]);
+    TextureHandle second = resources_->requestTexture(SHEETS[0]);
+    EXPECT_EQ(resources_->getLoadingCount(), 1);
+
+    int maxReadyPerUpdate = 0;
+    ASSERT_TRUE(updateUntilLoaded(1, {first}, maxReadyPerUpdate));
+    ASSERT_TRUE(second.isReady());
+    EXPECT_EQ(first.getRegion().texture, second.getRegion().texture);
+}
+
+TEST_F(ResourceManagerAsyncTest, AtlasImagesResolveOnBuild) {
+    for (const auto& path : SHEETS) {
+        resources_->addToAtlas(path);
+    }
+    TextureHandle handle = resources_->requestTexture(SHEETS[1]);
+    EXPECT_TRUE(handle.isPending());
+
+    ASSERT_TRUE(resources_->buildAtlas());
+    EXPECT_FALSE(resources_->isLoading());
+    ASSERT_TRUE(handle.isReady());
+    TextureRegion region = resources_->loadRegion(SHEETS[1]);
+    EXPECT_EQ(handle.getRegion().texture, region.texture);
+    EXPECT_EQ(handle.getRegion().rect.x, region.rect.x);
+    EXPECT_EQ(handle.getRegion().rect.y, region.rect.y);
+}
+
+TEST_F(ResourceManagerAsyncTest, RejectedAndUnloadedRequestsFail) {
+    EXPECT_TRUE(resources_->requestTexture("../outside.png").isFailed());
+
+    TextureHandle handle = resources_->requestTexture(SHEETS[0]);
+    resources_->unloadAllTextures();
+    EXPECT_TRUE(handle.isFailed());
+    EXPECT_FALSE(resources_->isLoading());
+
+    // The decode still running is dropped, not uploaded
+    int maxReadyPerUpdate = 0;
+    ASSERT_TRUE(updateUntilLoaded(1, {handle}, maxReadyPerUpdate));
+    EXPECT_EQ(resources_->getTexture(SHEETS[0]), nullptr);
+}
+
+TEST_F(ResourceManagerAsyncTest, AtlasReusesRequestedDecodes) {
+    // Still decoding when queued for the atlas
+    TextureHandle decoding = resources_->requestTexture(SHEETS[0]);
+    resources_->addToAtlas(SHEETS[0]);
+
+    // Most likely decoded and waiting for upload when queued (reused either way)
+    TextureHandle decoded = resources_->requestTexture(SHEETS[1]);
+    for (int i = 0; i < 50; ++i) {
+        resources_->update(0);  // Collects finished decodes, uploads none
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    resources_->addToAtlas(SHEETS[1]);
+    EXPECT_EQ(resources_->getDecodeCount(), 2);
+
+    ASSERT_TRUE(resources_->buildAtlas());
+    EXPECT_EQ(resources_->getDecodeCount(), 2);
+    EXPECT_FALSE(resources_->isLoading());
+    for (size_t i = 0; i < 2; ++i) {
+        const TextureHandle& handle = i == 0 ? decoding : decoded;
+        ASSERT_TRUE(handle.isReady()) << SHEETS[i];
+        TextureRegion region = resources_->loadRegion(SHEETS[i]);
+        EXPECT_EQ(handle.getRegion().texture, region.texture);
+        EXPECT_EQ(handle.getRegion().rect.x, region.rect.x);
+        EXPECT_EQ(handle.getRegion().rect.y, region.rect.y);
+    }
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "system/AtlasPacker.h"
+
+namespace {
+
+bool overlaps(const AtlasPacker::Placement& a, const Vec2& sizeA,
+              const AtlasPacker::Placement& b, const Vec2& sizeB) {
+    return a.page == b.page &&
+           a.x < b.x + sizeB.x && b.x < a.x + sizeA.x &&
+           a.y < b.y + sizeB.y && b.y < a.y + sizeA.y;
+}
+
+}  // namespace
+
+TEST(AtlasPackerTest, GameSheetsShareOnePage) {
+    // tileset, player, npcs and font sheets
+    std::vector<Vec2> sizes = {Vec2{128, 96}, Vec2{128, 128}, Vec2{128, 256}, Vec2{128, 48}};
+    AtlasPacker packer(1024, 1024, 1);
+    std::vector<AtlasPacker::Placement> placements = packer.pack(sizes);
+
+    ASSERT_EQ(placements.size(), sizes.size());
+    EXPECT_EQ(packer.getPageCount(), 1);
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        EXPECT_EQ(placements[i].page, 0);
+        for (size_t j = i + 1; j < sizes.size(); ++j) {
+            EXPECT_FALSE(overlaps(placements[i], sizes[i], placements[j], sizes[j]));
+        }
+    }
+    // Tallest sheet first, in the corner; the page is only as large as needed
+    EXPECT_EQ(placements[2].x, 0);
+    EXPECT_EQ(placements[2].y, 0);
+    EXPECT_LE(packer.getUsedSize(0).y, 257);
+}
+
+TEST(AtlasPackerTest, ManyRectanglesStayInsidePagesWithoutOverlap) {
+    std::vector<Vec2> sizes;
+    for (int i = 0; i < 200; ++i) {
+        sizes.push_back(Vec2{8 + (i * 37) % 56, 8 + (i * 53) % 40});
+    }
+    AtlasPacker packer(256, 256, 1);
+    std::vector<AtlasPacker::Placement> placements = packer.pack(sizes);
+
+    EXPECT_GT(packer.getPageCount(), 1);
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        ASSERT_GE(placements[i].page, 0);
+        EXPECT_GE(placements[i].x, 0);
+        EXPECT_GE(placements[i].y, 0);
+        EXPECT_LE(placements[i].x + sizes[i].x, 256);
+        EXPECT_LE(placements[i].y + sizes[i].y, 256);
+        for (size_t j = i + 1; j < sizes.size(); ++j) {
+            ASSERT_FALSE(overlaps(placements[i], sizes[i], placements[j], sizes[j])) << i << " " << j;
+        }
+    }
+}
+
+TEST(AtlasPackerTest, PaddingSeparatesNeighbors) {
+    std::vector<Vec2> sizes = {Vec2{16, 16}, Vec2{16, 16}};
+    AtlasPacker packer(64, 64, 2);
+    std::vector<AtlasPacker::Placement> placements = packer.pack(sizes);
+
+    Vec2 padded{18, 18};
+    EXPECT_FALSE(overlaps(placements[0], padded, placements[1], sizes[1]));
+}
+
+TEST(AtlasPackerTest, OversizedRectangleIsNotPlaced) {
+    std::vector<Vec2> sizes = {Vec2{300, 10}, Vec2{32, 32}};
+    AtlasPacker packer(256, 256, 0);
+    std::vector<AtlasPacker::Placement> placements = packer.pack(sizes);
+
+    EXPECT_EQ(placements[0].page, -1);
+    EXPECT_EQ(placements[1].page, 0);
+    EXPECT_EQ(packer.getPageCount(), 1);
+}
+
+TEST(AtlasPackerTest, FullPageExactFit) {
+    std::vector<Vec2> sizes(4, Vec2{32, 32});
+    AtlasPacker packer(64, 64, 0);
+    std::vector<AtlasPacker::Placement> placements = packer.pack(sizes);
+
+    EXPECT_EQ(packer.getPageCount(), 1);
+    EXPECT_EQ(packer.getUsedSize(0), Vec2(64, 64));
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include "ui/BakedFont.h"
+#include "ui/FontFormat.h"
+
+namespace {
+
+FontFormat::RFntGlyph makeGlyph(char32_t codePoint, int x, int width, int advance) {
+    FontFormat::RFntGlyph glyph{};
+    glyph.codePoint = codePoint;
+    glyph.x = static_cast<uint16_t>(x);
+    glyph.width = static_cast<uint16_t>(width);
+    glyph.height = width > 0 ? 7 : 0;
+    glyph.bearingY = 1;
+    glyph.advance = static_cast<int16_t>(advance);
+    return glyph;
+}
+
+// Glyphs out of order on purpose: write() sorts them
+std::vector<FontFormat::RFntGlyph> testGlyphs() {
+    return {makeGlyph('V', 8, 5, 6), makeGlyph(' ', 0, 0, 4), makeGlyph(0x3042, 16, 7, 8),
+            makeGlyph('A', 0, 5, 6)};
+}
+
+}  // namespace
+
+class BakedFontTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        std::remove("test_font.rfnt");
+    }
+
+    static std::vector<char> readFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    static void writeFile(const std::string& path, const std::vector<char>& bytes) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+};
+
+TEST_F(BakedFontTest, FindsGlyphsAndKerningPairs) {
+    ASSERT_TRUE(FontFormat::write("test_font.rfnt", 8, 32, 8, testGlyphs(),
+                                  {FontFormat::RFntKerning{'A', 'V', -1}}, "test_font_atlas.png"));
+
+    BakedFont font;
+    ASSERT_TRUE(font.open("test_font.rfnt"));
+    EXPECT_EQ(font.getGlyphCount(), 4);
+    EXPECT_EQ(font.getLineHeight(), 8);
+    EXPECT_EQ(font.getAtlasPath(), "test_font_atlas.png");
+
+    BakedFont::Glyph glyph;
+    ASSERT_TRUE(font.find('V', glyph));
+    EXPECT_EQ(glyph.src.x, 8);
+    EXPECT_EQ(glyph.src.w, 5);
+    EXPECT_EQ(glyph.bearingY, 1);
+    EXPECT_EQ(glyph.advance, 6);
+    ASSERT_TRUE(font.find(0x3042, glyph));
+    EXPECT_EQ(glyph.advance, 8);
+    EXPECT_FALSE(font.find('B', glyph));
+
+    EXPECT_EQ(font.getKerning('A', 'V'), -1);
+    EXPECT_EQ(font.getKerning('V', 'A'), 0);
+}
+
+TEST_F(BakedFontTest, RejectsGlyphsOutsideAtlas) {
+    std::vector<FontFormat::RFntGlyph> glyphs = testGlyphs();
+    glyphs[0].x = 30;  // 5 wide in a 32-wide atlas
+    ASSERT_TRUE(FontFormat::write("test_font.rfnt", 8, 32, 8, glyphs, {}, "test_font_atlas.png"));
+
+    BakedFont font;
+    EXPECT_FALSE(font.open("test_font.rfnt"));
+}
+
+TEST_F(BakedFontTest, RejectsAtlasOutsideFontDirectory) {
+    ASSERT_TRUE(FontFormat::write("test_font.rfnt", 8, 32, 8, testGlyphs(), {}, "../atlas.png"));
+
+    BakedFont font;
+    EXPECT_FALSE(font.open("test_font.rfnt"));
+}
+
+TEST_F(BakedFontTest, RejectsTruncatedAndUnsortedFiles) {
+    ASSERT_TRUE(FontFormat::write("test_font.rfnt", 8, 32, 8, testGlyphs(), {}, "test_font_atlas.png"));
+    std::vector<char> bytes = readFile("test_font.rfnt");
+
+    // Swap the first two glyph records
+    std::vector<char> unsorted = bytes;
+    size_t glyphs = sizeof(FontFormat::RFntHeader);
+    std::swap_ranges(unsorted.begin() + glyphs, unsorted.begin() + glyphs + sizeof(FontFormat::RFntGlyph),
+                     unsorted.begin() + glyphs + sizeof(FontFormat::RFntGlyph));
+    writeFile("test_font.rfnt", unsorted);
+    BakedFont font;
+    EXPECT_FALSE(font.open("test_font.rfnt"));
+
+    bytes.resize(bytes.size() - 4);
+    writeFile("test_font.rfnt", bytes);
+    EXPECT_FALSE(font.open("test_font.rfnt"));
+}
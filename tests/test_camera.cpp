@@ -364,3 +364,11 @@ TEST(CameraTest, GettersAreConst) {
     EXPECT_EQ(x, 100);
     EXPECT_EQ(y, 200);
 }
+
+// Test center tile of the view
+TEST(CameraTest, CenterTile) {
+    Camera camera{64, 32, 2000, 2000};
+    Vec2 center = camera.getCenterTile();
+    EXPECT_EQ(center.x, (64 + Constants::INTERNAL_WIDTH / 2) / Constants::TILE_SIZE);
+    EXPECT_EQ(center.y, (32 + Constants::INTERNAL_HEIGHT / 2) / Constants::TILE_SIZE);
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
+#include "ui/DialogueBox.h"
 #include "ui/DialogueState.h"
+#include "ui/TextRenderer.h"
 
 class DialogueStateTest : public ::testing::Test {
 protected:
@@ -141,3 +143,35 @@ TEST_F(DialogueStateTest, AdvanceToCloseIsImmutable) {
     EXPECT_TRUE(state.isActive());
     EXPECT_FALSE(closed.isActive());
 }
+
+TEST(DialogueBoxTest, LayoutPagesFitTheBox) {
+    DialogueBox box;
+    TextRenderer textRenderer;  // No font: 8px ASCII cells
+    std::vector<std::string> script = {
+        "Long ago, the seven bells of the valley rang every morning, and every traveler "
+        "who heard them found the road home. One by one they fell silent, and now only "
+        "the bell in the old tower remains.",
+        "Short page."
+    };
+
+    std::vector<std::string> pages = box.layoutPages(textRenderer, script);
+
+    ASSERT_EQ(pages.size(), 3u);
+    EXPECT_EQ(pages.back(), "Short page.");
+    int columns = box.getTextWidth() / Constants::FONT_CHAR_WIDTH;
+    for (const auto& page : pages) {
+        std::vector<std::string> lines;
+        size_t start = 0;
+        size_t end;
+        while ((end = page.find('\n', start)) != std::string::npos) {
+            lines.push_back(page.substr(start, end - start));
+            start = end + 1;
+        }
+        lines.push_back(page.substr(start));
+
+        EXPECT_LE(static_cast<int>(lines.size()), box.getLinesPerPage(textRenderer));
+        for (const auto& line : lines) {
+            EXPECT_LE(static_cast<int>(line.size()), columns) << line;
+        }
+    }
+}
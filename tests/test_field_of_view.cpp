@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include <utility>
+#include <vector>
+#include "field/FieldOfView.h"
+#include "field/Map.h"
+
+namespace {
+
+// Open floor room, walled on the border
+void makeRoom(Map& map, int width, int height) {
+    std::vector<TileType> tiles(static_cast<size_t>(width) * height, TileType::Floor);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (x == 0 || y == 0 || x == width - 1 || y == height - 1) {
+                tiles[static_cast<size_t>(y) * width + x] = TileType::Wall;
+            }
+        }
+    }
+    ASSERT_TRUE(map.loadFromTiles(width, height, std::move(tiles)));
+}
+
+int countVisible(const FieldOfView& fov, const Map& map) {
+    int count = 0;
+    for (int y = 0; y < map.getHeight(); ++y) {
+        for (int x = 0; x < map.getWidth(); ++x) {
+            count += fov.isVisible(x, y) ? 1 : 0;
+        }
+    }
+    return count;
+}
+
+}  // namespace
+
+TEST(FieldOfViewTest, NothingVisibleBeforeUpdate) {
+    FieldOfView fov;
+    EXPECT_FALSE(fov.isVisible(0, 0));
+    EXPECT_EQ(fov.getRadius(), -1);
+}
+
+TEST(FieldOfViewTest, RadiusLimitsOpenRoom) {
+    Map map;
+    makeRoom(map, 30, 30);
+    FieldOfView fov;
+    ASSERT_TRUE(fov.update(map, Vec2{15, 15}, 1));
+    EXPECT_EQ(countVisible(fov, map), 9);  // Full 3 x 3 block
+
+    ASSERT_TRUE(fov.update(map, Vec2{15, 15}, 4));
+    EXPECT_TRUE(fov.isVisible(19, 15));
+    EXPECT_TRUE(fov.isVisible(15, 11));
+    EXPECT_TRUE(fov.isVisible(18, 18));   // 9 + 9 <= 4^2 + 4
+    EXPECT_FALSE(fov.isVisible(19, 19));  // Corner of the window is outside the circle
+    EXPECT_FALSE(fov.isVisible(20, 15));
+}
+
+TEST(FieldOfViewTest, WallsBlockSightButAreSeen) {
+    Map map;
+    makeRoom(map, 30, 30);
+    ASSERT_TRUE(map.setTile(17, 15, TileType::Wall));
+    FieldOfView fov;
+    fov.update(map, Vec2{15, 15}, 6);
+
+    EXPECT_TRUE(fov.isVisible(16, 15));
+    EXPECT_TRUE(fov.isVisible(17, 15));   // The pillar itself
+    EXPECT_FALSE(fov.isVisible(18, 15));  // Its shadow
+    EXPECT_FALSE(fov.isVisible(20, 15));
+    EXPECT_TRUE(fov.isVisible(20, 17));   // Beside the shadow
+
+    // Water and doors do not block sight
+    ASSERT_TRUE(map.setTile(17, 15, TileType::Water));
+    fov.update(map, Vec2{15, 15}, 6);
+    EXPECT_TRUE(fov.isVisible(20, 15));
+}
+
+TEST(FieldOfViewTest, CannotSeeThroughRoomWalls) {
+    Map map;
+    makeRoom(map, 12, 12);
+    FieldOfView fov;
+    fov.update(map, Vec2{1, 1}, 8);
+    EXPECT_TRUE(fov.isVisible(0, 0));
+    EXPECT_TRUE(fov.isVisible(0, 5));
+    EXPECT_FALSE(fov.isVisible(-1, 1));
+
+    // A wall splitting the room hides its other half
+    for (int y = 0; y < 12; ++y) {
+        ASSERT_TRUE(map.setTile(5, y, TileType::Wall));
+    }
+    fov.update(map, Vec2{2, 5}, 8);
+    EXPECT_TRUE(fov.isVisible(5, 5));
+    EXPECT_FALSE(fov.isVisible(6, 5));
+    EXPECT_FALSE(fov.isVisible(8, 3));
+}
+
+TEST(FieldOfViewTest, UnchangedUpdateIsSkipped) {
+    Map map;
+    makeRoom(map, 20, 20);
+    FieldOfView fov;
+    ASSERT_TRUE(fov.update(map, Vec2{5, 5}, 3));
+    uint64_t revision = fov.getRevision();
+
+    EXPECT_FALSE(fov.update(map, Vec2{5, 5}, 3));
+    EXPECT_EQ(fov.getRevision(), revision);
+
+    // Moving, changing the radius or editing tiles all recast
+    EXPECT_TRUE(fov.update(map, Vec2{6, 5}, 3));
+    EXPECT_TRUE(fov.update(map, Vec2{6, 5}, 4));
+    ASSERT_TRUE(map.setTile(8, 8, TileType::Wall));
+    EXPECT_TRUE(fov.update(map, Vec2{6, 5}, 4));
+    EXPECT_GT(fov.getRevision(), revision);
+
+    fov.reset();
+    EXPECT_FALSE(fov.isVisible(6, 5));
+    EXPECT_TRUE(fov.update(map, Vec2{6, 5}, 4));
+}
+
+TEST(FieldOfViewTest, OneTileStepReadsOnlyTheNewEdge) {
+    Map map;
+    makeRoom(map, 40, 40);
+    ASSERT_TRUE(map.setTile(24, 21, TileType::Tree));
+    FieldOfView fov;
+    fov.update(map, Vec2{20, 20}, 4);
+    EXPECT_EQ(fov.getTilesRead(), 81);
+
+    fov.update(map, Vec2{21, 20}, 4);
+    EXPECT_EQ(fov.getTilesRead(), 9);
+    fov.update(map, Vec2{21, 19}, 4);
+    EXPECT_EQ(fov.getTilesRead(), 9);
+
+    // The shifted opacity casts the same shadows as a fresh read
+    FieldOfView stepped;
+    stepped.update(map, Vec2{21, 19}, 4);
+    for (int y = 14; y < 25; ++y) {
+        for (int x = 16; x < 27; ++x) {
+            EXPECT_EQ(fov.isVisible(x, y), stepped.isVisible(x, y)) << x << "," << y;
+        }
+    }
+    EXPECT_FALSE(fov.isVisible(25, 22));  // Behind the tree
+
+    // A tile change invalidates the cached opacity
+    ASSERT_TRUE(map.setTile(23, 19, TileType::Wall));
+    fov.update(map, Vec2{21, 20}, 4);
+    EXPECT_EQ(fov.getTilesRead(), 81);
+    EXPECT_FALSE(fov.isVisible(25, 18));  // Behind the new wall, as from scratch
+
+    FieldOfView fresh;
+    fresh.update(map, Vec2{21, 20}, 4);
+    for (int y = 14; y < 27; ++y) {
+        for (int x = 14; x < 28; ++x) {
+            EXPECT_EQ(fov.isVisible(x, y), fresh.isVisible(x, y)) << x << "," << y;
+        }
+    }
+}
+
+TEST(FieldOfViewTest, ExploredTilesPersistPerMap) {
+    Map map;
+    makeRoom(map, 30, 10);
+    FieldOfView fov;
+    fov.update(map, Vec2{3, 5}, 1);
+    const TileMask& explored = map.getExploredMask();
+    EXPECT_EQ(explored.getWidth(), 30);
+    EXPECT_TRUE(explored.test(4, 5));
+    EXPECT_FALSE(explored.test(10, 5));
+
+    for (int x = 4; x <= 10; ++x) {
+        fov.update(map, Vec2{x, 5}, 1);
+    }
+    EXPECT_FALSE(fov.isVisible(3, 5));
+    EXPECT_TRUE(explored.test(3, 5));  // Remembered after walking away
+    EXPECT_TRUE(explored.test(11, 5));
+    EXPECT_EQ(explored.countInRow(5, 0, 29), 10);  // Columns 2..11
+
+    // Loading a layout forgets it
+    makeRoom(map, 30, 10);
+    EXPECT_EQ(map.getExploredMask().getWidth(), 0);
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "system/FrameCapture.h"
+#include "system/Renderer.h"
+
+// Captures from a headless renderer, written by a recording encoder
+class FrameCaptureTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(renderer_.init("test", Constants::WINDOW_WIDTH, Constants::WINDOW_HEIGHT,
+                                   Renderer::Backend::Headless));
+    }
+
+    FrameCapture::Encoder recordingEncoder() {
+        return [this](const FrameCapture::Image& image, const std::string& path) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            paths_.push_back(path);
+            EXPECT_NE(image.pixels, nullptr);
+            EXPECT_GT(image.width, 0);
+            EXPECT_GT(image.height, 0);
+            return true;
+        };
+    }
+
+    // One game loop frame: draw, capture if due, present
+    void frame(FrameCapture& capture) {
+        bool due = capture.beginFrame();
+        renderer_.fillRect(0, 0, 16, 16);
+        if (due) {
+            capture.capture(renderer_);
+        }
+        renderer_.present();
+    }
+
+    Renderer renderer_;
+    std::mutex mutex_;
+    std::vector<std::string> paths_;
+};
+
+TEST_F(FrameCaptureTest, ScreenshotCapturesNextFrameOnce) {
+    FrameCapture capture("shots", recordingEncoder());
+    EXPECT_FALSE(capture.beginFrame());
+
+    capture.requestScreenshot();
+    frame(capture);
+    frame(capture);
+    capture.waitUntilIdle();
+
+    EXPECT_EQ(capture.getSavedCount(), 1);
+    ASSERT_EQ(paths_.size(), 1u);
+    EXPECT_EQ(paths_[0].rfind("shots/screenshot-", 0), 0u);
+}
+
+TEST_F(FrameCaptureTest, SequenceKeepsEveryNthFrame) {
+    FrameCapture capture("shots", recordingEncoder());
+    capture.startSequence(3, 4);
+    for (int i = 0; i < 20; ++i) {
+        frame(capture);
+    }
+    capture.waitUntilIdle();
+
+    EXPECT_FALSE(capture.isSequenceActive());  // Stopped after 4 frames
+    EXPECT_EQ(capture.getSavedCount() + capture.getDroppedCount(), 4);
+    EXPECT_LE(capture.getBufferCount(), Constants::CAPTURE_BUFFER_POOL);
+}
+
+TEST_F(FrameCaptureTest, BuffersAreReused) {
+    FrameCapture capture("shots", recordingEncoder());
+    capture.startSequence(1);
+    for (int i = 0; i < 50; ++i) {
+        frame(capture);
+        capture.waitUntilIdle();  // Worker keeps up: nothing dropped
+    }
+    EXPECT_EQ(capture.getSavedCount(), 50);
+    EXPECT_EQ(capture.getDroppedCount(), 0);
+    EXPECT_EQ(capture.getBufferCount(), 1);
+}
+
+TEST_F(FrameCaptureTest, SlowWriterDropsSequenceFrames) {
+    std::mutex gate;
+    std::unique_lock<std::mutex> hold(gate);  // Encoder blocks until released
+    FrameCapture capture("shots", [&gate](const FrameCapture::Image&, const std::string&) {
+        std::lock_guard<std::mutex> lock(gate);
+        return true;
+    });
+    capture.startSequence(1);
+    for (int i = 0; i < Constants::CAPTURE_BUFFER_POOL + 5; ++i) {
+        frame(capture);  // Never waits for the writer
+    }
+    EXPECT_EQ(capture.getBufferCount(), Constants::CAPTURE_BUFFER_POOL);
+    EXPECT_EQ(capture.getDroppedCount(), 5);
+
+    hold.unlock();
+    capture.waitUntilIdle();
+    EXPECT_EQ(capture.getSavedCount(), Constants::CAPTURE_BUFFER_POOL);
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "dialogue/TopicDatabase.h"
+#include "language/WordDatabase.h"
+#include "system/Renderer.h"
+#include "ui/GlyphCache.h"
+#include "ui/HexFont.h"
+#include "util/Utf8.h"
+
+namespace {
+
+// Every code point below 0x4000 is a solid 8x8 square
+bool squareFont(char32_t codePoint, GlyphCache::Bitmap& bitmap) {
+    if (codePoint >= 0x4000) return false;
+    bitmap.width = 8;
+    bitmap.height = 8;
+    bitmap.coverage.assign(64, 255);
+    return true;
+}
+
+}  // namespace
+
+class GlyphCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(renderer_.init("test", Constants::WINDOW_WIDTH, Constants::WINDOW_HEIGHT,
+                                   Renderer::Backend::Headless));
+    }
+
+    Renderer renderer_;
+};
+
+TEST_F(GlyphCacheTest, GlyphsAreRasterizedOnce) {
+    GlyphCache cache(squareFont);
+    EXPECT_EQ(cache.getPageCount(), 0);  // Nothing up front
+
+    const GlyphCache::Glyph* first = cache.get(renderer_, 0x3042);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first->src.w, 8);
+    EXPECT_EQ(cache.get(renderer_, 0x3042), first);
+    EXPECT_EQ(cache.getMissCount(), 1u);
+    EXPECT_EQ(cache.getHitCount(), 1u);
+    EXPECT_EQ(cache.getPageCount(), 1);
+}
+
+TEST_F(GlyphCacheTest, MissingGlyphsShareReplacementBox) {
+    GlyphCache cache(squareFont);
+    const GlyphCache::Glyph* a = cache.get(renderer_, 0x5000);
+    const GlyphCache::Glyph* b = cache.get(renderer_, 0x5001);
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(cache.getGlyphCount(), 1);
+    EXPECT_EQ(cache.getAdvance(0x5002), Constants::FONT_CHAR_WIDTH);
+}
+
+TEST_F(GlyphCacheTest, EvictsLeastRecentlyUsedFromEarlierFrames) {
+    constexpr int CELLS = (Constants::GLYPH_PAGE_SIZE / Constants::GLYPH_CELL_SIZE) *
+                          (Constants::GLYPH_PAGE_SIZE / Constants::GLYPH_CELL_SIZE);
+    GlyphCache cache(squareFont, 1);
+    for (int i = 0; i < CELLS; ++i) {
+        ASSERT_NE(cache.get(renderer_, 0x3000 + i), nullptr);
+    }
+    EXPECT_EQ(cache.get(renderer_, 0x3000 + CELLS), nullptr);  // All drawn this frame
+
+    renderer_.present();
+    ASSERT_NE(cache.get(renderer_, 0x3001), nullptr);  // Touch: no longer the oldest
+    ASSERT_NE(cache.get(renderer_, 0x3000 + CELLS), nullptr);
+    EXPECT_EQ(cache.getEvictionCount(), 1u);
+    EXPECT_EQ(cache.getPageCount(), 1);
+
+    // 0x3000 went; 0x3001 stayed
+    uint64_t misses = cache.getMissCount();
+    ASSERT_NE(cache.get(renderer_, 0x3001), nullptr);
+    EXPECT_EQ(cache.getMissCount(), misses);
+    ASSERT_NE(cache.get(renderer_, 0x3000), nullptr);
+    EXPECT_EQ(cache.getMissCount(), misses + 1);
+}
+
+TEST(HexFontTest, FindsGlyphsByBinarySearch) {
+    std::string path = ::testing::TempDir() + "glyphs_test.hex";
+    {
+        std::ofstream out(path);
+        out << "0041:FF818181818181FF\n";                   // 8x8
+        out << "3042:" << std::string(64, 'F') << "\n";     // 32x8
+        out << "3044:00000000000000000000000000000001\r\n"; // 16x8, CRLF
+    }
+    HexFont font;
+    ASSERT_TRUE(font.open(path, 8));
+
+    GlyphCache::Bitmap bitmap;
+    ASSERT_TRUE(font.rasterize(0x41, bitmap));
+    EXPECT_EQ(bitmap.width, 8);
+    EXPECT_EQ(bitmap.height, 8);
+    EXPECT_EQ(bitmap.coverage[0], 255);        // Top row set
+    EXPECT_EQ(bitmap.coverage[8 + 1], 0);      // Second row hollow inside
+    EXPECT_EQ(bitmap.coverage[8 + 7], 255);
+
+    ASSERT_TRUE(font.rasterize(0x3044, bitmap));
+    EXPECT_EQ(bitmap.width, 8 * 2);
+    EXPECT_EQ(bitmap.coverage.back(), 255);    // Last pixel of the last row
+
+    EXPECT_FALSE(font.rasterize(0x3043, bitmap));
+    EXPECT_FALSE(font.rasterize(0x10, bitmap));
+    EXPECT_FALSE(font.rasterize(0x4000, bitmap));
+    std::remove(path.c_str());
+}
+
+TEST(HexFontTest, ShippedGlyphsCoverGameStrings) {
+    HexFont font;
+    ASSERT_TRUE(font.open("assets/fonts/glyphs.hex", Constants::GLYPH_HEX_HEIGHT));
+
+    std::vector<std::string> strings;
+    for (const auto& topic : TopicDatabase::instance().getAllTopics()) {
+        strings.push_back(topic.promptJapanese);
+        for (const auto& choice : topic.choices) {
+            strings.push_back(choice.japanese);
+        }
+    }
+    for (const auto& word : WordDatabase::instance().getAllWords()) {
+        strings.push_back(word.japanese);
+    }
+
+    // Every character beyond ASCII has a glyph with some ink
+    int checked = 0;
+    GlyphCache::Bitmap bitmap;
+    for (const auto& text : strings) {
+        size_t pos = 0;
+        while (pos < text.size()) {
+            char32_t c = Utf8::next(text, pos);
+            if (c < 0x80) continue;
+            ASSERT_TRUE(font.rasterize(c, bitmap)) << "No glyph for U+" << std::hex << static_cast<uint32_t>(c);
+            EXPECT_EQ(bitmap.height, Constants::GLYPH_HEX_HEIGHT);
+            EXPECT_TRUE(std::any_of(bitmap.coverage.begin(), bitmap.coverage.end(),
+                                    [](uint8_t coverage) { return coverage > 0; }));
+            ++checked;
+        }
+    }
+    EXPECT_GT(checked, 0);
+}
@@ -116,8 +116,8 @@ TEST_F(MapTest, MapTransitions) {
     ASSERT_TRUE(map.loadFromCSV("test_map.csv"));
 
     // Initially no transitions
-    auto noTransition = map.getTransitionAt(Vec2{2, 2});
-    EXPECT_FALSE(noTransition.has_value());
+    const MapTransition* noTransition = map.getTransitionAt(Vec2{2, 2});
+    EXPECT_EQ(noTransition, nullptr);
 
     // Add a transition
     map.addTransition(MapTransition{
@@ -127,14 +127,63 @@ TEST_F(MapTest, MapTransitions) {
     });
 
     // Now there should be a transition at (2, 2)
-    auto transition = map.getTransitionAt(Vec2{2, 2});
-    EXPECT_TRUE(transition.has_value());
+    const MapTransition* transition = map.getTransitionAt(Vec2{2, 2});
+    ASSERT_NE(transition, nullptr);
     EXPECT_EQ(transition->targetMap, "dungeon.csv");
     EXPECT_EQ(transition->targetPos.x, 5);
     EXPECT_EQ(transition->targetPos.y, 5);
 
     // Other positions should still have no transition
-    EXPECT_FALSE(map.getTransitionAt(Vec2{1, 1}).has_value());
+    EXPECT_EQ(map.getTransitionAt(Vec2{1, 1}), nullptr);
+}
+
+// Test trigger layer returns a reference into the transition table
+TEST_F(MapTest, TransitionLookupReturnsReference) {
+    ASSERT_TRUE(map.loadFromCSV("test_map.csv"));
+    map.addTransition(MapTransition{Vec2{2, 2}, "dungeon.csv", Vec2{5, 5}});
+
+    EXPECT_EQ(map.getTransitionAt(Vec2{2, 2}), &map.getTransitions()[0]);
+}
+
+// Test one transition per tile; off-map transitions are ignored
+TEST_F(MapTest, TransitionTriggerConflicts) {
+    ASSERT_TRUE(map.loadFromCSV("test_map.csv"));
+    map.addTransition(MapTransition{Vec2{2, 2}, "first.csv", Vec2{1, 1}});
+    map.addTransition(MapTransition{Vec2{2, 2}, "second.csv", Vec2{1, 1}});
+    map.addTransition(MapTransition{Vec2{-1, 2}, "outside.csv", Vec2{1, 1}});
+    map.addTransition(MapTransition{Vec2{99, 2}, "outside.csv", Vec2{1, 1}});
+
+    ASSERT_EQ(map.getTransitions().size(), 1u);
+    ASSERT_NE(map.getTransitionAt(Vec2{2, 2}), nullptr);
+    EXPECT_EQ(map.getTransitionAt(Vec2{2, 2})->targetMap, "first.csv");
+    EXPECT_EQ(map.getTransitionAt(Vec2{-1, 2}), nullptr);
+}
+
+// Test loading a map replaces the trigger layer
+TEST_F(MapTest, ReloadReplacesTriggers) {
+    ASSERT_TRUE(map.loadFromCSV("test_map.csv"));
+    map.addTransition(MapTransition{Vec2{2, 2}, "dungeon.csv", Vec2{5, 5}});
+
+    ASSERT_TRUE(map.loadFromCSV("test_map.csv"));
+    EXPECT_TRUE(map.getTransitions().empty());
+    EXPECT_EQ(map.getTransitionAt(Vec2{2, 2}), nullptr);
+}
+
+// Test many triggers are each found at their own tile
+TEST_F(MapTest, ManyTriggers) {
+    std::vector<TileType> tiles(64 * 64, TileType::Floor);
+    ASSERT_TRUE(map.loadFromTiles(64, 64, tiles));
+    for (int i = 0; i < 500; ++i) {
+        map.addTransition(MapTransition{Vec2{i % 64, i / 64}, "warp" + std::to_string(i), Vec2{i, 0}});
+    }
+
+    ASSERT_EQ(map.getTransitions().size(), 500u);
+    for (int i = 0; i < 500; ++i) {
+        const MapTransition* transition = map.getTransitionAt(Vec2{i % 64, i / 64});
+        ASSERT_NE(transition, nullptr);
+        EXPECT_EQ(transition->targetPos.x, i);
+    }
+    EXPECT_EQ(map.getTransitionAt(Vec2{63, 63}), nullptr);
 }
 
 // Test out of bounds tile returns default (wall)
@@ -398,3 +447,73 @@ TEST_F(MapInvalidCSVTest, FloatValuesTruncated) {
     EXPECT_EQ(map.getTile(1, 0).type, TileType::Grass);  // 0
     EXPECT_EQ(map.getTile(2, 0).type, TileType::Wall);   // 2
 }
+
+// Additional edge case: Rows longer than the first row are truncated
+TEST_F(MapInvalidCSVTest, LongerRowsTruncated) {
+    writeTestCSV("0,0\n4,4,4\n2,2\n");
+
+    EXPECT_TRUE(map.loadFromCSV("test_invalid.csv"));
+
+    EXPECT_EQ(map.getWidth(), 2);
+    EXPECT_EQ(map.getTile(1, 1).type, TileType::Tree);
+    // Third row must not be shifted by the extra cell
+    EXPECT_EQ(map.getTile(0, 2).type, TileType::Wall);
+}
+
+// ==============================================================================
+// In-memory Tile Layer Tests
+// ==============================================================================
+
+TEST(MapTileLayerTest, LoadFromTiles) {
+    Map map;
+    std::vector<TileType> tiles = {
+        TileType::Wall, TileType::Grass, TileType::Water,
+        TileType::Door, TileType::Stairs, TileType::Tree
+    };
+
+    ASSERT_TRUE(map.loadFromTiles(3, 2, tiles));
+    EXPECT_EQ(map.getWidth(), 3);
+    EXPECT_EQ(map.getHeight(), 2);
+    EXPECT_EQ(map.getTileType(2, 0), TileType::Water);
+    EXPECT_EQ(map.getTile(1, 1).type, TileType::Stairs);
+    EXPECT_TRUE(map.isWalkable(0, 1));
+    EXPECT_FALSE(map.isWalkable(2, 1));
+    EXPECT_EQ(map.getTileMemoryBytes(), 6u);
+}
+
+TEST(MapTileLayerTest, LoadFromTilesRejectsSizeMismatch) {
+    Map map;
+    EXPECT_FALSE(map.loadFromTiles(3, 3, std::vector<TileType>(8, TileType::Grass)));
+    EXPECT_FALSE(map.loadFromTiles(0, 0, {}));
+}
+
+TEST(MapTileLayerTest, LoadFromTilesRejectsInvalidIds) {
+    Map map;
+    std::vector<TileType> tiles(4, TileType::Grass);
+    tiles[2] = static_cast<TileType>(200);
+    EXPECT_FALSE(map.loadFromTiles(2, 2, tiles));
+}
+
+TEST(MapTileLayerTest, OutOfBoundsTileTypeIsWall) {
+    Map map;
+    ASSERT_TRUE(map.loadFromTiles(1, 1, {TileType::Grass}));
+    EXPECT_EQ(map.getTileType(-1, 0), TileType::Wall);
+    EXPECT_EQ(map.getTileType(0, 1), TileType::Wall);
+}
+
+// Test shipped maps define their transitions and NPCs in map data
+TEST(MapDataTest, ShippedMapsLinkEachOther) {
+    Map world;
+    ASSERT_TRUE(world.loadFromCSV("data/maps/world_01.csv"));
+    const MapTransition* down = world.getTransitionAt(Vec2{9, 10});
+    ASSERT_NE(down, nullptr);
+    EXPECT_EQ(down->targetMap, "data/maps/dungeon_01.csv");
+    EXPECT_EQ(world.getNPCPlacements().size(), 2u);
+
+    Map dungeon;
+    ASSERT_TRUE(dungeon.loadFromCSV(down->targetMap));
+    const MapTransition* up = dungeon.getTransitionAt(down->targetPos);
+    ASSERT_NE(up, nullptr);
+    EXPECT_EQ(up->targetMap, "data/maps/world_01.csv");
+    EXPECT_EQ(up->targetPos, Vec2(9, 10));
+}
@@ -0,0 +1,321 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include "field/Map.h"
+#include "field/MapFormat.h"
+
+class MapBinaryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::ofstream csv("test_binary_map.csv");
+        csv << "# Test map with directives\n";
+        csv << "#spawn,2,1\n";
+        csv << "#transition,3,2,data/maps/dungeon_01.csv,7,7\n";
+        csv << "#npc,1,2,left,villager\n";
+        csv << "2,2,2,2,2\n";
+        csv << "2,0,0,0,2\n";
+        csv << "2,0,3,9,2\n";
+        csv << "2,2,2,2,2\n";
+        csv.close();
+    }
+
+    void TearDown() override {
+        std::remove("test_binary_map.csv");
+        std::remove("test_binary_map.rmap");
+        std::remove("test_corrupt.rmap");
+    }
+
+    // Read whole file into a byte buffer
+    static std::vector<char> readFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(file), {});
+    }
+
+    static void writeFile(const std::string& path, const std::vector<char>& bytes) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    // Build a valid .rmap and return its bytes for corruption tests
+    std::vector<char> validBinary() {
+        Map source;
+        EXPECT_TRUE(source.loadFromCSV("test_binary_map.csv"));
+        EXPECT_TRUE(source.saveToBinary("test_binary_map.rmap"));
+        return readFile("test_binary_map.rmap");
+    }
+
+    static MapFormat::RMapHeader headerOf(const std::vector<char>& bytes) {
+        MapFormat::RMapHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        return header;
+    }
+
+    static void setHeader(std::vector<char>& bytes, const MapFormat::RMapHeader& header) {
+        std::memcpy(bytes.data(), &header, sizeof(header));
+    }
+
+    Map map;
+};
+
+// ==============================================================================
+// CSV Directive Tests
+// ==============================================================================
+
+TEST_F(MapBinaryTest, CSVDirectivesAreParsed) {
+    ASSERT_TRUE(map.loadFromCSV("test_binary_map.csv"));
+
+    // Directive lines are not tile rows
+    EXPECT_EQ(map.getWidth(), 5);
+    EXPECT_EQ(map.getHeight(), 4);
+
+    EXPECT_EQ(map.getSpawnPosition().x, 2);
+    EXPECT_EQ(map.getSpawnPosition().y, 1);
+
+    ASSERT_EQ(map.getTransitions().size(), 1u);
+    EXPECT_EQ(map.getTransitions()[0].targetMap, "data/maps/dungeon_01.csv");
+
+    ASSERT_EQ(map.getNPCPlacements().size(), 1u);
+    EXPECT_EQ(map.getNPCPlacements()[0].facing, Direction::Left);
+    EXPECT_EQ(map.getNPCPlacements()[0].definitionId, "villager");
+}
+
+TEST_F(MapBinaryTest, CSVRejectsUnsafeTransitionTarget) {
+    std::ofstream csv("test_binary_map.csv");
+    csv << "#transition,1,1,../secret.csv,0,0\n";
+    csv << "#npc,9,9,down,villager\n";
+    csv << "0,0,0\n0,0,0\n";
+    csv.close();
+
+    ASSERT_TRUE(map.loadFromCSV("test_binary_map.csv"));
+    EXPECT_TRUE(map.getTransitions().empty());
+    // Placement outside the map is dropped
+    EXPECT_TRUE(map.getNPCPlacements().empty());
+}
+
+TEST_F(MapBinaryTest, ReloadReplacesTransitions) {
+    ASSERT_TRUE(map.loadFromCSV("test_binary_map.csv"));
+    ASSERT_TRUE(map.loadFromCSV("test_binary_map.csv"));
+    EXPECT_EQ(map.getTransitions().size(), 1u);
+    EXPECT_EQ(map.getNPCPlacements().size(), 1u);
+}
+
+// ==============================================================================
+// Round Trip Tests
+// ==============================================================================
+
+TEST_F(MapBinaryTest, RoundTripPreservesMap) {
+    Map source;
+    ASSERT_TRUE(source.loadFromCSV("test_binary_map.csv"));
+    ASSERT_TRUE(source.saveToBinary("test_binary_map.rmap"));
+
+    ASSERT_TRUE(map.loadFromBinary("test_binary_map.rmap"));
+    EXPECT_TRUE(map.isMemoryMapped());
+    EXPECT_EQ(map.getWidth(), source.getWidth());
+    EXPECT_EQ(map.getHeight(), source.getHeight());
+    for (int y = 0; y < map.getHeight(); ++y) {
+        for (int x = 0; x < map.getWidth(); ++x) {
+            EXPECT_EQ(map.getTileType(x, y), source.getTileType(x, y));
+        }
+    }
+
+    EXPECT_EQ(map.getSpawnPosition().x, 2);
+    EXPECT_EQ(map.getSpawnPosition().y, 1);
+
+    const MapTransition* transition = map.getTransitionAt(Vec2{3, 2});
+    ASSERT_NE(transition, nullptr);
+    EXPECT_EQ(transition->targetMap, "data/maps/dungeon_01.csv");
+    EXPECT_EQ(transition->targetPos.x, 7);
+
+    ASSERT_EQ(map.getNPCPlacements().size(), 1u);
+    EXPECT_EQ(map.getNPCPlacements()[0].pos.x, 1);
+    EXPECT_EQ(map.getNPCPlacements()[0].pos.y, 2);
+    EXPECT_EQ(map.getNPCPlacements()[0].definitionId, "villager");
+
+    // Walkability works on mapped tile data
+    EXPECT_TRUE(map.isWalkable(1, 1));
+    EXPECT_FALSE(map.isWalkable(0, 0));
+}
+
+TEST_F(MapBinaryTest, DarkFlagSurvivesBothFormats) {
+    Map source;
+    ASSERT_TRUE(source.loadFromCSV("test_binary_map.csv"));
+    EXPECT_FALSE(source.isDark());
+    ASSERT_TRUE(source.saveToBinary("test_binary_map.rmap"));
+    ASSERT_TRUE(map.loadFromBinary("test_binary_map.rmap"));
+    EXPECT_FALSE(map.isDark());
+
+    source.setDark(true);
+    ASSERT_TRUE(source.saveToCSV("test_dark_map.csv"));
+    ASSERT_TRUE(map.loadFromCSV("test_dark_map.csv"));
+    std::remove("test_dark_map.csv");
+    EXPECT_TRUE(map.isDark());
+
+    ASSERT_TRUE(map.saveToBinary("test_binary_map.rmap"));
+    Map loaded;
+    ASSERT_TRUE(loaded.loadFromBinary("test_binary_map.rmap"));
+    EXPECT_TRUE(loaded.isDark());
+}
+
+TEST_F(MapBinaryTest, LoadPrefersUpToDateBinary) {
+    Map source;
+    ASSERT_TRUE(source.loadFromCSV("test_binary_map.csv"));
+    ASSERT_TRUE(source.saveToBinary("test_binary_map.rmap"));
+
+    ASSERT_TRUE(map.load("test_binary_map.csv"));
+    EXPECT_TRUE(map.isMemoryMapped());
+}
+
+TEST_F(MapBinaryTest, LoadFallsBackToCSV) {
+    ASSERT_TRUE(map.load("test_binary_map.csv"));
+    EXPECT_FALSE(map.isMemoryMapped());
+    EXPECT_EQ(map.getWidth(), 5);
+}
+
+TEST_F(MapBinaryTest, MapIsMovable) {
+    ASSERT_TRUE(map.loadFromCSV("test_binary_map.csv"));
+    ASSERT_TRUE(map.saveToBinary("test_binary_map.rmap"));
+    ASSERT_TRUE(map.loadFromBinary("test_binary_map.rmap"));
+
+    Map moved(std::move(map));
+    EXPECT_EQ(moved.getTileType(3, 2), TileType::Stairs);
+    EXPECT_TRUE(moved.isMemoryMapped());
+}
+
+// ==============================================================================
+// Validation Tests
+// ==============================================================================
+
+TEST_F(MapBinaryTest, RejectsPathTraversal) {
+    EXPECT_FALSE(map.loadFromBinary("../test_binary_map.rmap"));
+    EXPECT_FALSE(map.loadFromBinary("/tmp/test_binary_map.rmap"));
+}
+
+TEST_F(MapBinaryTest, RejectsMissingFile) {
+    EXPECT_FALSE(map.loadFromBinary("nonexistent.rmap"));
+}
+
+TEST_F(MapBinaryTest, RejectsBadMagic) {
+    std::vector<char> bytes = validBinary();
+    bytes[0] = 'X';
+    writeFile("test_corrupt.rmap", bytes);
+    EXPECT_FALSE(map.loadFromBinary("test_corrupt.rmap"));
+}
+
+TEST_F(MapBinaryTest, RejectsUnknownVersion) {
+    std::vector<char> bytes = validBinary();
+    auto header = headerOf(bytes);
+    header.version = MapFormat::VERSION + 1;
+    setHeader(bytes, header);
+    writeFile("test_corrupt.rmap", bytes);
+    EXPECT_FALSE(map.loadFromBinary("test_corrupt.rmap"));
+}
+
+TEST_F(MapBinaryTest, RejectsTruncatedFile) {
+    std::vector<char> bytes = validBinary();
+    bytes.resize(bytes.size() - 4);
+    writeFile("test_corrupt.rmap", bytes);
+    EXPECT_FALSE(map.loadFromBinary("test_corrupt.rmap"));
+
+    bytes.resize(8);
+    writeFile("test_corrupt.rmap", bytes);
+    EXPECT_FALSE(map.loadFromBinary("test_corrupt.rmap"));
+}
+
+TEST_F(MapBinaryTest, RejectsOutOfRangeTileId) {
+    std::vector<char> bytes = validBinary();
+    auto header = headerOf(bytes);
+    bytes[header.tileOffset + 6] = static_cast<char>(Constants::MAX_TILE_ID + 1);
+    writeFile("test_corrupt.rmap", bytes);
+    EXPECT_FALSE(map.loadFromBinary("test_corrupt.rmap"));
+}
+
+TEST_F(MapBinaryTest, RejectsOversizedDimensions) {
+    std::vector<char> bytes = validBinary();
+    auto header = headerOf(bytes);
+    header.width = MapFormat::MAX_DIMENSION + 1;
+    setHeader(bytes, header);
+    writeFile("test_corrupt.rmap", bytes);
+    EXPECT_FALSE(map.loadFromBinary("test_corrupt.rmap"));
+}
+
+TEST_F(MapBinaryTest, RejectsSpawnOutsideMap) {
+    std::vector<char> bytes = validBinary();
+    auto header = headerOf(bytes);
+    header.spawnX = 99;
+    setHeader(bytes, header);
+    writeFile("test_corrupt.rmap", bytes);
+    EXPECT_FALSE(map.loadFromBinary("test_corrupt.rmap"));
+}
+
+TEST_F(MapBinaryTest, CSVRejectsSpawnOutsideMap) {
+    // Checked like the binary loader does, so csv2rmap never writes a map the game refuses
+    for (const char* spawn : {"#spawn,5,1\n", "#spawn,-1,0\n"}) {
+        std::ofstream csv("test_corrupt.csv");
+        csv << spawn << "0,0,0,0,0\n0,0,0,0,0\n";
+        csv.close();
+        EXPECT_FALSE(map.loadFromCSV("test_corrupt.csv")) << spawn;
+    }
+    std::remove("test_corrupt.csv");
+
+    std::vector<TileType> tiles(10, TileType::Grass);
+    EXPECT_FALSE(MapFormat::write("test_corrupt.rmap", 5, 2, 5, 1, tiles.data(), {}, {}));
+}
+
+TEST_F(MapBinaryTest, CSVDropsTransitionsTheBinaryLoaderRejects) {
+    std::ofstream csv("test_corrupt.csv");
+    csv << "#transition,1,1,data/maps/dungeon_01.csv,-1,3\n";
+    csv << "#transition,1,0,data/maps/dungeon_01.csv,1,1\n";
+    csv << "0,0,0\n0,0,0\n";
+    csv.close();
+    ASSERT_TRUE(map.loadFromCSV("test_corrupt.csv"));
+    std::remove("test_corrupt.csv");
+
+    ASSERT_EQ(map.getTransitions().size(), 1u);
+    ASSERT_TRUE(map.saveToBinary("test_binary_map.rmap"));
+    Map loaded;
+    EXPECT_TRUE(loaded.loadFromBinary("test_binary_map.rmap"));
+}
+
+TEST_F(MapBinaryTest, RejectsStringOutsideTable) {
+    std::vector<char> bytes = validBinary();
+    auto header = headerOf(bytes);
+    MapFormat::RMapTransition record;
+    std::memcpy(&record, bytes.data() + header.transitionOffset, sizeof(record));
+    record.targetMapLength = header.stringSize + 1;
+    std::memcpy(bytes.data() + header.transitionOffset, &record, sizeof(record));
+    writeFile("test_corrupt.rmap", bytes);
+    EXPECT_FALSE(map.loadFromBinary("test_corrupt.rmap"));
+}
+
+TEST_F(MapBinaryTest, RejectsUnsafeTransitionTarget) {
+    std::vector<char> bytes = validBinary();
+    auto header = headerOf(bytes);
+    // Overwrite the start of "data/maps/..." with a parent reference
+    bytes[header.stringOffset] = '.';
+    bytes[header.stringOffset + 1] = '.';
+    writeFile("test_corrupt.rmap", bytes);
+    EXPECT_FALSE(map.loadFromBinary("test_corrupt.rmap"));
+}
+
+TEST_F(MapBinaryTest, RejectsInvalidNPCFacing) {
+    std::vector<char> bytes = validBinary();
+    auto header = headerOf(bytes);
+    MapFormat::RMapNPC record;
+    std::memcpy(&record, bytes.data() + header.npcOffset, sizeof(record));
+    record.facing = 42;
+    std::memcpy(bytes.data() + header.npcOffset, &record, sizeof(record));
+    writeFile("test_corrupt.rmap", bytes);
+    EXPECT_FALSE(map.loadFromBinary("test_corrupt.rmap"));
+}
+
+TEST_F(MapBinaryTest, FailedLoadKeepsPreviousMap) {
+    ASSERT_TRUE(map.loadFromCSV("test_binary_map.csv"));
+    std::vector<char> bytes = validBinary();
+    bytes[0] = 'X';
+    writeFile("test_corrupt.rmap", bytes);
+
+    EXPECT_FALSE(map.loadFromBinary("test_corrupt.rmap"));
+    EXPECT_EQ(map.getWidth(), 5);
+    EXPECT_EQ(map.getTileType(3, 2), TileType::Stairs);
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include "field/MapCache.h"
+
+class MapCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        writeMap("test_cache_a.csv", "test_cache_b.csv", 3);
+        writeMap("test_cache_b.csv", "test_cache_a.csv", 3);
+        writeMap("test_cache_c.csv", "test_cache_a.csv", 3);
+    }
+
+    void TearDown() override {
+        std::remove("test_cache_a.csv");
+        std::remove("test_cache_b.csv");
+        std::remove("test_cache_c.csv");
+    }
+
+    static void writeMap(const std::string& path, const std::string& target, int size) {
+        std::ofstream file(path);
+        file << "#transition,1,1," << target << ",1,1\n";
+        file << "#npc,2,2,down,villager\n";
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                file << (x ? "," : "") << "0";
+            }
+            file << "\n";
+        }
+    }
+
+    // Spawns NPCs like Game::setupNPCs and counts calls
+    MapCache::SetupHook countingSetup() {
+        return [this](Map& map) {
+            ++setupCalls;
+            map.addNPCDefinition(NPCDefinition{"villager", 0, {"Hello!"}});
+            for (const auto& placement : map.getNPCPlacements()) {
+                map.addNPC(placement.pos, placement.facing, placement.definitionId);
+            }
+        };
+    }
+
+    int setupCalls = 0;
+};
+
+TEST_F(MapCacheTest, AcquireReturnsSameMap) {
+    MapCache cache(1024 * 1024, countingSetup());
+    std::shared_ptr<Map> first = cache.acquire("test_cache_a.csv");
+    ASSERT_NE(first, nullptr);
+    std::shared_ptr<Map> second = cache.acquire("test_cache_a.csv");
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(cache.getMapCount(), 1);
+    EXPECT_EQ(setupCalls, 1);
+}
+
+TEST_F(MapCacheTest, RoundTripsDoNotGrowNPCs) {
+    MapCache cache(1024 * 1024, countingSetup());
+    for (int i = 0; i < 5; ++i) {
+        std::shared_ptr<Map> a = cache.acquire("test_cache_a.csv");
+        std::shared_ptr<Map> b = cache.acquire("test_cache_b.csv");
+        ASSERT_NE(a, nullptr);
+        ASSERT_NE(b, nullptr);
+        EXPECT_EQ(a->getNPCs().size(), 1u);
+        EXPECT_EQ(b->getNPCs().size(), 1u);
+    }
+    EXPECT_EQ(setupCalls, 2);
+}
+
+TEST_F(MapCacheTest, FailedLoadReturnsNull) {
+    MapCache cache;
+    EXPECT_EQ(cache.acquire("nonexistent.csv"), nullptr);
+    EXPECT_EQ(cache.getMapCount(), 0);
+}
+
+TEST_F(MapCacheTest, PrefetchLoadsInBackground) {
+    MapCache cache(1024 * 1024, countingSetup());
+    std::shared_ptr<Map> a = cache.acquire("test_cache_a.csv");
+    ASSERT_NE(a, nullptr);
+
+    cache.prefetch({a->getTransitions()[0].targetMap});
+    cache.waitForPrefetch();
+    EXPECT_TRUE(cache.contains("test_cache_b.csv"));
+    EXPECT_EQ(setupCalls, 2);
+
+    // Entering the prefetched map does not load it again
+    std::shared_ptr<Map> b = cache.acquire("test_cache_b.csv");
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(b->getNPCs().size(), 1u);
+    EXPECT_EQ(setupCalls, 2);
+}
+
+TEST_F(MapCacheTest, AcquireWhilePrefetchingLoadsOnce) {
+    MapCache cache(1024 * 1024, countingSetup());
+    cache.prefetch({"test_cache_a.csv", "test_cache_b.csv", "test_cache_c.csv"});
+
+    std::shared_ptr<Map> c = cache.acquire("test_cache_c.csv");
+    ASSERT_NE(c, nullptr);
+    cache.waitForPrefetch();
+
+    EXPECT_EQ(cache.getMapCount(), 3);
+    EXPECT_EQ(setupCalls, 3);
+    EXPECT_EQ(cache.acquire("test_cache_c.csv"), c);
+}
+
+TEST_F(MapCacheTest, EvictsLeastRecentlyUsedOverBudget) {
+    MapCache probe;
+    size_t mapBytes = 0;
+    {
+        std::shared_ptr<Map> map = probe.acquire("test_cache_a.csv");
+        ASSERT_NE(map, nullptr);
+        mapBytes = map->getMemoryBytes();
+    }
+
+    // Room for two of the three maps
+    MapCache cache(mapBytes * 2 + mapBytes / 2);
+    ASSERT_NE(cache.acquire("test_cache_a.csv"), nullptr);
+    ASSERT_NE(cache.acquire("test_cache_b.csv"), nullptr);
+    ASSERT_NE(cache.acquire("test_cache_a.csv"), nullptr);  // b is now least recent
+    ASSERT_NE(cache.acquire("test_cache_c.csv"), nullptr);
+
+    EXPECT_TRUE(cache.contains("test_cache_a.csv"));
+    EXPECT_FALSE(cache.contains("test_cache_b.csv"));
+    EXPECT_TRUE(cache.contains("test_cache_c.csv"));
+    EXPECT_LE(cache.getCachedBytes(), mapBytes * 2 + mapBytes / 2);
+}
+
+TEST_F(MapCacheTest, MapsInUseAreNotEvicted) {
+    MapCache cache(1);  // Every map is over budget
+    std::shared_ptr<Map> a = cache.acquire("test_cache_a.csv");
+    std::shared_ptr<Map> b = cache.acquire("test_cache_b.csv");
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+
+    // a is still held, so it stays cached
+    EXPECT_TRUE(cache.contains("test_cache_a.csv"));
+    EXPECT_EQ(cache.acquire("test_cache_a.csv"), a);
+}
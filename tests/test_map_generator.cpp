@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <set>
+#include <utility>
+#include <vector>
+#include "field/Map.h"
+#include "field/MapGenerator.h"
+#include "field/Pathfinder.h"
+
+namespace {
+
+MapGenerator::Config makeConfig(MapGenerator::Style style, int width, int height, uint32_t seed) {
+    MapGenerator::Config config;
+    config.style = style;
+    config.width = width;
+    config.height = height;
+    config.seed = seed;
+    return config;
+}
+
+bool sameLayout(const Map& a, const Map& b) {
+    if (a.getWidth() != b.getWidth() || a.getHeight() != b.getHeight() ||
+        !a.getSpawnPosition().equals(b.getSpawnPosition()) ||
+        a.getTransitions().size() != b.getTransitions().size() ||
+        a.getNPCPlacements().size() != b.getNPCPlacements().size()) {
+        return false;
+    }
+    for (int y = 0; y < a.getHeight(); ++y) {
+        for (int x = 0; x < a.getWidth(); ++x) {
+            if (a.getTileType(x, y) != b.getTileType(x, y)) return false;
+        }
+    }
+    for (size_t i = 0; i < a.getTransitions().size(); ++i) {
+        const MapTransition& ta = a.getTransitions()[i];
+        const MapTransition& tb = b.getTransitions()[i];
+        if (!ta.triggerPos.equals(tb.triggerPos) || ta.targetMap != tb.targetMap ||
+            !ta.targetPos.equals(tb.targetPos)) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < a.getNPCPlacements().size(); ++i) {
+        const NPCPlacement& pa = a.getNPCPlacements()[i];
+        const NPCPlacement& pb = b.getNPCPlacements()[i];
+        if (!pa.pos.equals(pb.pos) || pa.facing != pb.facing || pa.definitionId != pb.definitionId) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const MapGenerator::Style STYLES[] = {MapGenerator::Style::Overworld, MapGenerator::Style::Dungeon};
+
+}  // namespace
+
+TEST(MapGeneratorTest, SameSeedProducesSameMap) {
+    for (auto style : STYLES) {
+        Map first;
+        Map second;
+        ASSERT_TRUE(MapGenerator::generate(makeConfig(style, 160, 96, 42), first));
+        ASSERT_TRUE(MapGenerator::generate(makeConfig(style, 160, 96, 42), second));
+        EXPECT_TRUE(sameLayout(first, second));
+    }
+}
+
+TEST(MapGeneratorTest, DifferentSeedsProduceDifferentMaps) {
+    for (auto style : STYLES) {
+        Map first;
+        Map second;
+        ASSERT_TRUE(MapGenerator::generate(makeConfig(style, 128, 128, 1), first));
+        ASSERT_TRUE(MapGenerator::generate(makeConfig(style, 128, 128, 2), second));
+        EXPECT_FALSE(sameLayout(first, second));
+    }
+}
+
+TEST(MapGeneratorTest, RejectsSizesOutOfRange) {
+    Map map;
+    EXPECT_FALSE(MapGenerator::generate(makeConfig(MapGenerator::Style::Overworld, 63, 64, 1), map));
+    EXPECT_FALSE(MapGenerator::generate(makeConfig(MapGenerator::Style::Dungeon, 64, 16385, 1), map));
+    EXPECT_TRUE(MapGenerator::generate(makeConfig(MapGenerator::Style::Dungeon, 64, 100, 1), map));
+    EXPECT_EQ(map.getWidth(), 64);
+    EXPECT_EQ(map.getHeight(), 100);
+}
+
+TEST(MapGeneratorTest, OnlyDungeonsAreDark) {
+    Map map;
+    ASSERT_TRUE(MapGenerator::generate(makeConfig(MapGenerator::Style::Dungeon, 64, 64, 1), map));
+    EXPECT_TRUE(map.isDark());
+    ASSERT_TRUE(MapGenerator::generate(makeConfig(MapGenerator::Style::Overworld, 64, 64, 1), map));
+    EXPECT_FALSE(map.isDark());
+}
+
+TEST(MapGeneratorTest, RejectsUnsafeLinkMap) {
+    MapGenerator::Config config;
+    config.linkMap = "../outside.csv";
+    Map map;
+    EXPECT_FALSE(MapGenerator::generate(config, map));
+}
+
+TEST(MapGeneratorTest, SmallestMapsUseEveryTileType) {
+    for (auto style : STYLES) {
+        for (uint32_t seed = 0; seed < 8; ++seed) {
+            Map map;
+            ASSERT_TRUE(MapGenerator::generate(makeConfig(style, 64, 64, seed), map));
+            std::set<TileType> used;
+            for (int y = 0; y < map.getHeight(); ++y) {
+                for (int x = 0; x < map.getWidth(); ++x) {
+                    used.insert(map.getTileType(x, y));
+                }
+            }
+            EXPECT_EQ(static_cast<int>(used.size()), TILE_TYPE_COUNT) << "seed " << seed;
+            EXPECT_FALSE(map.getTransitions().empty());
+            EXPECT_FALSE(map.getNPCPlacements().empty());
+        }
+    }
+}
+
+TEST(MapGeneratorTest, ObjectsAreReachableFromSpawn) {
+    for (auto style : STYLES) {
+        for (uint32_t seed = 0; seed < 4; ++seed) {
+            Map map;
+            ASSERT_TRUE(MapGenerator::generate(makeConfig(style, 256, 192, seed), map));
+            Pathfinder pathfinder;
+            Vec2 spawn = map.getSpawnPosition();
+            ASSERT_TRUE(map.isWalkable(spawn.x, spawn.y));
+
+            for (const auto& transition : map.getTransitions()) {
+                EXPECT_EQ(map.getTileType(transition.triggerPos.x, transition.triggerPos.y), TileType::Stairs);
+                EXPECT_TRUE(pathfinder.isReachable(map, spawn, transition.triggerPos));
+                EXPECT_EQ(transition.targetMap, "data/maps/world_01.csv");
+            }
+
+            std::set<std::pair<int, int>> occupied;
+            for (const auto& placement : map.getNPCPlacements()) {
+                EXPECT_TRUE(occupied.insert({placement.pos.x, placement.pos.y}).second);
+                EXPECT_TRUE(map.getTile(placement.pos.x, placement.pos.y).walkable);
+                EXPECT_EQ(map.getTransitionAt(placement.pos), nullptr);
+                EXPECT_FALSE(placement.pos.equals(spawn));
+                EXPECT_TRUE(pathfinder.isReachable(map, spawn, placement.pos));
+                EXPECT_TRUE(placement.definitionId == "villager" || placement.definitionId == "guard");
+            }
+        }
+    }
+}
+
+TEST(MapGeneratorTest, SpawnedNPCsDoNotBlockStairs) {
+    for (auto style : STYLES) {
+        Map map;
+        ASSERT_TRUE(MapGenerator::generate(makeConfig(style, 512, 512, 9), map));
+        map.addNPCDefinition(NPCDefinition{"villager", 0, {"Hello!"}});
+        map.addNPCDefinition(NPCDefinition{"guard", 1, {"Halt!"}});
+        for (const auto& placement : map.getNPCPlacements()) {
+            map.addNPC(placement.pos, placement.facing, placement.definitionId);
+        }
+        ASSERT_EQ(map.getNPCs().size(), map.getNPCPlacements().size());
+
+        Pathfinder pathfinder;
+        std::vector<Vec2> path;
+        for (const auto& transition : map.getTransitions()) {
+            EXPECT_TRUE(pathfinder.findPath(map, map.getSpawnPosition(), transition.triggerPos, path));
+        }
+    }
+}
+
+TEST(MapGeneratorTest, LinkTargetIsConfigurable) {
+    MapGenerator::Config config = makeConfig(MapGenerator::Style::Dungeon, 96, 96, 3);
+    config.linkMap = "data/maps/dungeon_01.csv";
+    config.linkX = 7;
+    config.linkY = 7;
+    Map map;
+    ASSERT_TRUE(MapGenerator::generate(config, map));
+    ASSERT_FALSE(map.getTransitions().empty());
+    for (const auto& transition : map.getTransitions()) {
+        EXPECT_EQ(transition.targetMap, "data/maps/dungeon_01.csv");
+        EXPECT_TRUE(transition.targetPos.equals(Vec2{7, 7}));
+    }
+}
+
+TEST(MapGeneratorTest, DensityScalesWithArea) {
+    Map small;
+    Map large;
+    ASSERT_TRUE(MapGenerator::generate(makeConfig(MapGenerator::Style::Overworld, 256, 256, 5), small));
+    ASSERT_TRUE(MapGenerator::generate(makeConfig(MapGenerator::Style::Overworld, 2048, 2048, 5), large));
+    EXPECT_GT(large.getNPCPlacements().size(), small.getNPCPlacements().size() * 16);
+    EXPECT_GT(large.getTransitions().size(), small.getTransitions().size() * 16);
+}
+
+TEST(MapGeneratorTest, RoundTripsThroughCSVAndBinary) {
+    for (auto style : STYLES) {
+        Map generated;
+        ASSERT_TRUE(MapGenerator::generate(makeConfig(style, 96, 80, 11), generated));
+
+        ASSERT_TRUE(generated.saveToCSV("test_generated_map.csv"));
+        Map fromCSV;
+        ASSERT_TRUE(fromCSV.loadFromCSV("test_generated_map.csv"));
+        EXPECT_TRUE(sameLayout(generated, fromCSV));
+
+        ASSERT_TRUE(generated.saveToBinary("test_generated_map.rmap"));
+        Map fromBinary;
+        ASSERT_TRUE(fromBinary.loadFromBinary("test_generated_map.rmap"));
+        EXPECT_TRUE(sameLayout(generated, fromBinary));
+    }
+    std::remove("test_generated_map.csv");
+    std::remove("test_generated_map.rmap");
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "field/Map.h"
+#include "field/ChunkStreamer.h"
+
+class MapStreamingTest : public ::testing::Test {
+protected:
+    static constexpr int WIDTH = 200;
+    static constexpr int HEIGHT = 150;
+    static constexpr int CHUNK = ChunkStreamer::CHUNK_SIZE;
+
+    void SetUp() override {
+        // Deterministic pattern so every tile can be checked
+        std::vector<TileType> tiles(static_cast<size_t>(WIDTH) * HEIGHT);
+        for (int y = 0; y < HEIGHT; ++y) {
+            for (int x = 0; x < WIDTH; ++x) {
+                tiles[y * WIDTH + x] = expectedTile(x, y);
+            }
+        }
+        ASSERT_TRUE(source.loadFromTiles(WIDTH, HEIGHT, tiles));
+        source.setSpawnPosition(Vec2{5, 5});
+        source.addTransition(MapTransition{Vec2{6, 6}, "data/maps/dungeon_01.csv", Vec2{7, 7}});
+        ASSERT_TRUE(source.saveToBinary("test_stream.rmap"));
+    }
+
+    void TearDown() override {
+        std::remove("test_stream.rmap");
+    }
+
+    static TileType expectedTile(int x, int y) {
+        return (x + y) % 3 == 0 ? TileType::Water : TileType::Grass;
+    }
+
+    // Stream around a tile until nearby chunks are resident (bounded wait)
+    static void streamUntilResident(Map& map, const Vec2& pos) {
+        for (int i = 0; i < 500 && map.getTileType(pos.x, pos.y) == TileType::Wall; ++i) {
+            map.streamAround(pos);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    Map source;
+    Map map;
+};
+
+TEST_F(MapStreamingTest, OpenLoadsSpawnArea) {
+    ASSERT_TRUE(map.openStreaming("test_stream.rmap"));
+    EXPECT_TRUE(map.isStreaming());
+    EXPECT_EQ(map.getWidth(), WIDTH);
+    EXPECT_EQ(map.getHeight(), HEIGHT);
+
+    // Spawn chunk and its neighbours are resident immediately
+    EXPECT_EQ(map.getTileType(5, 5), expectedTile(5, 5));
+    EXPECT_EQ(map.getTileType(CHUNK + 3, 4), expectedTile(CHUNK + 3, 4));
+
+    // Objects are available without streaming tiles
+    EXPECT_NE(map.getTransitionAt(Vec2{6, 6}), nullptr);
+}
+
+TEST_F(MapStreamingTest, NonResidentChunkIsNotWalkable) {
+    ASSERT_TRUE(map.openStreaming("test_stream.rmap"));
+
+    // Far corner is outside the load radius of the spawn
+    int farX = WIDTH - 2;
+    int farY = HEIGHT - 2;
+    ASSERT_EQ(expectedTile(farX, farY), TileType::Grass);
+    EXPECT_FALSE(map.isWalkable(farX, farY));
+    EXPECT_EQ(map.getTile(farX, farY).type, TileType::Wall);
+}
+
+TEST_F(MapStreamingTest, StreamAroundLoadsInBackground) {
+    ASSERT_TRUE(map.openStreaming("test_stream.rmap"));
+
+    Vec2 far{WIDTH - 2, HEIGHT - 2};
+    streamUntilResident(map, far);
+    EXPECT_TRUE(map.isWalkable(far.x, far.y));
+
+    // All tiles in the focus chunk match the source map
+    int originX = (far.x / CHUNK) * CHUNK;
+    int originY = (far.y / CHUNK) * CHUNK;
+    for (int y = originY; y < HEIGHT; ++y) {
+        for (int x = originX; x < WIDTH; ++x) {
+            EXPECT_EQ(map.getTileType(x, y), expectedTile(x, y));
+        }
+    }
+}
+
+TEST_F(MapStreamingTest, LoadAroundBlocksUntilResident) {
+    ASSERT_TRUE(map.openStreaming("test_stream.rmap"));
+    map.loadAround(Vec2{WIDTH - 1, HEIGHT - 1});
+    EXPECT_EQ(map.getTileType(WIDTH - 1, HEIGHT - 1), expectedTile(WIDTH - 1, HEIGHT - 1));
+}
+
+TEST_F(MapStreamingTest, EvictsUnderMemoryBudget) {
+    // Budget of one 5x5 neighbourhood of chunks
+    size_t budget = 25 * ChunkStreamer::CHUNK_BYTES;
+    ASSERT_TRUE(map.openStreaming("test_stream.rmap", budget));
+
+    // Walk the focus across the whole map
+    for (int y = 0; y < HEIGHT; y += CHUNK) {
+        for (int x = 0; x < WIDTH; x += CHUNK) {
+            map.loadAround(Vec2{x, y});
+            EXPECT_LE(map.getTileMemoryBytes(), budget);
+        }
+    }
+
+    // The origin chunk was evicted once the focus moved away
+    EXPECT_FALSE(map.isWalkable(1, 1));
+}
+
+TEST_F(MapStreamingTest, LoadStreamsLargeMapsOnly) {
+    // The test map is below STREAMING_MIN_TILES, so load() maps it whole
+    ASSERT_TRUE(map.load("test_stream.rmap"));
+    EXPECT_FALSE(map.isStreaming());
+    EXPECT_TRUE(map.isMemoryMapped());
+}
+
+TEST_F(MapStreamingTest, RejectsInvalidFiles) {
+    EXPECT_FALSE(map.openStreaming("../test_stream.rmap"));
+    EXPECT_FALSE(map.openStreaming("nonexistent.rmap"));
+    EXPECT_FALSE(map.isStreaming());
+}
+
+TEST_F(MapStreamingTest, FullyLoadedMapIgnoresStreamingCalls) {
+    map.streamAround(Vec2{1, 1});
+    map.loadAround(Vec2{1, 1});
+    EXPECT_FALSE(map.isStreaming());
+}
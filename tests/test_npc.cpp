@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <fstream>
+#include <optional>
 #include "entity/NPC.h"
 #include "entity/NPCData.h"
 #include "field/Map.h"
@@ -107,7 +108,7 @@ TEST_F(MapNPCTest, AddNPC) {
     map_.addNPC(Vec2{2, 2}, Direction::Down, "villager");
 
     EXPECT_EQ(map_.getNPCs().size(), 1u);
-    EXPECT_EQ(map_.getNPCs()[0].getPosition(), Vec2(2, 2));
+    EXPECT_EQ(map_.getNPCs().getPosition(0), Vec2(2, 2));
 }
 
 TEST_F(MapNPCTest, HasNPCAt) {
@@ -120,11 +121,11 @@ TEST_F(MapNPCTest, HasNPCAt) {
 TEST_F(MapNPCTest, GetNPCAt) {
     map_.addNPC(Vec2{2, 2}, Direction::Down, "villager");
 
-    const NPC* npc = map_.getNPCAt(Vec2{2, 2});
-    ASSERT_NE(npc, nullptr);
+    std::optional<NPC> npc = map_.getNPCAt(Vec2{2, 2});
+    ASSERT_TRUE(npc.has_value());
     EXPECT_EQ(npc->getPosition(), Vec2(2, 2));
 
-    EXPECT_EQ(map_.getNPCAt(Vec2{3, 3}), nullptr);
+    EXPECT_FALSE(map_.getNPCAt(Vec2{3, 3}).has_value());
 }
 
 TEST_F(MapNPCTest, NPCBlocksMovement) {
@@ -143,8 +144,8 @@ TEST_F(MapNPCTest, UpdateNPCFacing) {
     // NPC faces player to the left
     map_.updateNPCFacing(Vec2{2, 2}, Vec2{1, 2});
 
-    const NPC* npc = map_.getNPCAt(Vec2{2, 2});
-    ASSERT_NE(npc, nullptr);
+    std::optional<NPC> npc = map_.getNPCAt(Vec2{2, 2});
+    ASSERT_TRUE(npc.has_value());
     EXPECT_EQ(npc->getFacing(), Direction::Left);
 }
 
@@ -159,8 +160,89 @@ TEST_F(MapNPCTest, AddInvalidNPCDefinition) {
 TEST_F(MapNPCTest, NPCHasCorrectDialogue) {
     map_.addNPC(Vec2{2, 2}, Direction::Down, "villager");
 
-    const NPC* npc = map_.getNPCAt(Vec2{2, 2});
-    ASSERT_NE(npc, nullptr);
+    std::optional<NPC> npc = map_.getNPCAt(Vec2{2, 2});
+    ASSERT_TRUE(npc.has_value());
     ASSERT_EQ(npc->getDialogue().size(), 1u);
     EXPECT_EQ(npc->getDialogue()[0], "Hello!");
 }
+
+TEST_F(MapNPCTest, RejectsNPCOnOccupiedTile) {
+    map_.addNPC(Vec2{2, 2}, Direction::Down, "villager");
+    map_.addNPC(Vec2{2, 2}, Direction::Up, "villager");
+
+    EXPECT_EQ(map_.getNPCs().size(), 1u);
+    EXPECT_EQ(map_.getNPCAt(Vec2{2, 2})->getFacing(), Direction::Down);
+}
+
+TEST_F(MapNPCTest, RejectsNPCOutsideMap) {
+    map_.addNPC(Vec2{5, 0}, Direction::Down, "villager");
+    map_.addNPC(Vec2{-1, 2}, Direction::Down, "villager");
+
+    EXPECT_TRUE(map_.getNPCs().empty());
+    EXPECT_FALSE(map_.hasNPCAt(Vec2{-1, 2}));
+}
+
+TEST_F(MapNPCTest, RemoveNPC) {
+    map_.addNPC(Vec2{1, 1}, Direction::Down, "villager");
+    map_.addNPC(Vec2{2, 2}, Direction::Down, "villager");
+    map_.addNPC(Vec2{3, 3}, Direction::Down, "villager");
+
+    EXPECT_TRUE(map_.removeNPCAt(Vec2{1, 1}));
+    EXPECT_FALSE(map_.removeNPCAt(Vec2{1, 1}));
+    EXPECT_EQ(map_.getNPCs().size(), 2u);
+    EXPECT_TRUE(map_.isWalkable(1, 1));
+
+    // Remaining NPCs are still found at their tiles
+    ASSERT_TRUE(map_.getNPCAt(Vec2{2, 2}).has_value());
+    EXPECT_EQ(map_.getNPCAt(Vec2{2, 2})->getPosition(), Vec2(2, 2));
+    ASSERT_TRUE(map_.getNPCAt(Vec2{3, 3}).has_value());
+    EXPECT_EQ(map_.getNPCAt(Vec2{3, 3})->getPosition(), Vec2(3, 3));
+}
+
+TEST_F(MapNPCTest, MoveNPC) {
+    map_.addNPC(Vec2{2, 2}, Direction::Left, "villager");
+
+    EXPECT_TRUE(map_.moveNPC(Vec2{2, 2}, Vec2{2, 3}));
+    EXPECT_FALSE(map_.hasNPCAt(Vec2{2, 2}));
+    EXPECT_TRUE(map_.isWalkable(2, 2));
+    EXPECT_FALSE(map_.isWalkable(2, 3));
+
+    std::optional<NPC> npc = map_.getNPCAt(Vec2{2, 3});
+    ASSERT_TRUE(npc.has_value());
+    EXPECT_EQ(npc->getPosition(), Vec2(2, 3));
+    EXPECT_EQ(npc->getFacing(), Direction::Left);
+}
+
+TEST_F(MapNPCTest, MoveNPCBlocked) {
+    map_.addNPC(Vec2{2, 2}, Direction::Down, "villager");
+    map_.addNPC(Vec2{3, 2}, Direction::Down, "villager");
+
+    EXPECT_FALSE(map_.moveNPC(Vec2{2, 2}, Vec2{3, 2}));  // Occupied
+    EXPECT_FALSE(map_.moveNPC(Vec2{2, 2}, Vec2{2, 9}));  // Off the map
+    EXPECT_FALSE(map_.moveNPC(Vec2{0, 0}, Vec2{1, 0}));  // No NPC to move
+    EXPECT_TRUE(map_.hasNPCAt(Vec2{2, 2}));
+}
+
+TEST_F(MapNPCTest, ReloadClearsNPCs) {
+    map_.addNPC(Vec2{1, 1}, Direction::Down, "villager");
+
+    // Spawned NPCs belong to the old layout; definitions are kept
+    std::vector<TileType> tiles(3 * 3, TileType::Grass);
+    ASSERT_TRUE(map_.loadFromTiles(3, 3, tiles));
+
+    EXPECT_TRUE(map_.getNPCs().empty());
+    EXPECT_TRUE(map_.isWalkable(1, 1));
+    map_.addNPC(Vec2{1, 1}, Direction::Down, "villager");
+    EXPECT_TRUE(map_.hasNPCAt(Vec2{1, 1}));
+}
+
+TEST_F(MapNPCTest, ReAddingDefinitionReplacesIt) {
+    map_.addNPCDefinition(NPCDefinition{"villager", 2, {"Hi again!"}});
+    map_.addNPC(Vec2{2, 2}, Direction::Down, "villager");
+
+    std::optional<NPC> npc = map_.getNPCAt(Vec2{2, 2});
+    ASSERT_TRUE(npc.has_value());
+    EXPECT_EQ(npc->getDefinitionIndex(), 0);
+    EXPECT_EQ(npc->getSpriteRow(), 2);
+    EXPECT_EQ(npc->getDialogue()[0], "Hi again!");
+}
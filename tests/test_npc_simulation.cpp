@@ -0,0 +1,263 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <vector>
+#include "entity/NPC.h"
+#include "entity/NPCSimulation.h"
+#include "field/Map.h"
+
+namespace {
+
+// Open grass field with NPC types for each behavior
+void makeField(Map& map, int width, int height) {
+    std::vector<TileType> tiles(static_cast<size_t>(width) * height, TileType::Grass);
+    ASSERT_TRUE(map.loadFromTiles(width, height, std::move(tiles)));
+    map.addNPCDefinition(NPCDefinition{"guard", 1, {"Halt!"}});
+    map.addNPCDefinition(NPCDefinition{"villager", 0, {"Hello!"}, NPCBehavior::Wander});
+    map.addNPCDefinition(NPCDefinition{"dog", 2, {"Woof!"}, NPCBehavior::Follow});
+}
+
+// Run frames until walking NPCs have arrived
+void runFrames(Map& map, const Vec2& playerPos, int frames, int budget = Constants::NPC_THINK_BUDGET) {
+    for (int i = 0; i < frames; ++i) {
+        map.updateNPCs(playerPos, budget);
+    }
+}
+
+}  // namespace
+
+TEST(NPCSimulationTest, RemoveMovesLastIntoSlot) {
+    NPCSimulation npcs;
+    npcs.add(Vec2{1, 1}, Direction::Down, 0, NPCBehavior::Stand);
+    npcs.add(Vec2{2, 2}, Direction::Left, 1, NPCBehavior::Wander);
+    npcs.add(Vec2{3, 3}, Direction::Up, 2, NPCBehavior::Follow);
+
+    npcs.remove(0);
+    ASSERT_EQ(npcs.size(), 2u);
+    EXPECT_EQ(npcs.getPosition(0), Vec2(3, 3));
+    EXPECT_EQ(npcs.getFacing(0), Direction::Up);
+    EXPECT_EQ(npcs.getDefinitionIndex(0), 2);
+    EXPECT_EQ(npcs.getBehavior(0), NPCBehavior::Follow);
+    EXPECT_EQ(npcs.getPosition(1), Vec2(2, 2));
+}
+
+TEST(NPCSimulationTest, WalkAnimatesOverStepFrames) {
+    NPCSimulation npcs;
+    npcs.add(Vec2{4, 4}, Direction::Down, 0, NPCBehavior::Stand);
+    npcs.walk(0, Direction::Right);
+    EXPECT_EQ(npcs.getPosition(0), Vec2(5, 4));
+    EXPECT_EQ(npcs.getFacing(0), Direction::Right);
+    EXPECT_EQ(npcs.getStepPixels(0), Constants::TILE_SIZE);
+
+    for (int i = 0; i < Constants::NPC_STEP_FRAMES; ++i) {
+        npcs.advanceSteps();
+    }
+    EXPECT_EQ(npcs.getStepPixels(0), 0);
+    npcs.advanceSteps();
+    EXPECT_EQ(npcs.getStepPixels(0), 0);
+}
+
+TEST(NPCSimulationTest, AnyWalkingUntilLastStepEnds) {
+    NPCSimulation npcs;
+    npcs.add(Vec2{4, 4}, Direction::Down, 0, NPCBehavior::Stand);
+    npcs.add(Vec2{8, 8}, Direction::Down, 0, NPCBehavior::Stand);
+    EXPECT_FALSE(npcs.isAnyWalking());
+
+    npcs.walk(1, Direction::Up);
+    for (int i = 0; i < Constants::NPC_STEP_FRAMES; ++i) {
+        EXPECT_TRUE(npcs.isAnyWalking());
+        npcs.advanceSteps();
+    }
+    EXPECT_FALSE(npcs.isAnyWalking());
+}
+
+TEST(NPCSimulationTest, RevisionChangesOnlyWhenSomethingShows) {
+    NPCSimulation npcs;
+    npcs.add(Vec2{4, 4}, Direction::Down, 0, NPCBehavior::Stand);
+    uint64_t revision = npcs.getRevision();
+
+    npcs.setFacing(0, Direction::Down);  // Already facing down
+    npcs.advanceSteps();                 // Standing
+    EXPECT_EQ(npcs.getRevision(), revision);
+
+    npcs.walk(0, Direction::Left);
+    EXPECT_NE(npcs.getRevision(), revision);
+    for (int i = 0; i < Constants::NPC_STEP_FRAMES; ++i) {
+        revision = npcs.getRevision();
+        npcs.advanceSteps();
+        EXPECT_NE(npcs.getRevision(), revision);  // Every walking frame moves the sprite
+    }
+    revision = npcs.getRevision();
+    npcs.advanceSteps();
+    EXPECT_EQ(npcs.getRevision(), revision);
+}
+
+TEST(NPCSimulationTest, ThinkBudgetIsSpreadAcrossFrames) {
+    NPCSimulation npcs;
+    for (int i = 0; i < 8; ++i) {
+        npcs.add(Vec2{i + 1, 0}, Direction::Down, 0, NPCBehavior::Follow);
+    }
+    // Every follower is in range, so each think wants a step
+    std::vector<NPCSimulation::Step> steps;
+    npcs.think(4, Vec2{5, 2}, steps);
+    ASSERT_EQ(steps.size(), 4u);
+    EXPECT_EQ(steps[0].index, 0);
+    EXPECT_EQ(steps[3].index, 3);
+
+    steps.clear();
+    npcs.think(4, Vec2{5, 2}, steps);
+    EXPECT_EQ(steps.front().index, 4);  // Resumes where the last call stopped
+
+    steps.clear();
+    npcs.think(100, Vec2{5, 2}, steps);  // Never more than one think per NPC
+    EXPECT_EQ(steps.size(), 8u);
+}
+
+TEST(NPCSimulationTest, DialogueIsSharedWithDefinition) {
+    Map map;
+    makeField(map, 8, 8);
+    map.addNPC(Vec2{1, 1}, Direction::Down, "guard");
+    map.addNPC(Vec2{2, 2}, Direction::Down, "guard");
+    std::optional<NPC> first = map.getNPCAt(Vec2{1, 1});
+    std::optional<NPC> second = map.getNPCAt(Vec2{2, 2});
+    ASSERT_TRUE(first && second);
+    EXPECT_EQ(&first->getDialogue(), &second->getDialogue());
+    EXPECT_EQ(&first->getDialogue(), map.getNPCDefinitions()[0].dialogue.get());
+}
+
+TEST(NPCSimulationTest, WanderersStayNearHome) {
+    Map map;
+    makeField(map, 40, 40);
+    map.addNPC(Vec2{20, 20}, Direction::Down, "villager");
+    map.addNPC(Vec2{10, 10}, Direction::Down, "guard");
+
+    bool moved = false;
+    for (int frame = 0; frame < 2000; ++frame) {
+        map.updateNPCs(Vec2{0, 0});
+        Vec2 pos = map.getNPCs().getPosition(0);
+        moved = moved || !pos.equals(Vec2{20, 20});
+        ASSERT_LE(std::abs(pos.x - 20), Constants::NPC_WANDER_RADIUS);
+        ASSERT_LE(std::abs(pos.y - 20), Constants::NPC_WANDER_RADIUS);
+        ASSERT_TRUE(map.hasNPCAt(pos));
+    }
+    EXPECT_TRUE(moved);
+    EXPECT_EQ(map.getNPCs().getPosition(1), Vec2(10, 10));  // Guards stand
+}
+
+TEST(NPCSimulationTest, PatrolWalksRouteAndLoops) {
+    Map map;
+    makeField(map, 20, 20);
+    map.addNPC(Vec2{2, 2}, Direction::Down, "guard");
+    ASSERT_TRUE(map.setNPCPatrolRoute(Vec2{2, 2}, {Vec2{6, 2}, Vec2{6, 5}, Vec2{2, 2}}));
+    EXPECT_FALSE(map.setNPCPatrolRoute(Vec2{9, 9}, {Vec2{1, 1}}));
+
+    std::vector<bool> reached(3, false);
+    for (int frame = 0; frame < 40 * Constants::NPC_STEP_FRAMES; ++frame) {
+        map.updateNPCs(Vec2{15, 15});
+        Vec2 pos = map.getNPCs().getPosition(0);
+        reached[0] = reached[0] || pos.equals(Vec2{6, 2});
+        reached[1] = reached[1] || (reached[0] && pos.equals(Vec2{6, 5}));
+        reached[2] = reached[2] || (reached[1] && pos.equals(Vec2{2, 2}));
+    }
+    EXPECT_TRUE(reached[0] && reached[1] && reached[2]);
+}
+
+TEST(NPCSimulationTest, FollowersApproachButNeverEnterPlayerTile) {
+    Map map;
+    makeField(map, 20, 20);
+    map.addNPC(Vec2{5, 5}, Direction::Down, "dog");
+    Vec2 player{9, 7};
+    runFrames(map, player, 20 * Constants::NPC_STEP_FRAMES);
+
+    Vec2 pos = map.getNPCs().getPosition(0);
+    EXPECT_EQ(std::abs(pos.x - player.x) + std::abs(pos.y - player.y), 1);
+    EXPECT_FALSE(map.hasNPCAt(player));
+
+    // Out of range: stays put
+    map.addNPC(Vec2{0, 19}, Direction::Down, "dog");
+    runFrames(map, player, 10 * Constants::NPC_STEP_FRAMES);
+    EXPECT_TRUE(map.hasNPCAt(Vec2{0, 19}));
+}
+
+TEST(NPCSimulationTest, BlockedStepsOnlyTurn) {
+    Map map;
+    makeField(map, 10, 10);
+    ASSERT_TRUE(map.setTile(6, 5, TileType::Water));
+    map.addNPC(Vec2{5, 5}, Direction::Down, "dog");
+    runFrames(map, Vec2{8, 5}, 4 * Constants::NPC_STEP_FRAMES);
+
+    EXPECT_TRUE(map.hasNPCAt(Vec2{5, 5}));
+    EXPECT_EQ(map.getNPCAt(Vec2{5, 5})->getFacing(), Direction::Right);
+}
+
+TEST(NPCSimulationTest, StepsIntoTileThePlayerIsEnteringOnlyTurn) {
+    Map map;
+    makeField(map, 10, 10);
+    map.addNPC(Vec2{5, 5}, Direction::Down, "dog");
+
+    // Player walking from (8, 5) into (6, 5): the dog's step right is refused
+    for (int frame = 0; frame < 4 * Constants::NPC_STEP_FRAMES; ++frame) {
+        map.updateNPCs(Vec2{7, 5}, Vec2{6, 5});
+    }
+    EXPECT_TRUE(map.hasNPCAt(Vec2{5, 5}));
+    EXPECT_FALSE(map.hasNPCAt(Vec2{6, 5}));
+    EXPECT_EQ(map.getNPCAt(Vec2{5, 5})->getFacing(), Direction::Right);
+}
+
+TEST(NPCSimulationTest, ReplacedPatrolRoutesFreeTheirWaypoints) {
+    NPCSimulation npcs;
+    npcs.add(Vec2{1, 1}, Direction::Down, 0, NPCBehavior::Patrol);
+    npcs.add(Vec2{5, 5}, Direction::Down, 0, NPCBehavior::Patrol);
+    npcs.setPatrolRoute(0, {Vec2{1, 4}, Vec2{4, 4}, Vec2{1, 1}});
+    npcs.setPatrolRoute(1, {Vec2{5, 8}, Vec2{5, 5}});
+    EXPECT_EQ(npcs.getWaypointCount(), 5u);
+
+    for (int i = 0; i < 100; ++i) {
+        npcs.setPatrolRoute(0, {Vec2{1, 2}, Vec2{1, 1}});
+    }
+    EXPECT_EQ(npcs.getWaypointCount(), 4u);
+
+    npcs.setPatrolRoute(0, {});
+    EXPECT_EQ(npcs.getWaypointCount(), 2u);
+
+    // The other route still points at its own waypoints
+    std::vector<NPCSimulation::Step> steps;
+    npcs.think(2, Vec2{0, 0}, steps);
+    ASSERT_EQ(steps.size(), 1u);
+    EXPECT_EQ(steps[0].index, 1);
+    EXPECT_EQ(steps[0].dir, Direction::Down);
+
+    npcs.remove(1);
+    EXPECT_EQ(npcs.getWaypointCount(), 0u);
+}
+
+TEST(NPCSimulationTest, InterpolationCoversTheFinalStep) {
+    NPCSimulation npcs;
+    npcs.add(Vec2{4, 4}, Direction::Down, 0, NPCBehavior::Stand);
+    npcs.walk(0, Direction::Right);
+
+    // Just started: still on the old tile whatever alpha
+    EXPECT_EQ(NPCRenderer::drawnStepPixels(npcs, 0, 0.0), Constants::TILE_SIZE);
+    EXPECT_EQ(NPCRenderer::drawnStepPixels(npcs, 0, 1.0), Constants::TILE_SIZE);
+
+    // One frame in: between the old tile and one frame's walk
+    npcs.advanceSteps();
+    EXPECT_EQ(NPCRenderer::drawnStepPixels(npcs, 0, 0.0), Constants::TILE_SIZE);
+    EXPECT_EQ(NPCRenderer::drawnStepPixels(npcs, 0, 0.5), Constants::TILE_SIZE - Constants::NPC_SPEED / 2);
+    EXPECT_EQ(NPCRenderer::drawnStepPixels(npcs, 0, 1.0), Constants::TILE_SIZE - Constants::NPC_SPEED);
+
+    // Final step: slides the last NPC_SPEED pixels instead of snapping
+    for (int i = 1; i < Constants::NPC_STEP_FRAMES; ++i) {
+        npcs.advanceSteps();
+    }
+    ASSERT_EQ(npcs.getStepPixels(0), 0);
+    EXPECT_TRUE(npcs.isAnyMoving());
+    EXPECT_EQ(NPCRenderer::drawnStepPixels(npcs, 0, 0.0), Constants::NPC_SPEED);
+    EXPECT_EQ(NPCRenderer::drawnStepPixels(npcs, 0, 0.5), Constants::NPC_SPEED / 2);
+    EXPECT_EQ(NPCRenderer::drawnStepPixels(npcs, 0, 1.0), 0);
+
+    // Standing afterwards
+    npcs.advanceSteps();
+    EXPECT_FALSE(npcs.isAnyMoving());
+    EXPECT_EQ(NPCRenderer::drawnStepPixels(npcs, 0, 0.0), 0);
+    EXPECT_EQ(NPCRenderer::drawnStepPixels(npcs, 0, 1.0), 0);
+}
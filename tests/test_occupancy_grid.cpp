@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include "field/OccupancyGrid.h"
+
+TEST(OccupancyGridTest, EmptyByDefault) {
+    OccupancyGrid grid;
+    grid.reset(100, 50);
+
+    EXPECT_EQ(grid.get(0, 0), OccupancyGrid::EMPTY);
+    EXPECT_EQ(grid.get(99, 49), OccupancyGrid::EMPTY);
+}
+
+TEST(OccupancyGridTest, SetGetClear) {
+    OccupancyGrid grid;
+    grid.reset(100, 50);
+
+    grid.set(40, 33, 7);
+    EXPECT_EQ(grid.get(40, 33), 7);
+    EXPECT_EQ(grid.get(41, 33), OccupancyGrid::EMPTY);
+
+    grid.clear(40, 33);
+    EXPECT_EQ(grid.get(40, 33), OccupancyGrid::EMPTY);
+}
+
+TEST(OccupancyGridTest, OutOfBoundsIgnored) {
+    OccupancyGrid grid;
+    grid.reset(10, 10);
+
+    grid.set(-1, 0, 1);
+    grid.set(10, 0, 1);
+    grid.clear(0, 10);
+    EXPECT_EQ(grid.get(-1, 0), OccupancyGrid::EMPTY);
+    EXPECT_EQ(grid.get(10, 0), OccupancyGrid::EMPTY);
+    EXPECT_FALSE(grid.isInBounds(0, 10));
+}
+
+TEST(OccupancyGridTest, ResetClearsCells) {
+    OccupancyGrid grid;
+    grid.reset(10, 10);
+    grid.set(3, 3, 1);
+
+    grid.reset(10, 10);
+    EXPECT_EQ(grid.get(3, 3), OccupancyGrid::EMPTY);
+}
+
+TEST(OccupancyGridTest, BlocksAllocatedOnDemand) {
+    OccupancyGrid grid;
+    grid.reset(4096, 4096);
+    size_t tableBytes = grid.getMemoryBytes();
+
+    // A dense int32 grid would be 64MB; one occupied block adds 4KB
+    grid.set(2000, 3000, 1);
+    EXPECT_EQ(grid.getMemoryBytes(),
+              tableBytes + OccupancyGrid::BLOCK_SIZE * OccupancyGrid::BLOCK_SIZE * sizeof(int32_t));
+    EXPECT_LT(grid.getMemoryBytes(), 1024u * 1024u);
+}
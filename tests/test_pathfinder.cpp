@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+#include "field/Map.h"
+#include "field/Pathfinder.h"
+
+namespace {
+
+// Build a map from rows of '.' (floor) and '#' (wall)
+Map makeMap(const std::vector<std::string>& rows) {
+    int width = static_cast<int>(rows[0].size());
+    int height = static_cast<int>(rows.size());
+    std::vector<TileType> tiles;
+    for (const auto& row : rows) {
+        for (char c : row) {
+            tiles.push_back(c == '#' ? TileType::Wall : TileType::Floor);
+        }
+    }
+    Map map;
+    EXPECT_TRUE(map.loadFromTiles(width, height, tiles));
+    return map;
+}
+
+// Reference shortest path length by breadth-first search (-1 if unreachable)
+int bfsDistance(const Map& map, const Vec2& start, const Vec2& goal) {
+    int width = map.getWidth();
+    std::vector<int> dist(static_cast<size_t>(width) * map.getHeight(), -1);
+    std::deque<int> queue;
+    dist[start.y * width + start.x] = 0;
+    queue.push_back(start.y * width + start.x);
+    while (!queue.empty()) {
+        int index = queue.front();
+        queue.pop_front();
+        int x = index % width;
+        int y = index / width;
+        if (x == goal.x && y == goal.y) return dist[index];
+        const int offsets[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+        for (const auto& offset : offsets) {
+            int nx = x + offset[0];
+            int ny = y + offset[1];
+            if (map.isWalkable(nx, ny) && dist[ny * width + nx] < 0) {
+                dist[ny * width + nx] = dist[index] + 1;
+                queue.push_back(ny * width + nx);
+            }
+        }
+    }
+    return -1;
+}
+
+// Every step is one tile, walkable, and the path ends at the goal
+void expectValidPath(const Map& map, const Vec2& start, const Vec2& goal,
+                     const std::vector<Vec2>& path) {
+    int x = start.x;
+    int y = start.y;
+    for (const auto& step : path) {
+        EXPECT_EQ(std::abs(step.x - x) + std::abs(step.y - y), 1);
+        EXPECT_TRUE(map.isWalkable(step.x, step.y));
+        x = step.x;
+        y = step.y;
+    }
+    EXPECT_EQ(x, goal.x);
+    EXPECT_EQ(y, goal.y);
+}
+
+}  // namespace
+
+TEST(PathfinderTest, StraightLine) {
+    Map map = makeMap({"......"});
+    Pathfinder pathfinder;
+    std::vector<Vec2> path;
+
+    ASSERT_TRUE(pathfinder.findPath(map, Vec2{0, 0}, Vec2{5, 0}, path));
+    ASSERT_EQ(path.size(), 5u);
+    EXPECT_EQ(path.front(), Vec2(1, 0));
+    EXPECT_EQ(path.back(), Vec2(5, 0));
+}
+
+TEST(PathfinderTest, StartEqualsGoal) {
+    Map map = makeMap({"..."});
+    Pathfinder pathfinder;
+    std::vector<Vec2> path{Vec2{9, 9}};
+
+    EXPECT_TRUE(pathfinder.findPath(map, Vec2{1, 0}, Vec2{1, 0}, path));
+    EXPECT_TRUE(path.empty());
+}
+
+TEST(PathfinderTest, AroundWall) {
+    Map map = makeMap({
+        ".....",
+        ".###.",
+        "..#..",
+        ".....",
+    });
+    Pathfinder pathfinder;
+    std::vector<Vec2> path;
+
+    Vec2 start{1, 2};
+    Vec2 goal{3, 2};
+    ASSERT_TRUE(pathfinder.findPath(map, start, goal, path));
+    expectValidPath(map, start, goal, path);
+    EXPECT_EQ(static_cast<int>(path.size()), bfsDistance(map, start, goal));
+}
+
+TEST(PathfinderTest, UnreachableRegionRejected) {
+    Map map = makeMap({
+        "..#..",
+        "..#..",
+        "..#..",
+    });
+    Pathfinder pathfinder;
+    std::vector<Vec2> path;
+
+    EXPECT_FALSE(pathfinder.isReachable(map, Vec2{0, 0}, Vec2{4, 0}));
+    EXPECT_FALSE(pathfinder.findPath(map, Vec2{0, 0}, Vec2{4, 0}, path));
+    EXPECT_EQ(pathfinder.getExpandedNodes(), 0);  // Rejected before searching
+    EXPECT_NE(pathfinder.getRegion(map, Vec2{0, 0}), pathfinder.getRegion(map, Vec2{4, 2}));
+    EXPECT_EQ(pathfinder.getRegion(map, Vec2{2, 1}), 0u);
+}
+
+TEST(PathfinderTest, InvalidEndpoints) {
+    Map map = makeMap({"..#"});
+    Pathfinder pathfinder;
+    std::vector<Vec2> path;
+
+    EXPECT_FALSE(pathfinder.findPath(map, Vec2{0, 0}, Vec2{2, 0}, path));   // Wall
+    EXPECT_FALSE(pathfinder.findPath(map, Vec2{0, 0}, Vec2{5, 0}, path));   // Off the map
+    EXPECT_FALSE(pathfinder.findPath(map, Vec2{-1, 0}, Vec2{1, 0}, path));
+}
+
+TEST(PathfinderTest, NPCsBlockButNotOnStart) {
+    Map map = makeMap({
+        "...",
+        "...",
+    });
+    map.addNPCDefinition(NPCDefinition{"villager", 0, {"Hi"}});
+    map.addNPC(Vec2{0, 0}, Direction::Down, "villager");
+    map.addNPC(Vec2{1, 0}, Direction::Down, "villager");
+    Pathfinder pathfinder;
+    std::vector<Vec2> path;
+
+    // The NPC at (0, 0) plans around the one at (1, 0)
+    ASSERT_TRUE(pathfinder.findPath(map, Vec2{0, 0}, Vec2{2, 0}, path));
+    EXPECT_EQ(path.size(), 4u);
+    expectValidPath(map, Vec2{0, 0}, Vec2{2, 0}, path);
+
+    // A goal occupied by an NPC cannot be reached
+    EXPECT_FALSE(pathfinder.findPath(map, Vec2{2, 1}, Vec2{1, 0}, path));
+}
+
+TEST(PathfinderTest, RegionsFollowTileChanges) {
+    Map map = makeMap({"..#.."});
+    Pathfinder pathfinder;
+    EXPECT_FALSE(pathfinder.isReachable(map, Vec2{0, 0}, Vec2{4, 0}));
+
+    ASSERT_TRUE(map.setTile(2, 0, TileType::Floor));
+    EXPECT_TRUE(pathfinder.isReachable(map, Vec2{0, 0}, Vec2{4, 0}));
+
+    std::vector<Vec2> path;
+    EXPECT_TRUE(pathfinder.findPath(map, Vec2{0, 0}, Vec2{4, 0}, path));
+    EXPECT_EQ(path.size(), 4u);
+}
+
+TEST(PathfinderTest, ReusedAcrossMaps) {
+    Map small = makeMap({"...", "...", "..."});
+    Map wide = makeMap({"..........", "..........", ".........."});
+    Pathfinder pathfinder;
+    std::vector<Vec2> path;
+
+    ASSERT_TRUE(pathfinder.findPath(wide, Vec2{0, 0}, Vec2{9, 2}, path));
+    EXPECT_EQ(path.size(), 11u);
+    ASSERT_TRUE(pathfinder.findPath(small, Vec2{0, 0}, Vec2{2, 2}, path));
+    EXPECT_EQ(path.size(), 4u);
+}
+
+// Paths are optimal on random obstacle maps (checked against BFS)
+TEST(PathfinderTest, MatchesBreadthFirstSearch) {
+    std::mt19937 rng(1234);
+    Pathfinder pathfinder;
+    std::vector<Vec2> path;
+
+    for (int round = 0; round < 40; ++round) {
+        int width = 12 + round % 7;
+        int height = 10 + round % 5;
+        std::vector<TileType> tiles(static_cast<size_t>(width) * height);
+        for (auto& tile : tiles) {
+            tile = (rng() % 100 < 30) ? TileType::Wall : TileType::Floor;
+        }
+        Map map;
+        ASSERT_TRUE(map.loadFromTiles(width, height, tiles));
+
+        for (int query = 0; query < 20; ++query) {
+            Vec2 start{static_cast<int>(rng() % width), static_cast<int>(rng() % height)};
+            Vec2 goal{static_cast<int>(rng() % width), static_cast<int>(rng() % height)};
+            if (!map.isWalkable(start.x, start.y) || !map.isWalkable(goal.x, goal.y)) continue;
+
+            int expected = bfsDistance(map, start, goal);
+            bool found = pathfinder.findPath(map, start, goal, path);
+            ASSERT_EQ(found, expected >= 0);
+            if (found) {
+                ASSERT_EQ(static_cast<int>(path.size()), expected);
+                expectValidPath(map, start, goal, path);
+            }
+        }
+    }
+}
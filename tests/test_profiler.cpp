@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include "system/Profiler.h"
+#include "system/SampleRing.h"
+
+namespace {
+
+ProfileSample makeSample(uint32_t update, uint32_t frame) {
+    ProfileSample sample;
+    sample.sections[static_cast<size_t>(ProfileSection::Update)] = update;
+    sample.frame = frame;
+    return sample;
+}
+
+}  // namespace
+
+TEST(SampleRingTest, PopsInOrderAndRefusesWhenFull) {
+    SampleRing<int, 4> ring;
+    int value = 0;
+    EXPECT_FALSE(ring.pop(value));
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring.push(i));
+    }
+    EXPECT_FALSE(ring.push(4));
+    EXPECT_EQ(ring.size(), 4u);
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_TRUE(ring.push(5));  // Indices wrap around
+    ASSERT_TRUE(ring.pop(value));
+    EXPECT_EQ(value, 5);
+}
+
+TEST(ProfilerTest, StatsCoverCollectedFrames) {
+    Profiler profiler;
+    for (uint32_t i = 1; i <= 100; ++i) {
+        profiler.pushSample(makeSample(i, i * 10));
+    }
+    EXPECT_EQ(profiler.getHistorySize(), 0u);  // Nothing collected yet
+
+    profiler.collect();
+    EXPECT_EQ(profiler.getHistorySize(), 100u);
+    Profiler::Stats update = profiler.getStats(ProfileSection::Update);
+    EXPECT_EQ(update.min, 1u);
+    EXPECT_EQ(update.average, 50u);
+    EXPECT_EQ(update.p99, 99u);
+    EXPECT_EQ(profiler.getFrameStats().p99, 990u);
+    EXPECT_EQ(profiler.getStats(ProfileSection::Render).average, 0u);
+}
+
+TEST(ProfilerTest, HistoryKeepsLatestFramesOldestFirst) {
+    Profiler profiler;
+    int frames = Constants::PROFILER_HISTORY_FRAMES + 30;
+    for (int i = 0; i < frames; ++i) {
+        profiler.pushSample(makeSample(0, static_cast<uint32_t>(i)));
+        profiler.collect();
+    }
+    std::vector<uint32_t> history = profiler.getFrameHistory();
+    ASSERT_EQ(history.size(), static_cast<size_t>(Constants::PROFILER_HISTORY_FRAMES));
+    EXPECT_EQ(history.front(), 30u);
+    EXPECT_EQ(history.back(), static_cast<uint32_t>(frames - 1));
+}
+
+TEST(ProfilerTest, FullRingDropsFrames) {
+    Profiler profiler;
+    for (int i = 0; i < Constants::PROFILER_RING_CAPACITY + 3; ++i) {
+        profiler.pushSample(makeSample(0, 1));
+    }
+    EXPECT_EQ(profiler.getDroppedFrames(), 3u);
+}
+
+TEST(ProfilerTest, ScopesAddToCurrentFrame) {
+    Profiler profiler;
+    profiler.beginFrame();
+    {
+        ProfileScope scope(profiler, ProfileSection::Update);
+    }
+    profiler.add(ProfileSection::Update, 500);
+    profiler.add(ProfileSection::Update, 500);
+    profiler.beginFrame();  // Finishes the first frame
+    profiler.collect();
+
+    ASSERT_EQ(profiler.getHistorySize(), 1u);
+    EXPECT_GE(profiler.getStats(ProfileSection::Update).min, 1000u);
+}
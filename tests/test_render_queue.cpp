@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "system/RenderQueue.h"
+
+namespace {
+
+// Queue textures are only sort keys, never dereferenced
+SDL_Texture* fakeTexture(int id) {
+    static char storage[8];
+    return reinterpret_cast<SDL_Texture*>(&storage[id]);
+}
+
+const SDL_Color WHITE = {255, 255, 255, 255};
+
+void addSprite(RenderQueue& queue, int texture, int y) {
+    queue.addSprite(fakeTexture(texture), SDL_Rect{0, 0, 16, 16}, SDL_Rect{0, y, 16, 16}, WHITE);
+}
+
+// Destination y of the commands in draw order
+std::vector<int> drawnY(RenderQueue& queue) {
+    std::vector<int> ys;
+    for (uint32_t index : queue.sort()) {
+        ys.push_back(queue.getCommand(index).dst.y);
+    }
+    return ys;
+}
+
+}  // namespace
+
+TEST(RenderQueueTest, LayersDrawBottomToTop) {
+    RenderQueue queue;
+    queue.setLayer(RenderLayer::UI);
+    addSprite(queue, 0, 1);
+    queue.setLayer(RenderLayer::Objects);
+    addSprite(queue, 0, 2);
+    queue.setLayer(RenderLayer::Ground);
+    addSprite(queue, 0, 3);
+    queue.setLayer(RenderLayer::Overlay);
+    addSprite(queue, 0, 4);
+
+    EXPECT_EQ(drawnY(queue), (std::vector<int>{3, 2, 4, 1}));
+}
+
+TEST(RenderQueueTest, ObjectsAreSortedByBottomEdge) {
+    RenderQueue queue;
+    queue.setLayer(RenderLayer::Objects);
+    addSprite(queue, 0, 40);
+    addSprite(queue, 1, -8);  // Partly above the screen
+    addSprite(queue, 0, 16);
+    queue.addSprite(fakeTexture(1), SDL_Rect{0, 0, 16, 32}, SDL_Rect{0, 0, 16, 32}, WHITE);  // Tall: bottom at 32
+
+    EXPECT_EQ(drawnY(queue), (std::vector<int>{-8, 16, 0, 40}));
+}
+
+TEST(RenderQueueTest, GroundGroupsTexturesKeepingOrderWithin) {
+    RenderQueue queue;
+    addSprite(queue, 0, 1);
+    addSprite(queue, 1, 2);
+    addSprite(queue, 0, 3);
+    addSprite(queue, 1, 4);
+
+    EXPECT_EQ(drawnY(queue), (std::vector<int>{1, 3, 2, 4}));
+}
+
+TEST(RenderQueueTest, UserInterfaceKeepsRecordedOrder) {
+    RenderQueue queue;
+    queue.setLayer(RenderLayer::UI);
+    queue.addRect(RenderQueue::Command::Type::FillRect, SDL_Rect{0, 1, 8, 8}, WHITE);
+    addSprite(queue, 0, 2);
+    addSprite(queue, 1, 3);
+    queue.addRect(RenderQueue::Command::Type::DrawRect, SDL_Rect{0, 4, 8, 8}, WHITE);
+    addSprite(queue, 0, 5);
+
+    EXPECT_EQ(drawnY(queue), (std::vector<int>{1, 2, 3, 4, 5}));
+}
+
+TEST(RenderQueueTest, ClearKeepsNothingAndResetsLayer) {
+    RenderQueue queue;
+    queue.setLayer(RenderLayer::UI);
+    addSprite(queue, 0, 1);
+    queue.clear();
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.getLayer(), RenderLayer::Ground);
+    EXPECT_TRUE(queue.sort().empty());
+}
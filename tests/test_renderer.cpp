@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "system/Renderer.h"
+
+// Headless renderers need no window, so the whole draw path runs here
+class RendererTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(renderer_.init("test", Constants::WINDOW_WIDTH, Constants::WINDOW_HEIGHT,
+                                   Renderer::Backend::Headless));
+        texture_ = renderer_.createStreamingTexture(32, 32);
+        other_ = renderer_.createStreamingTexture(32, 32);
+        ASSERT_NE(texture_, nullptr);
+        ASSERT_NE(other_, nullptr);
+    }
+
+    void TearDown() override {
+        SDL_DestroyTexture(texture_);
+        SDL_DestroyTexture(other_);
+    }
+
+    void drawSprite(SDL_Texture* texture, int x) {
+        SDL_Rect src = {0, 0, 16, 16};
+        SDL_Rect dst = {x, 0, 16, 16};
+        renderer_.drawTexture(texture, &src, &dst);
+    }
+
+    // Copy of the headless frame (ARGB8888, row by row)
+    std::vector<uint32_t> capture() const {
+        const SDL_Surface* surface = renderer_.getSurface();
+        std::vector<uint32_t> pixels(static_cast<size_t>(surface->w) * surface->h);
+        for (int y = 0; y < surface->h; ++y) {
+            std::memcpy(&pixels[static_cast<size_t>(y) * surface->w],
+                        static_cast<const uint8_t*>(surface->pixels) + static_cast<size_t>(y) * surface->pitch,
+                        static_cast<size_t>(surface->w) * 4);
+        }
+        return pixels;
+    }
+
+    Renderer renderer_;
+    SDL_Texture* texture_ = nullptr;
+    SDL_Texture* other_ = nullptr;
+};
+
+TEST_F(RendererTest, HeadlessDrawsToSurface) {
+    EXPECT_EQ(renderer_.getBackend(), Renderer::Backend::Headless);
+    const SDL_Surface* surface = renderer_.getSurface();
+    ASSERT_NE(surface, nullptr);
+    EXPECT_EQ(surface->w, Constants::WINDOW_WIDTH);
+    EXPECT_EQ(surface->h, Constants::WINDOW_HEIGHT);
+}
+
+TEST_F(RendererTest, SpritesSharingTextureAreOneDrawCall) {
+    for (int i = 0; i < 10; ++i) {
+        drawSprite(texture_, i * 16);
+    }
+    renderer_.present();
+
+    const Renderer::FrameStats& stats = renderer_.getFrameStats();
+    EXPECT_EQ(stats.drawCalls, 1);
+    EXPECT_EQ(stats.sprites, 10);
+    EXPECT_EQ(stats.vertices, 40);
+}
+
+TEST_F(RendererTest, BatchKeepsDrawOrder) {
+    renderer_.setLayer(RenderLayer::UI);  // Recorded order decides
+    drawSprite(texture_, 0);
+    drawSprite(other_, 16);    // Texture change submits the first batch
+    drawSprite(texture_, 32);
+    renderer_.fillRect(0, 0, 8, 8);  // Rectangles submit pending sprites first
+    drawSprite(texture_, 48);
+    renderer_.present();
+
+    const Renderer::FrameStats& stats = renderer_.getFrameStats();
+    EXPECT_EQ(stats.drawCalls, 5);
+    EXPECT_EQ(stats.sprites, 4);
+}
+
+TEST_F(RendererTest, GroundIsGroupedByTexture) {
+    drawSprite(texture_, 0);
+    drawSprite(other_, 16);
+    drawSprite(texture_, 32);
+    drawSprite(other_, 48);
+    renderer_.present();
+
+    const Renderer::FrameStats& stats = renderer_.getFrameStats();
+    EXPECT_EQ(stats.commands, 4);
+    EXPECT_EQ(stats.drawCalls, 2);
+}
+
+TEST_F(RendererTest, ClearDropsRecordedCommands) {
+    drawSprite(texture_, 0);
+    renderer_.clear();
+    renderer_.present();
+    EXPECT_EQ(renderer_.getFrameStats().commands, 0);
+}
+
+TEST_F(RendererTest, StatsAreCountedPerFrame) {
+    drawSprite(texture_, 0);
+    renderer_.present();
+    renderer_.present();
+    EXPECT_EQ(renderer_.getFrameStats().drawCalls, 0);
+}
+
+TEST_F(RendererTest, BatchedQuadsMatchRenderCopy) {
+    // Color and alpha ramps, from fully transparent to opaque
+    std::vector<uint32_t> pattern(32 * 32);
+    for (int y = 0; y < 32; ++y) {
+        for (int x = 0; x < 32; ++x) {
+            uint32_t a = static_cast<uint32_t>(x * 255 / 31);
+            uint32_t r = static_cast<uint32_t>(y * 8);
+            uint32_t g = static_cast<uint32_t>(255 - x * 8);
+            uint32_t b = static_cast<uint32_t>((x + y) * 4);
+            pattern[static_cast<size_t>(y) * 32 + x] = (a << 24) | (r << 16) | (g << 8) | b;
+        }
+    }
+    ASSERT_TRUE(renderer_.updateTexture(texture_, pattern.data(), 32 * 4));
+    ASSERT_TRUE(renderer_.updateTexture(other_, pattern.data(), 32 * 4));
+    SDL_SetTextureColorMod(texture_, 200, 120, 60);
+    SDL_SetTextureAlphaMod(texture_, 180);
+
+    // Overlapping quads of both textures, 1:1 so neither path resamples
+    struct Quad {
+        SDL_Texture* texture;
+        SDL_Rect src;
+        SDL_Rect dst;
+    };
+    const std::vector<Quad> quads = {
+        {texture_, {0, 0, 32, 32}, {10, 10, 32, 32}},
+        {texture_, {8, 4, 16, 16}, {30, 20, 16, 16}},
+        {other_, {0, 0, 32, 32}, {24, 24, 32, 32}},
+        {texture_, {16, 16, 16, 16}, {40, 30, 16, 16}},
+    };
+
+    // Batched: recorded, then submitted through SDL_RenderGeometry
+    renderer_.setDrawColor(30, 60, 90);
+    renderer_.clear();
+    renderer_.setLayer(RenderLayer::UI);  // Keep the overlap order as drawn
+    for (const auto& quad : quads) {
+        renderer_.drawTexture(quad.texture, &quad.src, &quad.dst);
+    }
+    renderer_.present();
+    EXPECT_EQ(renderer_.getFrameStats().sprites, 4);
+    std::vector<uint32_t> batched = capture();
+
+    // Reference: SDL's own copy with the same color mod and alpha
+    renderer_.clear();
+    for (const auto& quad : quads) {
+        ASSERT_EQ(SDL_RenderCopy(renderer_.getSDLRenderer(), quad.texture, &quad.src, &quad.dst), 0);
+    }
+    renderer_.present();
+    std::vector<uint32_t> copied = capture();
+
+    // The software triangle filler and the blitter may round blending differently
+    const int tolerance = 2;
+    ASSERT_EQ(batched.size(), copied.size());
+    int mismatches = 0;
+    for (size_t i = 0; i < batched.size(); ++i) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            int expected = static_cast<int>((copied[i] >> shift) & 0xFF);
+            int actual = static_cast<int>((batched[i] >> shift) & 0xFF);
+            if (std::abs(expected - actual) > tolerance) {
+                ++mismatches;
+                break;
+            }
+        }
+    }
+    EXPECT_EQ(mismatches, 0);
+}
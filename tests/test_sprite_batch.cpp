@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "system/SpriteBatch.h"
+
+// Textures only serve as batch keys, so they come from a software renderer
+class SpriteBatchTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        surface_ = SDL_CreateRGBSurfaceWithFormat(0, 64, 64, 32, SDL_PIXELFORMAT_ARGB8888);
+        ASSERT_NE(surface_, nullptr);
+        renderer_ = SDL_CreateSoftwareRenderer(surface_);
+        ASSERT_NE(renderer_, nullptr);
+        first_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 64, 32);
+        second_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 64, 32);
+        ASSERT_NE(first_, nullptr);
+        ASSERT_NE(second_, nullptr);
+    }
+
+    void TearDown() override {
+        SDL_DestroyTexture(first_);
+        SDL_DestroyTexture(second_);
+        SDL_DestroyRenderer(renderer_);
+        SDL_FreeSurface(surface_);
+    }
+
+    SDL_Surface* surface_ = nullptr;
+    SDL_Renderer* renderer_ = nullptr;
+    SDL_Texture* first_ = nullptr;
+    SDL_Texture* second_ = nullptr;
+    SpriteBatch batch_;
+};
+
+TEST_F(SpriteBatchTest, QuadHasNormalizedTextureCoordinates) {
+    SDL_Color tint = {255, 128, 0, 255};
+    batch_.add(first_, SDL_BLENDMODE_BLEND, 64, 32, SDL_Rect{16, 8, 16, 8}, SDL_Rect{10, 20, 32, 16}, tint);
+
+    ASSERT_EQ(batch_.getQuadCount(), 1);
+    ASSERT_EQ(batch_.getVertexCount(), 4);
+    const SDL_Vertex* v = batch_.getVertices();
+    EXPECT_FLOAT_EQ(v[0].position.x, 10.0f);
+    EXPECT_FLOAT_EQ(v[0].position.y, 20.0f);
+    EXPECT_FLOAT_EQ(v[2].position.x, 42.0f);
+    EXPECT_FLOAT_EQ(v[2].position.y, 36.0f);
+    EXPECT_FLOAT_EQ(v[0].tex_coord.x, 0.25f);
+    EXPECT_FLOAT_EQ(v[0].tex_coord.y, 0.25f);
+    EXPECT_FLOAT_EQ(v[2].tex_coord.x, 0.5f);
+    EXPECT_FLOAT_EQ(v[2].tex_coord.y, 0.5f);
+    EXPECT_EQ(v[3].color.g, 128);
+}
+
+TEST_F(SpriteBatchTest, IndicesFormTwoTrianglesPerQuad) {
+    SDL_Color white = {255, 255, 255, 255};
+    batch_.add(first_, SDL_BLENDMODE_BLEND, 64, 32, SDL_Rect{0, 0, 16, 16}, SDL_Rect{0, 0, 16, 16}, white);
+    batch_.add(first_, SDL_BLENDMODE_BLEND, 64, 32, SDL_Rect{16, 0, 16, 16}, SDL_Rect{16, 0, 16, 16}, white);
+
+    ASSERT_EQ(batch_.getIndexCount(), 12);
+    const int expected[12] = {0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7};
+    for (int i = 0; i < 12; ++i) {
+        EXPECT_EQ(batch_.getIndices()[i], expected[i]);
+    }
+}
+
+TEST_F(SpriteBatchTest, AcceptsOnlyMatchingTextureAndBlendMode) {
+    EXPECT_TRUE(batch_.accepts(first_, SDL_BLENDMODE_BLEND));  // Empty batch takes anything
+    SDL_Color white = {255, 255, 255, 255};
+    batch_.add(first_, SDL_BLENDMODE_BLEND, 64, 32, SDL_Rect{0, 0, 16, 16}, SDL_Rect{0, 0, 16, 16}, white);
+
+    EXPECT_TRUE(batch_.accepts(first_, SDL_BLENDMODE_BLEND));
+    EXPECT_FALSE(batch_.accepts(second_, SDL_BLENDMODE_BLEND));
+    EXPECT_FALSE(batch_.accepts(first_, SDL_BLENDMODE_ADD));
+    EXPECT_EQ(batch_.getTexture(), first_);
+}
+
+TEST_F(SpriteBatchTest, ClearEmptiesBatch) {
+    SDL_Color white = {255, 255, 255, 255};
+    batch_.add(first_, SDL_BLENDMODE_NONE, 64, 32, SDL_Rect{0, 0, 64, 32}, SDL_Rect{0, 0, 64, 32}, white);
+    batch_.clear();
+
+    EXPECT_TRUE(batch_.empty());
+    EXPECT_EQ(batch_.getIndexCount(), 0);
+    EXPECT_EQ(batch_.getTexture(), nullptr);
+    EXPECT_TRUE(batch_.accepts(second_, SDL_BLENDMODE_ADD));
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "ui/TextLayout.h"
+
+namespace {
+
+// 8 pixels per character, like the font sheet
+int fixedAdvance(char32_t, char32_t) {
+    return 8;
+}
+
+std::vector<std::string> wrapChars(const std::string& text, int columns) {
+    return TextLayout::wrap(text, columns * 8, fixedAdvance);
+}
+
+}  // namespace
+
+TEST(TextLayoutTest, WrapsAtSpacesAndDropsThem) {
+    std::vector<std::string> expected = {"Hello,", "traveler!", "Welcome to", "our", "village."};
+    EXPECT_EQ(wrapChars("Hello, traveler! Welcome to our village.", 10), expected);
+}
+
+TEST(TextLayoutTest, KeepsHardBreaksAndBlankLines) {
+    std::vector<std::string> expected = {"Saluton!", "", "(Hello!)"};
+    EXPECT_EQ(wrapChars("Saluton!\n\n(Hello!)", 20), expected);
+    EXPECT_EQ(wrapChars("", 20), std::vector<std::string>{""});
+}
+
+TEST(TextLayoutTest, SplitsWordsWiderThanTheBox) {
+    std::vector<std::string> expected = {"abcd", "efgh", "ij"};
+    EXPECT_EQ(wrapChars("abcdefghij", 4), expected);
+
+    std::vector<std::string> hyphen = {"well-", "known"};
+    EXPECT_EQ(wrapChars("well-known", 7), hyphen);
+}
+
+TEST(TextLayoutTest, BreaksBetweenKanaButNotBeforeClosingPunctuation) {
+    // "こんにちは。": the full stop pulls "は" onto the next line with it
+    std::vector<std::string> expected = {"こんにち", "は。"};
+    EXPECT_EQ(wrapChars("こんにちは。", 5), expected);
+}
+
+TEST(TextLayoutTest, MeasuresWithKerning) {
+    auto kerned = [](char32_t previous, char32_t c) { return previous == 'A' && c == 'V' ? 4 : 8; };
+
+    std::vector<std::string> expected = {"AV", "AV"};
+    EXPECT_EQ(TextLayout::wrap("AV AV", 12, kerned), expected);
+}
+
+TEST(TextLayoutTest, PaginatesLines) {
+    std::vector<std::string> expected = {"one\ntwo", "three\nfour", "five"};
+    EXPECT_EQ(TextLayout::paginate("one two three four five", 40, 2, fixedAdvance), expected);
+
+    EXPECT_EQ(TextLayout::paginate("one two", 40, 0, fixedAdvance), std::vector<std::string>{"one\ntwo"});
+    EXPECT_EQ(TextLayout::paginate("", 40, 2, fixedAdvance), std::vector<std::string>{""});
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "system/Renderer.h"
+#include "system/ResourceManager.h"
+#include "ui/FontFormat.h"
+#include "ui/TextRenderer.h"
+
+class TextRendererTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(renderer_.init("test", Constants::WINDOW_WIDTH, Constants::WINDOW_HEIGHT,
+                                   Renderer::Backend::Headless));
+        resources_ = std::make_unique<ResourceManager>(renderer_.getSDLRenderer());
+        ASSERT_TRUE(text_.loadFont(*resources_, "assets/fonts/font.png"));
+    }
+
+    // Pixels of one presented frame with the given text drawn
+    std::vector<uint8_t> drawFrame(const char* text, int x, int y) {
+        renderer_.clear();
+        text_.renderText(renderer_, text, x, y);
+        renderer_.present();
+        const SDL_Surface* surface = renderer_.getSurface();
+        const uint8_t* pixels = static_cast<const uint8_t*>(surface->pixels);
+        return std::vector<uint8_t>(pixels, pixels + static_cast<size_t>(surface->pitch) * surface->h);
+    }
+
+    Renderer renderer_;
+    std::unique_ptr<ResourceManager> resources_;
+    TextRenderer text_;
+};
+
+TEST_F(TextRendererTest, SameStringAtSamePlaceReusesLayout) {
+    text_.renderText(renderer_, "HP 10/10", 8, 8);
+    renderer_.present();
+    text_.renderText(renderer_, "HP 10/10", 8, 8);
+
+    EXPECT_EQ(text_.getLayoutMissCount(), 1u);
+    EXPECT_EQ(text_.getLayoutHitCount(), 1u);
+    EXPECT_EQ(text_.getLayoutCount(), 1);
+}
+
+TEST_F(TextRendererTest, ChangedStringOrPositionIsLaidOutAgain) {
+    text_.renderText(renderer_, "HP 10/10", 8, 8);
+    text_.renderText(renderer_, "HP 9/10", 8, 8);
+    text_.renderText(renderer_, "HP 10/10", 8, 20);
+
+    EXPECT_EQ(text_.getLayoutMissCount(), 3u);
+    EXPECT_EQ(text_.getLayoutHitCount(), 0u);
+}
+
+TEST_F(TextRendererTest, CachedLayoutDrawsLikeUncached) {
+    drawFrame("Gold  123\nEXP 4", 16, 24);
+    std::vector<uint8_t> cached = drawFrame("Gold  123\nEXP 4", 16, 24);
+    int cachedCommands = renderer_.getFrameStats().commands;
+    ASSERT_EQ(text_.getLayoutHitCount(), 1u);
+
+    text_.setLayoutCacheEnabled(false);
+    std::vector<uint8_t> uncached = drawFrame("Gold  123\nEXP 4", 16, 24);
+    EXPECT_EQ(text_.getLayoutCount(), 0);
+    EXPECT_EQ(renderer_.getFrameStats().commands, cachedCommands);
+    EXPECT_TRUE(cached == uncached);
+}
+
+TEST_F(TextRendererTest, LayoutsNotDrawnRecentlyAreDropped) {
+    for (int i = 0; i < Constants::TEXT_LAYOUT_CACHE_ENTRIES; ++i) {
+        text_.renderText(renderer_, "x" + std::to_string(i), 0, 0);
+    }
+    EXPECT_EQ(text_.getLayoutCount(), Constants::TEXT_LAYOUT_CACHE_ENTRIES);
+
+    // Full: the next new layout sweeps out those not drawn last frame or this one
+    renderer_.present();
+    text_.renderText(renderer_, "x0", 0, 0);
+    renderer_.present();
+    text_.renderText(renderer_, "new", 0, 0);
+    EXPECT_EQ(text_.getLayoutCount(), 2);
+}
+
+TEST_F(TextRendererTest, BakedFontUsesAdvancesAndKerning) {
+    // Metrics over the ASCII sheet, which serves as the atlas
+    auto glyph = [](char32_t codePoint, int x, int advance) {
+        FontFormat::RFntGlyph record{};
+        record.codePoint = codePoint;
+        record.x = static_cast<uint16_t>(x);
+        record.width = 5;
+        record.height = 8;
+        record.advance = static_cast<int16_t>(advance);
+        return record;
+    };
+    const char* path = "assets/fonts/test_baked.rfnt";
+    ASSERT_TRUE(FontFormat::write(path, 8, 128, 48, {glyph('A', 8, 6), glyph('V', 16, 6), glyph('i', 24, 3)},
+                                  {FontFormat::RFntKerning{'A', 'V', -1}}, "font.png"));
+    bool loaded = text_.loadFont(*resources_, path);
+    std::remove(path);
+    ASSERT_TRUE(loaded);
+    EXPECT_TRUE(text_.isBaked());
+
+    EXPECT_EQ(text_.measureText("AV").x, 11);
+    EXPECT_EQ(text_.measureText("Vi").x, 9);
+    EXPECT_EQ(text_.measureText("Vi\nA"), (Vec2{9, 2 * Constants::DIALOGUE_LINE_HEIGHT}));
+}
+
+TEST_F(TextRendererTest, FontImageFollowsTheFontLoadFontUses) {
+    const char* sheet = "assets/fonts/test_image.png";
+    const char* baked = "assets/fonts/test_image.rfnt";
+    { std::ofstream(sheet) << "png"; }
+    EXPECT_EQ(TextRenderer::getFontImagePath(sheet), sheet);  // No baked font
+
+    FontFormat::RFntGlyph glyph{};
+    glyph.codePoint = 'A';
+    glyph.width = 5;
+    glyph.height = 8;
+    glyph.advance = 6;
+    ASSERT_TRUE(FontFormat::write(baked, 8, 128, 48, {glyph}, {}, "test_image_atlas.png"));
+    std::filesystem::last_write_time(baked, std::filesystem::last_write_time(sheet));
+    EXPECT_EQ(TextRenderer::getFontImagePath(sheet), "assets/fonts/test_image_atlas.png");
+    EXPECT_EQ(TextRenderer::getFontImagePath(baked), "assets/fonts/test_image_atlas.png");
+
+    // A sheet edited after the bake is loaded itself
+    std::filesystem::last_write_time(sheet, std::filesystem::last_write_time(baked) + std::chrono::hours(1));
+    EXPECT_EQ(TextRenderer::getFontImagePath(sheet), sheet);
+
+    std::remove(sheet);
+    std::remove(baked);
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
+#include <iterator>
 #include "field/Tile.h"
+#include "util/Constants.h"
 
 // Test Tile construction
 TEST(TileTest, Construction) {
@@ -118,3 +120,60 @@ TEST(TileTest, WalkabilityMatrix) {
     EXPECT_FALSE(Tile::tree().isWalkable());
     EXPECT_FALSE(Tile::mountain().isWalkable());
 }
+
+// Test which tiles block line of sight
+TEST(TileTest, OpacityMatrix) {
+    EXPECT_TRUE(Tile::wall().isOpaque());
+    EXPECT_TRUE(Tile::tree().isOpaque());
+    EXPECT_TRUE(Tile::mountain().isOpaque());
+
+    // Water blocks movement but not sight; doors are open
+    EXPECT_FALSE(Tile::water().isOpaque());
+    EXPECT_FALSE(Tile::door().isOpaque());
+    EXPECT_FALSE(Tile::grass().isOpaque());
+    EXPECT_FALSE(Tile::floor().isOpaque());
+}
+
+// Test TILE_TABLE matches the tile factory functions
+TEST(TileTableTest, MatchesExpectedProperties) {
+    // Literal values, so a wrong table entry or factory cannot pass by comparing with itself
+    struct Expected {
+        TileType type;
+        int id;
+        bool walkable;
+        int textureX;
+        int textureY;
+        bool opaque;
+    };
+    const Expected expected[] = {
+        {TileType::Grass, 0, true, 0, 0, false},
+        {TileType::Water, 1, false, 1, 0, false},
+        {TileType::Wall, 2, false, 2, 0, true},
+        {TileType::Floor, 3, true, 3, 0, false},
+        {TileType::Tree, 4, false, 0, 1, true},
+        {TileType::Mountain, 5, false, 1, 1, true},
+        {TileType::Sand, 6, true, 2, 1, false},
+        {TileType::Bridge, 7, true, 3, 1, false},
+        {TileType::Door, 8, true, 0, 2, false},
+        {TileType::Stairs, 9, true, 1, 2, false},
+    };
+    ASSERT_EQ(static_cast<int>(std::size(expected)), TILE_TYPE_COUNT);
+
+    for (const auto& e : expected) {
+        SCOPED_TRACE(e.id);
+        EXPECT_EQ(static_cast<int>(e.type), e.id);
+        for (const Tile& tile : {tileOf(e.type), Tile::fromId(e.id)}) {
+            EXPECT_EQ(tile.type, e.type);
+            EXPECT_EQ(tile.walkable, e.walkable);
+            EXPECT_EQ(tile.textureX, e.textureX);
+            EXPECT_EQ(tile.textureY, e.textureY);
+            EXPECT_EQ(tile.opaque, e.opaque);
+        }
+    }
+}
+
+// Test TileType fits in one byte for compact map storage
+TEST(TileTableTest, TileTypeIsOneByte) {
+    EXPECT_EQ(sizeof(TileType), 1u);
+    EXPECT_EQ(TILE_TYPE_COUNT, Constants::MAX_TILE_ID + 1);
+}
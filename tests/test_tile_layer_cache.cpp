@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include "field/Map.h"
+#include "field/TileLayerCache.h"
+
+// Chunk textures come from a software renderer, so no window is needed
+class TileLayerCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        surface_ = SDL_CreateRGBSurfaceWithFormat(0, 64, 64, 32, SDL_PIXELFORMAT_ARGB8888);
+        ASSERT_NE(surface_, nullptr);
+        renderer_ = SDL_CreateSoftwareRenderer(surface_);
+        ASSERT_NE(renderer_, nullptr);
+    }
+
+    void TearDown() override {
+        cache_.clear();
+        SDL_DestroyRenderer(renderer_);
+        SDL_FreeSurface(surface_);
+    }
+
+    SDL_Texture* makeTexture() {
+        return SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+                                 Constants::TILE_CACHE_CHUNK_PIXELS, Constants::TILE_CACHE_CHUNK_PIXELS);
+    }
+
+    SDL_Surface* surface_ = nullptr;
+    SDL_Renderer* renderer_ = nullptr;
+    TileLayerCache cache_;
+};
+
+TEST_F(TileLayerCacheTest, FindInserted) {
+    SDL_Texture* texture = makeTexture();
+    cache_.beginFrame();
+    EXPECT_EQ(cache_.find(1, 2), nullptr);
+
+    cache_.insert(1, 2, texture);
+    EXPECT_EQ(cache_.find(1, 2), texture);
+    EXPECT_EQ(cache_.find(2, 1), nullptr);
+    EXPECT_EQ(cache_.getChunkCount(), 1);
+}
+
+TEST_F(TileLayerCacheTest, InvalidateTileDropsItsChunk) {
+    cache_.beginFrame();
+    cache_.insert(0, 0, makeTexture());
+    cache_.insert(1, 0, makeTexture());
+
+    // Last tile of chunk (0, 0)
+    int tiles = Constants::TILE_CACHE_CHUNK_TILES;
+    cache_.invalidateTile(tiles - 1, tiles - 1);
+    EXPECT_EQ(cache_.find(0, 0), nullptr);
+    EXPECT_NE(cache_.find(1, 0), nullptr);
+}
+
+TEST_F(TileLayerCacheTest, EvictsLeastRecentlyUsed) {
+    for (int i = 0; i < Constants::TILE_CACHE_MAX_CHUNKS; ++i) {
+        cache_.beginFrame();
+        cache_.insert(i, 0, makeTexture());
+    }
+
+    // Touch chunk 0 so chunk 1 is now the oldest
+    cache_.beginFrame();
+    ASSERT_NE(cache_.find(0, 0), nullptr);
+    cache_.insert(0, 1, makeTexture());
+
+    EXPECT_EQ(cache_.getChunkCount(), Constants::TILE_CACHE_MAX_CHUNKS);
+    EXPECT_NE(cache_.find(0, 0), nullptr);
+    EXPECT_EQ(cache_.find(1, 0), nullptr);
+    EXPECT_NE(cache_.find(0, 1), nullptr);
+}
+
+TEST_F(TileLayerCacheTest, MoveTransfersOwnership) {
+    cache_.beginFrame();
+    SDL_Texture* texture = makeTexture();
+    cache_.insert(3, 3, texture);
+
+    TileLayerCache moved(std::move(cache_));
+    EXPECT_EQ(moved.find(3, 3), texture);
+    EXPECT_EQ(cache_.getChunkCount(), 0);
+}
+
+// Map tile edits
+
+TEST(MapSetTileTest, SetTileChangesWalkability) {
+    Map map;
+    std::vector<TileType> tiles(10 * 10, TileType::Grass);
+    ASSERT_TRUE(map.loadFromTiles(10, 10, tiles));
+
+    EXPECT_TRUE(map.setTile(3, 4, TileType::Water));
+    EXPECT_EQ(map.getTileType(3, 4), TileType::Water);
+    EXPECT_FALSE(map.isWalkable(3, 4));
+
+    EXPECT_FALSE(map.setTile(10, 0, TileType::Water));
+    EXPECT_FALSE(map.setTile(0, 0, static_cast<TileType>(200)));
+}
+
+TEST(MapSetTileTest, SetTileCopiesMappedLayer) {
+    Map source;
+    std::vector<TileType> tiles(10 * 10, TileType::Floor);
+    ASSERT_TRUE(source.loadFromTiles(10, 10, tiles));
+    ASSERT_TRUE(source.saveToBinary("test_set_tile.rmap"));
+
+    Map map;
+    ASSERT_TRUE(map.loadFromBinary("test_set_tile.rmap"));
+    ASSERT_TRUE(map.isMemoryMapped());
+    EXPECT_TRUE(map.setTile(1, 1, TileType::Wall));
+    EXPECT_FALSE(map.isMemoryMapped());
+    EXPECT_EQ(map.getTileType(1, 1), TileType::Wall);
+    EXPECT_EQ(map.getTileType(2, 1), TileType::Floor);
+
+    // The file on disk is unchanged
+    Map reloaded;
+    ASSERT_TRUE(reloaded.loadFromBinary("test_set_tile.rmap"));
+    EXPECT_EQ(reloaded.getTileType(1, 1), TileType::Floor);
+    std::remove("test_set_tile.rmap");
+}
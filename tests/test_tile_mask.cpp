@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "field/Map.h"
+#include "field/TileMask.h"
+
+namespace {
+
+// Random mask (about 90% set) with a plain bool copy for reference answers
+struct RandomMask {
+    TileMask mask;
+    std::vector<bool> bits;
+    int width;
+    int height;
+
+    RandomMask(int w, int h, unsigned seed) : width(w), height(h) {
+        std::mt19937 rng(seed);
+        mask.reset(w, h);
+        bits.assign(static_cast<size_t>(w) * h, false);
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) {
+                bool value = rng() % 10 != 0;
+                mask.set(x, y, value);
+                bits[static_cast<size_t>(y) * w + x] = value;
+            }
+        }
+    }
+
+    bool at(int x, int y) const {
+        return x >= 0 && y >= 0 && x < width && y < height && bits[static_cast<size_t>(y) * width + x];
+    }
+};
+
+// Reference line walk: offsets along each axis rounded half up
+bool referenceLine(const RandomMask& m, int x0, int y0, int x1, int y1) {
+    long dx = std::abs(x1 - x0);
+    long dy = std::abs(y1 - y0);
+    long steps = std::max(1L, std::max(dx, dy));
+    for (long s = 0; s <= std::max(dx, dy); ++s) {
+        int x = x0 + (x1 >= x0 ? 1 : -1) * static_cast<int>((2 * s * dx + steps) / (2 * steps));
+        int y = y0 + (y1 >= y0 ? 1 : -1) * static_cast<int>((2 * s * dy + steps) / (2 * steps));
+        if (!m.at(x, y)) return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST(TileMaskTest, SetTestAndBounds) {
+    TileMask mask;
+    mask.reset(70, 3);
+    EXPECT_EQ(mask.getWordsPerRow(), 2);
+    EXPECT_FALSE(mask.test(69, 2));
+    mask.set(69, 2, true);
+    mask.set(0, 0, true);
+    EXPECT_TRUE(mask.test(69, 2));
+    EXPECT_TRUE(mask.test(0, 0));
+    mask.set(69, 2, false);
+    EXPECT_FALSE(mask.test(69, 2));
+
+    mask.set(-1, 0, true);
+    mask.set(70, 0, true);
+    EXPECT_FALSE(mask.test(-1, 0));
+    EXPECT_FALSE(mask.test(70, 0));
+    EXPECT_FALSE(mask.test(0, 3));
+}
+
+TEST(TileMaskTest, SetWordMasksPadding) {
+    TileMask mask;
+    mask.reset(70, 1);
+    mask.setWord(0, 1, ~uint64_t{0});
+    EXPECT_EQ(mask.getRow(0)[1], (uint64_t{1} << 6) - 1);
+    EXPECT_EQ(mask.countInRow(0, 0, 1000), 6);
+}
+
+TEST(TileMaskTest, SpansMatchReference) {
+    RandomMask m(300, 8, 1);
+    // Mostly set rows so long spans are not rejected on the first word
+    for (int x = 0; x < 300; ++x) {
+        m.mask.set(x, 4, x != 250);
+        m.bits[4 * 300 + x] = x != 250;
+    }
+    std::mt19937 rng(2);
+    for (int i = 0; i < 20000; ++i) {
+        int y = static_cast<int>(rng() % 8);
+        int x0 = static_cast<int>(rng() % 320) - 10;
+        int x1 = static_cast<int>(rng() % 320) - 10;
+        bool expected = true;
+        int count = 0;
+        for (int x = std::min(x0, x1); x <= std::max(x0, x1); ++x) {
+            expected = expected && m.at(x, y);
+            count += m.at(x, y) ? 1 : 0;
+        }
+        ASSERT_EQ(m.mask.allSetInRow(y, x0, x1), expected) << y << " " << x0 << " " << x1;
+        ASSERT_EQ(m.mask.countInRow(y, x0, x1), count);
+    }
+    EXPECT_TRUE(m.mask.allSetInRow(4, 0, 249));
+    EXPECT_FALSE(m.mask.allSetInRow(4, 0, 299));
+}
+
+TEST(TileMaskTest, ExcludeMaskBlocksTiles) {
+    TileMask open;
+    TileMask blocked;
+    open.reset(200, 4);
+    blocked.reset(200, 4);
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 200; ++x) open.set(x, y, true);
+    }
+    EXPECT_TRUE(open.allSetInRect(0, 0, 200, 4, &blocked));
+
+    blocked.set(130, 2, true);
+    EXPECT_FALSE(open.allSetInRect(0, 0, 200, 4, &blocked));
+    EXPECT_TRUE(open.allSetInRect(0, 0, 130, 4, &blocked));
+    EXPECT_TRUE(open.allSetInRect(131, 0, 69, 4, &blocked));
+    EXPECT_FALSE(open.allSetInRow(2, 129, 131, &blocked));
+    EXPECT_FALSE(open.allSetInRect(0, 0, 0, 4));
+    EXPECT_FALSE(open.allSetInRect(190, 0, 20, 4));
+}
+
+TEST(TileMaskTest, LinesMatchReference) {
+    RandomMask m(150, 90, 3);
+    std::mt19937 rng(4);
+    for (int i = 0; i < 20000; ++i) {
+        int x0 = static_cast<int>(rng() % 150);
+        int y0 = static_cast<int>(rng() % 90);
+        int x1 = std::min(149, std::max(0, x0 + static_cast<int>(rng() % 41) - 20));
+        int y1 = std::min(89, std::max(0, y0 + static_cast<int>(rng() % 41) - 20));
+        ASSERT_EQ(m.mask.allSetOnLine(x0, y0, x1, y1), referenceLine(m, x0, y0, x1, y1))
+            << x0 << "," << y0 << " -> " << x1 << "," << y1;
+    }
+    EXPECT_FALSE(m.mask.allSetOnLine(-1, 0, 5, 5));
+}
+
+TEST(TileMaskTest, LineIsSymmetricOnDiagonals) {
+    TileMask mask;
+    mask.reset(10, 10);
+    for (int i = 0; i < 10; ++i) mask.set(i, i, true);
+    EXPECT_TRUE(mask.allSetOnLine(0, 0, 9, 9));
+    EXPECT_TRUE(mask.allSetOnLine(9, 9, 0, 0));
+    EXPECT_FALSE(mask.allSetOnLine(0, 0, 9, 8));
+}
+
+class MapWalkabilityMaskTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // 100 x 3 floor with a wall at (70, 1)
+        std::vector<TileType> tiles(300, TileType::Floor);
+        tiles[100 + 70] = TileType::Wall;
+        ASSERT_TRUE(map.loadFromTiles(100, 3, std::move(tiles)));
+        map.addNPCDefinition(NPCDefinition{"villager", 0, {"Hello!"}});
+    }
+
+    Map map;
+};
+
+TEST_F(MapWalkabilityMaskTest, MaskFollowsTiles) {
+    EXPECT_TRUE(map.getWalkableMask().test(69, 1));
+    EXPECT_FALSE(map.getWalkableMask().test(70, 1));
+    EXPECT_TRUE(map.isSpanWalkable(0, 0, 99));
+    EXPECT_FALSE(map.isSpanWalkable(1, 0, 99));
+    EXPECT_TRUE(map.isSpanWalkable(1, 71, 99));
+
+    ASSERT_TRUE(map.setTile(70, 1, TileType::Bridge));
+    EXPECT_TRUE(map.isSpanWalkable(1, 0, 99));
+    ASSERT_TRUE(map.setTile(5, 0, TileType::Water));
+    EXPECT_FALSE(map.isWalkable(5, 0));
+    EXPECT_FALSE(map.isAreaWalkable(0, 0, 10, 3));
+}
+
+TEST_F(MapWalkabilityMaskTest, NPCsBlockSpansButNotSight) {
+    map.addNPC(Vec2{40, 0}, Direction::Down, "villager");
+    EXPECT_TRUE(map.getNPCMask().test(40, 0));
+    EXPECT_FALSE(map.isWalkable(40, 0));
+    EXPECT_FALSE(map.isSpanWalkable(0, 0, 99));
+    EXPECT_FALSE(map.isAreaWalkable(30, 0, 20, 2));
+    EXPECT_TRUE(map.hasLineOfSight(Vec2{0, 0}, Vec2{99, 0}));
+
+    ASSERT_TRUE(map.moveNPC(Vec2{40, 0}, Vec2{40, 2}));
+    EXPECT_TRUE(map.isSpanWalkable(0, 0, 99));
+    EXPECT_FALSE(map.isSpanWalkable(2, 0, 99));
+
+    ASSERT_TRUE(map.removeNPCAt(Vec2{40, 2}));
+    EXPECT_TRUE(map.isAreaWalkable(0, 2, 100, 1));
+    EXPECT_FALSE(map.getNPCMask().test(40, 2));
+}
+
+TEST_F(MapWalkabilityMaskTest, LineOfSightStopsAtWalls) {
+    EXPECT_FALSE(map.hasLineOfSight(Vec2{60, 1}, Vec2{80, 1}));
+    EXPECT_TRUE(map.hasLineOfSight(Vec2{60, 0}, Vec2{80, 0}));
+    EXPECT_FALSE(map.hasLineOfSight(Vec2{0, 0}, Vec2{100, 0}));
+}
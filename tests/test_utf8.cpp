@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "util/Utf8.h"
+
+namespace {
+
+std::vector<char32_t> decode(const std::string& text) {
+    std::vector<char32_t> codePoints;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        codePoints.push_back(Utf8::next(text, pos));
+    }
+    return codePoints;
+}
+
+}  // namespace
+
+TEST(Utf8Test, DecodesAllSequenceLengths) {
+    // "a", "é", "こ", "😀"
+    std::vector<char32_t> expected = {U'a', 0xE9, 0x3053, 0x1F600};
+    EXPECT_EQ(decode("a\xC3\xA9\xE3\x81\x93\xF0\x9F\x98\x80"), expected);
+}
+
+TEST(Utf8Test, JapaneseText) {
+    std::vector<char32_t> expected = {0x3053, 0x3093, 0x306B, 0x3061, 0x306F};
+    EXPECT_EQ(decode("こんにちは"), expected);
+}
+
+TEST(Utf8Test, MalformedBytesBecomeReplacement) {
+    std::vector<char32_t> expected = {Utf8::REPLACEMENT, U'a'};
+    EXPECT_EQ(decode("\x80" "a"), expected);           // Stray continuation
+    EXPECT_EQ(decode("\xE3\x81" "a").front(), Utf8::REPLACEMENT);  // Truncated
+    EXPECT_EQ(decode("\xC0\xAF").front(), Utf8::REPLACEMENT);       // Overlong "/"
+    EXPECT_EQ(decode("\xED\xA0\x80").front(), Utf8::REPLACEMENT);   // Surrogate
+    EXPECT_EQ(decode("\xE3\x81").size(), 2u);  // Every byte makes progress
+}
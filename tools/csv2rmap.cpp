@@ -0,0 +1,56 @@
+// csv2rmap - offline converter from CSV maps to the binary .rmap format
+//
+// Usage: csv2rmap <input.csv> <output.rmap>
+//
+// Tile cells, #spawn, #transition and #npc directives are read with the same
+// rules as the game (Map::loadFromCSV) and written with Map::saveToBinary.
+// The result is loaded back and compared so a bad conversion never ships.
+
+#include <iostream>
+#include <string>
+#include "field/Map.h"
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <input.csv> <output.rmap>" << std::endl;
+        return 1;
+    }
+
+    const std::string input = argv[1];
+    const std::string output = argv[2];
+
+    Map map;
+    if (!map.loadFromCSV(input)) {
+        std::cerr << "csv2rmap: failed to load " << input << std::endl;
+        return 1;
+    }
+
+    if (!map.saveToBinary(output)) {
+        std::cerr << "csv2rmap: failed to write " << output << std::endl;
+        return 1;
+    }
+
+    // Verify round trip
+    Map check;
+    if (!check.loadFromBinary(output) ||
+        check.getWidth() != map.getWidth() || check.getHeight() != map.getHeight() ||
+        check.getTransitions().size() != map.getTransitions().size() ||
+        check.getNPCPlacements().size() != map.getNPCPlacements().size()) {
+        std::cerr << "csv2rmap: verification of " << output << " failed" << std::endl;
+        return 1;
+    }
+    for (int y = 0; y < map.getHeight(); ++y) {
+        for (int x = 0; x < map.getWidth(); ++x) {
+            if (check.getTileType(x, y) != map.getTileType(x, y)) {
+                std::cerr << "csv2rmap: tile mismatch in " << output << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    std::cout << input << " -> " << output << " ("
+              << map.getWidth() << "x" << map.getHeight() << ", "
+              << map.getTransitions().size() << " transitions, "
+              << map.getNPCPlacements().size() << " NPCs)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,352 @@
+// fontbake - offline baker from bitmap font sources to the .rfnt format
+//
+// Usage: fontbake [options] <output.rfnt>
+//   --sheet <image> <cellWidth> <cellHeight> <firstChar>
+//                          Fixed-cell sheet, cells row-major from firstChar
+//                          (assets/fonts/font.png is 8 8 32)
+//   --hex <file.hex> <glyphHeight>
+//                          .hex font (see ui/HexFont.h) for the characters below
+//   --text <file>          Bake every character used in a UTF-8 text file
+//                          (e.g. the game's strings, for a CJK subset)
+//   --range <first> <last> Bake a range of code points (hex, e.g. 3040 309F)
+//   --kerning <file>       One pair per line: two characters and an adjustment
+//                          in pixels ("AV -1"); '#' starts a comment line
+//   --proportional         Advance by inked width plus one pixel, not the cell width
+//   --atlas-size <n>       Atlas edge in pixels (default 256)
+//
+// Sheet glyphs win over .hex glyphs. Empty rows and columns are trimmed and
+// the glyphs packed into one atlas, written next to the output as
+// <name>_atlas.png. The result is loaded back and compared so a bad bake
+// never ships.
+
+#include <SDL.h>
+#include <SDL_image.h>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "system/AtlasPacker.h"
+#include "ui/BakedFont.h"
+#include "ui/FontFormat.h"
+#include "ui/GlyphCache.h"
+#include "ui/HexFont.h"
+#include "util/PathUtil.h"
+#include "util/Utf8.h"
+
+namespace {
+    using Bitmap = GlyphCache::Bitmap;
+
+    bool parseInt(const char* text, long minValue, long maxValue, long& out) {
+        char* end = nullptr;
+        out = std::strtol(text, &end, 10);
+        return end != text && *end == '\0' && out >= minValue && out <= maxValue;
+    }
+
+    bool parseCodePoint(const char* text, char32_t& out) {
+        char* end = nullptr;
+        long value = std::strtol(text, &end, 16);
+        if (end == text || *end != '\0' || value < 0 || value > 0x10FFFF) return false;
+        out = static_cast<char32_t>(value);
+        return true;
+    }
+
+    bool readFile(const std::string& path, std::string& out) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "fontbake: cannot read " << path << std::endl;
+            return false;
+        }
+        out.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    // Cells of a font sheet, with the alpha channel as coverage
+    bool readSheet(const std::string& path, int cellWidth, int cellHeight, char32_t firstChar,
+                   std::map<char32_t, Bitmap>& glyphs) {
+        SDL_Surface* loaded = IMG_Load(path.c_str());
+        if (!loaded) {
+            std::cerr << "fontbake: failed to load " << path << ": " << IMG_GetError() << std::endl;
+            return false;
+        }
+        SDL_Surface* sheet = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+        SDL_FreeSurface(loaded);
+        if (!sheet) {
+            std::cerr << "fontbake: failed to convert " << path << ": " << SDL_GetError() << std::endl;
+            return false;
+        }
+
+        int columns = sheet->w / cellWidth;
+        int rows = sheet->h / cellHeight;
+        const uint8_t* pixels = static_cast<const uint8_t*>(sheet->pixels);
+        for (int row = 0; row < rows; ++row) {
+            for (int col = 0; col < columns; ++col) {
+                Bitmap& bitmap = glyphs[firstChar + static_cast<char32_t>(row * columns + col)];
+                bitmap.width = cellWidth;
+                bitmap.height = cellHeight;
+                bitmap.coverage.resize(static_cast<size_t>(cellWidth) * cellHeight);
+                for (int y = 0; y < cellHeight; ++y) {
+                    const uint8_t* line = pixels + static_cast<size_t>(row * cellHeight + y) * sheet->pitch;
+                    for (int x = 0; x < cellWidth; ++x) {
+                        bitmap.coverage[static_cast<size_t>(y) * cellWidth + x] = line[(col * cellWidth + x) * 4 + 3];
+                    }
+                }
+            }
+        }
+        SDL_FreeSurface(sheet);
+        return columns > 0 && rows > 0;
+    }
+
+    // Every printable character of a UTF-8 text file
+    bool readCharacters(const std::string& path, std::set<char32_t>& out) {
+        std::string text;
+        if (!readFile(path, text)) return false;
+        size_t pos = 0;
+        while (pos < text.size()) {
+            char32_t c = Utf8::next(text, pos);
+            if (c >= 0x20 && c != 0x7F && c != Utf8::REPLACEMENT) {
+                out.insert(c);
+            }
+        }
+        return true;
+    }
+
+    bool readKerning(const std::string& path, std::vector<FontFormat::RFntKerning>& out) {
+        std::string text;
+        if (!readFile(path, text)) return false;
+        std::istringstream lines(text);
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(lines, line)) {
+            ++lineNumber;
+            if (line.empty() || line[0] == '#') continue;
+            size_t pos = 0;
+            char32_t left = Utf8::next(line, pos);
+            char32_t right = pos < line.size() ? Utf8::next(line, pos) : 0;
+            long adjust = 0;
+            if (right == 0 || pos >= line.size() || line[pos] != ' ' ||
+                !parseInt(line.c_str() + pos + 1, -FontFormat::MAX_KERNING_ADJUST,
+                          FontFormat::MAX_KERNING_ADJUST, adjust)) {
+                std::cerr << "fontbake: " << path << ":" << lineNumber << ": expected \"AB <adjust>\"" << std::endl;
+                return false;
+            }
+            out.push_back(FontFormat::RFntKerning{left, right, static_cast<int32_t>(adjust)});
+        }
+        return true;
+    }
+
+    // Inked extent of a bitmap (false if blank)
+    bool inkBounds(const Bitmap& bitmap, int& minX, int& minY, int& maxX, int& maxY) {
+        minX = bitmap.width;
+        minY = bitmap.height;
+        maxX = -1;
+        maxY = -1;
+        for (int y = 0; y < bitmap.height; ++y) {
+            for (int x = 0; x < bitmap.width; ++x) {
+                if (bitmap.coverage[static_cast<size_t>(y) * bitmap.width + x] != 0) {
+                    minX = std::min(minX, x);
+                    minY = std::min(minY, y);
+                    maxX = std::max(maxX, x);
+                    maxY = std::max(maxY, y);
+                }
+            }
+        }
+        return maxX >= 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string sheetPath;
+    long cellWidth = 0;
+    long cellHeight = 0;
+    char32_t firstChar = 0;
+    std::string hexPath;
+    long hexHeight = 0;
+    std::set<char32_t> wanted;
+    std::vector<FontFormat::RFntKerning> kerning;
+    bool proportional = false;
+    long atlasSize = 256;
+    std::string output;
+
+    bool argsOk = true;
+    for (int i = 1; i < argc && argsOk; ++i) {
+        const std::string arg = argv[i];
+        auto remaining = [&](int count) { return i + count < argc; };
+        if (arg == "--sheet" && remaining(4)) {
+            // First char is decimal, as FONT_FIRST_CHAR (32 = space)
+            long first = 0;
+            sheetPath = argv[i + 1];
+            argsOk = parseInt(argv[i + 2], 1, 64, cellWidth) && parseInt(argv[i + 3], 1, 64, cellHeight) &&
+                     parseInt(argv[i + 4], 0, 0x10FFFF, first);
+            firstChar = static_cast<char32_t>(first);
+            i += 4;
+        } else if (arg == "--hex" && remaining(2)) {
+            hexPath = argv[i + 1];
+            argsOk = parseInt(argv[i + 2], 1, 64, hexHeight);
+            i += 2;
+        } else if (arg == "--text" && remaining(1)) {
+            argsOk = readCharacters(argv[++i], wanted);
+        } else if (arg == "--range" && remaining(2)) {
+            char32_t first = 0;
+            char32_t last = 0;
+            argsOk = parseCodePoint(argv[i + 1], first) && parseCodePoint(argv[i + 2], last) && first <= last;
+            for (char32_t c = first; argsOk && c <= last; ++c) {
+                wanted.insert(c);
+            }
+            i += 2;
+        } else if (arg == "--kerning" && remaining(1)) {
+            argsOk = readKerning(argv[++i], kerning);
+        } else if (arg == "--proportional") {
+            proportional = true;
+        } else if (arg == "--atlas-size" && remaining(1)) {
+            argsOk = parseInt(argv[++i], 16, FontFormat::MAX_ATLAS_SIZE, atlasSize);
+        } else if (i == argc - 1 && arg[0] != '-') {
+            output = arg;
+        } else {
+            argsOk = false;
+        }
+    }
+    if (!argsOk || output.empty() || !PathUtil::hasExtension(output, ".rfnt") ||
+        (sheetPath.empty() && hexPath.empty())) {
+        std::cerr << "Usage: " << argv[0] << " [--sheet <image> <cellWidth> <cellHeight> <firstChar>]"
+                  << " [--hex <file.hex> <glyphHeight>] [--text <file>] [--range <first> <last>]"
+                  << " [--kerning <file>] [--proportional] [--atlas-size <n>] <output.rfnt>" << std::endl;
+        return 1;
+    }
+
+    // Sources
+    std::map<char32_t, Bitmap> glyphs;
+    if (!sheetPath.empty() &&
+        !readSheet(sheetPath, static_cast<int>(cellWidth), static_cast<int>(cellHeight), firstChar, glyphs)) {
+        return 1;
+    }
+    int missing = 0;
+    if (!wanted.empty()) {
+        HexFont hexFont;
+        if (!hexPath.empty() && !hexFont.open(hexPath, static_cast<int>(hexHeight))) {
+            std::cerr << "fontbake: failed to open " << hexPath << std::endl;
+            return 1;
+        }
+        Bitmap bitmap;
+        for (char32_t c : wanted) {
+            if (glyphs.count(c) != 0) continue;
+            if (hexFont.isOpen() && hexFont.rasterize(c, bitmap)) {
+                glyphs[c] = bitmap;
+            } else {
+                ++missing;
+            }
+        }
+    }
+    if (glyphs.empty()) {
+        std::cerr << "fontbake: no glyphs to bake" << std::endl;
+        return 1;
+    }
+
+    // Metrics, with glyphs trimmed to their ink
+    int lineHeight = 0;
+    for (const auto& entry : glyphs) {
+        lineHeight = std::max(lineHeight, entry.second.height);
+    }
+    std::vector<FontFormat::RFntGlyph> records;
+    std::vector<const Bitmap*> inked;   // Bitmap of each packed glyph
+    std::vector<size_t> inkedRecords;   // Its record
+    std::vector<Vec2> sizes;
+    for (const auto& [codePoint, bitmap] : glyphs) {
+        FontFormat::RFntGlyph record{};
+        record.codePoint = codePoint;
+        int minX = 0, minY = 0, maxX = 0, maxY = 0;
+        if (inkBounds(bitmap, minX, minY, maxX, maxY)) {
+            record.width = static_cast<uint16_t>(maxX - minX + 1);
+            record.height = static_cast<uint16_t>(maxY - minY + 1);
+            record.bearingX = static_cast<int16_t>(proportional ? 0 : minX);
+            // Bottom-aligned when sources differ in height
+            record.bearingY = static_cast<int16_t>(minY + lineHeight - bitmap.height);
+            record.advance = static_cast<int16_t>(proportional ? record.width + 1 : bitmap.width);
+            inked.push_back(&bitmap);
+            inkedRecords.push_back(records.size());
+            sizes.push_back(Vec2{record.width, record.height});
+        } else {
+            record.advance = static_cast<int16_t>(proportional ? std::max(bitmap.width / 2, 1) : bitmap.width);
+        }
+        records.push_back(record);
+    }
+
+    // Atlas: white, coverage as alpha (text is tinted with color mods)
+    AtlasPacker packer(static_cast<int>(atlasSize), static_cast<int>(atlasSize), 1);
+    std::vector<AtlasPacker::Placement> placements = packer.pack(sizes);
+    for (const AtlasPacker::Placement& placement : placements) {
+        if (placement.page != 0) {
+            std::cerr << "fontbake: glyphs do not fit one " << atlasSize << "x" << atlasSize
+                      << " atlas (use a larger --atlas-size)" << std::endl;
+            return 1;
+        }
+    }
+    Vec2 used = packer.getPageCount() > 0 ? packer.getUsedSize(0) : Vec2{1, 1};
+    SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, std::max(used.x, 1), std::max(used.y, 1),
+                                                        32, SDL_PIXELFORMAT_RGBA32);
+    if (!atlas) {
+        std::cerr << "fontbake: failed to create atlas: " << SDL_GetError() << std::endl;
+        return 1;
+    }
+    uint8_t* pixels = static_cast<uint8_t*>(atlas->pixels);
+    for (size_t i = 0; i < placements.size(); ++i) {
+        FontFormat::RFntGlyph& record = records[inkedRecords[i]];
+        record.x = static_cast<uint16_t>(placements[i].x);
+        record.y = static_cast<uint16_t>(placements[i].y);
+        const Bitmap& bitmap = *inked[i];
+        int minX = 0, minY = 0, maxX = 0, maxY = 0;
+        (void)inkBounds(bitmap, minX, minY, maxX, maxY);
+        for (int y = 0; y < record.height; ++y) {
+            uint8_t* line = pixels + static_cast<size_t>(record.y + y) * atlas->pitch;
+            for (int x = 0; x < record.width; ++x) {
+                uint8_t* pixel = line + (record.x + x) * 4;
+                pixel[0] = pixel[1] = pixel[2] = 255;
+                pixel[3] = bitmap.coverage[static_cast<size_t>(minY + y) * bitmap.width + minX + x];
+            }
+        }
+    }
+
+    const std::string atlasPath = PathUtil::replaceExtension(output, "_atlas.png");
+    const std::string atlasName = atlasPath.substr(atlasPath.find_last_of('/') + 1);
+    bool saved = IMG_SavePNG(atlas, atlasPath.c_str()) == 0;
+    int atlasWidth = atlas->w;
+    int atlasHeight = atlas->h;
+    SDL_FreeSurface(atlas);
+    if (!saved) {
+        std::cerr << "fontbake: failed to write " << atlasPath << ": " << IMG_GetError() << std::endl;
+        return 1;
+    }
+    if (!FontFormat::write(output, lineHeight, atlasWidth, atlasHeight, records, kerning, atlasName)) {
+        std::cerr << "fontbake: failed to write " << output << std::endl;
+        return 1;
+    }
+
+    // Verify round trip
+    BakedFont check;
+    if (!check.open(output) || check.getGlyphCount() != static_cast<int>(records.size()) ||
+        check.getKerningCount() != static_cast<int>(kerning.size())) {
+        std::cerr << "fontbake: verification of " << output << " failed" << std::endl;
+        return 1;
+    }
+    for (const FontFormat::RFntGlyph& record : records) {
+        BakedFont::Glyph glyph;
+        if (!check.find(record.codePoint, glyph) || glyph.advance != record.advance ||
+            glyph.src.w != record.width || glyph.src.h != record.height) {
+            std::cerr << "fontbake: glyph mismatch in " << output << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << output << " + " << atlasName << " (" << records.size() << " glyphs, "
+              << kerning.size() << " kerning pairs, " << atlasWidth << "x" << atlasHeight << " atlas";
+    if (missing > 0) {
+        std::cout << ", " << missing << " characters in no source";
+    }
+    std::cout << ")" << std::endl;
+    return 0;
+}
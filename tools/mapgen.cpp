@@ -0,0 +1,104 @@
+// mapgen - seeded procedural map generator for stress fixtures
+//
+// Usage: mapgen <overworld|dungeon> <width> <height> <seed> <output.csv|output.rmap>
+//               [<linkMap> <linkX> <linkY>]
+//
+// Sizes range from 64 to 16384 per side. The same arguments always produce
+// the same map (see field/MapGenerator.h). Stairs lead to linkMap at
+// (linkX, linkY), data/maps/world_01.csv at (9, 10) by default. Maps of
+// STREAMING_MIN_TILES tiles or more should be written as .rmap: the game
+// streams those and parsing a CSV of that size needs several GB.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "field/Map.h"
+#include "field/MapGenerator.h"
+#include "util/PathUtil.h"
+
+namespace {
+    bool parseInt(const char* text, long minValue, long maxValue, long& out) {
+        char* end = nullptr;
+        out = std::strtol(text, &end, 10);
+        return end != text && *end == '\0' && out >= minValue && out <= maxValue;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 6 && argc != 9) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <overworld|dungeon> <width> <height> <seed> <output.csv|output.rmap>"
+                  << " [<linkMap> <linkX> <linkY>]" << std::endl;
+        return 1;
+    }
+
+    MapGenerator::Config config;
+    const std::string style = argv[1];
+    if (style == "overworld") {
+        config.style = MapGenerator::Style::Overworld;
+    } else if (style == "dungeon") {
+        config.style = MapGenerator::Style::Dungeon;
+    } else {
+        std::cerr << "mapgen: unknown style " << style << std::endl;
+        return 1;
+    }
+
+    long width = 0;
+    long height = 0;
+    long seed = 0;
+    if (!parseInt(argv[2], MapGenerator::MIN_SIZE, MapGenerator::MAX_SIZE, width) ||
+        !parseInt(argv[3], MapGenerator::MIN_SIZE, MapGenerator::MAX_SIZE, height)) {
+        std::cerr << "mapgen: width and height must be " << MapGenerator::MIN_SIZE
+                  << ".." << MapGenerator::MAX_SIZE << std::endl;
+        return 1;
+    }
+    if (!parseInt(argv[4], 0, 0xFFFFFFFFL, seed)) {
+        std::cerr << "mapgen: seed must be an unsigned 32-bit number" << std::endl;
+        return 1;
+    }
+    config.width = static_cast<int>(width);
+    config.height = static_cast<int>(height);
+    config.seed = static_cast<uint32_t>(seed);
+
+    if (argc == 9) {
+        long linkX = 0;
+        long linkY = 0;
+        if (!parseInt(argv[7], 0, MapGenerator::MAX_SIZE - 1, linkX) ||
+            !parseInt(argv[8], 0, MapGenerator::MAX_SIZE - 1, linkY)) {
+            std::cerr << "mapgen: invalid link position" << std::endl;
+            return 1;
+        }
+        config.linkMap = argv[6];
+        config.linkX = static_cast<int>(linkX);
+        config.linkY = static_cast<int>(linkY);
+    }
+
+    const std::string output = argv[5];
+    bool binary = PathUtil::hasExtension(output, ".rmap");
+    if (!binary && !PathUtil::hasExtension(output, ".csv")) {
+        std::cerr << "mapgen: output must end in .csv or .rmap" << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    Map map;
+    if (!MapGenerator::generate(config, map)) {
+        std::cerr << "mapgen: generation failed" << std::endl;
+        return 1;
+    }
+    bool saved = binary ? map.saveToBinary(output) : map.saveToCSV(output);
+    if (!saved) {
+        std::cerr << "mapgen: failed to write " << output << std::endl;
+        return 1;
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    std::cout << output << " (" << style << " " << map.getWidth() << "x" << map.getHeight()
+              << ", seed " << config.seed << ", "
+              << map.getTransitions().size() << " transitions, "
+              << map.getNPCPlacements().size() << " NPCs, "
+              << elapsed.count() << " ms)" << std::endl;
+    return 0;
+}